@@ -1154,6 +1154,19 @@ export declare namespace native {
          */
         export function getDataFromFile(fullpath: string): ArrayBuffer;
 
+        /**
+         *  @en
+         *  Gets the contents of a file, copied once from the memory mapped file or mounted pack
+         *  instead of being read into an intermediate buffer first. The buffer belongs to the caller
+         *  and may be modified.
+         *
+         *  @zh
+         *  获取文件内容，直接从内存映射的文件或已挂载的包中拷贝一次，不经过中间缓冲区。返回的缓冲区归调用者所有，可以修改。
+         *  @param fullpath The current fullpath of the file. Includes path and name.
+         *  @return The contents, null if the file doesn't exist or is empty.
+         */
+        export function getFileView(fullpath: string): ArrayBuffer | null;
+
         /**
          *  @en
          *  write Data into a file
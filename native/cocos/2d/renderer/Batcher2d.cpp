@@ -28,6 +28,7 @@
 #include "base/TypeDef.h"
 #include "core/Root.h"
 #include "editor-support/MiddlewareManager.h"
+#include "profiler/Profiler.h"
 #include "renderer/pipeline/Define.h"
 #include "scene/Pass.h"
 
@@ -56,6 +57,9 @@ Batcher2d::~Batcher2d() { // NOLINT
     for (auto* drawBatch : _batches) {
         delete drawBatch;
     }
+    for (auto& retained : _retainedBatches) {
+        delete retained.second;
+    }
     _attributes.clear();
 
     if (_maskClearModel != nullptr) {
@@ -94,10 +98,50 @@ void Batcher2d::syncRootNodesToNative(ccstd::vector<Node*>&& rootNodes) {
 }
 
 void Batcher2d::fillBuffersAndMergeBatches() {
+    _reusedBatchCount = 0;
+    _rebuiltBatchCount = 0;
+    _filledDrawInfoCount = 0;
+    ++_walkFrame;
     for (auto* rootNode : _rootNodeArr) {
         walk(rootNode, 1);
         generateBatch(_currEntity, _currDrawInfo);
     }
+    _bufferFiller.flush();
+    releaseRetainedBatches();
+
+    CC_PROFILE_COUNTER(UIBatchesReused, _reusedBatchCount);
+    CC_PROFILE_COUNTER(UIBatchesRebuilt, _rebuiltBatchCount);
+    CC_PROFILE_COUNTER(UIDrawInfosFilled, _filledDrawInfoCount);
+}
+
+scene::DrawBatch2D* Batcher2d::requireDrawBatch(const void* owner, uint32_t index) {
+    // every required batch is pushed to _batches right after, in the same order
+    _batchKeys.emplace_back(owner, index);
+    auto iter = _retainedBatches.find(_batchKeys.back());
+    if (iter != _retainedBatches.end()) {
+        auto* batch = iter->second;
+        _retainedBatches.erase(iter);
+        batch->clear();
+        return batch;
+    }
+    return _drawBatchPool.alloc();
+}
+
+void Batcher2d::fillDrawBatchPass(scene::DrawBatch2D* batch, Material* mat, gfx::DepthStencilState* depthStencil, ccstd::hash_t dssHash, const ccstd::vector<scene::IMacroPatch>* patches) {
+    if (patches == nullptr && batch->isPassReusable(mat, depthStencil, dssHash)) {
+        ++_reusedBatchCount;
+        return;
+    }
+    batch->fillPass(mat, depthStencil, dssHash, patches);
+    ++_rebuiltBatchCount;
+}
+
+void Batcher2d::releaseRetainedBatches() {
+    for (auto& retained : _retainedBatches) {
+        retained.second->clear();
+        _drawBatchPool.free(retained.second);
+    }
+    _retainedBatches.clear();
 }
 
 void Batcher2d::walk(Node* node, float parentOpacity) { // NOLINT(misc-no-recursion)
@@ -121,6 +165,7 @@ void Batcher2d::walk(Node* node, float parentOpacity) { // NOLINT(misc-no-recurs
                 handleDrawInfo(entity, drawInfo, node);
             }
             entity->setVBColorDirty(false);
+            entity->setFillDirty(false);
         }
         if (entity->getRenderEntityType() == RenderEntityType::CROSSED) {
             breakWalk = true;
@@ -195,15 +240,7 @@ CC_FORCE_INLINE void Batcher2d::handleComponentDraw(RenderEntity* entity, Render
     }
 
     if (!drawInfo->getIsMeshBuffer()) {
-        if (node->getChangedFlags() || drawInfo->getVertDirty()) {
-            fillVertexBuffers(entity, drawInfo);
-            drawInfo->setVertDirty(false);
-        }
-        if (entity->getVBColorDirty()) {
-            fillColors(entity, drawInfo);
-        }
-
-        fillIndexBuffers(drawInfo);
+        recordComponentFill(entity, drawInfo, node);
     }
 
     if (isMask) {
@@ -211,6 +248,24 @@ CC_FORCE_INLINE void Batcher2d::handleComponentDraw(RenderEntity* entity, Render
     }
 }
 
+CC_FORCE_INLINE void Batcher2d::recordComponentFill(RenderEntity* entity, RenderDrawInfo* drawInfo, Node* node) {
+    UIMeshBuffer* buffer = drawInfo->getMeshBuffer();
+    const uint32_t indexOffset = buffer->getIndexOffset();
+    const bool fillVertices = node->getChangedFlags() || drawInfo->getVertDirty();
+    const bool fillColors = entity->getVBColorDirty();
+    drawInfo->setVertDirty(false);
+
+    // the script rewrites the indices of a chunk only together with its vertices, which sets vertDirty,
+    // so a clean draw info landing on the same range as in the previous walk finds its indices in place
+    if (fillVertices || fillColors || entity->getFillDirty() || !drawInfo->isFilledAt(indexOffset, _walkFrame)) {
+        _bufferFiller.record(entity, drawInfo, fillVertices, fillColors);
+        ++_filledDrawInfoCount;
+    } else {
+        buffer->setIndexOffset(indexOffset + drawInfo->getIbCount());
+    }
+    drawInfo->setFilledAt(indexOffset, _walkFrame);
+}
+
 CC_FORCE_INLINE void Batcher2d::handleModelDraw(RenderEntity* entity, RenderDrawInfo* drawInfo) {
     generateBatch(_currEntity, _currDrawInfo);
     resetRenderStates();
@@ -240,14 +295,15 @@ CC_FORCE_INLINE void Batcher2d::handleModelDraw(RenderEntity* entity, RenderDraw
     model->updateUBOs(stamp);
 
     const auto& subModelList = model->getSubModels();
-    for (const auto& submodel : subModelList) {
-        auto* curdrawBatch = _drawBatchPool.alloc();
+    for (uint32_t i = 0; i < subModelList.size(); ++i) {
+        const auto& submodel = subModelList[i];
+        auto* curdrawBatch = requireDrawBatch(drawInfo, i);
         curdrawBatch->setVisFlags(entity->getNode()->getLayer());
         curdrawBatch->setModel(model);
         curdrawBatch->setInputAssembler(submodel->getInputAssembler());
         curdrawBatch->setDescriptorSet(submodel->getDescriptorSet());
 
-        curdrawBatch->fillPass(renderMat, depthStencil, dssHash, &(submodel->getPatches()));
+        fillDrawBatchPass(curdrawBatch, renderMat, depthStencil, dssHash, &(submodel->getPatches()));
         _batches.push_back(curdrawBatch);
     }
 
@@ -354,10 +410,10 @@ void Batcher2d::generateBatch(RenderEntity* entity, RenderDrawInfo* drawInfo) {
     depthStencil = _stencilManager->getDepthStencilState(entityStage, _currMaterial);
     dssHash = _stencilManager->getStencilHash(entityStage);
 
-    auto* curdrawBatch = _drawBatchPool.alloc();
+    auto* curdrawBatch = requireDrawBatch(drawInfo);
     curdrawBatch->setVisFlags(_currLayer);
     curdrawBatch->setInputAssembler(ia);
-    curdrawBatch->fillPass(_currMaterial, depthStencil, dssHash);
+    fillDrawBatchPass(curdrawBatch, _currMaterial, depthStencil, dssHash);
     const auto& pass = curdrawBatch->getPasses().at(0);
 
     if (entity->getUseLocal()) {
@@ -393,10 +449,10 @@ void Batcher2d::generateBatchForMiddleware(RenderEntity* entity, RenderDrawInfo*
     gfx::DepthStencilState* depthStencil = _stencilManager->getDepthStencilState(stencilStage, material);
     ccstd::hash_t dssHash = _stencilManager->getStencilHash(stencilStage);
 
-    auto* curdrawBatch = _drawBatchPool.alloc();
+    auto* curdrawBatch = requireDrawBatch(drawInfo);
     curdrawBatch->setVisFlags(_currLayer);
     curdrawBatch->setInputAssembler(ia);
-    curdrawBatch->fillPass(material, depthStencil, dssHash);
+    fillDrawBatchPass(curdrawBatch, material, depthStencil, dssHash);
     const auto& pass = curdrawBatch->getPasses().at(0);
     if (entity->getUseLocal()) {
         drawInfo->updateLocalDescriptorSet(entity->getNode(), pass->getLocalSetLayout());
@@ -504,11 +560,18 @@ void Batcher2d::uploadBuffers() {
 }
 
 void Batcher2d::reset() {
-    for (auto& batch : _batches) {
-        batch->clear();
-        _drawBatchPool.free(batch);
+    // keep this frame's batches for the next walk, the ones left unclaimed are freed after it
+    releaseRetainedBatches();
+    CC_ASSERT(_batchKeys.size() == _batches.size());
+    for (size_t i = 0; i < _batches.size(); ++i) {
+        if (!_retainedBatches.emplace(_batchKeys[i], _batches[i]).second) {
+            // an owner walked twice in one frame, e.g. through a sub node
+            _batches[i]->clear();
+            _drawBatchPool.free(_batches[i]);
+        }
     }
     _batches.clear();
+    _batchKeys.clear();
 
     for (auto& meshRenderData : _meshRenderDrawInfo) {
         meshRenderData->resetMeshIA();
@@ -559,14 +622,15 @@ void Batcher2d::insertMaskBatch(RenderEntity* entity) {
     _maskClearModel->updateUBOs(stamp);
 
     const auto& subModelList = _maskClearModel->getSubModels();
-    for (const auto& submodel : subModelList) {
-        auto* curdrawBatch = _drawBatchPool.alloc();
+    for (uint32_t i = 0; i < subModelList.size(); ++i) {
+        const auto& submodel = subModelList[i];
+        auto* curdrawBatch = requireDrawBatch(entity, i);
         curdrawBatch->setVisFlags(entity->getNode()->getLayer());
         curdrawBatch->setModel(_maskClearModel);
         curdrawBatch->setInputAssembler(submodel->getInputAssembler());
         curdrawBatch->setDescriptorSet(submodel->getDescriptorSet());
 
-        curdrawBatch->fillPass(_maskClearMtl, depthStencil, dssHash, &(submodel->getPatches()));
+        fillDrawBatchPass(curdrawBatch, _maskClearMtl, depthStencil, dssHash, &(submodel->getPatches()));
         _batches.push_back(curdrawBatch);
     }
 
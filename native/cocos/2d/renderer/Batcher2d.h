@@ -26,10 +26,13 @@
 #pragma once
 #include "2d/renderer/RenderDrawInfo.h"
 #include "2d/renderer/RenderEntity.h"
+#include "2d/renderer/UIBufferFiller.h"
 #include "2d/renderer/UIMeshBuffer.h"
 #include "base/Macros.h"
 #include "base/Ptr.h"
 #include "base/TypeDef.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/hash/hash.h"
 #include "core/assets/Material.h"
 #include "core/memop/Pool.h"
 #include "renderer/gfx-base/GFXTexture.h"
@@ -75,39 +78,15 @@ public:
     void generateBatchForMiddleware(RenderEntity* entity, RenderDrawInfo* drawInfo);
     void resetRenderStates();
 
+    // batches reused from the last frame versus batches whose passes were filled again
+    inline uint32_t getReusedBatchCount() const { return _reusedBatchCount; }
+    inline uint32_t getRebuiltBatchCount() const { return _rebuiltBatchCount; }
+    // draw infos whose vertices or indices were filled in the last walk, clean ones are skipped
+    inline uint32_t getFilledDrawInfoCount() const { return _filledDrawInfoCount; }
+
 private:
     bool _isInit = false;
 
-    inline void fillIndexBuffers(RenderDrawInfo* drawInfo) { // NOLINT(readability-convert-member-functions-to-static)
-        uint16_t* ib = drawInfo->getIDataBuffer();
-
-        UIMeshBuffer* buffer = drawInfo->getMeshBuffer();
-        uint32_t indexOffset = buffer->getIndexOffset();
-
-        uint16_t* indexb = drawInfo->getIbBuffer();
-        uint32_t indexCount = drawInfo->getIbCount();
-
-        memcpy(&ib[indexOffset], indexb, indexCount * sizeof(uint16_t));
-        indexOffset += indexCount;
-
-        buffer->setIndexOffset(indexOffset);
-    }
-
-    inline void fillVertexBuffers(RenderEntity* entity, RenderDrawInfo* drawInfo) { // NOLINT(readability-convert-member-functions-to-static)
-        Node* node = entity->getNode();
-        const Mat4& matrix = node->getWorldMatrix();
-        uint8_t stride = drawInfo->getStride();
-        uint32_t size = drawInfo->getVbCount() * stride;
-        float* vbBuffer = drawInfo->getVbBuffer();
-        for (int i = 0; i < size; i += stride) {
-            Render2dLayout* curLayout = drawInfo->getRender2dLayout(i);
-            // make sure that the layout of Vec3 is three consecutive floats
-            static_assert(sizeof(Vec3) == 3 * sizeof(float));
-            // cast to reduce value copy instructions
-            reinterpret_cast<Vec3*>(vbBuffer + i)->transformMat4(curLayout->position, matrix);
-        }
-    }
-
     inline void setIndexRange(RenderDrawInfo* drawInfo) { // NOLINT(readability-convert-member-functions-to-static)
         UIMeshBuffer* buffer = drawInfo->getMeshBuffer();
         uint32_t indexOffset = drawInfo->getIndexOffset();
@@ -118,22 +97,11 @@ private:
         }
     }
 
-    inline void fillColors(RenderEntity* entity, RenderDrawInfo* drawInfo) { // NOLINT(readability-convert-member-functions-to-static)
-        Color temp = entity->getColor();
-
-        uint8_t stride = drawInfo->getStride();
-        uint32_t size = drawInfo->getVbCount() * stride;
-        float* vbBuffer = drawInfo->getVbBuffer();
-
-        uint32_t offset = 0;
-        for (int i = 0; i < size; i += stride) {
-            offset = i + 5;
-            vbBuffer[offset++] = static_cast<float>(temp.r) / 255.0F;
-            vbBuffer[offset++] = static_cast<float>(temp.g) / 255.0F;
-            vbBuffer[offset++] = static_cast<float>(temp.b) / 255.0F;
-            vbBuffer[offset++] = entity->getOpacity();
-        }
-    }
+    // the owner is the draw info, model or mask entity producing the batch, index tells apart its sub-models
+    scene::DrawBatch2D* requireDrawBatch(const void* owner, uint32_t index = 0);
+    void fillDrawBatchPass(scene::DrawBatch2D* batch, Material* mat, gfx::DepthStencilState* depthStencil, ccstd::hash_t dssHash, const ccstd::vector<scene::IMacroPatch>* patches = nullptr);
+    void releaseRetainedBatches();
+    void recordComponentFill(RenderEntity* entity, RenderDrawInfo* drawInfo, Node* node);
 
     void insertMaskBatch(RenderEntity* entity);
     void createClearModel();
@@ -147,9 +115,21 @@ private:
     // weak reference
     ccstd::vector<Node*> _rootNodeArr;
 
+    // vertex and index data are filled after the walk, in parallel
+    UIBufferFiller _bufferFiller;
+
     // manage memory manually
     ccstd::vector<scene::DrawBatch2D*> _batches;
     memop::Pool<scene::DrawBatch2D> _drawBatchPool;
+    using DrawBatchKey = std::pair<const void*, uint32_t>;
+    // owner of each batch in _batches
+    ccstd::vector<DrawBatchKey> _batchKeys;
+    // batches of the last frame by owner, taken over by the same owner so insertions elsewhere keep them valid
+    ccstd::unordered_map<DrawBatchKey, scene::DrawBatch2D*, ccstd::hash<DrawBatchKey>> _retainedBatches;
+    uint32_t _reusedBatchCount{0};
+    uint32_t _rebuiltBatchCount{0};
+    uint32_t _filledDrawInfoCount{0};
+    uint32_t _walkFrame{0};
 
     // weak reference
     gfx::Device* _device{nullptr}; // use getDevice()
@@ -200,6 +200,20 @@ public:
 
     void changeMeshBuffer();
 
+    // whether the data filled in the previous walk is still in place at indexOffset of the same mesh buffer
+    inline bool isFilledAt(uint32_t indexOffset, uint32_t walkFrame) const {
+        return _filledWalkFrame + 1 == walkFrame && _filledIndexOffset == indexOffset && _filledIbCount == _drawInfoAttrs._ibCount
+               && _filledIDataBuffer == _iDataBuffer && _filledIbBuffer == _ibBuffer && _filledVbBuffer == _vbBuffer;
+    }
+    inline void setFilledAt(uint32_t indexOffset, uint32_t walkFrame) {
+        _filledWalkFrame = walkFrame;
+        _filledIndexOffset = indexOffset;
+        _filledIbCount = _drawInfoAttrs._ibCount;
+        _filledIDataBuffer = _iDataBuffer;
+        _filledIbBuffer = _ibBuffer;
+        _filledVbBuffer = _vbBuffer;
+    }
+
     inline RenderDrawInfoType getEnumDrawInfoType() const { return _drawInfoAttrs._drawInfoType; }
 
     inline void setRender2dBufferToNative(uint8_t* buffer) { // NOLINT(bugprone-easily-swappable-parameters)
@@ -245,6 +259,7 @@ public:
         _subNode = nullptr;
         _model = nullptr;
         _sharedBuffer = nullptr;
+        _filledWalkFrame = 0;
     }
 
 private:
@@ -295,5 +310,13 @@ private:
     gfx::InputAssemblerInfo* _iaInfo{nullptr};
     ccstd::vector<gfx::InputAssembler*>* _iaPool{nullptr};
     LocalDSBF* _localDSBF{nullptr};
+
+    // what the last Batcher2d fill left in the mesh buffer, weak references
+    uint16_t* _filledIDataBuffer{nullptr};
+    uint16_t* _filledIbBuffer{nullptr};
+    float* _filledVbBuffer{nullptr};
+    uint32_t _filledIndexOffset{0};
+    uint32_t _filledIbCount{0};
+    uint32_t _filledWalkFrame{0};
 };
 } // namespace cc
@@ -48,22 +48,26 @@ RenderEntity::~RenderEntity() {
 void RenderEntity::addDynamicRenderDrawInfo(RenderDrawInfo* drawInfo) {
     CC_ASSERT(_renderEntityType != RenderEntityType::STATIC);
     _dynamicDrawInfos.push_back(drawInfo);
+    _fillDirty = true;
 }
 void RenderEntity::setDynamicRenderDrawInfo(RenderDrawInfo* drawInfo, uint32_t index) {
     CC_ASSERT(_renderEntityType != RenderEntityType::STATIC);
     if (index < _dynamicDrawInfos.size()) {
         _dynamicDrawInfos[index] = drawInfo;
+        _fillDirty = true;
     }
 }
 void RenderEntity::removeDynamicRenderDrawInfo() {
     CC_ASSERT(_renderEntityType != RenderEntityType::STATIC);
     if (_dynamicDrawInfos.empty()) return;
     _dynamicDrawInfos.pop_back(); // warning: memory leaking & crash
+    _fillDirty = true;
 }
 
 void RenderEntity::clearDynamicRenderDrawInfos() {
     CC_ASSERT(_renderEntityType != RenderEntityType::STATIC);
     _dynamicDrawInfos.clear();
+    _fillDirty = true;
 }
 
 void RenderEntity::clearStaticRenderDrawInfos() {
@@ -74,6 +78,7 @@ void RenderEntity::clearStaticRenderDrawInfos() {
         drawInfo.resetDrawInfo();
     }
     _staticDrawInfoSize = 0;
+    _fillDirty = true;
 }
 
 void RenderEntity::setNode(Node* node) {
@@ -84,6 +89,7 @@ void RenderEntity::setNode(Node* node) {
     if (_node) {
         _node->setUserData(this);
     }
+    _fillDirty = true;
 }
 
 void RenderEntity::setRenderTransform(Node* renderTransform) {
@@ -104,6 +110,7 @@ ccstd::vector<RenderDrawInfo*>& RenderEntity::getDynamicRenderDrawInfos() {
 void RenderEntity::setStaticDrawInfoSize(uint32_t size) {
     CC_ASSERT(_renderEntityType == RenderEntityType::STATIC && size <= RenderEntity::STATIC_DRAW_INFO_CAPACITY);
     _staticDrawInfoSize = size;
+    _fillDirty = true;
 }
 RenderDrawInfo* RenderEntity::getStaticRenderDrawInfo(uint32_t index) {
     CC_ASSERT(_renderEntityType == RenderEntityType::STATIC && index < _staticDrawInfoSize);
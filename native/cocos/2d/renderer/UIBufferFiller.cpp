@@ -0,0 +1,118 @@
+/****************************************************************************
+ Copyright (c) 2019-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "2d/renderer/UIBufferFiller.h"
+#include "2d/renderer/UIMeshBuffer.h"
+#include "base/job-system/JobSystem.h"
+#include "profiler/Profiler.h"
+
+namespace cc {
+
+void UIBufferFiller::record(RenderEntity* entity, RenderDrawInfo* drawInfo, bool fillVertices, bool fillColors) {
+    UIMeshBuffer* buffer = drawInfo->getMeshBuffer();
+    const uint32_t indexOffset = buffer->getIndexOffset();
+    buffer->setIndexOffset(indexOffset + drawInfo->getIbCount());
+
+    // the world matrix is updated lazily, resolve it here rather than on the workers
+    const Mat4* worldMatrix = fillVertices ? &entity->getNode()->getWorldMatrix() : nullptr;
+    _commands.push_back({worldMatrix, entity, drawInfo, indexOffset, fillColors});
+
+    _pendingVertices += drawInfo->getVbCount();
+    if (_pendingVertices >= VERTICES_PER_JOB) {
+        _jobEnds.push_back(static_cast<uint32_t>(_commands.size()));
+        _pendingVertices = 0;
+    }
+}
+
+void UIBufferFiller::flush() {
+    CC_PROFILE(UIBufferFillerFlush);
+    if (_commands.empty()) {
+        return;
+    }
+    if (_pendingVertices > 0) {
+        _jobEnds.push_back(static_cast<uint32_t>(_commands.size()));
+    }
+
+    const auto jobCount = static_cast<uint32_t>(_jobEnds.size());
+    if (_parallelEnabled && jobCount > 1) {
+        auto fillJob = [this](uint32_t job) {
+            fillRange(job ? _jobEnds[job - 1] : 0U, _jobEnds[job]);
+        };
+        JobGraph g(JobSystem::getInstance(), "UIBufferFill");
+        g.createForEachIndexJob(1U, jobCount, 1U, fillJob);
+        g.run();
+        fillJob(0);
+        g.waitForAll();
+    } else {
+        fillRange(0, static_cast<uint32_t>(_commands.size()));
+    }
+
+    _commands.clear();
+    _jobEnds.clear();
+    _pendingVertices = 0;
+}
+
+void UIBufferFiller::fillRange(uint32_t begin, uint32_t end) const {
+    for (uint32_t i = begin; i < end; ++i) {
+        fill(_commands[i]);
+    }
+}
+
+void UIBufferFiller::fill(const UIFillCommand& command) {
+    RenderDrawInfo* drawInfo = command.drawInfo;
+    const uint8_t stride = drawInfo->getStride();
+    const uint32_t size = drawInfo->getVbCount() * stride;
+    float* vbBuffer = drawInfo->getVbBuffer();
+
+    if (command.worldMatrix) {
+        const Mat4& matrix = *command.worldMatrix;
+        for (uint32_t i = 0; i < size; i += stride) {
+            Render2dLayout* curLayout = drawInfo->getRender2dLayout(i);
+            // make sure that the layout of Vec3 is three consecutive floats
+            static_assert(sizeof(Vec3) == 3 * sizeof(float));
+            // cast to reduce value copy instructions
+            reinterpret_cast<Vec3*>(vbBuffer + i)->transformMat4(curLayout->position, matrix);
+        }
+    }
+
+    if (command.fillColors) {
+        const Color temp = command.entity->getColor();
+        const float r = static_cast<float>(temp.r) / 255.0F;
+        const float g = static_cast<float>(temp.g) / 255.0F;
+        const float b = static_cast<float>(temp.b) / 255.0F;
+        const float a = command.entity->getOpacity();
+        for (uint32_t i = 0; i < size; i += stride) {
+            float* color = vbBuffer + i + 5;
+            color[0] = r;
+            color[1] = g;
+            color[2] = b;
+            color[3] = a;
+        }
+    }
+
+    memcpy(&drawInfo->getIDataBuffer()[command.indexOffset], drawInfo->getIbBuffer(), drawInfo->getIbCount() * sizeof(uint16_t));
+}
+
+} // namespace cc
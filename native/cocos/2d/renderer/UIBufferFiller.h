@@ -0,0 +1,82 @@
+/****************************************************************************
+ Copyright (c) 2019-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+#include "2d/renderer/RenderDrawInfo.h"
+#include "2d/renderer/RenderEntity.h"
+#include "base/Macros.h"
+#include "base/std/container/vector.h"
+#include "math/Mat4.h"
+
+namespace cc {
+
+struct UIFillCommand {
+    // nullptr if the vertex positions are up to date
+    const Mat4* worldMatrix{nullptr};
+    RenderEntity* entity{nullptr};
+    RenderDrawInfo* drawInfo{nullptr};
+    uint32_t indexOffset{0};
+    bool fillColors{false};
+};
+
+/**
+ * UIBufferFiller: fills vertex and index data of the 2d draw infos recorded during Batcher2d::walk.
+ * Index ranges in the UIMeshBuffers are reserved while recording, so the recorded commands are independent
+ * of each other and are filled in parallel on the job system.
+ */
+class UIBufferFiller final {
+public:
+    // vertices per job, smaller workloads are filled on the calling thread
+    static constexpr uint32_t VERTICES_PER_JOB{4096};
+
+    UIBufferFiller() = default;
+    ~UIBufferFiller() = default;
+
+    /**
+     * Reserves the index range of the draw info in its mesh buffer and records what needs to be filled.
+     * Must be called in draw order, from the thread walking the scene.
+     */
+    void record(RenderEntity* entity, RenderDrawInfo* drawInfo, bool fillVertices, bool fillColors);
+    void flush();
+
+    inline void setParallelEnabled(bool enabled) { _parallelEnabled = enabled; }
+    inline bool isParallelEnabled() const { return _parallelEnabled; }
+    inline uint32_t getCommandCount() const { return static_cast<uint32_t>(_commands.size()); }
+
+    static void fill(const UIFillCommand& command);
+
+private:
+    void fillRange(uint32_t begin, uint32_t end) const;
+
+    ccstd::vector<UIFillCommand> _commands;
+    // command index where each job ends
+    ccstd::vector<uint32_t> _jobEnds;
+    uint32_t _pendingVertices{0};
+    bool _parallelEnabled{true};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(UIBufferFiller);
+};
+
+} // namespace cc
@@ -124,13 +124,14 @@ void UIMeshBuffer::uploadBuffers() {
         if (byteCount > vBuffer->getSize()) {
             vBuffer->resize(byteCount);
         }
-        vBuffer->update(_vData);
+        // only the range used this frame, the buffers grow but never shrink
+        vBuffer->update(_vData, byteCount);
     }
     gfx::Buffer* iBuffer = ia->getIndexBuffer();
     if (indexCount * 2 > iBuffer->getSize()) {
         iBuffer->resize(indexCount * 2);
     }
-    iBuffer->update(_iData);
+    iBuffer->update(_iData, indexCount * 2);
 
     setDirty(false);
 }
@@ -123,7 +123,7 @@ size_t DummyGraph::addNode(Fn &&fn) {
 
 class DummyJobGraph final {
 public:
-    explicit DummyJobGraph(DummyJobSystem * /*system*/) noexcept {}
+    explicit DummyJobGraph(DummyJobSystem * /*system*/, const char * /*name*/ = nullptr) noexcept {}
     DummyJobGraph(const DummyJobGraph &) = delete;
     DummyJobGraph(DummyJobGraph &&) = delete;
     DummyJobGraph &operator=(const DummyJobGraph &) = delete;
@@ -138,6 +138,8 @@ public:
 
     void makeEdge(uint32_t j1, uint32_t j2);
 
+    inline void setJobName(uint32_t /*job*/, const char * /*name*/) noexcept {}
+
     void run() noexcept;
 
     inline void waitForAll() { run(); }
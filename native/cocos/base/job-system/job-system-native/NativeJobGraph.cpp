@@ -0,0 +1,91 @@
+/****************************************************************************
+ Copyright (c) 2020-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "NativeJobGraph.h"
+
+namespace cc {
+
+void NativeJobGraph::makeEdge(uint32_t j1, uint32_t j2) noexcept {
+    CC_ASSERT(j1 < _nodes.size() && j2 < _nodes.size());
+    _nodes[j1].successors.push_back(&_nodes[j2]);
+    ++_nodes[j2].predecessorCount;
+}
+
+void NativeJobGraph::setJobName(uint32_t job, const char *name) noexcept {
+    CC_ASSERT(job < _nodes.size());
+    _nodes[job].name = name;
+}
+
+void NativeJobGraph::run() noexcept {
+    if (_nodes.empty()) {
+        return;
+    }
+    waitForAll();
+
+    // reset every counter before the first task can possibly finish
+    for (auto &node : _nodes) {
+        node.pendingPredecessors.store(node.predecessorCount, std::memory_order_relaxed);
+        node.pendingTasks.store(1, std::memory_order_relaxed);
+        node.task = {&node, 0, node.parallel ? node.count : 1U, false};
+    }
+    _finished = false;
+    _pending = true;
+    _pendingNodes.store(static_cast<uint32_t>(_nodes.size()), std::memory_order_release);
+
+    for (auto &node : _nodes) {
+        if (!node.predecessorCount) {
+            _system->submit(&node.task);
+        }
+    }
+}
+
+void NativeJobGraph::waitForAll() {
+    if (!_pending) {
+        return;
+    }
+
+    while (_pendingNodes.load(std::memory_order_acquire)) {
+        if (!_system->help()) {
+            if (!_system->currentWorker()) {
+                break;
+            }
+            // never put a worker to sleep, the remaining tasks may depend on it
+            std::this_thread::yield();
+        }
+    }
+
+    // the last node signals under the lock, so the graph can't be destroyed while it is being notified
+    std::unique_lock<std::mutex> lock(_mutex);
+    _condition.wait(lock, [this]() { return _finished; });
+    _pending = false;
+}
+
+void NativeJobGraph::onFinished() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _finished = true;
+    _condition.notify_all();
+}
+
+} // namespace cc
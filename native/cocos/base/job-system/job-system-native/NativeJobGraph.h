@@ -0,0 +1,136 @@
+/****************************************************************************
+ Copyright (c) 2020-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include "NativeJobSystem.h"
+#include "base/Macros.h"
+#include "base/memory/Memory.h"
+#include "base/std/container/deque.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+class NativeJobCallable {
+public:
+    virtual ~NativeJobCallable() = default;
+    virtual void execute(uint32_t index) = 0;
+};
+
+template <class Fn>
+class NativeJobCallableImpl final : public NativeJobCallable {
+public:
+    explicit NativeJobCallableImpl(Fn &&fn) noexcept : _fn(std::forward<Fn>(fn)) {}
+    inline void execute(uint32_t index) override { _fn(index); }
+
+private:
+    std::decay_t<Fn> _fn;
+};
+
+struct NativeJobNode {
+    NativeJobNode(NativeJobGraph *owner, NativeJobCallable *fn, uint32_t from, uint32_t to, uint32_t stride) noexcept
+    : graph(owner), callable(fn), begin(from), step(stride), count(from < to ? (to - from + stride - 1) / stride : 0) {}
+    ~NativeJobNode() { delete callable; }
+
+    NativeJobGraph *graph{nullptr};
+    NativeJobCallable *callable{nullptr};
+    const char *name{nullptr};
+    // iteration i runs callable with begin + i * step
+    uint32_t begin{0};
+    uint32_t step{1};
+    uint32_t count{1};
+    bool parallel{false};
+
+    ccstd::vector<NativeJobNode *> successors;
+    uint32_t predecessorCount{0};
+
+    std::atomic<uint32_t> pendingPredecessors{0};
+    std::atomic<uint32_t> pendingTasks{0};
+    NativeJobTask task;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(NativeJobNode);
+};
+
+class NativeJobGraph final {
+public:
+    explicit NativeJobGraph(NativeJobSystem *system, const char *name = nullptr) noexcept
+    : _system(system), _name(name) {}
+    ~NativeJobGraph() { waitForAll(); }
+
+    template <typename Function>
+    uint32_t createJob(Function &&func) noexcept;
+
+    template <typename Function>
+    uint32_t createForEachIndexJob(uint32_t begin, uint32_t end, uint32_t step, Function &&func) noexcept;
+
+    // j2 runs after j1 has completed, including all iterations of a parallel job
+    void makeEdge(uint32_t j1, uint32_t j2) noexcept;
+
+    // name shown for the job in traces, must outlive the graph
+    void setJobName(uint32_t job, const char *name) noexcept;
+
+    void run() noexcept;
+
+    void waitForAll();
+
+private:
+    friend class NativeJobSystem;
+
+    void onFinished();
+
+    NativeJobSystem *_system{nullptr};
+    const char *_name{nullptr};
+    ccstd::deque<NativeJobNode> _nodes; // existing nodes cannot be invalidated
+
+    std::atomic<uint32_t> _pendingNodes{0};
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _finished{true};
+    bool _pending{false};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(NativeJobGraph);
+};
+
+template <typename Function>
+uint32_t NativeJobGraph::createJob(Function &&func) noexcept {
+    auto job = [fn = std::forward<Function>(func)](uint32_t /*index*/) mutable { fn(); };
+    _nodes.emplace_back(this, ccnew NativeJobCallableImpl<decltype(job)>(std::move(job)), 0U, 1U, 1U);
+    return static_cast<uint32_t>(_nodes.size() - 1U);
+}
+
+template <typename Function>
+uint32_t NativeJobGraph::createForEachIndexJob(uint32_t begin, uint32_t end, uint32_t step, Function &&func) noexcept {
+    CC_ASSERT(step > 0);
+    _nodes.emplace_back(this, ccnew NativeJobCallableImpl<Function>(std::forward<Function>(func)), begin, end, step);
+    _nodes.back().parallel = true;
+    return static_cast<uint32_t>(_nodes.size() - 1U);
+}
+
+} // namespace cc
@@ -0,0 +1,315 @@
+/****************************************************************************
+ Copyright (c) 2020-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "NativeJobSystem.h"
+#include <chrono>
+#include "NativeJobGraph.h"
+#include "base/Log.h"
+#include "base/StringUtil.h"
+#include "platform/FileUtils.h"
+#include "profiler/TimelineRecorder.h"
+
+namespace cc {
+
+namespace {
+
+thread_local NativeJobSystem *tlsSystem{nullptr};
+thread_local void *tlsWorker{nullptr};
+
+// spins before a worker goes to sleep, stealing is cheap compared to a wake up
+constexpr uint32_t IDLE_SPIN_COUNT = 64;
+
+int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void appendTraceEvent(ccstd::string &out, const char *name, uint32_t tid, double ts, double dur, uint32_t first, uint32_t last) {
+    if (out.back() != '[') {
+        out += ",\n";
+    }
+    out += StringUtil::format(R"({"name":"%s","cat":"job","ph":"X","pid":0,"tid":%u,"ts":%.3f,"dur":%.3f,"args":{"first":%u,"last":%u}})",
+                              name, tid, ts, dur, first, last);
+}
+
+void appendThreadName(ccstd::string &out, uint32_t tid, const char *name) {
+    if (out.back() != '[') {
+        out += ",\n";
+    }
+    out += StringUtil::format(R"({"name":"thread_name","ph":"M","pid":0,"tid":%u,"args":{"name":"%s"}})", tid, name);
+}
+
+} // namespace
+
+NativeJobSystem *NativeJobSystem::_instance = nullptr;
+
+NativeJobSystem::NativeJobSystem(uint32_t threadCount) noexcept
+: _threadCount(std::max(1U, threadCount)),
+  _traceOrigin(now()) {
+    _workers.reserve(_threadCount);
+    for (uint32_t i = 0; i < _threadCount; ++i) {
+        _workers.emplace_back(std::make_unique<Worker>(i));
+    }
+    // start the threads once every deque exists, workers steal from each other right away
+    for (auto &worker : _workers) {
+        worker->thread = std::thread(&NativeJobSystem::workerLoop, this, worker.get());
+    }
+    CC_LOG_INFO("Native Job system initialized: %d worker threads", _threadCount);
+}
+
+NativeJobSystem::~NativeJobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _running.store(false, std::memory_order_seq_cst);
+    }
+    _sleepCondition.notify_all();
+    for (auto &worker : _workers) {
+        worker->thread.join();
+    }
+}
+
+NativeJobSystem::Worker *NativeJobSystem::currentWorker() const {
+    return tlsSystem == this ? static_cast<Worker *>(tlsWorker) : nullptr;
+}
+
+void NativeJobSystem::submit(NativeJobTask *task) {
+    Worker *worker = currentWorker();
+    if (worker) {
+        worker->deque.push(task);
+    } else {
+        std::lock_guard<std::mutex> lock(_injectedMutex);
+        _injected.push_back(task);
+        _injectedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    wakeUp(false);
+}
+
+void NativeJobSystem::wakeUp(bool all) {
+    _workEpoch.fetch_add(1, std::memory_order_seq_cst);
+    if (_sleepers.load(std::memory_order_seq_cst)) {
+        // pairs with the predicate check of sleeping workers, no wake up can get lost in between
+        { std::lock_guard<std::mutex> lock(_sleepMutex); }
+        if (all) {
+            _sleepCondition.notify_all();
+        } else {
+            _sleepCondition.notify_one();
+        }
+    }
+}
+
+NativeJobTask *NativeJobSystem::takeTask(Worker *worker) {
+    if (worker) {
+        if (NativeJobTask *task = worker->deque.pop()) {
+            return task;
+        }
+    }
+
+    if (_injectedCount.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(_injectedMutex);
+        if (!_injected.empty()) {
+            NativeJobTask *task = _injected.front();
+            _injected.pop_front();
+            _injectedCount.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+
+    uint32_t begin = 0;
+    if (worker) {
+        worker->seed ^= worker->seed << 13;
+        worker->seed ^= worker->seed >> 17;
+        worker->seed ^= worker->seed << 5;
+        begin = worker->seed;
+    }
+    return stealTask(begin);
+}
+
+NativeJobTask *NativeJobSystem::stealTask(uint32_t begin) {
+    for (uint32_t i = 0; i < _threadCount; ++i) {
+        Worker *victim = _workers[(begin + i) % _threadCount].get();
+        if (victim->deque.empty()) {
+            continue;
+        }
+        if (NativeJobTask *task = victim->deque.steal()) {
+            _stealCount.fetch_add(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+bool NativeJobSystem::help() {
+    Worker *worker = currentWorker();
+    NativeJobTask *task = takeTask(worker);
+    if (!task) {
+        return false;
+    }
+    execute(task, worker);
+    return true;
+}
+
+void NativeJobSystem::workerLoop(Worker *worker) {
+    tlsSystem = this;
+    tlsWorker = worker;
+    TimelineRecorder::getInstance()->setThreadName(StringUtil::format("JobWorker %u", worker->index).c_str());
+
+    uint32_t idleCount = 0;
+    while (_running.load(std::memory_order_relaxed)) {
+        const uint64_t epoch = _workEpoch.load(std::memory_order_seq_cst);
+        if (NativeJobTask *task = takeTask(worker)) {
+            execute(task, worker);
+            idleCount = 0;
+            continue;
+        }
+        if (++idleCount < IDLE_SPIN_COUNT) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _sleepers.fetch_add(1, std::memory_order_seq_cst);
+        _sleepCondition.wait(lock, [&]() {
+            return _workEpoch.load(std::memory_order_seq_cst) != epoch || !_running.load(std::memory_order_relaxed);
+        });
+        _sleepers.fetch_sub(1, std::memory_order_seq_cst);
+        idleCount = 0;
+    }
+
+    tlsSystem = nullptr;
+    tlsWorker = nullptr;
+}
+
+void NativeJobSystem::execute(NativeJobTask *task, Worker *worker) {
+    while (task) {
+        NativeJobNode *node = task->node;
+        uint32_t first = task->first;
+        uint32_t last = task->last;
+        if (task->split) {
+            delete task;
+        }
+
+        const char *name = node->name ? node->name : (node->graph->_name ? node->graph->_name : "Job");
+        auto *recorder = TimelineRecorder::getInstance();
+        const bool recording = recorder->isRecording();
+        if (recording) {
+            recorder->beginScope(name);
+        }
+        const bool tracing = isTracing();
+        const int64_t begin = tracing ? now() : 0;
+        const uint32_t traceFirst = first;
+
+        if (node->parallel) {
+            for (; first < last; ++first) {
+                // lazy binary splitting: share the upper half only once the previous share was taken,
+                // threads outside of the pool share through the injected queue
+                if (last - first > 1 && (worker ? worker->deque.empty() : !_injectedCount.load(std::memory_order_relaxed))) {
+                    const uint32_t middle = first + (last - first) / 2;
+                    node->pendingTasks.fetch_add(1, std::memory_order_relaxed);
+                    submit(ccnew NativeJobTask{node, middle, last, true});
+                    last = middle;
+                }
+                node->callable->execute(node->begin + first * node->step);
+            }
+        } else {
+            node->callable->execute(0);
+        }
+
+        if (tracing) {
+            record(worker, {name, traceFirst, last, begin, now()});
+        }
+        if (recording) {
+            recorder->endScope();
+        }
+
+        task = nullptr;
+        if (node->pendingTasks.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            task = finishNode(node);
+        }
+    }
+}
+
+NativeJobTask *NativeJobSystem::finishNode(NativeJobNode *node) {
+    NativeJobTask *continuation = nullptr;
+    for (NativeJobNode *successor : node->successors) {
+        if (successor->pendingPredecessors.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            if (!continuation) {
+                continuation = &successor->task;
+            } else {
+                submit(&successor->task);
+            }
+        }
+    }
+
+    // neither the node nor the graph may be touched once the last node is done
+    NativeJobGraph *graph = node->graph;
+    if (graph->_pendingNodes.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        graph->onFinished();
+    }
+    return continuation;
+}
+
+void NativeJobSystem::record(Worker *worker, const TraceEvent &event) {
+    if (worker) {
+        worker->trace.events.push_back(event);
+    } else {
+        std::lock_guard<std::mutex> lock(_externalTrace.mutex);
+        _externalTrace.events.push_back(event);
+    }
+}
+
+void NativeJobSystem::setTracing(bool enabled) {
+    _tracing.store(enabled, std::memory_order_relaxed);
+}
+
+ccstd::string NativeJobSystem::dumpTrace() const {
+    ccstd::string out{R"({"displayTimeUnit":"ns","traceEvents":[)"};
+    auto appendBuffer = [&](const TraceBuffer &buffer, uint32_t tid) {
+        for (const auto &event : buffer.events) {
+            appendTraceEvent(out, event.name, tid, static_cast<double>(event.begin - _traceOrigin) / 1000.0,
+                             static_cast<double>(event.end - event.begin) / 1000.0, event.first, event.last);
+        }
+    };
+    for (const auto &worker : _workers) {
+        appendThreadName(out, worker->index, StringUtil::format("JobWorker %u", worker->index).c_str());
+        appendBuffer(worker->trace, worker->index);
+    }
+    appendThreadName(out, _threadCount, "External");
+    appendBuffer(_externalTrace, _threadCount);
+    out += "]}\n";
+    return out;
+}
+
+bool NativeJobSystem::writeTrace(const ccstd::string &path) const {
+    return FileUtils::getInstance()->writeStringToFile(dumpTrace(), path);
+}
+
+void NativeJobSystem::clearTrace() {
+    for (auto &worker : _workers) {
+        worker->trace.events.clear();
+    }
+    std::lock_guard<std::mutex> lock(_externalTrace.mutex);
+    _externalTrace.events.clear();
+}
+
+} // namespace cc
@@ -0,0 +1,172 @@
+/****************************************************************************
+ Copyright (c) 2020-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "WorkStealingDeque.h"
+#include "base/Macros.h"
+#include "base/memory/Memory.h"
+#include "base/std/container/deque.h"
+#include "base/std/container/string.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+using NativeJobToken = void;
+
+class NativeJobGraph;
+struct NativeJobNode;
+
+// A slice [first, last) of the iterations of a job node, for plain jobs it is always [0, 1).
+struct NativeJobTask {
+    NativeJobNode *node{nullptr};
+    uint32_t first{0};
+    uint32_t last{0};
+    bool split{false}; // allocated when a parallel job is split, freed after execution
+};
+
+/**
+ * Work-stealing job system.
+ * Every worker owns a deque, new tasks are pushed to the bottom of the current worker's deque and idle
+ * workers steal from the top of the others. Parallel jobs are split lazily: a thread hands out the upper
+ * half of its remaining range only when its own deque has been drained, so chunks adapt to the actual load.
+ * Threads outside of the pool, e.g. the main thread helping in waitForAll, share through the injected queue.
+ * When a job finishes, the first successor it makes ready runs right away on the same worker as a continuation.
+ * Threads that wait for a graph help executing tasks instead of blocking.
+ */
+class NativeJobSystem final {
+public:
+    static NativeJobSystem *getInstance() {
+        if (!_instance) {
+            _instance = ccnew NativeJobSystem;
+        }
+        return _instance;
+    }
+
+    static void destroyInstance() {
+        CC_SAFE_DELETE(_instance);
+    }
+
+    NativeJobSystem() noexcept : NativeJobSystem(defaultThreadCount()) {}
+    explicit NativeJobSystem(uint32_t threadCount) noexcept;
+    ~NativeJobSystem();
+
+    inline uint32_t threadCount() const { return _threadCount; }
+
+    /**
+     * Record the execution of every task, see dumpTrace.
+     */
+    void setTracing(bool enabled);
+    inline bool isTracing() const { return _tracing.load(std::memory_order_relaxed); }
+
+    /**
+     * Recorded tasks in the Chrome trace event format, viewable in chrome://tracing or Perfetto.
+     * Should be called while no graph is running.
+     */
+    ccstd::string dumpTrace() const;
+    bool writeTrace(const ccstd::string &path) const;
+    void clearTrace();
+
+    // number of tasks taken from other workers since startup
+    inline uint64_t getStealCount() const { return _stealCount.load(std::memory_order_relaxed); }
+
+private:
+    friend class NativeJobGraph;
+
+    struct TraceEvent {
+        const char *name{nullptr};
+        uint32_t first{0};
+        uint32_t last{0};
+        int64_t begin{0};
+        int64_t end{0};
+    };
+
+    struct TraceBuffer {
+        ccstd::vector<TraceEvent> events;
+        std::mutex mutex; // only used for threads outside of the pool
+    };
+
+    struct Worker {
+        explicit Worker(uint32_t idx) : index(idx), seed(idx * 2654435761U + 1U) {}
+
+        uint32_t index{0};
+        uint32_t seed{1};
+        WorkStealingDeque<NativeJobTask> deque;
+        TraceBuffer trace;
+        std::thread thread;
+    };
+
+    static uint32_t defaultThreadCount() {
+        const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+        return std::max(2U, hardwareThreads > 2U ? hardwareThreads - 2U : 0U);
+    }
+
+    Worker *currentWorker() const;
+
+    void submit(NativeJobTask *task);
+    void wakeUp(bool all);
+    NativeJobTask *takeTask(Worker *worker);
+    NativeJobTask *stealTask(uint32_t begin);
+    // executes one pending task on behalf of a waiting thread
+    bool help();
+
+    void workerLoop(Worker *worker);
+    void execute(NativeJobTask *task, Worker *worker);
+    NativeJobTask *finishNode(NativeJobNode *node);
+    void record(Worker *worker, const TraceEvent &event);
+
+    static NativeJobSystem *_instance;
+
+    uint32_t _threadCount{0};
+    ccstd::vector<std::unique_ptr<Worker>> _workers;
+
+    // tasks submitted from threads outside of the pool
+    std::mutex _injectedMutex;
+    ccstd::deque<NativeJobTask *> _injected;
+    std::atomic<uint32_t> _injectedCount{0};
+
+    std::mutex _sleepMutex;
+    std::condition_variable _sleepCondition;
+    std::atomic<uint32_t> _sleepers{0};
+    std::atomic<uint64_t> _workEpoch{0};
+    std::atomic<bool> _running{true};
+
+    std::atomic<bool> _tracing{false};
+    TraceBuffer _externalTrace;
+    int64_t _traceOrigin{0};
+
+    std::atomic<uint64_t> _stealCount{0};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(NativeJobSystem);
+};
+
+} // namespace cc
@@ -0,0 +1,160 @@
+/****************************************************************************
+ Copyright (c) 2020-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "base/Macros.h"
+#include "base/memory/Memory.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+/**
+ * Chase-Lev work-stealing deque of pointers.
+ * push() and pop() may only be called by the owning thread and work at the bottom end,
+ * steal() may be called by any thread and takes from the top end.
+ * Retired buffers are kept until the deque is destroyed, so thieves never read freed memory.
+ */
+template <typename T>
+class WorkStealingDeque final {
+public:
+    explicit WorkStealingDeque(int64_t capacity = 256);
+    ~WorkStealingDeque();
+
+    void push(T *item);
+    T *pop();
+    T *steal();
+
+    inline bool empty() const {
+        return _bottom.load(std::memory_order_relaxed) <= _top.load(std::memory_order_relaxed);
+    }
+
+    inline int64_t size() const {
+        const int64_t size = _bottom.load(std::memory_order_relaxed) - _top.load(std::memory_order_relaxed);
+        return size > 0 ? size : 0;
+    }
+
+    inline int64_t capacity() const { return _array.load(std::memory_order_relaxed)->capacity; }
+
+private:
+    struct Array {
+        explicit Array(int64_t cap) : capacity(cap), mask(cap - 1), buffer(ccnew std::atomic<T *>[cap]) {}
+        ~Array() { delete[] buffer; }
+
+        inline T *get(int64_t i) const { return buffer[i & mask].load(std::memory_order_relaxed); }
+        inline void put(int64_t i, T *item) { buffer[i & mask].store(item, std::memory_order_relaxed); }
+
+        Array *grow(int64_t bottom, int64_t top) const {
+            auto *array = ccnew Array(capacity * 2);
+            for (int64_t i = top; i != bottom; ++i) {
+                array->put(i, get(i));
+            }
+            return array;
+        }
+
+        int64_t capacity{0};
+        int64_t mask{0};
+        std::atomic<T *> *buffer{nullptr};
+    };
+
+    alignas(64) std::atomic<int64_t> _top{0};
+    alignas(64) std::atomic<int64_t> _bottom{0};
+    std::atomic<Array *> _array{nullptr};
+    ccstd::vector<Array *> _retired;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(WorkStealingDeque);
+};
+
+template <typename T>
+WorkStealingDeque<T>::WorkStealingDeque(int64_t capacity) {
+    CC_ASSERT(capacity > 0 && (capacity & (capacity - 1)) == 0);
+    _array.store(ccnew Array(capacity), std::memory_order_relaxed);
+}
+
+template <typename T>
+WorkStealingDeque<T>::~WorkStealingDeque() {
+    for (auto *array : _retired) {
+        delete array;
+    }
+    delete _array.load(std::memory_order_relaxed);
+}
+
+template <typename T>
+void WorkStealingDeque<T>::push(T *item) {
+    const int64_t bottom = _bottom.load(std::memory_order_relaxed);
+    const int64_t top = _top.load(std::memory_order_acquire);
+    Array *array = _array.load(std::memory_order_relaxed);
+    if (bottom - top > array->capacity - 1) {
+        _retired.push_back(array);
+        array = array->grow(bottom, top);
+        _array.store(array, std::memory_order_release);
+    }
+    array->put(bottom, item);
+    _bottom.store(bottom + 1, std::memory_order_release);
+}
+
+template <typename T>
+T *WorkStealingDeque<T>::pop() {
+    const int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+    Array *array = _array.load(std::memory_order_relaxed);
+    _bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = _top.load(std::memory_order_relaxed);
+
+    T *item = nullptr;
+    if (top <= bottom) {
+        item = array->get(bottom);
+        if (top == bottom) {
+            // last item, race against thieves
+            if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+    } else {
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return item;
+}
+
+template <typename T>
+T *WorkStealingDeque<T>::steal() {
+    int64_t top = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t bottom = _bottom.load(std::memory_order_acquire);
+
+    if (top < bottom) {
+        Array *array = _array.load(std::memory_order_acquire);
+        T *item = array->get(top);
+        if (_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return item;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace cc
@@ -35,7 +35,11 @@ using TFJobToken = void;
 
 class TFJobGraph final {
 public:
-    explicit TFJobGraph(TFJobSystem *system) noexcept : _executor(&system->_executor) {}
+    explicit TFJobGraph(TFJobSystem *system, const char *name = nullptr) noexcept : _executor(&system->_executor) {
+        if (name) {
+            _flow.name(name);
+        }
+    }
 
     template <typename Function>
     uint32_t createJob(Function &&func) noexcept;
@@ -45,6 +49,8 @@ public:
 
     void makeEdge(uint32_t j1, uint32_t j2) noexcept;
 
+    inline void setJobName(uint32_t job, const char *name) noexcept { _tasks[job].name(name); }
+
     void run() noexcept;
 
     inline void waitForAll() {
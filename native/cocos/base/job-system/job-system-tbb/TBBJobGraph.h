@@ -37,7 +37,7 @@ class TBBJobSystem;
 
 class TBBJobGraph final {
 public:
-    explicit TBBJobGraph(TBBJobSystem *system) noexcept {
+    explicit TBBJobGraph(TBBJobSystem *system, const char * /*name*/ = nullptr) noexcept {
         _nodes.emplace_back(_graph, [](TBBJobToken t) {});
     }
 
@@ -49,6 +49,8 @@ public:
 
     void makeEdge(uint32_t j1, uint32_t j2) noexcept;
 
+    inline void setJobName(uint32_t /*job*/, const char * /*name*/) noexcept {}
+
     void run() noexcept;
 
     inline void waitForAll() {
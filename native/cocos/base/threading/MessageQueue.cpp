@@ -26,6 +26,7 @@
 #include "MessageQueue.h"
 #include "AutoReleasePool.h"
 #include "base/Utils.h"
+#include "profiler/TimelineRecorder.h"
 
 namespace cc {
 
@@ -245,7 +246,15 @@ void MessageQueue::executeMessages() noexcept {
         return;
     }
 
+    auto *recorder = TimelineRecorder::getInstance();
+    const bool recording = recorder->isRecording();
+    if (recording) {
+        recorder->beginScope(msg->getName());
+    }
     msg->execute();
+    if (recording) {
+        recorder->endScope();
+    }
     msg->~Message();
 }
 
@@ -639,6 +639,32 @@ static bool js_engine_FileUtils_listFilesRecursively(se::State &s) { // NOLINT(r
 }
 SE_BIND_FUNC(js_engine_FileUtils_listFilesRecursively) // NOLINT(readability-identifier-naming)
 
+static bool js_engine_FileUtils_getFileView(se::State &s) { // NOLINT(readability-identifier-naming)
+    auto *cobj = static_cast<cc::FileUtils *>(s.nativeThisObject());
+    SE_PRECONDITION2(cobj, false, "Invalid Native Object");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        ccstd::string arg0;
+        ok &= sevalue_to_native(args[0], &arg0);
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+        auto fileView = cobj->getFileView(arg0);
+        if (fileView.empty()) {
+            s.rval().setNull();
+            return true;
+        }
+        // the mapping is read only and script may write to the buffer, so the contents are copied,
+        // straight from the mapped pages instead of through a heap Data as getDataFromFile does
+        se::HandleObject buffer(se::Object::createArrayBufferObject(fileView.data(), fileView.size()));
+        s.rval().setObject(buffer);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_engine_FileUtils_getFileView) // NOLINT(readability-identifier-naming)
+
 static bool js_se_setExceptionCallback(se::State &s) { // NOLINT(readability-identifier-naming)
     const auto &args = s.args();
     if (args.size() != 1 || !args[0].isObject() || !args[0].toObject()->isFunction()) {
@@ -677,6 +703,7 @@ SE_BIND_FUNC(js_se_setExceptionCallback) // NOLINT(readability-identifier-naming
 
 static bool register_filetuils_ext(se::Object * /*obj*/) { // NOLINT(readability-identifier-naming)
     __jsb_cc_FileUtils_proto->defineFunction("listFilesRecursively", _SE(js_engine_FileUtils_listFilesRecursively));
+    __jsb_cc_FileUtils_proto->defineFunction("getFileView", _SE(js_engine_FileUtils_getFileView));
     return true;
 }
 
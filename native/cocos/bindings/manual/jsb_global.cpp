@@ -38,6 +38,7 @@
 #include "network/Downloader.h"
 #include "network/HttpClient.h"
 #include "platform/Image.h"
+#include "platform/ImageDecoder.h"
 #include "platform/interfaces/modules/ISystem.h"
 #include "platform/interfaces/modules/ISystemWindow.h"
 #include "ui/edit-box/EditBox.h"
@@ -548,7 +549,7 @@ struct ImageInfo *createImageInfo(Image *img) {
 }
 } // namespace
 
-bool jsb_global_load_image(const ccstd::string &path, const se::Value &callbackVal) { // NOLINT(readability-identifier-naming)
+bool jsb_global_load_image(const ccstd::string &path, const se::Value &callbackVal, int32_t priority) { // NOLINT(readability-identifier-naming)
     if (path.empty()) {
         se::ValueArray seArgs;
         callbackVal.toObject()->call(seArgs, nullptr);
@@ -557,58 +558,42 @@ bool jsb_global_load_image(const ccstd::string &path, const se::Value &callbackV
 
     std::shared_ptr<se::Value> callbackPtr = std::make_shared<se::Value>(callbackVal);
 
-    auto initImageFunc = [path, callbackPtr](const ccstd::string &fullPath, unsigned char *imageData, int imageBytes) {
-        auto *img = ccnew Image();
-
-        gThreadPool->pushTask([=](int /*tid*/) {
-            // NOTE: FileUtils::getInstance()->fullPathForFilename isn't a threadsafe method,
-            // Image::initWithImageFile will call fullPathForFilename internally which may
-            // cause thread race issues. Therefore, we get the full path of file before
-            // going into task callback.
-            // Be careful of invoking any Cocos2d-x interface in a sub-thread.
-            bool loadSucceed = false;
-            if (fullPath.empty()) {
-                loadSucceed = img->initWithImageData(imageData, imageBytes);
-                free(imageData);
-            } else {
-                loadSucceed = img->initWithImageFile(fullPath);
-            }
+    auto initImageFunc = [path, callbackPtr, priority](const ccstd::string &fullPath, unsigned char *imageData, int imageBytes) {
+        // NOTE: FileUtils::getInstance()->fullPathForFilename isn't a threadsafe method,
+        // Image::initWithImageFile will call fullPathForFilename internally which may
+        // cause thread race issues. Therefore, we get the full path of file before
+        // going into the decoder.
+        ImageDecoder::Request request;
+        request.path = fullPath;
+        if (fullPath.empty()) {
+            request.data = FileView::fromBuffer(imageData, imageBytes);
+        }
+        // decode straight into the RGBA8 layout that web apis return
+        request.options.expandToRGBA = true;
+        request.priority = priority;
+        request.callback = [path, callbackPtr](const IntrusivePtr<Image> &img) {
+            se::AutoHandleScope hs;
+            se::ValueArray seArgs;
+
+            if (img) {
+                ImageInfo *imgInfo = createImageInfo(img.get());
+                se::HandleObject retObj(se::Object::createPlainObject());
+                auto *obj = se::Object::createObjectWithClass(__jsb_cc_JSBNativeDataHolder_class);
+                auto *nativeObj = JSB_MAKE_PRIVATE_OBJECT(cc::JSBNativeDataHolder, imgInfo->data);
+                obj->setPrivateObject(nativeObj);
+                retObj->setProperty("data", se::Value(obj));
+                retObj->setProperty("width", se::Value(imgInfo->width));
+                retObj->setProperty("height", se::Value(imgInfo->height));
+
+                seArgs.push_back(se::Value(retObj));
 
-            ImageInfo *imgInfo = nullptr;
-            if (loadSucceed) {
-                imgInfo = createImageInfo(img);
-            }
-            auto app = CC_CURRENT_APPLICATION();
-            if (!app) {
                 delete imgInfo;
-                delete img;
-                return;
+            } else {
+                SE_REPORT_ERROR("initWithImageFile: %s failed!", path.c_str());
             }
-            auto engine = app->getEngine();
-            CC_ASSERT(engine != nullptr);
-            engine->getScheduler()->performFunctionInCocosThread([=]() {
-                se::AutoHandleScope hs;
-                se::ValueArray seArgs;
-
-                if (loadSucceed) {
-                    se::HandleObject retObj(se::Object::createPlainObject());
-                    auto *obj = se::Object::createObjectWithClass(__jsb_cc_JSBNativeDataHolder_class);
-                    auto *nativeObj = JSB_MAKE_PRIVATE_OBJECT(cc::JSBNativeDataHolder, imgInfo->data);
-                    obj->setPrivateObject(nativeObj);
-                    retObj->setProperty("data", se::Value(obj));
-                    retObj->setProperty("width", se::Value(imgInfo->width));
-                    retObj->setProperty("height", se::Value(imgInfo->height));
-
-                    seArgs.push_back(se::Value(retObj));
-
-                    delete imgInfo;
-                } else {
-                    SE_REPORT_ERROR("initWithImageFile: %s failed!", path.c_str());
-                }
-                callbackPtr->toObject()->call(seArgs, nullptr);
-                delete img;
-            });
-        });
+            callbackPtr->toObject()->call(seArgs, nullptr);
+        };
+        ImageDecoder::getInstance()->push(std::move(request));
     };
     size_t pos = ccstd::string::npos;
     if (path.find("http://") == 0 || path.find("https://") == 0) {
@@ -645,18 +630,23 @@ static bool js_loadImage(se::State &s) { // NOLINT
     const auto &args = s.args();
     size_t argc = args.size();
     CC_UNUSED bool ok = true;
-    if (argc == 2) {
+    if (argc == 2 || argc == 3) {
         ccstd::string path;
         ok &= sevalue_to_native(args[0], &path);
+        // optional, higher priorities are decoded first
+        int32_t priority = 0;
+        if (argc == 3) {
+            ok &= sevalue_to_native(args[2], &priority);
+        }
         SE_PRECONDITION2(ok, false, "Error processing arguments");
 
         se::Value callbackVal = args[1];
         CC_ASSERT(callbackVal.isObject());
         CC_ASSERT(callbackVal.toObject()->isFunction());
 
-        return jsb_global_load_image(path, callbackVal);
+        return jsb_global_load_image(path, callbackVal, priority);
     }
-    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 2);
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d or %d", (int)argc, 2, 3);
     return false;
 }
 SE_BIND_FUNC(js_loadImage)
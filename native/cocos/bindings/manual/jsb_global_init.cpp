@@ -149,8 +149,8 @@ void jsb_init_file_operation_delegate() { //NOLINT
                 return;
             }
 
-            fileData = FileUtils::getInstance()->getDataFromFile(path);
-            readCallback(fileData.getBytes(), fileData.getSize());
+            FileView view = FileUtils::getInstance()->getFileView(path);
+            readCallback(view.data(), view.size());
         };
 
         delegate.onGetStringFromFile = [](const ccstd::string &path) -> ccstd::string {
@@ -107,6 +107,7 @@
 
 #if CC_USE_PHYSICS_PHYSX
     #include "cocos/bindings/auto/jsb_physics_auto.h"
+    #include "cocos/bindings/manual/jsb_physics_manual.h"
 #endif
 
 bool jsb_register_all_modules() {
@@ -185,6 +186,7 @@ bool jsb_register_all_modules() {
 
 #if CC_USE_PHYSICS_PHYSX
     se->addRegisterCallback(register_all_physics);
+    se->addRegisterCallback(register_all_physics_manual);
 #endif
 
 #if (CC_PLATFORM == CC_PLATFORM_IOS || CC_PLATFORM == CC_PLATFORM_ANDROID || CC_PLATFORM == CC_PLATFORM_OHOS)
@@ -0,0 +1,126 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "jsb_physics_manual.h"
+#include <algorithm>
+#include <memory>
+#include "cocos/bindings/auto/jsb_physics_auto.h"
+#include "cocos/bindings/jswrapper/SeApi.h"
+#include "cocos/bindings/manual/jsb_conversions.h"
+#include "cocos/physics/spec/IWorld.h"
+
+// script views queries and hits as words through Float32Array and Uint32Array
+static_assert(sizeof(cc::physics::SceneQuery) == 17 * sizeof(uint32_t), "SceneQuery must be tightly packed");
+static_assert(sizeof(cc::physics::SceneQueryHit) == 8 * sizeof(uint32_t), "SceneQueryHit must be tightly packed");
+
+template <typename T>
+static se::Object *createBuffer(size_t count, T **elements) {
+    // the array buffer owns the memory and frees it once script drops it
+    auto *buffer = se::Object::createArrayBufferObject(nullptr, count * sizeof(T));
+    uint8_t *data = nullptr;
+    buffer->getArrayBufferData(&data, nullptr);
+    *elements = reinterpret_cast<T *>(data);
+    std::uninitialized_default_construct_n(*elements, count);
+    return buffer;
+}
+
+static bool js_cc_physics_IPhysicsWorld_reserveSceneQueries(se::State &s) { // NOLINT(readability-identifier-naming)
+    auto *cobj = SE_THIS_OBJECT<cc::physics::IPhysicsWorld>(s);
+    SE_PRECONDITION2(cobj, false, "Invalid Native Object");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 2) {
+        uint32_t capacity = 0;
+        uint32_t maxHits = 0;
+        ok &= sevalue_to_native(args[0], &capacity, s.thisObject());
+        ok &= sevalue_to_native(args[1], &maxHits, s.thisObject());
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+        maxHits = std::max(maxHits, 1U);
+        cc::physics::SceneQuery *queryData = nullptr;
+        cc::physics::SceneQueryHit *hitData = nullptr;
+        uint32_t *hitCountData = nullptr;
+        se::HandleObject queries(createBuffer(capacity, &queryData));
+        se::HandleObject hits(createBuffer(static_cast<size_t>(capacity) * maxHits, &hitData));
+        se::HandleObject hitCounts(createBuffer(capacity, &hitCountData));
+        cobj->sceneQueryBatch().attach(queryData, hitData, hitCountData, capacity, maxHits);
+        se::HandleObject retObj(se::Object::createPlainObject());
+        retObj->setProperty("queries", se::Value(queries));
+        retObj->setProperty("hits", se::Value(hits));
+        retObj->setProperty("hitCounts", se::Value(hitCounts));
+        // the batch borrows the buffers, the world keeps them alive until they are replaced
+        s.thisObject()->setProperty("_sceneQueryBuffers", se::Value(retObj));
+        s.rval().setObject(retObj);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 2);
+    return false;
+}
+SE_BIND_FUNC(js_cc_physics_IPhysicsWorld_reserveSceneQueries) // NOLINT(readability-identifier-naming)
+
+static bool js_cc_physics_IPhysicsWorld_sceneQuery(se::State &s) { // NOLINT(readability-identifier-naming)
+    auto *cobj = SE_THIS_OBJECT<cc::physics::IPhysicsWorld>(s);
+    SE_PRECONDITION2(cobj, false, "Invalid Native Object");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        uint32_t count = 0;
+        ok &= sevalue_to_native(args[0], &count, s.thisObject());
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+        const uint32_t result = cobj->sceneQuery(cobj->sceneQueryBatch(), count);
+        ok &= nativevalue_to_se(result, s.rval(), s.thisObject());
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_cc_physics_IPhysicsWorld_sceneQuery) // NOLINT(readability-identifier-naming)
+
+static bool js_cc_physics_IPhysicsWorld_setAsyncStep(se::State &s) { // NOLINT(readability-identifier-naming)
+    auto *cobj = SE_THIS_OBJECT<cc::physics::IPhysicsWorld>(s);
+    SE_PRECONDITION2(cobj, false, "Invalid Native Object");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        bool async = false;
+        ok &= sevalue_to_native(args[0], &async, s.thisObject());
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+        cobj->setAsyncStep(async);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_cc_physics_IPhysicsWorld_setAsyncStep) // NOLINT(readability-identifier-naming)
+
+bool register_all_physics_manual(se::Object *obj) { // NOLINT(readability-identifier-naming)
+    __jsb_cc_physics_IPhysicsWorld_proto->defineFunction("reserveSceneQueries", _SE(js_cc_physics_IPhysicsWorld_reserveSceneQueries));
+    __jsb_cc_physics_IPhysicsWorld_proto->defineFunction("sceneQuery", _SE(js_cc_physics_IPhysicsWorld_sceneQuery));
+    __jsb_cc_physics_IPhysicsWorld_proto->defineFunction("setAsyncStep", _SE(js_cc_physics_IPhysicsWorld_setAsyncStep));
+    return true;
+}
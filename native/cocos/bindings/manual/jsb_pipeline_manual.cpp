@@ -50,6 +50,36 @@ static bool JSB_getOrCreatePipelineState(se::State &s) { // NOLINT(readability-i
 }
 SE_BIND_FUNC(JSB_getOrCreatePipelineState);
 
+static bool JSB_saveCache(se::State &s) { // NOLINT(readability-identifier-naming)
+    const auto &args = s.args();
+    size_t argc = args.size();
+    if (argc == 1) {
+        ccstd::string path;
+        bool ok = sevalue_to_native(args[0], &path, s.thisObject());
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+        s.rval().setBoolean(cc::pipeline::PipelineStateManager::saveCache(path));
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(JSB_saveCache);
+
+static bool JSB_loadCache(se::State &s) { // NOLINT(readability-identifier-naming)
+    const auto &args = s.args();
+    size_t argc = args.size();
+    if (argc == 1) {
+        ccstd::string path;
+        bool ok = sevalue_to_native(args[0], &path, s.thisObject());
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+        s.rval().setBoolean(cc::pipeline::PipelineStateManager::loadCache(path));
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(JSB_loadCache);
+
 bool register_all_pipeline_manual(se::Object *obj) { // NOLINT(readability-identifier-naming)
     // Get the ns
     se::Value nrVal;
@@ -65,6 +95,8 @@ bool register_all_pipeline_manual(se::Object *obj) { // NOLINT(readability-ident
     psmVal.setObject(jsobj);
     nr->setProperty("PipelineStateManager", psmVal);
     psmVal.toObject()->defineFunction("getOrCreatePipelineState", _SE(JSB_getOrCreatePipelineState));
+    psmVal.toObject()->defineFunction("saveCache", _SE(JSB_saveCache));
+    psmVal.toObject()->defineFunction("loadCache", _SE(JSB_loadCache));
 
     return true;
 }
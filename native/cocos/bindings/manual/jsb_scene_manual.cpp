@@ -26,8 +26,10 @@
 #include "jsb_scene_manual.h"
 #include "bindings/auto/jsb_scene_auto.h"
 #include "bindings/auto/jsb_gfx_auto.h"
+#include "bindings/auto/jsb_render_auto.h"
 #include "core/Root.h"
 #include "core/scene-graph/Node.h"
+#include "renderer/core/ProgramLib.h"
 #include "scene/Model.h"
 
 #ifndef JSB_ALLOC
@@ -775,6 +777,186 @@ static bool js_assets_MaterialInstance_registerListeners(se::State &s) // NOLINT
 }
 SE_BIND_FUNC(js_assets_MaterialInstance_registerListeners) // NOLINT(readability-identifier-naming)
 
+// the script-facing controls of async shader compile and variant prewarm, the rest of
+// ProgramLib's compile queue is internal to the engine and ignored in scene.i
+static bool js_cc_ProgramLib_hasPendingShaders(se::State &s) { // NOLINT(readability-identifier-naming)
+    auto *cobj = SE_THIS_OBJECT<cc::ProgramLib>(s);
+    SE_PRECONDITION2(cobj, false, "Invalid Native Object");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        bool result = cobj->hasPendingShaders();
+        ok &= nativevalue_to_se(result, s.rval(), s.thisObject());
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_cc_ProgramLib_hasPendingShaders) // NOLINT(readability-identifier-naming)
+
+static bool js_cc_ProgramLib_setAsyncCompileEnabled(se::State &s) { // NOLINT(readability-identifier-naming)
+    auto *cobj = SE_THIS_OBJECT<cc::ProgramLib>(s);
+    SE_PRECONDITION2(cobj, false, "Invalid Native Object");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        bool enabled = false;
+        ok &= sevalue_to_native(args[0], &enabled, s.thisObject());
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+        cobj->setAsyncCompileEnabled(enabled);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_cc_ProgramLib_setAsyncCompileEnabled) // NOLINT(readability-identifier-naming)
+
+static bool js_cc_ProgramLib_isAsyncCompileEnabled(se::State &s) { // NOLINT(readability-identifier-naming)
+    auto *cobj = SE_THIS_OBJECT<cc::ProgramLib>(s);
+    SE_PRECONDITION2(cobj, false, "Invalid Native Object");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        bool result = cobj->isAsyncCompileEnabled();
+        ok &= nativevalue_to_se(result, s.rval(), s.thisObject());
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_cc_ProgramLib_isAsyncCompileEnabled) // NOLINT(readability-identifier-naming)
+
+static bool js_cc_ProgramLib_setCompileBudget(se::State &s) { // NOLINT(readability-identifier-naming)
+    auto *cobj = SE_THIS_OBJECT<cc::ProgramLib>(s);
+    SE_PRECONDITION2(cobj, false, "Invalid Native Object");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        float milliseconds = 0.F;
+        ok &= sevalue_to_native(args[0], &milliseconds, s.thisObject());
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+        cobj->setCompileBudget(milliseconds);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_cc_ProgramLib_setCompileBudget) // NOLINT(readability-identifier-naming)
+
+static bool js_cc_ProgramLib_getCompileBudget(se::State &s) { // NOLINT(readability-identifier-naming)
+    auto *cobj = SE_THIS_OBJECT<cc::ProgramLib>(s);
+    SE_PRECONDITION2(cobj, false, "Invalid Native Object");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        float result = cobj->getCompileBudget();
+        ok &= nativevalue_to_se(result, s.rval(), s.thisObject());
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_cc_ProgramLib_getCompileBudget) // NOLINT(readability-identifier-naming)
+
+static bool js_cc_ProgramLib_setVariantRecording(se::State &s) { // NOLINT(readability-identifier-naming)
+    auto *cobj = SE_THIS_OBJECT<cc::ProgramLib>(s);
+    SE_PRECONDITION2(cobj, false, "Invalid Native Object");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        bool enabled = false;
+        ok &= sevalue_to_native(args[0], &enabled, s.thisObject());
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+        cobj->setVariantRecording(enabled);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_cc_ProgramLib_setVariantRecording) // NOLINT(readability-identifier-naming)
+
+static bool js_cc_ProgramLib_isVariantRecording(se::State &s) { // NOLINT(readability-identifier-naming)
+    auto *cobj = SE_THIS_OBJECT<cc::ProgramLib>(s);
+    SE_PRECONDITION2(cobj, false, "Invalid Native Object");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        bool result = cobj->isVariantRecording();
+        ok &= nativevalue_to_se(result, s.rval(), s.thisObject());
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_cc_ProgramLib_isVariantRecording) // NOLINT(readability-identifier-naming)
+
+static bool js_cc_ProgramLib_clearRecordedVariants(se::State &s) { // NOLINT(readability-identifier-naming)
+    auto *cobj = SE_THIS_OBJECT<cc::ProgramLib>(s);
+    SE_PRECONDITION2(cobj, false, "Invalid Native Object");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    if (argc == 0) {
+        cobj->clearRecordedVariants();
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_cc_ProgramLib_clearRecordedVariants) // NOLINT(readability-identifier-naming)
+
+static bool js_cc_ProgramLib_saveRecordedVariants(se::State &s) { // NOLINT(readability-identifier-naming)
+    auto *cobj = SE_THIS_OBJECT<cc::ProgramLib>(s);
+    SE_PRECONDITION2(cobj, false, "Invalid Native Object");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        ccstd::string path;
+        ok &= sevalue_to_native(args[0], &path, s.thisObject());
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+        bool result = cobj->saveRecordedVariants(path);
+        ok &= nativevalue_to_se(result, s.rval(), s.thisObject());
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_cc_ProgramLib_saveRecordedVariants) // NOLINT(readability-identifier-naming)
+
+static bool js_cc_ProgramLib_prewarmAsync(se::State &s) { // NOLINT(readability-identifier-naming)
+    auto *cobj = SE_THIS_OBJECT<cc::ProgramLib>(s);
+    SE_PRECONDITION2(cobj, false, "Invalid Native Object");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 3) {
+        cc::gfx::Device *device = nullptr;
+        cc::render::PipelineRuntime *pipeline = nullptr;
+        ccstd::string path;
+        ok &= sevalue_to_native(args[0], &device, s.thisObject());
+        ok &= sevalue_to_native(args[1], &pipeline, s.thisObject());
+        ok &= sevalue_to_native(args[2], &path, s.thisObject());
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+        cobj->prewarmAsync(device, pipeline, path);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 3);
+    return false;
+}
+SE_BIND_FUNC(js_cc_ProgramLib_prewarmAsync) // NOLINT(readability-identifier-naming)
+
 bool register_all_scene_manual(se::Object *obj) // NOLINT(readability-identifier-naming)
 {
     // Get the ns
@@ -846,5 +1028,16 @@ bool register_all_scene_manual(se::Object *obj) // NOLINT(readability-identifier
     __jsb_cc_scene_Model_proto->defineFunction("_registerListeners", _SE(js_Model_registerListeners));
     __jsb_cc_MaterialInstance_proto->defineFunction("_registerListeners", _SE(js_assets_MaterialInstance_registerListeners));
 
+    __jsb_cc_ProgramLib_proto->defineFunction("hasPendingShaders", _SE(js_cc_ProgramLib_hasPendingShaders));
+    __jsb_cc_ProgramLib_proto->defineFunction("setAsyncCompileEnabled", _SE(js_cc_ProgramLib_setAsyncCompileEnabled));
+    __jsb_cc_ProgramLib_proto->defineFunction("isAsyncCompileEnabled", _SE(js_cc_ProgramLib_isAsyncCompileEnabled));
+    __jsb_cc_ProgramLib_proto->defineFunction("setCompileBudget", _SE(js_cc_ProgramLib_setCompileBudget));
+    __jsb_cc_ProgramLib_proto->defineFunction("getCompileBudget", _SE(js_cc_ProgramLib_getCompileBudget));
+    __jsb_cc_ProgramLib_proto->defineFunction("setVariantRecording", _SE(js_cc_ProgramLib_setVariantRecording));
+    __jsb_cc_ProgramLib_proto->defineFunction("isVariantRecording", _SE(js_cc_ProgramLib_isVariantRecording));
+    __jsb_cc_ProgramLib_proto->defineFunction("clearRecordedVariants", _SE(js_cc_ProgramLib_clearRecordedVariants));
+    __jsb_cc_ProgramLib_proto->defineFunction("saveRecordedVariants", _SE(js_cc_ProgramLib_saveRecordedVariants));
+    __jsb_cc_ProgramLib_proto->defineFunction("prewarmAsync", _SE(js_cc_ProgramLib_prewarmAsync));
+
     return true;
 }
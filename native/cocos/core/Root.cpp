@@ -27,22 +27,26 @@
 #include "2d/renderer/Batcher2d.h"
 #include "application/ApplicationManager.h"
 #include "bindings/event/EventDispatcher.h"
+#include "platform/FileUtils.h"
 #include "platform/interfaces/modules/IScreen.h"
 #include "platform/interfaces/modules/ISystemWindow.h"
 #include "platform/interfaces/modules/ISystemWindowManager.h"
 #include "platform/java/modules/XRInterface.h"
 #include "profiler/Profiler.h"
+#include "renderer/core/ProgramLib.h"
 #include "renderer/gfx-base/GFXDevice.h"
 #include "renderer/gfx-base/GFXSwapchain.h"
 #include "renderer/pipeline/Define.h"
 #include "renderer/pipeline/GeometryRenderer.h"
 #include "renderer/pipeline/PipelineSceneData.h"
+#include "renderer/pipeline/PipelineStateManager.h"
 #include "renderer/pipeline/custom/NativePipelineTypes.h"
 #include "renderer/pipeline/custom/RenderInterfaceTypes.h"
 #include "renderer/pipeline/deferred/DeferredPipeline.h"
 #include "renderer/pipeline/forward/ForwardPipeline.h"
 #include "scene/Camera.h"
 #include "scene/DirectionalLight.h"
+#include "scene/LocalUBOArena.h"
 #include "scene/SpotLight.h"
 #include "engine/EngineEvents.h"
 
@@ -50,7 +54,18 @@ namespace cc {
 
 namespace {
 Root *instance = nullptr;
+
+// pipeline states created per frame from the cache of the last session
+constexpr uint32_t PIPELINE_STATE_PREWARM_BUDGET = 8;
+
+ccstd::string getPipelineStateCachePath() {
+    return FileUtils::getInstance()->getWritablePath() + "pipeline-state-cache.bin";
+}
+
+ccstd::string getShaderVariantsPath() {
+    return FileUtils::getInstance()->getWritablePath() + "shader-variants.txt";
 }
+} // namespace
 
 Root *Root::getInstance() {
     return instance;
@@ -84,12 +99,19 @@ void Root::initialize(gfx::Swapchain * /*swapchain*/) {
     _curRenderWindow = _mainRenderWindow;
     _xr = CC_GET_XR_INTERFACE();
     addWindowEventListener();
+    // the app may be killed while in background without being destroyed
+    _enterBackgroundListener.bind([this]() {
+        saveShaderVariants();
+        savePipelineStateCache();
+    });
     // TODO(minggo):
     // return Promise.resolve(builtinResMgr.initBuiltinRes(this._device));
     const uint32_t usedUBOVectorCount = (pipeline::UBOGlobal::COUNT + pipeline::UBOCamera::COUNT + pipeline::UBOShadow::COUNT + pipeline::UBOLocal::COUNT) / 4;
     uint32_t maxJoints = (_device->getCapabilities().maxVertexUniformVectors - usedUBOVectorCount) / 3;
     maxJoints = maxJoints < 256 ? maxJoints : 256;
     pipeline::localDescriptorSetLayoutResizeMaxJoints(maxJoints);
+
+    _localUBOArena = ccnew scene::LocalUBOArena(_device);
 }
 
 render::Pipeline *Root::getCustomPipeline() const {
@@ -145,6 +167,9 @@ cc::scene::RenderWindow *Root::createRenderWindowFromSystemWindow(uint32_t windo
 void Root::destroy() {
     destroyScenes();
     removeWindowEventListener();
+    _enterBackgroundListener.reset();
+    saveShaderVariants();
+    savePipelineStateCache();
     if (_pipelineRuntime) {
         _pipelineRuntime->destroy();
     }
@@ -153,6 +178,7 @@ void Root::destroy() {
     CC_SAFE_DESTROY_NULL(_pipeline);
 
     CC_SAFE_DELETE(_batcher);
+    CC_SAFE_DELETE(_localUBOArena);
 
     for (auto *swapchain : _swapchains) {
         CC_SAFE_DELETE(swapchain);
@@ -313,6 +339,7 @@ bool Root::setRenderPipeline(pipeline::RenderPipeline *rppl /* = nullptr*/) {
             _pipeline = nullptr;
             return false;
         }
+        loadPipelineStateCache();
     } else {
         _pipelineRuntime = std::make_unique<render::NativePipeline>(
             boost::container::pmr::get_default_resource());
@@ -323,6 +350,8 @@ bool Root::setRenderPipeline(pipeline::RenderPipeline *rppl /* = nullptr*/) {
         }
     }
 
+    loadShaderVariants();
+
     // TODO(minggo):
     //    auto *scene = Director::getInstance()->getScene();
     //    if (scene) {
@@ -367,6 +396,12 @@ void Root::frameMoveBegin() {
         _batcher->update();
     }
 
+    // swap in the shader variants requested asynchronously
+    if (auto *programLib = ProgramLib::getInstance()) {
+        programLib->update();
+    }
+    prewarmPipelineStates();
+
     //
     _cameraList.clear();
 }
@@ -392,6 +427,10 @@ void Root::frameMoveProcess(bool isNeedUpdateScene, int32_t totalFrames, const c
             }
         }
 
+        if (_localUBOArena != nullptr) {
+            _localUBOArena->flush();
+        }
+
         CC_PROFILER_UPDATE;
     }
 }
@@ -637,4 +676,55 @@ void Root::removeWindowEventListener() {
     _windowRecreatedListener.reset();
 }
 
+void Root::loadPipelineStateCache() {
+    _prewarmedShaderCount = 0;
+    pipeline::PipelineStateManager::loadCache(getPipelineStateCachePath());
+}
+
+void Root::savePipelineStateCache() {
+    // only the builtin pipelines create their pipeline states through the PipelineStateManager
+    if (_pipeline) {
+        pipeline::PipelineStateManager::saveCache(getPipelineStateCachePath());
+    }
+}
+
+void Root::loadShaderVariants() {
+    // the variants used in the last session are compiled as their effects get registered
+    if (auto *programLib = ProgramLib::getInstance()) {
+        programLib->setVariantRecording(true);
+        programLib->prewarmAsync(_device, _pipelineRuntime.get(), getShaderVariantsPath());
+    }
+}
+
+void Root::saveShaderVariants() {
+    auto *programLib = ProgramLib::getInstance();
+    if (_pipelineRuntime && programLib && programLib->isVariantRecording()) {
+        programLib->saveRecordedVariants(getShaderVariantsPath());
+    }
+}
+
+void Root::prewarmPipelineStates() {
+    auto *programLib = ProgramLib::getInstance();
+    const auto &stats = pipeline::PipelineStateManager::getStats();
+    if (!_pipeline || !programLib || stats.recordsPending == 0) {
+        return;
+    }
+    // a record only resolves once its shader is compiled, don't rescan them until new shaders are
+    const auto shaderCount = programLib->getCreatedShaderCount();
+    if (shaderCount == _prewarmedShaderCount) {
+        return;
+    }
+
+    const auto pending = stats.recordsPending;
+    const auto remaining = pipeline::PipelineStateManager::prewarm(
+        [programLib](const ccstd::string &shaderName, gfx::Shader *&shader, gfx::PipelineLayout *&pipelineLayout) {
+            return programLib->getCompiledShader(shaderName, shader, pipelineLayout);
+        },
+        PIPELINE_STATE_PREWARM_BUDGET);
+    // the budget may have cut the pass short, the rest is resumed next frame
+    if (pending - remaining < PIPELINE_STATE_PREWARM_BUDGET) {
+        _prewarmedShaderCount = shaderCount;
+    }
+}
+
 } // namespace cc
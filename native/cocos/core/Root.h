@@ -42,6 +42,7 @@ class IXRInterface;
 namespace scene {
 class Camera;
 class DrawBatch2D;
+class LocalUBOArena;
 } // namespace scene
 namespace gfx {
 class SwapChain;
@@ -244,6 +245,13 @@ public:
      */
     inline Batcher2d *getBatcher2D() const { return _batcher; }
 
+    /**
+     * @zh
+     * 模型 UBOLocal 的共享缓冲区，未初始化时为空
+     * 引擎内部使用，用户无需调用此接口
+     */
+    inline scene::LocalUBOArena *getLocalUBOArena() const { return _localUBOArena; }
+
     /**
      * @zh
      * 场景列表
@@ -305,12 +313,18 @@ private:
     void frameMoveProcess(bool isNeedUpdateScene, int32_t totalFrames, const ccstd::vector<IntrusivePtr<scene::RenderWindow>> &windows);
     void frameMoveEnd();
     void doXRFrameMove(int32_t totalFrames);
+    void loadPipelineStateCache();
+    void savePipelineStateCache();
+    void prewarmPipelineStates();
+    void loadShaderVariants();
+    void saveShaderVariants();
     void addWindowEventListener();
     void removeWindowEventListener();
 
     gfx::Device *_device{nullptr};
     gfx::Swapchain *_swapchain{nullptr};
     Batcher2d *_batcher{nullptr};
+    scene::LocalUBOArena *_localUBOArena{nullptr};
     IntrusivePtr<scene::RenderWindow> _mainRenderWindow;
     IntrusivePtr<scene::RenderWindow> _curRenderWindow;
     IntrusivePtr<scene::RenderWindow> _tempWindow;
@@ -331,6 +345,8 @@ private:
     IXRInterface *_xr{nullptr};
     events::WindowDestroy::Listener _windowDestroyListener;
     events::WindowRecreated::Listener _windowRecreatedListener;
+    events::EnterBackground::Listener _enterBackgroundListener;
+    uint32_t _prewarmedShaderCount{0};
 
     // Cache ccstd::vector to avoid allocate every frame in frameMove
     ccstd::vector<scene::Camera *> _cameraList;
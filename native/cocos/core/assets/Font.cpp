@@ -26,7 +26,6 @@
 #include "Font.h"
 #include <algorithm>
 #include <cctype>
-#include "base/Data.h"
 #include "base/Log.h"
 #include "base/Macros.h"
 #include "base/memory/Memory.h"
@@ -95,14 +94,17 @@ Font::~Font() {
 }
 
 void Font::load(const ccstd::string &path) {
-    Data data = FileUtils::getInstance()->getDataFromFile(path);
-    if (data.isNull()) {
+    auto *fileUtils = FileUtils::getInstance();
+    _data = fileUtils->getFileView(path);
+    // the faces read the data as long as the font lives, only pack mappings are kept that long
+    if (_data.isMapped() && !fileUtils->isPackEntry(path)) {
+        _data = FileView::fromData(_data.toData());
+    }
+    if (_data.empty()) {
         CC_LOG_WARNING("Font load failed, path: %s.", path.c_str());
         return;
     }
 
-    _data.resize(data.getSize());
-    memcpy(&_data[0], data.getBytes(), data.getSize());
     CC_PROFILE_MEMORY_INC(Font, _data.size());
 }
 
@@ -27,6 +27,7 @@
 #include "base/std/container/unordered_map.h"
 #include "base/std/container/vector.h"
 #include "core/assets/Asset.h"
+#include "platform/FileView.h"
 
 namespace cc {
 
@@ -142,7 +143,7 @@ public:
 
     inline FontType getType() const { return _type; }
     inline const ccstd::string &getPath() const { return _path; }
-    inline const ccstd::vector<uint8_t> &getData() const { return _data; }
+    inline const FileView &getData() const { return _data; }
     inline FontFace *getFace(uint32_t fontSize) { return _faces[fontSize]; }
     void releaseFaces();
 
@@ -151,7 +152,7 @@ protected:
 
     FontType _type{FontType::INVALID};
     ccstd::string _path;
-    ccstd::vector<uint8_t> _data;
+    FileView _data;
     ccstd::unordered_map<uint32_t, FontFace *> _faces;
 };
 
@@ -0,0 +1,228 @@
+/****************************************************************************
+ Copyright (c) 2020-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "core/geometry/AABBSoA.h"
+#include <cmath>
+#include "core/geometry/AABB.h"
+#include "core/geometry/Frustum.h"
+#include "core/geometry/Plane.h"
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define CC_AABB_BATCH_AVX
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define CC_AABB_BATCH_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define CC_AABB_BATCH_NEON
+#endif
+
+namespace cc {
+namespace geometry {
+
+namespace {
+
+constexpr uint32_t PLANE_COUNT = 6;
+
+struct PlaneSoA {
+    float nx[PLANE_COUNT];
+    float ny[PLANE_COUNT];
+    float nz[PLANE_COUNT];
+    float ax[PLANE_COUNT]; // |n|
+    float ay[PLANE_COUNT];
+    float az[PLANE_COUNT];
+    float d[PLANE_COUNT];
+};
+
+void extractPlanes(const Frustum &frustum, PlaneSoA &out) {
+    for (uint32_t i = 0; i < PLANE_COUNT; ++i) {
+        const Plane &plane = *frustum.planes[i];
+        out.nx[i] = plane.n.x;
+        out.ny[i] = plane.n.y;
+        out.nz[i] = plane.n.z;
+        out.ax[i] = std::abs(plane.n.x);
+        out.ay[i] = std::abs(plane.n.y);
+        out.az[i] = std::abs(plane.n.z);
+        out.d[i] = plane.d;
+    }
+}
+
+// keep the operation order of aabbPlane so that both paths agree on the boundary
+uint32_t aabbFrustumScalar(const AABBSoA &boxes, const PlaneSoA &planes, uint32_t begin, uint8_t *results) {
+    const uint32_t count = boxes.size();
+    for (uint32_t i = begin; i < count; ++i) {
+        const float cx = boxes.getCenterX()[i];
+        const float cy = boxes.getCenterY()[i];
+        const float cz = boxes.getCenterZ()[i];
+        const float hx = boxes.getHalfExtentX()[i];
+        const float hy = boxes.getHalfExtentY()[i];
+        const float hz = boxes.getHalfExtentZ()[i];
+        uint8_t visible = 1;
+        for (uint32_t p = 0; p < PLANE_COUNT; ++p) {
+            const float r = hx * planes.ax[p] + hy * planes.ay[p] + hz * planes.az[p];
+            const float dot = planes.nx[p] * cx + planes.ny[p] * cy + planes.nz[p] * cz;
+            if (dot + r < planes.d[p]) {
+                visible = 0;
+                break;
+            }
+        }
+        results[i] = visible;
+    }
+    return count;
+}
+
+#if defined(CC_AABB_BATCH_AVX)
+
+uint32_t aabbFrustumSIMD(const AABBSoA &boxes, const PlaneSoA &planes, uint8_t *results) {
+    const uint32_t count = boxes.size() & ~7U;
+    for (uint32_t i = 0; i < count; i += 8) {
+        const __m256 cx = _mm256_loadu_ps(boxes.getCenterX() + i);
+        const __m256 cy = _mm256_loadu_ps(boxes.getCenterY() + i);
+        const __m256 cz = _mm256_loadu_ps(boxes.getCenterZ() + i);
+        const __m256 hx = _mm256_loadu_ps(boxes.getHalfExtentX() + i);
+        const __m256 hy = _mm256_loadu_ps(boxes.getHalfExtentY() + i);
+        const __m256 hz = _mm256_loadu_ps(boxes.getHalfExtentZ() + i);
+        __m256 outside = _mm256_setzero_ps();
+        for (uint32_t p = 0; p < PLANE_COUNT; ++p) {
+            const __m256 r = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(hx, _mm256_set1_ps(planes.ax[p])),
+                                                         _mm256_mul_ps(hy, _mm256_set1_ps(planes.ay[p]))),
+                                           _mm256_mul_ps(hz, _mm256_set1_ps(planes.az[p])));
+            const __m256 dot = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes.nx[p]), cx),
+                                                           _mm256_mul_ps(_mm256_set1_ps(planes.ny[p]), cy)),
+                                             _mm256_mul_ps(_mm256_set1_ps(planes.nz[p]), cz));
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(dot, r), _mm256_set1_ps(planes.d[p]), _CMP_LT_OQ));
+        }
+        const int mask = _mm256_movemask_ps(outside);
+        for (uint32_t lane = 0; lane < 8; ++lane) {
+            results[i + lane] = static_cast<uint8_t>(((mask >> lane) & 1) ^ 1);
+        }
+    }
+    return count;
+}
+
+#elif defined(CC_AABB_BATCH_SSE)
+
+uint32_t aabbFrustumSIMD(const AABBSoA &boxes, const PlaneSoA &planes, uint8_t *results) {
+    const uint32_t count = boxes.size() & ~3U;
+    for (uint32_t i = 0; i < count; i += 4) {
+        const __m128 cx = _mm_loadu_ps(boxes.getCenterX() + i);
+        const __m128 cy = _mm_loadu_ps(boxes.getCenterY() + i);
+        const __m128 cz = _mm_loadu_ps(boxes.getCenterZ() + i);
+        const __m128 hx = _mm_loadu_ps(boxes.getHalfExtentX() + i);
+        const __m128 hy = _mm_loadu_ps(boxes.getHalfExtentY() + i);
+        const __m128 hz = _mm_loadu_ps(boxes.getHalfExtentZ() + i);
+        __m128 outside = _mm_setzero_ps();
+        for (uint32_t p = 0; p < PLANE_COUNT; ++p) {
+            const __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(hx, _mm_set1_ps(planes.ax[p])),
+                                                   _mm_mul_ps(hy, _mm_set1_ps(planes.ay[p]))),
+                                        _mm_mul_ps(hz, _mm_set1_ps(planes.az[p])));
+            const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.nx[p]), cx),
+                                                     _mm_mul_ps(_mm_set1_ps(planes.ny[p]), cy)),
+                                          _mm_mul_ps(_mm_set1_ps(planes.nz[p]), cz));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(dot, r), _mm_set1_ps(planes.d[p])));
+        }
+        const int mask = _mm_movemask_ps(outside);
+        for (uint32_t lane = 0; lane < 4; ++lane) {
+            results[i + lane] = static_cast<uint8_t>(((mask >> lane) & 1) ^ 1);
+        }
+    }
+    return count;
+}
+
+#elif defined(CC_AABB_BATCH_NEON)
+
+uint32_t aabbFrustumSIMD(const AABBSoA &boxes, const PlaneSoA &planes, uint8_t *results) {
+    const uint32_t count = boxes.size() & ~3U;
+    for (uint32_t i = 0; i < count; i += 4) {
+        const float32x4_t cx = vld1q_f32(boxes.getCenterX() + i);
+        const float32x4_t cy = vld1q_f32(boxes.getCenterY() + i);
+        const float32x4_t cz = vld1q_f32(boxes.getCenterZ() + i);
+        const float32x4_t hx = vld1q_f32(boxes.getHalfExtentX() + i);
+        const float32x4_t hy = vld1q_f32(boxes.getHalfExtentY() + i);
+        const float32x4_t hz = vld1q_f32(boxes.getHalfExtentZ() + i);
+        uint32x4_t outside = vdupq_n_u32(0);
+        for (uint32_t p = 0; p < PLANE_COUNT; ++p) {
+            // no fused multiply-add, to match the scalar path
+            const float32x4_t r = vaddq_f32(vaddq_f32(vmulq_n_f32(hx, planes.ax[p]), vmulq_n_f32(hy, planes.ay[p])),
+                                            vmulq_n_f32(hz, planes.az[p]));
+            const float32x4_t dot = vaddq_f32(vaddq_f32(vmulq_n_f32(cx, planes.nx[p]), vmulq_n_f32(cy, planes.ny[p])),
+                                              vmulq_n_f32(cz, planes.nz[p]));
+            outside = vorrq_u32(outside, vcltq_f32(vaddq_f32(dot, r), vdupq_n_f32(planes.d[p])));
+        }
+        results[i + 0] = vgetq_lane_u32(outside, 0) ? 0 : 1;
+        results[i + 1] = vgetq_lane_u32(outside, 1) ? 0 : 1;
+        results[i + 2] = vgetq_lane_u32(outside, 2) ? 0 : 1;
+        results[i + 3] = vgetq_lane_u32(outside, 3) ? 0 : 1;
+    }
+    return count;
+}
+
+#else
+
+uint32_t aabbFrustumSIMD(const AABBSoA & /*boxes*/, const PlaneSoA & /*planes*/, uint8_t * /*results*/) {
+    return 0;
+}
+
+#endif
+
+} // namespace
+
+void AABBSoA::clear() {
+    _centerX.clear();
+    _centerY.clear();
+    _centerZ.clear();
+    _halfExtentX.clear();
+    _halfExtentY.clear();
+    _halfExtentZ.clear();
+}
+
+void AABBSoA::reserve(uint32_t count) {
+    _centerX.reserve(count);
+    _centerY.reserve(count);
+    _centerZ.reserve(count);
+    _halfExtentX.reserve(count);
+    _halfExtentY.reserve(count);
+    _halfExtentZ.reserve(count);
+}
+
+void AABBSoA::push(const AABB &aabb) {
+    _centerX.push_back(aabb.center.x);
+    _centerY.push_back(aabb.center.y);
+    _centerZ.push_back(aabb.center.z);
+    _halfExtentX.push_back(aabb.halfExtents.x);
+    _halfExtentY.push_back(aabb.halfExtents.y);
+    _halfExtentZ.push_back(aabb.halfExtents.z);
+}
+
+void aabbFrustumBatch(const AABBSoA &boxes, const Frustum &frustum, uint8_t *results) {
+    PlaneSoA planes;
+    extractPlanes(frustum, planes);
+    const uint32_t processed = aabbFrustumSIMD(boxes, planes, results);
+    aabbFrustumScalar(boxes, planes, processed, results);
+}
+
+} // namespace geometry
+} // namespace cc
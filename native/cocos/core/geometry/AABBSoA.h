@@ -0,0 +1,81 @@
+/****************************************************************************
+ Copyright (c) 2020-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+namespace geometry {
+
+class AABB;
+class Frustum;
+
+/**
+ * @en
+ * Structure-of-arrays copy of a set of AABBs, used by the batched intersection tests.
+ * @zh
+ * 以 SoA 布局存储的一组 AABB，用于批量相交性检测。
+ */
+class CC_DLL AABBSoA final {
+public:
+    void clear();
+    void reserve(uint32_t count);
+    void push(const AABB &aabb);
+
+    inline uint32_t size() const { return static_cast<uint32_t>(_centerX.size()); }
+    inline bool empty() const { return _centerX.empty(); }
+
+    inline const float *getCenterX() const { return _centerX.data(); }
+    inline const float *getCenterY() const { return _centerY.data(); }
+    inline const float *getCenterZ() const { return _centerZ.data(); }
+    inline const float *getHalfExtentX() const { return _halfExtentX.data(); }
+    inline const float *getHalfExtentY() const { return _halfExtentY.data(); }
+    inline const float *getHalfExtentZ() const { return _halfExtentZ.data(); }
+
+private:
+    ccstd::vector<float> _centerX;
+    ccstd::vector<float> _centerY;
+    ccstd::vector<float> _centerZ;
+    ccstd::vector<float> _halfExtentX;
+    ccstd::vector<float> _halfExtentY;
+    ccstd::vector<float> _halfExtentZ;
+};
+
+/**
+ * @en
+ * Batched aabb-frustum intersect detect, with the same result as `aabbFrustum` for every box.
+ * Uses 8 lanes with AVX, 4 lanes with SSE or NEON, and falls back to scalar code otherwise.
+ * @zh
+ * 批量的轴对齐包围盒和锥台相交性检测，每个包围盒的结果与 `aabbFrustum` 一致。
+ * @param boxes 轴对齐包围盒集合
+ * @param frustum 锥台
+ * @param results 输出，长度至少为 boxes.size()，相交为 1，否则为 0
+ */
+CC_DLL void aabbFrustumBatch(const AABBSoA &boxes, const Frustum &frustum, uint8_t *results);
+
+} // namespace geometry
+} // namespace cc
@@ -41,6 +41,7 @@ uint32_t Node::clearFrame{0};
 uint32_t Node::clearRound{1000};
 const uint32_t Node::TRANSFORM_ON{1 << 0};
 uint32_t Node::globalFlagChangeVersion{0};
+uint32_t Node::hierarchyVersion{0};
 
 namespace {
 const ccstd::string EMPTY_NODE_NAME;
@@ -171,6 +172,7 @@ void Node::setParent(Node *parent, bool isKeepWorld /* = false */) {
 #endif
     _parent = newParent;
     _siblingIndex = 0;
+    ++hierarchyVersion;
     onSetParent(oldParent, isKeepWorld);
     emit<ParentChanged>(oldParent);
     if (oldParent) {
@@ -258,6 +260,7 @@ bool Node::onPreDestroyBase() {
             index_t childIdx = getIdxOfChild(_parent->_children, this);
             if (childIdx != -1) {
                 _parent->_children.erase(_parent->_children.begin() + childIdx);
+                ++hierarchyVersion;
             }
             _siblingIndex = 0;
             _parent->updateSiblingIndex();
@@ -877,6 +880,7 @@ void Node::onHierarchyChanged(Node *oldParent) {
 //
 void Node::_setChildren(ccstd::vector<IntrusivePtr<Node>> &&children) {
     _children = std::move(children);
+    ++hierarchyVersion;
 }
 
 //
@@ -626,6 +626,8 @@ private:
 
     // increase on every frame, used to identify the frame
     static uint32_t globalFlagChangeVersion;
+    // increase whenever a node is attached to or detached from a parent
+    static uint32_t hierarchyVersion;
 
     static uint32_t clearFrame;
     static uint32_t clearRound;
@@ -667,6 +669,7 @@ private:
 
     friend class NodeActivator;
     friend class Scene;
+    friend class TransformHierarchy;
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(Node);
 };
@@ -25,6 +25,7 @@
 
 #include "core/scene-graph/Scene.h"
 #include "core/scene-graph/SceneGlobals.h"
+#include "core/scene-graph/TransformHierarchy.h"
 // #include "core/Director.h"
 #include "core/Root.h"
 //#include "core/scene-graph/NodeActivator.h"
@@ -46,6 +47,16 @@ Scene::~Scene() = default;
 
 void Scene::setSceneGlobals(SceneGlobals *globals) { _globals = globals; }
 
+void Scene::setTransformHierarchyEnabled(bool enabled) {
+    if (enabled == isTransformHierarchyEnabled()) {
+        return;
+    }
+    _transformHierarchy = enabled ? std::make_unique<TransformHierarchy>(this) : nullptr;
+    if (_renderScene) {
+        _renderScene->setTransformHierarchy(_transformHierarchy.get());
+    }
+}
+
 void Scene::load() {
     events::SceneLoad::broadcast();
     if (!_inited) {
@@ -104,8 +115,10 @@ bool Scene::destroy() {
     }
 
     if (_renderScene != nullptr) {
+        _renderScene->setTransformHierarchy(nullptr);
         Root::getInstance()->destroyScene(_renderScene);
     }
+    _transformHierarchy.reset();
 
     _active = false;
     setActiveInHierarchy(false);
@@ -25,10 +25,12 @@
 
 #pragma once
 
+#include <memory>
 #include "core/scene-graph/Node.h"
 
 namespace cc {
 class SceneGlobals;
+class TransformHierarchy;
 namespace scene {
 class RenderScene;
 }
@@ -49,6 +51,15 @@ public:
     void load();
     void activate(bool active = true);
 
+    /**
+     * @en Whether world transforms of the scene are refreshed in one batched, level ordered pass at the beginning
+     * of every render scene update. Node getters keep resolving lazily for nodes changed after that point.
+     * @zh 是否在每帧渲染场景更新前按层级批量刷新整个场景的世界变换。
+     */
+    void setTransformHierarchyEnabled(bool enabled);
+    inline bool isTransformHierarchyEnabled() const { return _transformHierarchy != nullptr; }
+    inline TransformHierarchy *getTransformHierarchy() const { return _transformHierarchy.get(); }
+
     void onBatchCreated(bool dontSyncChildPrefab) override;
     bool destroy() override;
 
@@ -62,6 +73,7 @@ protected:
      */
     //    @serializable
     IntrusivePtr<SceneGlobals> _globals;
+    std::unique_ptr<TransformHierarchy> _transformHierarchy;
     bool _inited{false};
 
     /**
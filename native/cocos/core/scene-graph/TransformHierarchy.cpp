@@ -0,0 +1,212 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "core/scene-graph/TransformHierarchy.h"
+#include <algorithm>
+#include "base/job-system/JobSystem.h"
+#include "core/scene-graph/Node.h"
+#include "profiler/Profiler.h"
+
+namespace cc {
+
+namespace {
+
+// nodes are composed in small batches, so they are still in cache when the results are written back
+constexpr uint32_t TRANSFORM_BATCH_SIZE = 64;
+
+struct TransformContext {
+    Node *nodes[TRANSFORM_BATCH_SIZE];
+    uint32_t bits[TRANSFORM_BATCH_SIZE];
+    Quaternion rotations[TRANSFORM_BATCH_SIZE];
+    Vec3 positions[TRANSFORM_BATCH_SIZE];
+    Vec3 scales[TRANSFORM_BATCH_SIZE];
+    Mat4 parentMatrices[TRANSFORM_BATCH_SIZE];
+    Mat4 matrices[TRANSFORM_BATCH_SIZE];
+};
+
+} // namespace
+
+TransformHierarchy::TransformHierarchy(Node *root)
+: _root(root) {}
+
+void TransformHierarchy::rebuild() {
+    _nodes.clear();
+    _parents.clear();
+    _levels.clear();
+
+    _nodes.push_back(_root);
+    _parents.push_back(0);
+    _levels.push_back(0);
+
+    size_t begin = 0;
+    while (begin < _nodes.size()) {
+        const size_t end = _nodes.size();
+        _levels.push_back(static_cast<uint32_t>(end));
+        for (size_t i = begin; i < end; ++i) {
+            for (const auto &child : _nodes[i]->_children) {
+                _nodes.push_back(child.get());
+                _parents.push_back(static_cast<uint32_t>(i));
+            }
+        }
+        begin = end;
+    }
+    _dirtyBits.assign(_nodes.size(), 0);
+
+    _hierarchyVersion = Node::hierarchyVersion;
+    _built = true;
+}
+
+void TransformHierarchy::update() {
+    if (!_root) {
+        return;
+    }
+    CC_PROFILE(TransformHierarchyUpdate);
+
+    if (!_built || _hierarchyVersion != Node::hierarchyVersion) {
+        rebuild();
+    }
+
+    // the root may have ancestors outside of this hierarchy, leave it to the lazy path
+    const uint32_t rootBits = _root->_activeInHierarchy ? _root->_dirtyFlag : 0;
+    if (rootBits) {
+        _root->updateWorldTransform();
+    }
+    _dirtyBits[0] = rootBits;
+
+    // nodes of the same depth only read their parents, so each level can be split freely
+    const auto levelCount = static_cast<uint32_t>(_levels.size()) - 1;
+    for (uint32_t level = 1; level < levelCount; ++level) {
+        const uint32_t begin = _levels[level];
+        const uint32_t end = _levels[level + 1];
+        if (end - begin <= NODES_PER_JOB) {
+            updateRange(begin, end);
+            continue;
+        }
+
+        const uint32_t jobCount = (end - begin + NODES_PER_JOB - 1) / NODES_PER_JOB;
+        auto updateJob = [this, begin, end](uint32_t index) {
+            const uint32_t jobBegin = begin + index * NODES_PER_JOB;
+            updateRange(jobBegin, std::min(jobBegin + NODES_PER_JOB, end));
+        };
+
+        JobGraph g(JobSystem::getInstance(), "TransformHierarchy");
+        g.createForEachIndexJob(1U, jobCount, 1U, updateJob);
+        g.run();
+        updateJob(0);
+        g.waitForAll();
+    }
+
+    CC_PROFILE_OBJECT_UPDATE(TransformHierarchyNodes, _nodes.size());
+}
+
+void TransformHierarchy::updateRange(uint32_t begin, uint32_t end) {
+    thread_local TransformContext context;
+    uint32_t count = 0;
+
+    constexpr auto positionBit = static_cast<uint32_t>(TransformBit::POSITION);
+    constexpr auto rotationBit = static_cast<uint32_t>(TransformBit::ROTATION);
+    constexpr auto rsBits = static_cast<uint32_t>(TransformBit::RS);
+
+    auto composeBatch = [&]() {
+        Mat4::fromRTSBatch(context.rotations, context.positions, context.scales, context.matrices, count);
+        Mat4::multiplyBatch(context.parentMatrices, context.matrices, context.matrices, count);
+
+        for (uint32_t i = 0; i < count; ++i) {
+            Node *node = context.nodes[i];
+            const Mat4 &world = context.matrices[i];
+            node->_worldMatrix = world;
+            if (context.bits[i] & positionBit) {
+                // the composed translation is the transformed local position unless the parent is projective
+                const Mat4 &parentWorld = context.parentMatrices[i];
+                if (parentWorld.m[3] == 0.F && parentWorld.m[7] == 0.F && parentWorld.m[11] == 0.F && parentWorld.m[15] == 1.F) {
+                    node->_worldPosition.set(world.m[12], world.m[13], world.m[14]);
+                } else {
+                    node->_worldPosition.transformMat4(node->_localPosition, parentWorld);
+                }
+            }
+            if (context.bits[i] & rotationBit) {
+                Quaternion::multiply(node->_parent->_worldRotation, node->_localRotation, &node->_worldRotation);
+            }
+            // diagonal of Mat3(conjugate(worldRotation)) * Mat3(worldMatrix), the only part used for world scale
+            const Quaternion &quat = node->_worldRotation;
+            const float x2 = -quat.x - quat.x;
+            const float y2 = -quat.y - quat.y;
+            const float z2 = -quat.z - quat.z;
+            const float xx = -quat.x * x2;
+            const float yx = -quat.y * x2;
+            const float yy = -quat.y * y2;
+            const float zx = -quat.z * x2;
+            const float zy = -quat.z * y2;
+            const float zz = -quat.z * z2;
+            const float wx = quat.w * x2;
+            const float wy = quat.w * y2;
+            const float wz = quat.w * z2;
+            node->_worldScale.set(world.m[0] * (1 - yy - zz) + world.m[1] * (yx - wz) + world.m[2] * (zx + wy),
+                                  world.m[4] * (yx + wz) + world.m[5] * (1 - xx - zz) + world.m[6] * (zy - wx),
+                                  world.m[8] * (zx - wy) + world.m[9] * (zy + wx) + world.m[10] * (1 - xx - yy));
+            node->setDirtyFlag(static_cast<uint32_t>(TransformBit::NONE));
+        }
+        count = 0;
+    };
+
+    // Same rules as Node::updateWorldTransformRecursive: dirty bits of a dirty parent flow down
+    // to its children. Nodes with rotation or scale changes are composed in batches, pure translations in place.
+    for (uint32_t i = begin; i < end; ++i) {
+        Node *node = _nodes[i];
+        const uint32_t ownBits = node->_dirtyFlag;
+        if (!ownBits || !node->_activeInHierarchy) {
+            _dirtyBits[i] = 0;
+            continue;
+        }
+
+        const uint32_t bits = ownBits | _dirtyBits[_parents[i]];
+        _dirtyBits[i] = bits;
+
+        const Node *parent = node->_parent;
+        if (!(bits & rsBits)) {
+            node->_worldPosition.transformMat4(node->_localPosition, parent->_worldMatrix);
+            node->_worldMatrix.m[12] = node->_worldPosition.x;
+            node->_worldMatrix.m[13] = node->_worldPosition.y;
+            node->_worldMatrix.m[14] = node->_worldPosition.z;
+            node->setDirtyFlag(static_cast<uint32_t>(TransformBit::NONE));
+            continue;
+        }
+
+        context.nodes[count] = node;
+        context.bits[count] = bits;
+        context.rotations[count] = node->_localRotation;
+        context.positions[count] = node->_localPosition;
+        context.scales[count] = node->_localScale;
+        context.parentMatrices[count] = parent->_worldMatrix;
+        if (++count == TRANSFORM_BATCH_SIZE) {
+            composeBatch();
+        }
+    }
+    if (count) {
+        composeBatch();
+    }
+}
+
+} // namespace cc
@@ -0,0 +1,78 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+class Node;
+
+/**
+ * @en Flattened, breadth-first view of a node hierarchy used to refresh world transforms level by level.
+ * Nodes of the same depth are independent, so dirty nodes are composed with the batched math kernels
+ * and large levels are split across the job system. Clean or inactive nodes are left untouched and
+ * keep resolving lazily through Node::updateWorldTransform.
+ * @zh 按广度优先展开的节点层级，逐层批量更新世界变换。
+ */
+class TransformHierarchy final {
+public:
+    explicit TransformHierarchy(Node *root);
+    ~TransformHierarchy() = default;
+
+    /**
+     * @en Recompute the world transform of every dirty, active node under the root.
+     * The flattened layout is rebuilt only when the node hierarchy has changed.
+     */
+    void update();
+
+    inline Node *getRoot() const { return _root; }
+    inline uint32_t getNodeCount() const { return static_cast<uint32_t>(_nodes.size()); }
+    inline uint32_t getLevelCount() const { return static_cast<uint32_t>(_levels.size()) - 1; }
+
+    // Nodes per job when a level is split across worker threads.
+    static constexpr uint32_t NODES_PER_JOB{1024};
+
+private:
+    void rebuild();
+    void updateRange(uint32_t begin, uint32_t end);
+
+    Node *_root{nullptr};
+    uint32_t _hierarchyVersion{0};
+    bool _built{false};
+
+    // nodes in breadth-first order, _levels[d] is the first index of depth d
+    ccstd::vector<Node *> _nodes;
+    ccstd::vector<uint32_t> _parents;
+    ccstd::vector<uint32_t> _levels;
+    // dirty bits accumulated along the ancestor chain during the current update
+    ccstd::vector<uint32_t> _dirtyBits;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(TransformHierarchy);
+};
+
+} // namespace cc
@@ -0,0 +1,230 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "FrameCache.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+MIDDLEWARE_BEGIN
+
+namespace {
+constexpr float QUANTIZED_MAX = static_cast<float>(std::numeric_limits<uint16_t>::max());
+constexpr std::size_t POSITION_COMPONENTS = 3;
+constexpr std::size_t UV_COMPONENTS = 2;
+constexpr std::size_t UV_OFFSET = 3;
+
+std::list<CachedAnimation *> lruList;
+std::size_t totalMemorySize = 0;
+std::size_t memoryBudget = 0;
+uint64_t currentTick = 1;
+} // namespace
+
+void CompactFrame::QuantizedStream::encode(const float *src, std::size_t count, std::size_t stride, std::size_t components) {
+    std::size_t stored = 0;
+    for (std::size_t c = 0; c < components; ++c) {
+        float minValue = std::numeric_limits<float>::max();
+        float maxValue = std::numeric_limits<float>::lowest();
+        for (std::size_t i = 0; i < count; ++i) {
+            float value = src[i * stride + c];
+            minValue = std::min(minValue, value);
+            maxValue = std::max(maxValue, value);
+        }
+        origin[c] = count > 0 ? minValue : 0.0F;
+        step[c] = count > 0 && maxValue > minValue ? (maxValue - minValue) / QUANTIZED_MAX : 0.0F;
+        if (step[c] > 0.0F) {
+            ++stored;
+        }
+    }
+
+    values.clear();
+    values.reserve(count * stored);
+    for (std::size_t i = 0; i < count; ++i) {
+        for (std::size_t c = 0; c < components; ++c) {
+            if (step[c] > 0.0F) {
+                float quantized = std::round((src[i * stride + c] - origin[c]) / step[c]);
+                values.push_back(static_cast<uint16_t>(std::min(std::max(quantized, 0.0F), QUANTIZED_MAX)));
+            }
+        }
+    }
+    values.shrink_to_fit();
+}
+
+void CompactFrame::QuantizedStream::decode(float *dst, std::size_t count, std::size_t stride, std::size_t components) const {
+    const uint16_t *value = values.data();
+    for (std::size_t i = 0; i < count; ++i) {
+        for (std::size_t c = 0; c < components; ++c) {
+            dst[i * stride + c] = step[c] > 0.0F ? origin[c] + static_cast<float>(*value++) * step[c] : origin[c];
+        }
+    }
+}
+
+bool CompactFrame::QuantizedStream::operator==(const QuantizedStream &rhs) const {
+    return std::equal(std::begin(origin), std::end(origin), std::begin(rhs.origin)) &&
+           std::equal(std::begin(step), std::end(step), std::begin(rhs.step)) &&
+           values == rhs.values;
+}
+
+void CompactFrame::encode(const IOBuffer &vb, std::size_t vertexFloats, const IOBuffer &ib, const CompactFrame *previous) {
+    const auto *vertices = reinterpret_cast<const float *>(vb.getBuffer());
+    _vertexCount = vertices ? vb.getCurPos() / sizeof(float) / vertexFloats : 0;
+    _positions.encode(vertices, _vertexCount, vertexFloats, POSITION_COMPONENTS);
+
+    auto uvs = std::make_shared<QuantizedStream>();
+    if (_vertexCount > 0) {
+        uvs->encode(vertices + UV_OFFSET, _vertexCount, vertexFloats, UV_COMPONENTS);
+    }
+    _ownsUVs = !previous || !previous->_uvs || !(*previous->_uvs == *uvs);
+    _uvs = _ownsUVs ? std::move(uvs) : previous->_uvs;
+
+    const auto *indices = reinterpret_cast<const uint16_t *>(ib.getBuffer());
+    std::size_t indexCount = indices ? ib.getCurPos() / sizeof(uint16_t) : 0;
+    _ownsIndices = !previous || !previous->_indices || previous->_indices->size() != indexCount ||
+                   (indexCount > 0 && memcmp(previous->_indices->data(), indices, indexCount * sizeof(uint16_t)) != 0);
+    if (_ownsIndices) {
+        _indices = std::make_shared<const std::vector<uint16_t>>(indices, indices + indexCount);
+    } else {
+        _indices = previous->_indices;
+    }
+}
+
+void CompactFrame::decode(IOBuffer &vb, std::size_t vertexFloats, IOBuffer &ib) const {
+    std::size_t vertexBytes = _vertexCount * vertexFloats * sizeof(float);
+    vb.reset();
+    if (vertexBytes > 0) {
+        vb.checkSpace(vertexBytes);
+        auto *vertices = reinterpret_cast<float *>(vb.getBuffer());
+        _positions.decode(vertices, _vertexCount, vertexFloats, POSITION_COMPONENTS);
+        _uvs->decode(vertices + UV_OFFSET, _vertexCount, vertexFloats, UV_COMPONENTS);
+        vb.move(static_cast<int>(vertexBytes));
+    }
+
+    ib.reset();
+    std::size_t indexCount = getIndexCount();
+    if (indexCount > 0) {
+        ib.checkSpace(indexCount * sizeof(uint16_t));
+        ib.writeBytes(reinterpret_cast<const char *>(_indices->data()), indexCount * sizeof(uint16_t));
+    }
+}
+
+void CompactFrame::encodeBone(const cc::Mat4 &matrix) {
+    const auto &m = matrix.m;
+    _bones.insert(_bones.end(), {m[0], m[1], m[4], m[5], m[12], m[13]});
+}
+
+void CompactFrame::decodeBone(std::size_t index, cc::Mat4 &matrix) const {
+    const float *bone = _bones.data() + index * BONE_FLOATS;
+    auto &m = matrix.m;
+    m[0] = bone[0];
+    m[1] = bone[1];
+    m[4] = bone[2];
+    m[5] = bone[3];
+    m[12] = bone[4];
+    m[13] = bone[5];
+}
+
+std::size_t CompactFrame::getMemorySize() const {
+    std::size_t size = sizeof(CompactFrame);
+    size += _positions.values.capacity() * sizeof(uint16_t);
+    size += _bones.capacity() * sizeof(float);
+    if (_ownsUVs && _uvs) {
+        size += sizeof(QuantizedStream) + _uvs->values.capacity() * sizeof(uint16_t);
+    }
+    if (_ownsIndices && _indices) {
+        size += sizeof(std::vector<uint16_t>) + _indices->capacity() * sizeof(uint16_t);
+    }
+    return size;
+}
+
+CachedAnimation::CachedAnimation() {
+    _lruIter = lruList.insert(lruList.end(), this);
+}
+
+CachedAnimation::~CachedAnimation() {
+    totalMemorySize -= _stats.memorySize;
+    lruList.erase(_lruIter);
+}
+
+void CachedAnimation::setBudget(std::size_t bytes) {
+    memoryBudget = bytes;
+}
+
+std::size_t CachedAnimation::getBudget() {
+    return memoryBudget;
+}
+
+std::size_t CachedAnimation::getTotalMemorySize() {
+    return totalMemorySize;
+}
+
+void CachedAnimation::tick() {
+    enforceBudget();
+    ++currentTick;
+}
+
+void CachedAnimation::touch() {
+    _lastUsedTick = currentTick;
+    lruList.splice(lruList.end(), lruList, _lruIter);
+}
+
+uint64_t CachedAnimation::getCurrentTick() {
+    return currentTick;
+}
+
+void CachedAnimation::addMemorySize(std::size_t bytes) {
+    touch();
+    _stats.memorySize += bytes;
+    totalMemorySize += bytes;
+}
+
+void CachedAnimation::removeMemorySize(std::size_t bytes) {
+    bytes = std::min(bytes, _stats.memorySize);
+    _stats.memorySize -= bytes;
+    totalMemorySize -= bytes;
+}
+
+void CachedAnimation::clearMemorySize() {
+    removeMemorySize(_stats.memorySize);
+}
+
+void CachedAnimation::addDecodeTime(std::chrono::nanoseconds time) {
+    ++_stats.decodeCount;
+    _stats.decodeTime += time;
+}
+
+void CachedAnimation::enforceBudget() {
+    if (memoryBudget == 0) return;
+    // least recently used first, stop at the animations used during the tick
+    auto it = lruList.begin();
+    while (totalMemorySize > memoryBudget && it != lruList.end() && (*it)->_lastUsedTick != currentTick) {
+        auto *animation = *it++;
+        if (animation->_stats.memorySize > 0) {
+            animation->evict();
+        }
+    }
+}
+
+MIDDLEWARE_END
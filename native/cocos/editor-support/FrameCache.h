@@ -0,0 +1,133 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <vector>
+#include "IOBuffer.h"
+#include "MiddlewareMacro.h"
+#include "math/Mat4.h"
+
+MIDDLEWARE_BEGIN
+
+/**
+ * Storage of one baked animation frame, as kept by the spine and dragonbones caches.
+ * Positions and uvs are quantized to 16 bits against the bounds of the frame, vertex colors
+ * are left to the owner, which restores them from its color ranges. A uv or index stream equal
+ * to the one of the previous frame is shared with it instead of being stored again.
+ */
+class CompactFrame {
+public:
+    // vertices are vertexFloats floats wide and start with x, y, z, u, v
+    void encode(const IOBuffer &vb, std::size_t vertexFloats, const IOBuffer &ib, const CompactFrame *previous);
+    // writes x, y, z, u, v of every vertex, the other vertex fields are left untouched
+    void decode(IOBuffer &vb, std::size_t vertexFloats, IOBuffer &ib) const;
+
+    // keeps a, b, c, d, tx, ty of a bone's global transform
+    void encodeBone(const cc::Mat4 &matrix);
+    void decodeBone(std::size_t index, cc::Mat4 &matrix) const;
+
+    inline std::size_t getVertexCount() const { return _vertexCount; }
+    inline std::size_t getIndexCount() const { return _indices ? _indices->size() : 0; }
+    inline std::size_t getBoneCount() const { return _bones.size() / BONE_FLOATS; }
+    // streams shared with the previous frame are only accounted there
+    std::size_t getMemorySize() const;
+
+private:
+    static constexpr std::size_t BONE_FLOATS = 6;
+
+    struct QuantizedStream {
+        // components with a zero step are constant and not stored
+        float origin[3]{0.0F, 0.0F, 0.0F};
+        float step[3]{0.0F, 0.0F, 0.0F};
+        std::vector<uint16_t> values;
+
+        void encode(const float *src, std::size_t count, std::size_t stride, std::size_t components);
+        void decode(float *dst, std::size_t count, std::size_t stride, std::size_t components) const;
+        bool operator==(const QuantizedStream &rhs) const;
+    };
+
+    std::size_t _vertexCount = 0;
+    QuantizedStream _positions;
+    std::shared_ptr<const QuantizedStream> _uvs;
+    std::shared_ptr<const std::vector<uint16_t>> _indices;
+    bool _ownsUVs = false;
+    bool _ownsIndices = false;
+    std::vector<float> _bones;
+};
+
+/**
+ * Base of the baked animations of spine and dragonbones. All of them share one byte budget,
+ * once it is exceeded the least recently used animations drop their frames, which are baked
+ * again the next time they are played.
+ */
+class CachedAnimation {
+public:
+    struct Stats {
+        std::size_t memorySize = 0;
+        std::size_t decodeCount = 0;
+        std::chrono::nanoseconds decodeTime{0};
+    };
+
+    CachedAnimation();
+    virtual ~CachedAnimation();
+    CachedAnimation(const CachedAnimation &) = delete;
+    CachedAnimation &operator=(const CachedAnimation &) = delete;
+
+    // budget in bytes of all cached animations, 0 means unlimited, applied at the next tick
+    static void setBudget(std::size_t bytes);
+    static std::size_t getBudget();
+    static std::size_t getTotalMemorySize();
+    // called once per frame, the budget is only enforced here so nothing is evicted between the update and
+    // the render of a frame, animations used since the last tick are kept
+    static void tick();
+
+    inline const Stats &getStats() const { return _stats; }
+
+protected:
+    // drops all frames of the animation
+    virtual void evict() = 0;
+
+    void touch();
+    // frames used by a display during the current tick carry its value
+    static uint64_t getCurrentTick();
+    void addMemorySize(std::size_t bytes);
+    void removeMemorySize(std::size_t bytes);
+    void clearMemorySize();
+    void addDecodeTime(std::chrono::nanoseconds time);
+
+private:
+    static void enforceBudget();
+
+    Stats _stats;
+    uint64_t _lastUsedTick = 0;
+    std::list<CachedAnimation *>::iterator _lruIter;
+};
+
+MIDDLEWARE_END
@@ -25,8 +25,10 @@
 
 #include "MiddlewareManager.h"
 #include <algorithm>
+#include "FrameCache.h"
 #include "SeApi.h"
 #include "2d/renderer/Batcher2d.h"
+#include "base/job-system/JobSystem.h"
 #include "core/Root.h"
 
 MIDDLEWARE_BEGIN
@@ -66,8 +68,36 @@ void MiddlewareManager::clearRemoveList() {
     _removeList.clear();
 }
 
+bool MiddlewareManager::isRemoved(IMiddleware *editor) const {
+    return !_removeList.empty() && std::find(_removeList.begin(), _removeList.end(), editor) != _removeList.end();
+}
+
+template <typename Fn>
+void MiddlewareManager::runInJobs(uint32_t count, const char *name, const Fn &fn) {
+    const uint32_t jobCount = (count + MIDDLEWARES_PER_JOB - 1) / MIDDLEWARES_PER_JOB;
+    auto job = [count, &fn](uint32_t index) {
+        const uint32_t end = std::min(count, (index + 1) * MIDDLEWARES_PER_JOB);
+        for (uint32_t i = index * MIDDLEWARES_PER_JOB; i < end; ++i) {
+            fn(i);
+        }
+    };
+
+    if (_parallelUpdateEnabled && jobCount > 1) {
+        JobGraph g(JobSystem::getInstance(), name);
+        g.createForEachIndexJob(1U, jobCount, 1U, job);
+        g.run();
+        job(0);
+        g.waitForAll();
+    } else {
+        for (uint32_t index = 0; index < jobCount; ++index) {
+            job(index);
+        }
+    }
+}
+
 void MiddlewareManager::update(float dt) {
     isUpdating = true;
+    CachedAnimation::tick();
 
     _attachInfo.reset();
     auto *attachBuffer = _attachInfo.getBuffer();
@@ -75,22 +105,44 @@ void MiddlewareManager::update(float dt) {
         attachBuffer->writeUint32(0);
     }
 
+    _parallelUpdateDt = dt;
     for (auto *editor : _updateList) {
         if (!_removeList.empty()) {
             auto removeIt = std::find(_removeList.begin(), _removeList.end(), editor);
             if (removeIt == _removeList.end()) {
                 editor->update(dt);
+                _parallelUpdateList.push_back(editor);
             }
         } else {
             editor->update(dt);
+            _parallelUpdateList.push_back(editor);
         }
     }
 
+    flushParallelUpdate();
+
     isUpdating = false;
 
     clearRemoveList();
 }
 
+void MiddlewareManager::flushParallelUpdate() {
+    // update callbacks may have removed middlewares updated before them
+    if (!_removeList.empty()) {
+        _parallelUpdateList.erase(std::remove_if(_parallelUpdateList.begin(), _parallelUpdateList.end(), [this](IMiddleware *editor) {
+                                      return std::find(_removeList.begin(), _removeList.end(), editor) != _removeList.end();
+                                  }),
+                                  _parallelUpdateList.end());
+    }
+
+    const float dt = _parallelUpdateDt;
+    runInJobs(static_cast<uint32_t>(_parallelUpdateList.size()), "MiddlewareUpdate", [this, dt](uint32_t i) {
+        _parallelUpdateList[i]->parallelUpdate(dt);
+    });
+
+    _parallelUpdateList.clear();
+}
+
 void MiddlewareManager::render(float dt) {
     for (auto it : _mbMap) {
         auto *buffer = it.second;
@@ -102,12 +154,21 @@ void MiddlewareManager::render(float dt) {
     isRendering = true;
 
     for (auto *editor : _updateList) {
-        if (!_removeList.empty()) {
-            auto removeIt = std::find(_removeList.begin(), _removeList.end(), editor);
-            if (removeIt == _removeList.end()) {
-                editor->render(dt);
-            }
-        } else {
+        if (isRemoved(editor)) continue;
+        const uint32_t partCount = editor->prepareRender();
+        for (uint32_t part = 0; part < partCount; ++part) {
+            _renderParts.emplace_back(editor, part);
+        }
+    }
+
+    // vertices are generated concurrently, the commits below keep the draw order of a serial render
+    runInJobs(static_cast<uint32_t>(_renderParts.size()), "MiddlewareRender", [this](uint32_t i) {
+        _renderParts[i].first->parallelRender(_renderParts[i].second);
+    });
+    _renderParts.clear();
+
+    for (auto *editor : _updateList) {
+        if (!isRemoved(editor)) {
             editor->render(dt);
         }
     }
@@ -26,6 +26,7 @@
 #pragma once
 
 #include <map>
+#include <utility>
 #include <vector>
 #include "MeshBuffer.h"
 #include "MiddlewareMacro.h"
@@ -42,6 +43,29 @@ public:
     IMiddleware() = default;
     virtual ~IMiddleware() = default;
     virtual void update(float dt) = 0;
+    /**
+     * Runs after the update of this middleware, on a worker thread and concurrently
+     * with other middlewares, so it may only touch state owned by this middleware.
+     * It's finished before any middleware invokes a script listener from its update,
+     * see MiddlewareManager::flushParallelUpdate.
+     */
+    virtual void parallelUpdate(float /*dt*/) {}
+    /**
+     * Runs on the main thread before the parallel render, for the state a worker
+     * can't read, such as node world matrices.
+     * Returns the number of parts parallelRender is invoked for, 0 renders serially.
+     */
+    virtual uint32_t prepareRender() { return 0; }
+    /**
+     * Generates the vertices of one part into buffers owned by this middleware, on a
+     * worker thread and concurrently with other parts.
+     */
+    virtual void parallelRender(uint32_t /*part*/) {}
+    /**
+     * Commits the generated vertices into the shared mesh buffers and requests the
+     * draw infos, on the main thread in registration order, so draw order is the same
+     * as with a serial render.
+     */
     virtual void render(float dt) = 0;
 };
 
@@ -106,6 +130,17 @@ public:
     SharedBufferManager *getRenderInfoMgr();
     SharedBufferManager *getAttachInfoMgr();
 
+    /**
+     * @brief Finishes the parallel update of the middlewares updated so far this frame.
+     * Middlewares call it before invoking script listeners from their update, so the
+     * listeners observe the same state as with a fully serial update.
+     */
+    void flushParallelUpdate();
+
+    // covers both parallelUpdate and parallelRender
+    inline void setParallelUpdateEnabled(bool enabled) { _parallelUpdateEnabled = enabled; }
+    inline bool isParallelUpdateEnabled() const { return _parallelUpdateEnabled; }
+
     MiddlewareManager();
     ~MiddlewareManager();
 
@@ -114,10 +149,20 @@ public:
     bool isUpdating = false;
 
 private:
+    static constexpr uint32_t MIDDLEWARES_PER_JOB = 16;
+
     void clearRemoveList();
+    bool isRemoved(IMiddleware *editor) const;
+    template <typename Fn>
+    void runInJobs(uint32_t count, const char *name, const Fn &fn);
 
     ccstd::vector<IMiddleware *> _updateList;
     ccstd::vector<IMiddleware *> _removeList;
+    // middlewares updated this frame whose parallel update is pending
+    ccstd::vector<IMiddleware *> _parallelUpdateList;
+    float _parallelUpdateDt{0.F};
+    ccstd::vector<std::pair<IMiddleware *, uint32_t>> _renderParts;
+    bool _parallelUpdateEnabled{true};
     std::map<int, MeshBuffer *> _mbMap;
 
     SharedBufferManager _renderInfo;
@@ -32,6 +32,10 @@ using namespace cc; // NOLINT(google-build-using-namespace)
 
 DRAGONBONES_NAMESPACE_BEGIN
 
+namespace {
+constexpr std::size_t VERTEX_FLOATS = sizeof(middleware::V3F_T2F_C4B) / sizeof(float);
+} // namespace
+
 float ArmatureCache::FrameTime = 1.0F / 60.0F;
 float ArmatureCache::MaxCacheTime = 120.0F;
 
@@ -109,6 +113,55 @@ std::size_t ArmatureCache::FrameData::getSegmentCount() const {
     return _segments.size();
 }
 
+void ArmatureCache::FrameData::compact(const FrameData *previous) {
+    _compact.encode(vb, VERTEX_FLOATS, ib, previous ? &previous->_compact : nullptr);
+    for (auto &bone : _bones) {
+        _compact.encodeBone(bone->globalTransformMatrix);
+    }
+    releaseDecoded();
+}
+
+void ArmatureCache::FrameData::decode() {
+    _compact.decode(vb, VERTEX_FLOATS, ib);
+    for (std::size_t i = 0, n = _compact.getBoneCount(); i < n; ++i) {
+        _compact.decodeBone(i, buildBoneData(i)->globalTransformMatrix);
+    }
+
+    // colors are constant over the vertex ranges recorded while baking
+    auto *vertices = reinterpret_cast<middleware::V3F_T2F_C4B *>(vb.getBuffer());
+    std::size_t vertexIndex = 0;
+    for (auto &colorData : _colors) {
+        const auto &color = colorData->color;
+        auto endIndex = std::min(static_cast<std::size_t>(colorData->vertexFloatOffset) / VERTEX_FLOATS, _compact.getVertexCount());
+        for (; vertexIndex < endIndex; ++vertexIndex) {
+            middleware::V3F_T2F_C4B *vertex = vertices + vertexIndex;
+            vertex->color = color;
+        }
+    }
+    _decoded = true;
+}
+
+void ArmatureCache::FrameData::releaseDecoded() {
+    for (auto &bone : _bones) {
+        delete bone;
+    }
+    _bones.clear();
+    _bones.shrink_to_fit();
+    vb.release();
+    ib.release();
+    _decoded = false;
+}
+
+std::size_t ArmatureCache::FrameData::getMemorySize() const {
+    return sizeof(FrameData) + _compact.getMemorySize() +
+           _colors.size() * (sizeof(ColorData *) + sizeof(ColorData)) +
+           _segments.size() * (sizeof(SegmentData *) + sizeof(SegmentData));
+}
+
+std::size_t ArmatureCache::FrameData::getDecodedSize() const {
+    return vb.getCapacity() + ib.getCapacity() + _bones.size() * (sizeof(BoneData *) + sizeof(BoneData));
+}
+
 ArmatureCache::AnimationData::AnimationData() = default;
 
 ArmatureCache::AnimationData::~AnimationData() {
@@ -120,6 +173,8 @@ void ArmatureCache::AnimationData::reset() {
         delete frame;
     }
     _frames.clear();
+    _decodedFrames.clear();
+    clearMemorySize();
     _isComplete = false;
     _totalTime = 0.0F;
 }
@@ -139,11 +194,44 @@ ArmatureCache::FrameData *ArmatureCache::AnimationData::buildFrameData(std::size
     return _frames[frameIdx];
 }
 
-ArmatureCache::FrameData *ArmatureCache::AnimationData::getFrameData(std::size_t frameIdx) const {
+ArmatureCache::FrameData *ArmatureCache::AnimationData::getFrameData(std::size_t frameIdx) {
     if (frameIdx >= _frames.size()) {
         return nullptr;
     }
-    return _frames[frameIdx];
+    touch();
+    FrameData *frameData = _frames[frameIdx];
+    const uint64_t tick = getCurrentTick();
+    if (!frameData->_decoded) {
+        for (auto it = _decodedFrames.begin(); it != _decodedFrames.end() && _decodedFrames.size() >= MAX_DECODED_FRAMES;) {
+            FrameData *decoded = *it;
+            if (decoded->_usedTick == tick) {
+                ++it;
+                continue;
+            }
+            removeMemorySize(decoded->getDecodedSize());
+            decoded->releaseDecoded();
+            it = _decodedFrames.erase(it);
+        }
+        auto start = std::chrono::steady_clock::now();
+        frameData->decode();
+        addDecodeTime(std::chrono::steady_clock::now() - start);
+        _decodedFrames.push_back(frameData);
+        addMemorySize(frameData->getDecodedSize());
+    }
+    frameData->_usedTick = tick;
+    return frameData;
+}
+
+void ArmatureCache::AnimationData::compactLastFrame() {
+    if (_frames.empty()) return;
+    std::size_t count = _frames.size();
+    FrameData *frameData = _frames[count - 1];
+    frameData->compact(count > 1 ? _frames[count - 2] : nullptr);
+    addMemorySize(frameData->getMemorySize());
+}
+
+void ArmatureCache::AnimationData::evict() {
+    reset();
 }
 
 std::size_t ArmatureCache::AnimationData::getFrameCount() const {
@@ -224,6 +312,7 @@ void ArmatureCache::updateToFrame(const std::string &animationName, int toFrameI
     do {
         armature->advanceTime(FrameTime);
         renderAnimationFrame(animationData);
+        animationData->compactLastFrame();
         animationData->_totalTime += FrameTime;
         if (animation->isCompleted()) {
             animationData->_isComplete = true;
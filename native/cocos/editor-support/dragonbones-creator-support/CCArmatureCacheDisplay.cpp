@@ -371,6 +371,8 @@ void CCArmatureCacheDisplay::dispatchDBEvent(const std::string &type, EventObjec
     }
 
     if (_dbEventCallback) {
+        // the callback may read the bones of spine skeletons updated before
+        MiddlewareManager::getInstance()->flushParallelUpdate();
         _dbEventCallback(value);
     }
 }
@@ -92,6 +92,26 @@ void CCArmatureDisplay::dbClear() {
 
 void CCArmatureDisplay::dbUpdate() {}
 
+bool CCArmatureDisplay::prepareRender() {
+    _verticesGenerated = false;
+    // child armatures are rendered by the display of the root armature
+    if (!_armature || _armature->getParent() || !_entity) {
+        return false;
+    }
+    _nodeWorldMat = _entity->getNode()->getWorldMatrix();
+    return true;
+}
+
+void CCArmatureDisplay::generateVertices() {
+    _vertexSegments.clear();
+    _vertexScratch.reset();
+    _indexScratch.reset();
+
+    // Traverse all aramture to fill vertex and index buffer.
+    traverseArmature(_armature);
+    _verticesGenerated = true;
+}
+
 void CCArmatureDisplay::dbRender() {
     _sharedBufferOffset->reset();
     _sharedBufferOffset->clear();
@@ -115,6 +135,13 @@ void CCArmatureDisplay::dbRender() {
     // store attach info offset
     _sharedBufferOffset->writeUint32(static_cast<uint32_t>(attachInfo->getCurPos()) / sizeof(uint32_t));
 
+    // the factory generates the vertices of all displays in parallel before, see CCFactory::parallelRender
+    if (!_verticesGenerated) {
+        prepareRender();
+        generateVertices();
+    }
+    _verticesGenerated = false;
+
     _preBlendMode = -1;
     _preISegWritePos = -1;
     _curISegLen = 0;
@@ -125,9 +152,7 @@ void CCArmatureDisplay::dbRender() {
     _curTexture = nullptr;
     _curDrawInfo = nullptr;
 
-
-    // Traverse all aramture to fill vertex and index buffer.
-    traverseArmature(_armature);
+    commitVertices();
 
     if (_curDrawInfo) _curDrawInfo->setIbCount(_curISegLen);
 
@@ -212,27 +237,88 @@ CCArmatureDisplay *CCArmatureDisplay::getRootDisplay() {
 }
 
 void CCArmatureDisplay::traverseArmature(Armature *armature, float parentOpacity) {
-    static cc::Mat4 matrixTemp;
-    auto &nodeWorldMat = _entity->getNode()->getWorldMatrix();
+    cc::Mat4 worldMatrix;
 
     // data store in buffer which 0 to 3 is render order, left data is node world matrix
     const auto &slots = armature->getSlots();
-    auto *mgr = MiddlewareManager::getInstance();
-
-    middleware::MeshBuffer *mb = mgr->getMeshBuffer(VF_XYZUVC);
-    IOBuffer &vb = mb->getVB();
-    IOBuffer &ib = mb->getIB();
+    IOBuffer &vb = _vertexScratch;
+    IOBuffer &ib = _indexScratch;
 
     float realOpacity = _nodeColor.a;
 
-    auto *attachMgr = mgr->getAttachInfoMgr();
-    auto *attachInfo = attachMgr->getBuffer();
-    if (!attachInfo) return;
-
     // range [0.0, 255.0]
     Color4B color(0, 0, 0, 0);
     CCSlot *slot = nullptr;
-    int isFull = 0;
+
+    for (auto *i : slots) {
+        slot = dynamic_cast<CCSlot *>(i); //TODO(zhakasi): refine the logic
+        if (slot == nullptr) {
+            return;
+        }
+        if (!slot->getVisible()) {
+            continue;
+        }
+
+        slot->updateWorldMatrix();
+
+        // If slots has child armature,will traverse child first.
+        Armature *childArmature = slot->getChildArmature();
+        if (childArmature != nullptr) {
+            traverseArmature(childArmature, parentOpacity * static_cast<float>(slot->color.a) / 255.0F);
+            continue;
+        }
+
+        if (!slot->getTexture()) continue;
+        auto vbSize = slot->triangles.vertCount * sizeof(middleware::V3F_T2F_C4B);
+        vb.checkSpace(vbSize, true);
+
+        // Calculation vertex color.
+        color.a = (uint8_t)(realOpacity * static_cast<float>(slot->color.a) * parentOpacity);
+        float multiplier = _premultipliedAlpha ? color.a / 255.0F : 1.0F;
+        color.r = _nodeColor.r * slot->color.r * multiplier;
+        color.g = _nodeColor.g * slot->color.g * multiplier;
+        color.b = _nodeColor.b * slot->color.b * multiplier;
+
+        // Transform component matrix to global matrix
+        middleware::Triangles &triangles = slot->triangles;
+        cc::Mat4::multiply(_nodeWorldMat, slot->worldMatrix, &worldMatrix);
+
+        middleware::V3F_T2F_C4B *worldTriangles = slot->worldVerts;
+
+        for (int v = 0, w = 0, vn = triangles.vertCount; v < vn; ++v, w += 2) {
+            middleware::V3F_T2F_C4B *vertex = triangles.verts + v;
+            middleware::V3F_T2F_C4B *worldVertex = worldTriangles + v;
+
+            vertex->vertex.z = 0; //reset for z value
+            worldVertex->vertex.transformMat4(vertex->vertex, worldMatrix);
+
+            worldVertex->color = color;
+        }
+
+        auto ibSize = triangles.indexCount * sizeof(uint16_t);
+        ib.checkSpace(ibSize, true);
+
+        // indices stay relative to the slot, they are rebased when committed
+        VertexSegment segment;
+        segment.texture = slot->getTexture();
+        segment.blendMode = slot->_blendMode;
+        segment.vbOffset = static_cast<uint32_t>(vb.getCurPos());
+        segment.vbSize = static_cast<uint32_t>(vbSize);
+        segment.ibOffset = static_cast<uint32_t>(ib.getCurPos());
+        segment.ibSize = static_cast<uint32_t>(ibSize);
+        _vertexSegments.push_back(segment);
+
+        vb.writeBytes(reinterpret_cast<char *>(worldTriangles), vbSize);
+        ib.writeBytes(reinterpret_cast<char *>(triangles.indices), ibSize);
+    }
+}
+
+void CCArmatureDisplay::commitVertices() {
+    auto *mgr = MiddlewareManager::getInstance();
+    middleware::MeshBuffer *mb = mgr->getMeshBuffer(VF_XYZUVC);
+    IOBuffer &vb = mb->getVB();
+    IOBuffer &ib = mb->getIB();
+    BlendMode blendMode = BlendMode::Normal;
 
     auto flush = [&]() {
         // fill pre segment count field
@@ -241,7 +327,7 @@ void CCArmatureDisplay::traverseArmature(Armature *armature, float parentOpacity
         _curDrawInfo = requestDrawInfo(_materialLen);
         _entity->addDynamicRenderDrawInfo(_curDrawInfo);
         // prepare to fill new segment field
-        switch (slot->_blendMode) {
+        switch (blendMode) {
             case BlendMode::Add:
                 _curBlendSrc = static_cast<int>(_premultipliedAlpha ? gfx::BlendFactor::ONE : gfx::BlendFactor::SRC_ALPHA);
                 _curBlendDst = static_cast<int>(gfx::BlendFactor::ONE);
@@ -271,7 +357,7 @@ void CCArmatureDisplay::traverseArmature(Armature *armature, float parentOpacity
         _curDrawInfo->setIndexOffset(static_cast<uint32_t>(ib.getCurPos()) / sizeof(uint16_t));
 
         // reset pre blend mode to current
-        _preBlendMode = static_cast<int>(slot->_blendMode);
+        _preBlendMode = static_cast<int>(blendMode);
         // reset pre texture index to current
         _preTexture = _curTexture;
 
@@ -281,77 +367,35 @@ void CCArmatureDisplay::traverseArmature(Armature *armature, float parentOpacity
         _materialLen++;
     };
 
-    for (auto *i : slots) {
-        isFull = 0;
-        slot = dynamic_cast<CCSlot *>(i); //TODO(zhakasi): refine the logic
-        if (slot == nullptr) {
-            return;
-        }
-        if (!slot->getVisible()) {
-            continue;
-        }
-
-        slot->updateWorldMatrix();
-
-        // If slots has child armature,will traverse child first.
-        Armature *childArmature = slot->getChildArmature();
-        if (childArmature != nullptr) {
-            traverseArmature(childArmature, parentOpacity * static_cast<float>(slot->color.a) / 255.0F);
-            continue;
-        }
-
-        if (!slot->getTexture()) continue;
-        _curTexture = static_cast<cc::Texture2D*>(slot->getTexture()->getRealTexture());
-        auto vbSize = slot->triangles.vertCount * sizeof(middleware::V3F_T2F_C4B);
-        isFull |= vb.checkSpace(vbSize, true);
+    // copy the generated slots into the shared buffer, a slot never straddles two buffers
+    for (const auto &segment : _vertexSegments) {
+        _curTexture = static_cast<cc::Texture2D *>(segment.texture->getRealTexture());
+        int isFull = vb.checkSpace(segment.vbSize, true);
+        blendMode = segment.blendMode;
 
         // If texture or blendMode change,will change material.
-        if (_preTexture != _curTexture || _preBlendMode != static_cast<int>(slot->_blendMode) || isFull) {
+        if (_preTexture != _curTexture || _preBlendMode != static_cast<int>(blendMode) || isFull) {
             flush();
         }
 
-        // Calculation vertex color.
-        color.a = (uint8_t)(realOpacity * static_cast<float>(slot->color.a) * parentOpacity);
-        float multiplier = _premultipliedAlpha ? color.a / 255.0F : 1.0F;
-        color.r = _nodeColor.r * slot->color.r * multiplier;
-        color.g = _nodeColor.g * slot->color.g * multiplier;
-        color.b = _nodeColor.b * slot->color.b * multiplier;
-
-        // Transform component matrix to global matrix
-        middleware::Triangles &triangles = slot->triangles;
-        cc::Mat4 *worldMatrix = &slot->worldMatrix;
-        cc::Mat4::multiply(nodeWorldMat, *worldMatrix, &matrixTemp);
-        worldMatrix = &matrixTemp;
-
-        middleware::V3F_T2F_C4B *worldTriangles = slot->worldVerts;
-
-        for (int v = 0, w = 0, vn = triangles.vertCount; v < vn; ++v, w += 2) {
-            middleware::V3F_T2F_C4B *vertex = triangles.verts + v;
-            middleware::V3F_T2F_C4B *worldVertex = worldTriangles + v;
-
-            vertex->vertex.z = 0; //reset for z value
-            worldVertex->vertex.transformMat4(vertex->vertex, *worldMatrix);
-
-            worldVertex->color = color;
-        }
-
         // Fill MiddlewareManager vertex buffer
         auto vertexOffset = vb.getCurPos() / sizeof(middleware::V3F_T2F_C4B);
-        vb.writeBytes(reinterpret_cast<char *>(worldTriangles), vbSize);
+        vb.writeBytes(reinterpret_cast<const char *>(_vertexScratch.getBuffer() + segment.vbOffset), segment.vbSize);
 
-        auto ibSize = triangles.indexCount * sizeof(uint16_t);
-        ib.checkSpace(ibSize, true);
+        ib.checkSpace(segment.ibSize, true);
+        const auto *indices = reinterpret_cast<const uint16_t *>(_indexScratch.getBuffer() + segment.ibOffset);
+        const auto indexCount = segment.ibSize / sizeof(uint16_t);
         // If vertex buffer current offset is zero,fill it directly or recalculate vertex offset.
         if (vertexOffset > 0) {
-            for (int ii = 0, nn = triangles.indexCount; ii < nn; ii++) {
-                ib.writeUint16(triangles.indices[ii] + vertexOffset);
+            for (uint32_t ii = 0; ii < indexCount; ii++) {
+                ib.writeUint16(indices[ii] + vertexOffset);
             }
         } else {
-            ib.writeBytes(reinterpret_cast<char *>(triangles.indices), ibSize);
+            ib.writeBytes(reinterpret_cast<const char *>(indices), segment.ibSize);
         }
 
         // Record this turn index segmentation count,it will store in material buffer in the end.
-        _curISegLen += triangles.indexCount;
+        _curISegLen += static_cast<int>(indexCount);
     }
 }
 
@@ -371,6 +415,8 @@ void CCArmatureDisplay::dispatchDBEvent(const std::string &type, EventObject *va
     }
 
     if (_dbEventCallback) {
+        // the callback may read the bones of spine skeletons updated before
+        MiddlewareManager::getInstance()->flushParallelUpdate();
         _dbEventCallback(value);
     }
 }
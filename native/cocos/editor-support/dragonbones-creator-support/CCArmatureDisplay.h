@@ -34,6 +34,7 @@
 #include "bindings/event/EventDispatcher.h"
 #include "dragonbones-creator-support/CCSlot.h"
 #include "dragonbones/DragonBonesHeaders.h"
+#include "math/Mat4.h"
 #include "middleware-adapter.h"
 
 namespace cc {
@@ -60,7 +61,18 @@ public:
     static CCArmatureDisplay *create();
 
 private:
+    // the vertices and indices of one slot in the scratch buffers, indices start at 0
+    struct VertexSegment {
+        cc::middleware::Texture2D *texture = nullptr;
+        BlendMode blendMode = BlendMode::Normal;
+        uint32_t vbOffset = 0;
+        uint32_t vbSize = 0;
+        uint32_t ibOffset = 0;
+        uint32_t ibSize = 0;
+    };
+
     void traverseArmature(Armature *armature, float parentOpacity = 1.0F);
+    void commitVertices();
 
 protected:
     bool _debugDraw = false;
@@ -86,6 +98,16 @@ public:
      * @inheritDoc
      */
     void dbRender() override;
+    /**
+     * @brief Reads the main thread state the vertices depend on, before they are generated.
+     * @return false if the armature isn't rendered by this display.
+     */
+    bool prepareRender();
+    /**
+     * @brief Generates the vertices of the armature tree into the scratch buffers of this display,
+     * may run on a worker thread, dbRender copies them into the shared mesh buffer.
+     */
+    void generateVertices();
     /**
      * @inheritDoc
      */
@@ -201,6 +223,12 @@ private:
     cc::Material *_material = nullptr;
     ccstd::vector<cc::RenderDrawInfo *> _drawInfoArray;
     ccstd::unordered_map<uint32_t, cc::Material*> _materialCaches;
+
+    cc::Mat4 _nodeWorldMat;
+    cc::middleware::IOBuffer _vertexScratch{MIN_TYPE_ARRAY_SIZE};
+    cc::middleware::IOBuffer _indexScratch{MIN_TYPE_ARRAY_SIZE};
+    ccstd::vector<VertexSegment> _vertexSegments;
+    bool _verticesGenerated = false;
 };
 
 DRAGONBONES_NAMESPACE_END
@@ -34,6 +34,31 @@ DRAGONBONES_NAMESPACE_BEGIN
 DragonBones *CCFactory::_dragonBonesInstance = nullptr;
 CCFactory *CCFactory::_factory = nullptr;
 
+uint32_t CCFactory::prepareRender() {
+    _renderDisplays.clear();
+    collectRenderDisplays(_dragonBonesInstance->getClock());
+    return static_cast<uint32_t>(_renderDisplays.size());
+}
+
+void CCFactory::collectRenderDisplays(WorldClock *clock) {
+    // same order as WorldClock::render
+    for (auto *animatable : clock->getAnimatables()) {
+        if (auto *armature = dynamic_cast<Armature *>(animatable)) {
+            auto *display = dynamic_cast<CCArmatureDisplay *>(armature->getProxy());
+            if (display && display->prepareRender()) {
+                _renderDisplays.push_back(display);
+            }
+        } else if (auto *childClock = dynamic_cast<WorldClock *>(animatable)) {
+            collectRenderDisplays(childClock);
+        }
+    }
+}
+
+void CCFactory::parallelRender(uint32_t part) {
+    // a display only touches its own armature tree and scratch buffers
+    _renderDisplays[part]->generateVertices();
+}
+
 TextureAtlasData *CCFactory::_buildTextureAtlasData(TextureAtlasData *textureAtlasData, void *textureAtlas) const {
     if (textureAtlasData != nullptr) {
         const auto pos = _prevPath.find_last_of("/");
@@ -108,6 +108,12 @@ public:
         _dragonBonesInstance->advanceTime(dt);
     }
 
+    /**
+     * @note Every root armature display is a part, their vertices are generated in parallel.
+     */
+    virtual uint32_t prepareRender() override;
+    virtual void parallelRender(uint32_t part) override;
+
     virtual void render(float dt) override {
         _dragonBonesInstance->render();
     }
@@ -126,6 +132,11 @@ public:
         clear(false);
     }
 
+private:
+    void collectRenderDisplays(WorldClock *clock);
+
+    std::vector<CCArmatureDisplay *> _renderDisplays;
+
 protected:
     virtual TextureAtlasData *_buildTextureAtlasData(TextureAtlasData *textureAtlasData, void *textureAtlas) const override;
     virtual Armature *_buildArmature(const BuildArmaturePackage &dataPackage) const override;
@@ -195,6 +195,14 @@ public:
         return _clock;
     }
     virtual void setClock(WorldClock* value) override;
+    /**
+     * - The IAnimatable instances in render order, removed ones are null.
+     * @version Cocos creator 3.6
+     * @language en_US
+     */
+    inline const std::vector<IAnimatable*>& getAnimatables() const {
+        return _animatebles;
+    }
 
 public: // For WebAssembly.
     static WorldClock* getStaticClock() { return &clock; }
@@ -127,8 +127,21 @@ void SkeletonAnimation::update(float deltaTime) {
         if (_ownsSkeleton) _skeleton->update(deltaTime);
         _state->update(deltaTime);
         _state->apply(*_skeleton);
+        // the state fires listeners, which have to stay on this thread and see the bones of
+        // the skeletons updated before, while a skeleton shared with other renderers can't be posed concurrently
+        if (_ownsSkeleton) {
+            _worldTransformDirty = true;
+        } else {
+            _skeleton->updateWorldTransform();
+        }
+    }
+}
+
+void SkeletonAnimation::parallelUpdate(float /*deltaTime*/) {
+    if (_worldTransformDirty && _skeleton) {
         _skeleton->updateWorldTransform();
     }
+    _worldTransformDirty = false;
 }
 
 void SkeletonAnimation::setAnimationStateData(AnimationStateData *stateData) {
@@ -221,6 +234,8 @@ void SkeletonAnimation::clearTrack(int trackIndex) {
 }
 
 void SkeletonAnimation::onAnimationStateEvent(TrackEntry *entry, EventType type, Event *event) {
+    // listeners may read the bones of skeletons updated before this one
+    cc::middleware::MiddlewareManager::getInstance()->flushParallelUpdate();
     switch (type) {
         case EventType_Start:
             if (_startListener) _startListener(entry);
@@ -246,6 +261,7 @@ void SkeletonAnimation::onAnimationStateEvent(TrackEntry *entry, EventType type,
 void SkeletonAnimation::onTrackEntryEvent(TrackEntry *entry, EventType type, Event *event) {
     if (!entry->getRendererObject()) return;
     auto *listeners = static_cast<TrackEntryListeners *>(entry->getRendererObject());
+    cc::middleware::MiddlewareManager::getInstance()->flushParallelUpdate();
     switch (type) {
         case EventType_Start:
             if (listeners->startListener) listeners->startListener(entry);
@@ -51,6 +51,7 @@ public:
     static void setGlobalTimeScale(float timeScale);
 
     virtual void update(float deltaTime) override;
+    virtual void parallelUpdate(float deltaTime) override;
 
     void setAnimationStateData(AnimationStateData *stateData);
     void setMix(const std::string &fromAnimation, const std::string &toAnimation, float duration);
@@ -94,6 +95,8 @@ public:
 protected:
     AnimationState *_state = nullptr;
     bool _ownsAnimationStateData = false;
+    // set by update, the world transform is then computed in parallelUpdate
+    bool _worldTransformDirty = false;
     StartListener _startListener = nullptr;
     InterruptListener _interruptListener = nullptr;
     EndListener _endListener = nullptr;
@@ -36,6 +36,10 @@ using namespace cc; // NOLINT(google-build-using-namespace)
 
 namespace spine {
 
+namespace {
+constexpr std::size_t VERTEX_FLOATS = sizeof(V3F_T2F_C4B_C4B) / sizeof(float);
+} // namespace
+
 float SkeletonCache::FrameTime = 1.0F / 60.0F;
 float SkeletonCache::MaxCacheTime = 120.0F;
 
@@ -113,6 +117,63 @@ std::size_t SkeletonCache::FrameData::getSegmentCount() const {
     return _segments.size();
 }
 
+void SkeletonCache::FrameData::compact(const FrameData *previous) {
+    _compact.encode(vb, VERTEX_FLOATS, ib, previous ? &previous->_compact : nullptr);
+    for (auto &bone : _bones) {
+        _compact.encodeBone(bone->globalTransformMatrix);
+    }
+    releaseDecoded();
+}
+
+void SkeletonCache::FrameData::decode() {
+    _compact.decode(vb, VERTEX_FLOATS, ib);
+    for (std::size_t i = 0, n = _compact.getBoneCount(); i < n; ++i) {
+        _compact.decodeBone(i, buildBoneData(i)->globalTransformMatrix);
+    }
+
+    // colors are constant over the vertex ranges recorded while baking
+    auto *vertices = reinterpret_cast<V3F_T2F_C4B_C4B *>(vb.getBuffer());
+    std::size_t vertexIndex = 0;
+    for (auto &colorData : _colors) {
+        const auto &color = colorData->finalColor;
+        const auto &darkColor = colorData->darkColor;
+        auto endIndex = std::min(static_cast<std::size_t>(colorData->vertexFloatOffset) / VERTEX_FLOATS, _compact.getVertexCount());
+        for (; vertexIndex < endIndex; ++vertexIndex) {
+            V3F_T2F_C4B_C4B *vertex = vertices + vertexIndex;
+            vertex->color.r = color.r / 255.0F;
+            vertex->color.g = color.g / 255.0F;
+            vertex->color.b = color.b / 255.0F;
+            vertex->color.a = color.a / 255.0F;
+            vertex->color2.r = darkColor.r / 255.0F;
+            vertex->color2.g = darkColor.g / 255.0F;
+            vertex->color2.b = darkColor.b / 255.0F;
+            vertex->color2.a = darkColor.a / 255.0F;
+        }
+    }
+    _decoded = true;
+}
+
+void SkeletonCache::FrameData::releaseDecoded() {
+    for (auto &bone : _bones) {
+        delete bone;
+    }
+    _bones.clear();
+    _bones.shrink_to_fit();
+    vb.release();
+    ib.release();
+    _decoded = false;
+}
+
+std::size_t SkeletonCache::FrameData::getMemorySize() const {
+    return sizeof(FrameData) + _compact.getMemorySize() +
+           _colors.size() * (sizeof(ColorData *) + sizeof(ColorData)) +
+           _segments.size() * (sizeof(SegmentData *) + sizeof(SegmentData));
+}
+
+std::size_t SkeletonCache::FrameData::getDecodedSize() const {
+    return vb.getCapacity() + ib.getCapacity() + _bones.size() * (sizeof(BoneData *) + sizeof(BoneData));
+}
+
 SkeletonCache::AnimationData::AnimationData() = default;
 
 SkeletonCache::AnimationData::~AnimationData() {
@@ -124,6 +185,8 @@ void SkeletonCache::AnimationData::reset() {
         delete frame;
     }
     _frames.clear();
+    _decodedFrames.clear();
+    clearMemorySize();
     _isComplete = false;
     _totalTime = 0.0F;
 }
@@ -143,11 +206,44 @@ SkeletonCache::FrameData *SkeletonCache::AnimationData::buildFrameData(std::size
     return _frames[frameIdx];
 }
 
-SkeletonCache::FrameData *SkeletonCache::AnimationData::getFrameData(std::size_t frameIdx) const {
+SkeletonCache::FrameData *SkeletonCache::AnimationData::getFrameData(std::size_t frameIdx) {
     if (frameIdx >= _frames.size()) {
         return nullptr;
     }
-    return _frames[frameIdx];
+    touch();
+    FrameData *frameData = _frames[frameIdx];
+    const uint64_t tick = getCurrentTick();
+    if (!frameData->_decoded) {
+        for (auto it = _decodedFrames.begin(); it != _decodedFrames.end() && _decodedFrames.size() >= MAX_DECODED_FRAMES;) {
+            FrameData *decoded = *it;
+            if (decoded->_usedTick == tick) {
+                ++it;
+                continue;
+            }
+            removeMemorySize(decoded->getDecodedSize());
+            decoded->releaseDecoded();
+            it = _decodedFrames.erase(it);
+        }
+        auto start = std::chrono::steady_clock::now();
+        frameData->decode();
+        addDecodeTime(std::chrono::steady_clock::now() - start);
+        _decodedFrames.push_back(frameData);
+        addMemorySize(frameData->getDecodedSize());
+    }
+    frameData->_usedTick = tick;
+    return frameData;
+}
+
+void SkeletonCache::AnimationData::compactLastFrame() {
+    if (_frames.empty()) return;
+    std::size_t count = _frames.size();
+    FrameData *frameData = _frames[count - 1];
+    frameData->compact(count > 1 ? _frames[count - 2] : nullptr);
+    addMemorySize(frameData->getMemorySize());
+}
+
+void SkeletonCache::AnimationData::evict() {
+    reset();
 }
 
 std::size_t SkeletonCache::AnimationData::getFrameCount() const {
@@ -219,6 +315,7 @@ void SkeletonCache::updateToFrame(const std::string &animationName, int toFrameI
     do {
         update(FrameTime);
         renderAnimationFrame(animationData);
+        animationData->compactLastFrame();
         animationData->_totalTime += FrameTime;
     } while (animationData->needUpdate(toFrameIdx));
 }
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "FrameCache.h"
 #include "IOBuffer.h"
 #include "SkeletonAnimation.h"
 #include "middleware-adapter.h"
@@ -98,19 +99,33 @@ public:
         std::vector<ColorData *> _colors;
         std::vector<SegmentData *> _segments;
 
+        // moves the baked buffers and bones into the compact storage
+        void compact(const FrameData *previous);
+        // restores the buffers and bones from the compact storage
+        void decode();
+        void releaseDecoded();
+        std::size_t getMemorySize() const;
+        std::size_t getDecodedSize() const;
+
+        cc::middleware::CompactFrame _compact;
+        bool _decoded = true;
+        // tick of the last display that fetched the frame
+        uint64_t _usedTick = 0;
+
     public:
         cc::middleware::IOBuffer ib;
         cc::middleware::IOBuffer vb;
     };
 
-    struct AnimationData {
+    struct AnimationData : public cc::middleware::CachedAnimation {
         friend class SkeletonCache;
 
         AnimationData();
         ~AnimationData();
         void reset();
 
-        FrameData *getFrameData(std::size_t frameIdx) const;
+        // decodes the frame if it is not decoded yet
+        FrameData *getFrameData(std::size_t frameIdx);
         std::size_t getFrameCount() const;
 
         bool isComplete() const { return _isComplete; }
@@ -119,12 +134,20 @@ public:
     private:
         // if frame is empty, it will build new one.
         FrameData *buildFrameData(std::size_t frameIdx);
+        // compacts the last baked frame against the one before it
+        void compactLastFrame();
+        void evict() override;
+
+        // decoded frames kept when no display used them this tick, frames used this tick are never released
+        // so the decoded set grows with the number of displays showing different frames
+        static constexpr std::size_t MAX_DECODED_FRAMES = 4;
 
     private:
         std::string _animationName = "";
         bool _isComplete = false;
         float _totalTime = 0.0f;
         std::vector<FrameData *> _frames;
+        std::vector<FrameData *> _decodedFrames;
     };
 
     SkeletonCache();
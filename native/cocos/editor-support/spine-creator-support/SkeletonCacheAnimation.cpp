@@ -123,6 +123,7 @@ void SkeletonCacheAnimation::update(float dt) {
 
     if (_accTime <= 0.00001 && _playCount == 0) {
         if (_startListener) {
+            MiddlewareManager::getInstance()->flushParallelUpdate();
             _startListener(_animationName);
         }
     }
@@ -144,6 +145,9 @@ void SkeletonCacheAnimation::update(float dt) {
         } else {
             frameIdx = 0;
         }
+        if (_endListener || _completeListener) {
+            MiddlewareManager::getInstance()->flushParallelUpdate();
+        }
         if (_endListener) {
             _endListener(_animationName);
         }
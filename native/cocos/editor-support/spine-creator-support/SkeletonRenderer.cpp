@@ -257,37 +257,45 @@ void SkeletonRenderer::initWithBinaryFile(const std::string &skeletonDataFile, c
     initialize();
 }
 
-void SkeletonRenderer::render(float /*deltaTime*/) {
-    if (!_skeleton) return;
-    auto *entity = _entity;
-    entity->clearDynamicRenderDrawInfos();
-    _sharedBufferOffset->reset();
-    _sharedBufferOffset->clear();
+uint32_t SkeletonRenderer::prepareRender() {
+    _verticesGenerated = false;
+    if (!_skeleton || !_entity) return 0;
 
-    // avoid other place call update.
-    auto *mgr = MiddlewareManager::getInstance();
-    if (!mgr->isRendering) return;
+    // the debug buffer is a typed array, it's created on the main thread
+    if ((_debugSlots || _debugBones || _debugMesh) && _debugBuffer == nullptr) {
+        _debugBuffer = new cc::middleware::IOTypedArray(se::Object::TypedArrayType::FLOAT32, MAX_DEBUG_BUFFER_SIZE);
+    }
 
-    auto *attachMgr = mgr->getAttachInfoMgr();
-    auto *attachInfo = attachMgr->getBuffer();
-    if (!attachInfo) return;
-    // store attach info offset
-    _sharedBufferOffset->writeUint32(static_cast<uint32_t>(attachInfo->getCurPos()) / sizeof(uint32_t));
+    if (_enableBatch) {
+        _nodeWorldMat = _entity->getNode()->getWorldMatrix();
+    }
+
+    // a vertex effect may be shared with other renderers, the vertices are generated in render then
+    if (_effectDelegate && _effectDelegate->getVertexEffect()) return 0;
+    return 1;
+}
+
+void SkeletonRenderer::parallelRender(uint32_t /*part*/) {
+    generateVertices();
+    _verticesGenerated = true;
+}
+
+void SkeletonRenderer::generateVertices() {
+    _vertexSegments.clear();
+    _vertexScratch.reset();
+    _indexScratch.reset();
 
     // If opacity is 0,then return.
     if (_skeleton->getColor().a == 0) {
         return;
     }
-    auto& nodeWorldMat = entity->getNode()->getWorldMatrix();
     // color range is [0.0, 1.0]
     cc::middleware::Color4F color;
     cc::middleware::Color4F darkColor;
     AttachmentVertices *attachmentVertices = nullptr;
     bool inRange = !(_startSlotIndex != -1 || _endSlotIndex != -1);
-    auto vertexFormat = _useTint ? VF_XYZUVCC : VF_XYZUVC;
-    cc::middleware::MeshBuffer *mb = mgr->getMeshBuffer(vertexFormat);
-    cc::middleware::IOBuffer &vb = mb->getVB();
-    cc::middleware::IOBuffer &ib = mb->getIB();
+    cc::middleware::IOBuffer &vb = _vertexScratch;
+    cc::middleware::IOBuffer &ib = _indexScratch;
 
     // vertex size int bytes with one color
     unsigned int vbs1 = sizeof(V3F_T2F_C4B);
@@ -305,73 +313,12 @@ void SkeletonRenderer::render(float /*deltaTime*/) {
 
     unsigned int vbSize = 0;
     unsigned int ibSize = 0;
-
-    int curBlendSrc = -1;
-    int curBlendDst = -1;
-    int curBlendMode = -1;
-    int preBlendMode = -1;
-    uint32_t curISegLen = 0;
-    cc::Texture2D* preTexture = nullptr;
-    cc::Texture2D* curTexture = nullptr;
-    RenderDrawInfo* curDrawInfo = nullptr;
-
-    int materialLen = 0;
     Slot *slot = nullptr;
-    int isFull = 0;
 
     if (_debugSlots || _debugBones || _debugMesh) {
-        // If enable debug draw,then init debug buffer.
-        if (_debugBuffer == nullptr) {
-            _debugBuffer = new cc::middleware::IOTypedArray(se::Object::TypedArrayType::FLOAT32, MAX_DEBUG_BUFFER_SIZE);
-        }
         _debugBuffer->reset();
     }
 
-    auto flush = [&]() {
-        // fill pre segment indices count field
-        if (curDrawInfo) {
-            curDrawInfo->setIbCount(curISegLen);
-        }
-        curDrawInfo = requestDrawInfo(materialLen);
-        entity->addDynamicRenderDrawInfo(curDrawInfo);
-        // prepare to fill new segment field
-        curBlendMode = slot->getData().getBlendMode();
-        switch (curBlendMode) {
-            case BlendMode_Additive:
-                curBlendSrc = static_cast<int>(_premultipliedAlpha ? BlendFactor::ONE : BlendFactor::SRC_ALPHA);
-                curBlendDst = static_cast<int>(BlendFactor::ONE);
-                break;
-            case BlendMode_Multiply:
-                curBlendSrc = static_cast<int>(BlendFactor::DST_COLOR);
-                curBlendDst = static_cast<int>(BlendFactor::ONE_MINUS_SRC_ALPHA);
-                break;
-            case BlendMode_Screen:
-                curBlendSrc = static_cast<int>(BlendFactor::ONE);
-                curBlendDst = static_cast<int>(BlendFactor::ONE_MINUS_SRC_COLOR);
-                break;
-            default:
-                curBlendSrc = static_cast<int>(_premultipliedAlpha ? BlendFactor::ONE : BlendFactor::SRC_ALPHA);
-                curBlendDst = static_cast<int>(BlendFactor::ONE_MINUS_SRC_ALPHA);
-        }
-        auto *material = requestMaterial(curBlendSrc, curBlendDst);
-        curDrawInfo->setMaterial(material);
-        gfx::Texture *texture = curTexture->getGFXTexture();
-        gfx::Sampler *sampler = curTexture->getGFXSampler();
-        curDrawInfo->setTexture(texture);
-        curDrawInfo->setSampler(sampler);
-        auto* uiMeshBuffer = mb->getUIMeshBuffer();
-        curDrawInfo->setMeshBuffer(uiMeshBuffer);
-        curDrawInfo->setIndexOffset(static_cast<uint32_t>(ib.getCurPos()) / sizeof(uint16_t));
-        // reset pre blend mode to current
-        preBlendMode = static_cast<int>(slot->getData().getBlendMode());
-        // reset pre texture index to current
-        preTexture = curTexture;
-        // reset index segmentation count
-        curISegLen = 0;
-        // material length increased
-        materialLen++;
-    };
-
     VertexEffect *effect = nullptr;
     if (_effectDelegate) {
         effect = _effectDelegate->getVertexEffect();
@@ -383,7 +330,6 @@ void SkeletonRenderer::render(float /*deltaTime*/) {
 
     auto &drawOrder = _skeleton->getDrawOrder();
     for (size_t i = 0, n = drawOrder.size(); i < n; ++i) {
-        isFull = 0;
         slot = drawOrder[i];
 
         if (slot->getBone().isActive() == false) {
@@ -430,7 +376,7 @@ void SkeletonRenderer::render(float /*deltaTime*/) {
             if (!_useTint) {
                 triangles.vertCount = attachmentVertices->_triangles->vertCount;
                 vbSize = triangles.vertCount * sizeof(V3F_T2F_C4B);
-                isFull |= vb.checkSpace(vbSize, true);
+                vb.checkSpace(vbSize, true);
                 triangles.verts = reinterpret_cast<V3F_T2F_C4B *>(vb.getCurBuffer());
                 memcpy(static_cast<void *>(triangles.verts), static_cast<void *>(attachmentVertices->_triangles->verts), vbSize);
                 attachment->computeWorldVertices(slot->getBone(), reinterpret_cast<float *>(triangles.verts), 0, vs1);
@@ -443,7 +389,7 @@ void SkeletonRenderer::render(float /*deltaTime*/) {
             } else {
                 trianglesTwoColor.vertCount = attachmentVertices->_triangles->vertCount;
                 vbSize = trianglesTwoColor.vertCount * sizeof(V3F_T2F_C4B_C4B);
-                isFull |= vb.checkSpace(vbSize, true);
+                vb.checkSpace(vbSize, true);
                 trianglesTwoColor.verts = reinterpret_cast<V3F_T2F_C4B_C4B *>(vb.getCurBuffer());
                 for (int ii = 0; ii < trianglesTwoColor.vertCount; ii++) {
                     trianglesTwoColor.verts[ii].texCoord = attachmentVertices->_triangles->verts[ii].texCoord;
@@ -487,7 +433,7 @@ void SkeletonRenderer::render(float /*deltaTime*/) {
             if (!_useTint) {
                 triangles.vertCount = attachmentVertices->_triangles->vertCount;
                 vbSize = triangles.vertCount * sizeof(V3F_T2F_C4B);
-                isFull |= vb.checkSpace(vbSize, true);
+                vb.checkSpace(vbSize, true);
                 triangles.verts = reinterpret_cast<V3F_T2F_C4B *>(vb.getCurBuffer());
                 memcpy(static_cast<void *>(triangles.verts), static_cast<void *>(attachmentVertices->_triangles->verts), vbSize);
                 attachment->computeWorldVertices(*slot, 0, attachment->getWorldVerticesLength(), reinterpret_cast<float *>(triangles.verts), 0, vs1);
@@ -500,7 +446,7 @@ void SkeletonRenderer::render(float /*deltaTime*/) {
             } else {
                 trianglesTwoColor.vertCount = attachmentVertices->_triangles->vertCount;
                 vbSize = trianglesTwoColor.vertCount * sizeof(V3F_T2F_C4B_C4B);
-                isFull |= vb.checkSpace(vbSize, true);
+                vb.checkSpace(vbSize, true);
                 trianglesTwoColor.verts = reinterpret_cast<V3F_T2F_C4B_C4B *>(vb.getCurBuffer());
                 for (int ii = 0; ii < trianglesTwoColor.vertCount; ii++) {
                     trianglesTwoColor.verts[ii].texCoord = attachmentVertices->_triangles->verts[ii].texCoord;
@@ -594,7 +540,7 @@ void SkeletonRenderer::render(float /*deltaTime*/) {
 
                 triangles.vertCount = static_cast<int>(_clipper->getClippedVertices().size()) >> 1;
                 vbSize = triangles.vertCount * sizeof(V3F_T2F_C4B);
-                isFull |= vb.checkSpace(vbSize, true);
+                vb.checkSpace(vbSize, true);
                 triangles.verts = reinterpret_cast<V3F_T2F_C4B *>(vb.getCurBuffer());
 
                 triangles.indexCount = static_cast<int>(_clipper->getClippedTriangles().size());
@@ -664,11 +610,12 @@ void SkeletonRenderer::render(float /*deltaTime*/) {
 
                 trianglesTwoColor.vertCount = static_cast<int>(_clipper->getClippedVertices().size()) >> 1;
                 vbSize = trianglesTwoColor.vertCount * sizeof(V3F_T2F_C4B_C4B);
-                isFull |= vb.checkSpace(vbSize, true);
+                vb.checkSpace(vbSize, true);
                 trianglesTwoColor.verts = reinterpret_cast<V3F_T2F_C4B_C4B *>(vb.getCurBuffer());
 
                 trianglesTwoColor.indexCount = static_cast<int>(_clipper->getClippedTriangles().size());
                 ibSize = trianglesTwoColor.indexCount * sizeof(uint16_t);
+                ib.checkSpace(ibSize, true);
                 trianglesTwoColor.indices = reinterpret_cast<uint16_t *>(ib.getCurBuffer());
                 memcpy(trianglesTwoColor.indices, _clipper->getClippedTriangles().buffer(), sizeof(uint16_t) * _clipper->getClippedTriangles().size());
 
@@ -715,33 +662,27 @@ void SkeletonRenderer::render(float /*deltaTime*/) {
             }
         }
 
-        curTexture = (cc::Texture2D*)attachmentVertices->_texture->getRealTexture();
-        // If texture or blendMode change,will change material.
-        if (preTexture != curTexture || preBlendMode != slot->getData().getBlendMode() || isFull) {
-            flush();
-        }
         if (_enableBatch) {
             uint8_t *vbBuffer = vb.getCurBuffer();
             cc::Vec3 *point = nullptr;
             for (unsigned int ii = 0, nn = vbSize; ii < nn; ii += vbs) {
                 point = reinterpret_cast<cc::Vec3 *>(vbBuffer + ii);
                 point->z = 0;
-                point->transformMat4(*point, nodeWorldMat);
+                point->transformMat4(*point, _nodeWorldMat);
             }
         }
-        auto vertexOffset = vb.getCurPos() / vbs;
         if (vbSize > 0 && ibSize > 0) {
-            if (vertexOffset > 0) {
-                auto *ibBuffer = reinterpret_cast<uint16_t *>(ib.getCurBuffer());
-                for (unsigned int ii = 0, nn = ibSize / sizeof(uint16_t); ii < nn; ii++) {
-                    ibBuffer[ii] += vertexOffset;
-                }
-            }
+            // indices stay relative to the slot, they are rebased when committed
+            VertexSegment segment;
+            segment.texture = attachmentVertices->_texture;
+            segment.blendMode = slot->getData().getBlendMode();
+            segment.vbOffset = static_cast<uint32_t>(vb.getCurPos());
+            segment.vbSize = vbSize;
+            segment.ibOffset = static_cast<uint32_t>(ib.getCurPos());
+            segment.ibSize = ibSize;
+            _vertexSegments.push_back(segment);
             vb.move(static_cast<int>(vbSize));
             ib.move(static_cast<int>(ibSize));
-
-            // Record this turn index segmentation count,it will store in material buffer in the end.
-            curISegLen += ibSize / sizeof(uint16_t);
         }
 
         _clipper->clipEnd(*slot);
@@ -751,40 +692,22 @@ void SkeletonRenderer::render(float /*deltaTime*/) {
 
     if (effect) effect->end();
 
-    if (curDrawInfo) curDrawInfo->setIbCount(curISegLen);
-
-    if (_useAttach || _debugBones) {
+    if (_debugBones) {
         auto &bones = _skeleton->getBones();
         size_t bonesCount = bones.size();
 
-        cc::Mat4 boneMat = cc::Mat4::IDENTITY;
-
-        if (_debugBones) {
-            _debugBuffer->writeFloat32(DebugType::BONES);
-            _debugBuffer->writeFloat32(static_cast<float>(bonesCount * 4));
-        }
+        _debugBuffer->writeFloat32(DebugType::BONES);
+        _debugBuffer->writeFloat32(static_cast<float>(bonesCount * 4));
 
         for (size_t i = 0, n = bonesCount; i < n; i++) {
             Bone *bone = bones[i];
-
-            boneMat.m[0] = bone->getA();
-            boneMat.m[1] = bone->getC();
-            boneMat.m[4] = bone->getB();
-            boneMat.m[5] = bone->getD();
-            boneMat.m[12] = bone->getWorldX();
-            boneMat.m[13] = bone->getWorldY();
-            attachInfo->checkSpace(sizeof(boneMat), true);
-            attachInfo->writeBytes(reinterpret_cast<const char *>(&boneMat), sizeof(boneMat));
-
-            if (_debugBones) {
-                float boneLength = bone->getData().getLength();
-                float x = boneLength * bone->getA() + bone->getWorldX();
-                float y = boneLength * bone->getC() + bone->getWorldY();
-                _debugBuffer->writeFloat32(bone->getWorldX());
-                _debugBuffer->writeFloat32(bone->getWorldY());
-                _debugBuffer->writeFloat32(x);
-                _debugBuffer->writeFloat32(y);
-            }
+            float boneLength = bone->getData().getLength();
+            float x = boneLength * bone->getA() + bone->getWorldX();
+            float y = boneLength * bone->getC() + bone->getWorldY();
+            _debugBuffer->writeFloat32(bone->getWorldX());
+            _debugBuffer->writeFloat32(bone->getWorldY());
+            _debugBuffer->writeFloat32(x);
+            _debugBuffer->writeFloat32(y);
         }
     }
 
@@ -799,6 +722,142 @@ void SkeletonRenderer::render(float /*deltaTime*/) {
     }
 }
 
+void SkeletonRenderer::render(float /*deltaTime*/) {
+    if (!_skeleton) return;
+    auto *entity = _entity;
+    entity->clearDynamicRenderDrawInfos();
+    _sharedBufferOffset->reset();
+    _sharedBufferOffset->clear();
+
+    // avoid other place call update.
+    auto *mgr = MiddlewareManager::getInstance();
+    if (!mgr->isRendering) return;
+
+    auto *attachMgr = mgr->getAttachInfoMgr();
+    auto *attachInfo = attachMgr->getBuffer();
+    if (!attachInfo) return;
+    // store attach info offset
+    _sharedBufferOffset->writeUint32(static_cast<uint32_t>(attachInfo->getCurPos()) / sizeof(uint32_t));
+
+    // If opacity is 0,then return.
+    if (_skeleton->getColor().a == 0) {
+        return;
+    }
+
+    if (!_verticesGenerated) {
+        prepareRender();
+        generateVertices();
+    }
+    _verticesGenerated = false;
+
+    auto vertexFormat = _useTint ? VF_XYZUVCC : VF_XYZUVC;
+    cc::middleware::MeshBuffer *mb = mgr->getMeshBuffer(vertexFormat);
+    cc::middleware::IOBuffer &vb = mb->getVB();
+    cc::middleware::IOBuffer &ib = mb->getIB();
+    unsigned int vbs = _useTint ? sizeof(V3F_T2F_C4B_C4B) : sizeof(V3F_T2F_C4B);
+
+    int curBlendSrc = -1;
+    int curBlendDst = -1;
+    int preBlendMode = -1;
+    uint32_t curISegLen = 0;
+    cc::Texture2D* preTexture = nullptr;
+    cc::Texture2D* curTexture = nullptr;
+    RenderDrawInfo* curDrawInfo = nullptr;
+    BlendMode curBlendMode = BlendMode_Normal;
+
+    int materialLen = 0;
+
+    auto flush = [&]() {
+        // fill pre segment indices count field
+        if (curDrawInfo) {
+            curDrawInfo->setIbCount(curISegLen);
+        }
+        curDrawInfo = requestDrawInfo(materialLen);
+        entity->addDynamicRenderDrawInfo(curDrawInfo);
+        // prepare to fill new segment field
+        switch (curBlendMode) {
+            case BlendMode_Additive:
+                curBlendSrc = static_cast<int>(_premultipliedAlpha ? BlendFactor::ONE : BlendFactor::SRC_ALPHA);
+                curBlendDst = static_cast<int>(BlendFactor::ONE);
+                break;
+            case BlendMode_Multiply:
+                curBlendSrc = static_cast<int>(BlendFactor::DST_COLOR);
+                curBlendDst = static_cast<int>(BlendFactor::ONE_MINUS_SRC_ALPHA);
+                break;
+            case BlendMode_Screen:
+                curBlendSrc = static_cast<int>(BlendFactor::ONE);
+                curBlendDst = static_cast<int>(BlendFactor::ONE_MINUS_SRC_COLOR);
+                break;
+            default:
+                curBlendSrc = static_cast<int>(_premultipliedAlpha ? BlendFactor::ONE : BlendFactor::SRC_ALPHA);
+                curBlendDst = static_cast<int>(BlendFactor::ONE_MINUS_SRC_ALPHA);
+        }
+        auto *material = requestMaterial(curBlendSrc, curBlendDst);
+        curDrawInfo->setMaterial(material);
+        gfx::Texture *texture = curTexture->getGFXTexture();
+        gfx::Sampler *sampler = curTexture->getGFXSampler();
+        curDrawInfo->setTexture(texture);
+        curDrawInfo->setSampler(sampler);
+        auto* uiMeshBuffer = mb->getUIMeshBuffer();
+        curDrawInfo->setMeshBuffer(uiMeshBuffer);
+        curDrawInfo->setIndexOffset(static_cast<uint32_t>(ib.getCurPos()) / sizeof(uint16_t));
+        // reset pre blend mode to current
+        preBlendMode = static_cast<int>(curBlendMode);
+        // reset pre texture index to current
+        preTexture = curTexture;
+        // reset index segmentation count
+        curISegLen = 0;
+        // material length increased
+        materialLen++;
+    };
+
+    // copy the generated slots into the shared buffer, a slot never straddles two buffers
+    for (const auto &segment : _vertexSegments) {
+        int isFull = vb.checkSpace(segment.vbSize, true);
+        ib.checkSpace(segment.ibSize, true);
+
+        curTexture = static_cast<cc::Texture2D *>(segment.texture->getRealTexture());
+        curBlendMode = segment.blendMode;
+        // If texture or blendMode change,will change material.
+        if (preTexture != curTexture || preBlendMode != static_cast<int>(curBlendMode) || isFull) {
+            flush();
+        }
+
+        memcpy(vb.getCurBuffer(), _vertexScratch.getBuffer() + segment.vbOffset, segment.vbSize);
+        auto vertexOffset = vb.getCurPos() / vbs;
+        const auto *indices = reinterpret_cast<const uint16_t *>(_indexScratch.getBuffer() + segment.ibOffset);
+        auto *ibBuffer = reinterpret_cast<uint16_t *>(ib.getCurBuffer());
+        for (unsigned int ii = 0, nn = segment.ibSize / sizeof(uint16_t); ii < nn; ii++) {
+            ibBuffer[ii] = static_cast<uint16_t>(indices[ii] + vertexOffset);
+        }
+        vb.move(static_cast<int>(segment.vbSize));
+        ib.move(static_cast<int>(segment.ibSize));
+
+        // Record this turn index segmentation count,it will store in material buffer in the end.
+        curISegLen += segment.ibSize / sizeof(uint16_t);
+    }
+
+    if (curDrawInfo) curDrawInfo->setIbCount(curISegLen);
+
+    if (_useAttach || _debugBones) {
+        auto &bones = _skeleton->getBones();
+        cc::Mat4 boneMat = cc::Mat4::IDENTITY;
+
+        for (size_t i = 0, n = bones.size(); i < n; i++) {
+            Bone *bone = bones[i];
+
+            boneMat.m[0] = bone->getA();
+            boneMat.m[1] = bone->getC();
+            boneMat.m[4] = bone->getB();
+            boneMat.m[5] = bone->getD();
+            boneMat.m[12] = bone->getWorldX();
+            boneMat.m[13] = bone->getWorldY();
+            attachInfo->checkSpace(sizeof(boneMat), true);
+            attachInfo->writeBytes(reinterpret_cast<const char *>(&boneMat), sizeof(boneMat));
+        }
+    }
+}
+
 cc::Rect SkeletonRenderer::getBoundingBox() const {
     static cc::middleware::IOBuffer buffer(1024);
     float *worldVertices = nullptr;
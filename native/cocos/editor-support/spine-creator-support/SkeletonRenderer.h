@@ -36,6 +36,7 @@
 #include "base/Macros.h"
 #include "base/RefCounted.h"
 #include "base/RefMap.h"
+#include "math/Mat4.h"
 #include "middleware-adapter.h"
 #include "spine-creator-support/VertexEffectDelegate.h"
 #include "spine/spine.h"
@@ -60,6 +61,12 @@ public:
     static SkeletonRenderer *createWithFile(const std::string &skeletonDataFile, const std::string &atlasFile, float scale = 1);
 
     void update(float deltaTime) override {}
+    uint32_t prepareRender() override;
+    /**
+     * Generates the vertices of the skeleton into the scratch buffers of this renderer,
+     * render copies them into the shared mesh buffer.
+     */
+    void parallelRender(uint32_t part) override;
     void render(float deltaTime) override;
     virtual cc::Rect getBoundingBox() const;
 
@@ -152,7 +159,18 @@ public:
     void setRenderEntity(cc::RenderEntity* entity);
 
 protected:
+    // the vertices and indices of one slot in the scratch buffers, indices start at 0
+    struct VertexSegment {
+        cc::middleware::Texture2D *texture = nullptr;
+        BlendMode blendMode = BlendMode_Normal;
+        uint32_t vbOffset = 0;
+        uint32_t vbSize = 0;
+        uint32_t ibOffset = 0;
+        uint32_t ibSize = 0;
+    };
+
     void setSkeletonData(SkeletonData *skeletonData, bool ownsSkeletonData);
+    void generateVertices();
 
     bool _ownsSkeletonData = false;
     bool _ownsSkeleton = false;
@@ -185,6 +203,12 @@ protected:
     cc::Material *_material = nullptr;
     ccstd::vector<cc::RenderDrawInfo *> _drawInfoArray;
     ccstd::unordered_map<uint32_t, cc::Material*> _materialCaches;
+
+    cc::Mat4 _nodeWorldMat;
+    cc::middleware::IOBuffer _vertexScratch{MIN_TYPE_ARRAY_SIZE};
+    cc::middleware::IOBuffer _indexScratch{MIN_TYPE_ARRAY_SIZE};
+    ccstd::vector<VertexSegment> _vertexSegments;
+    bool _verticesGenerated = false;
 };
 
 } // namespace spine
@@ -35,6 +35,7 @@
 #include "engine/EngineEvents.h"
 #include "platform/BasePlatform.h"
 #include "platform/FileUtils.h"
+#include "platform/ImageDecoder.h"
 #include "renderer/GFXDeviceManager.h"
 #include "renderer/core/ProgramLib.h"
 #include "renderer/pipeline/RenderPipeline.h"
@@ -143,6 +144,7 @@ int32_t Engine::init() {
 void Engine::destroy() {
     cc::DeferredReleasePool::clear();
     cc::network::HttpClient::destroyInstance();
+    ImageDecoder::destroyInstance();
     _scheduler->removeAllFunctionsToBePerformedInCocosThread();
     _scheduler->unscheduleAll();
     CCObject::deferredDestroy();
@@ -276,6 +278,7 @@ void Engine::tick() {
         prevTime = std::chrono::steady_clock::now();
 
         _scheduler->update(dt);
+        ImageDecoder::getInstance()->flush();
 
         se::ScriptEngine::getInstance()->handlePromiseExceptions();
         events::Tick::broadcast(dt);
@@ -426,11 +426,7 @@ void Mat4::add(float scalar) {
 
 void Mat4::add(float scalar, Mat4 *dst) {
     CC_ASSERT(dst);
-#ifdef __SSE__
-    MathUtil::addMatrix(col, scalar, dst->col);
-#else
     MathUtil::addMatrix(m, scalar, dst->m);
-#endif
 }
 
 void Mat4::add(const Mat4 &mat) {
@@ -439,11 +435,7 @@ void Mat4::add(const Mat4 &mat) {
 
 void Mat4::add(const Mat4 &m1, const Mat4 &m2, Mat4 *dst) {
     CC_ASSERT(dst);
-#ifdef __SSE__
-    MathUtil::addMatrix(m1.col, m2.col, dst->col);
-#else
     MathUtil::addMatrix(m1.m, m2.m, dst->m);
-#endif
 }
 
 void Mat4::fromRT(const Quaternion &rotation, const Vec3 &translation, Mat4 *dst) {
@@ -523,6 +515,11 @@ void Mat4::fromRTS(const Quaternion &rotation, const Vec3 &translation, const Ve
     dst->m[15] = 1;
 }
 
+void Mat4::fromRTSBatch(const Quaternion *rotations, const Vec3 *translations, const Vec3 *scales, Mat4 *dst, uint32_t count) {
+    static_assert(sizeof(Quaternion) == 4 * sizeof(float) && sizeof(Vec3) == 3 * sizeof(float), "packed layout is required");
+    MathUtil::composeMatrices(&rotations->x, &translations->x, &scales->x, dst->m, count);
+}
+
 void Mat4::toRTS(const Mat4 &src, Quaternion *rotation, Vec3 *translation, Vec3 *scale) {
     src.decompose(scale, rotation, translation);
 }
@@ -840,11 +837,7 @@ void Mat4::multiply(float scalar, Mat4 *dst) const {
 
 void Mat4::multiply(const Mat4 &m, float scalar, Mat4 *dst) {
     CC_ASSERT(dst);
-#ifdef __SSE__
-    MathUtil::multiplyMatrix(m.col, scalar, dst->col);
-#else
     MathUtil::multiplyMatrix(m.m, scalar, dst->m);
-#endif
 }
 
 void Mat4::multiply(const Mat4 &mat) {
@@ -853,19 +846,16 @@ void Mat4::multiply(const Mat4 &mat) {
 
 void Mat4::multiply(const Mat4 &m1, const Mat4 &m2, Mat4 *dst) {
     CC_ASSERT(dst);
-#ifdef __SSE__
-    MathUtil::multiplyMatrix(m1.col, m2.col, dst->col);
-#else
     MathUtil::multiplyMatrix(m1.m, m2.m, dst->m);
-#endif
+}
+
+void Mat4::multiplyBatch(const Mat4 *m1, const Mat4 *m2, Mat4 *dst, uint32_t count) {
+    static_assert(sizeof(Mat4) == 16 * sizeof(float), "packed layout is required");
+    MathUtil::multiplyMatrices(m1->m, m2->m, dst->m, count);
 }
 
 void Mat4::negate() {
-#ifdef __SSE__
-    MathUtil::negateMatrix(col, col);
-#else
     MathUtil::negateMatrix(m, m);
-#endif
 }
 
 Mat4 Mat4::getNegated() const {
@@ -993,11 +983,7 @@ void Mat4::subtract(const Mat4 &mat) {
 
 void Mat4::subtract(const Mat4 &m1, const Mat4 &m2, Mat4 *dst) {
     CC_ASSERT(dst);
-#ifdef __SSE__
-    MathUtil::subtractMatrix(m1.col, m2.col, dst->col);
-#else
     MathUtil::subtractMatrix(m1.m, m2.m, dst->m);
-#endif
 }
 
 void Mat4::transformVector(Vec4 *vector) const {
@@ -1007,11 +993,7 @@ void Mat4::transformVector(Vec4 *vector) const {
 
 void Mat4::transformVector(const Vec4 &vector, Vec4 *dst) const {
     CC_ASSERT(dst);
-#ifdef __SSE__
-    MathUtil::transformVec4(col, vector.v, dst->v);
-#else
     MathUtil::transformVec4(m, reinterpret_cast<const float *>(&vector), reinterpret_cast<float *>(dst));
-#endif
 }
 
 void Mat4::translate(float x, float y, float z) {
@@ -1033,11 +1015,7 @@ void Mat4::translate(const Vec3 &t, Mat4 *dst) const {
 }
 
 void Mat4::transpose() {
-#ifdef __SSE__
-    MathUtil::transposeMatrix(col, col);
-#else
     MathUtil::transposeMatrix(m, m);
-#endif
 }
 
 Mat4 Mat4::getTransposed() const {
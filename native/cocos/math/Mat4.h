@@ -27,11 +27,6 @@
 #include "math/Vec3.h"
 #include "math/Vec4.h"
 
-#undef __SSE__
-#ifdef __SSE__
-    #include <xmmintrin.h>
-#endif
-
 /**
  * @addtogroup base
  * @{
@@ -89,14 +84,7 @@ public:
     /**
      * Stores the columns of this 4x4 matrix.
      * */
-#ifdef __SSE__
-    union {
-        __m128 col[4];
-        float m[16];
-    };
-#else
     float m[16];
-#endif
 
     /**
      * Default constructor.
@@ -413,6 +401,17 @@ public:
      */
     static void fromRTS(const Quaternion &rotation, const Vec3 &translation, const Vec3 &scale, Mat4 *dst);
 
+    /**
+     * Compose count matrices from scale, rotation and translation arrays, same as calling fromRTS for each element.
+     *
+     * @param rotations The rotation array.
+     * @param translations The translation array.
+     * @param scales The scale array.
+     * @param dst The matrix array to store the results in.
+     * @param count The number of matrices.
+     */
+    static void fromRTSBatch(const Quaternion *rotations, const Vec3 *translations, const Vec3 *scales, Mat4 *dst, uint32_t count);
+
     /**
      *  Decomposes the scale, rotation and translation components of this matrix.
      */
@@ -570,6 +569,17 @@ public:
      */
     static void multiply(const Mat4 &m1, const Mat4 &m2, Mat4 *dst);
 
+    /**
+     * Multiplies count pairs of matrices, dst[i] = m1[i] * m2[i].
+     * dst may be the same array as m1 or m2.
+     *
+     * @param m1 The first matrix array to multiply.
+     * @param m2 The second matrix array to multiply.
+     * @param dst The matrix array to store the results in.
+     * @param count The number of matrices.
+     */
+    static void multiplyBatch(const Mat4 *m1, const Mat4 *m2, Mat4 *dst, uint32_t count);
+
     /**
      * Negates this matrix.
      */
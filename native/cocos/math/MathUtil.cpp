@@ -48,24 +48,33 @@ This file was modified to fit the cocos2d-x project
     #endif
 #endif
 
-#if defined(__SSE__)
-    #define USE_SSE
-    #define INCLUDE_SSE
+#if !defined(USE_NEON64) && !defined(INCLUDE_NEON32)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define USE_SSE
+        #define INCLUDE_SSE
+    #endif
 #endif
 
+#include <cmath>
+#include <cstring>
+#include "math/MathUtil.inl"
+
 #ifdef INCLUDE_NEON32
     #include "math/MathUtilNeon.inl"
 #endif
 
 #ifdef INCLUDE_NEON64
+    #include <arm_neon.h>
     #include "math/MathUtilNeon64.inl"
 #endif
 
 #ifdef INCLUDE_SSE
+    #include <emmintrin.h>
+    #ifdef __AVX__
+        #include <immintrin.h>
+    #endif
     #include "math/MathUtilSSE.inl"
 #endif
-#include <cstring>
-#include "math/MathUtil.inl"
 
 NS_CC_MATH_BEGIN
 
@@ -130,6 +139,8 @@ void MathUtil::addMatrix(const float *m, float scalar, float *dst) {
     } else {
         MathUtilC::addMatrix(m, scalar, dst);
     }
+#elif defined(USE_SSE)
+    MathUtilSSE::addMatrix(m, scalar, dst);
 #else
     MathUtilC::addMatrix(m, scalar, dst);
 #endif
@@ -146,6 +157,8 @@ void MathUtil::addMatrix(const float *m1, const float *m2, float *dst) {
     } else {
         MathUtilC::addMatrix(m1, m2, dst);
     }
+#elif defined(USE_SSE)
+    MathUtilSSE::addMatrix(m1, m2, dst);
 #else
     MathUtilC::addMatrix(m1, m2, dst);
 #endif
@@ -162,6 +175,8 @@ void MathUtil::subtractMatrix(const float *m1, const float *m2, float *dst) {
     } else {
         MathUtilC::subtractMatrix(m1, m2, dst);
     }
+#elif defined(USE_SSE)
+    MathUtilSSE::subtractMatrix(m1, m2, dst);
 #else
     MathUtilC::subtractMatrix(m1, m2, dst);
 #endif
@@ -178,6 +193,8 @@ void MathUtil::multiplyMatrix(const float *m, float scalar, float *dst) {
     } else {
         MathUtilC::multiplyMatrix(m, scalar, dst);
     }
+#elif defined(USE_SSE)
+    MathUtilSSE::multiplyMatrix(m, scalar, dst);
 #else
     MathUtilC::multiplyMatrix(m, scalar, dst);
 #endif
@@ -194,6 +211,8 @@ void MathUtil::multiplyMatrix(const float *m1, const float *m2, float *dst) {
     } else {
         MathUtilC::multiplyMatrix(m1, m2, dst);
     }
+#elif defined(USE_SSE)
+    MathUtilSSE::multiplyMatrix(m1, m2, dst);
 #else
     MathUtilC::multiplyMatrix(m1, m2, dst);
 #endif
@@ -210,6 +229,8 @@ void MathUtil::negateMatrix(const float *m, float *dst) {
     } else {
         MathUtilC::negateMatrix(m, dst);
     }
+#elif defined(USE_SSE)
+    MathUtilSSE::negateMatrix(m, dst);
 #else
     MathUtilC::negateMatrix(m, dst);
 #endif
@@ -226,6 +247,8 @@ void MathUtil::transposeMatrix(const float *m, float *dst) {
     } else {
         MathUtilC::transposeMatrix(m, dst);
     }
+#elif defined(USE_SSE)
+    MathUtilSSE::transposeMatrix(m, dst);
 #else
     MathUtilC::transposeMatrix(m, dst);
 #endif
@@ -242,6 +265,8 @@ void MathUtil::transformVec4(const float *m, float x, float y, float z, float w,
     } else {
         MathUtilC::transformVec4(m, x, y, z, w, dst);
     }
+#elif defined(USE_SSE)
+    MathUtilSSE::transformVec4(m, x, y, z, w, dst);
 #else
     MathUtilC::transformVec4(m, x, y, z, w, dst);
 #endif
@@ -258,6 +283,8 @@ void MathUtil::transformVec4(const float *m, const float *v, float *dst) {
     } else {
         MathUtilC::transformVec4(m, v, dst);
     }
+#elif defined(USE_SSE)
+    MathUtilSSE::transformVec4(m, v, dst);
 #else
     MathUtilC::transformVec4(m, v, dst);
 #endif
@@ -283,4 +310,56 @@ void MathUtil::combineHash(size_t &seed, const size_t &v) {
     seed ^= v + 0x9e3779b9 + (seed << 6) + (seed >> 2);
 }
 
+void MathUtil::multiplyMatrices(const float *m1, const float *m2, float *dst, uint32_t count) {
+#ifdef USE_NEON32
+    for (uint32_t i = 0; i < count; ++i) {
+        MathUtilNeon::multiplyMatrix(m1 + i * 16, m2 + i * 16, dst + i * 16);
+    }
+#elif defined(USE_NEON64)
+    MathUtilNeon64::multiplyMatrices(m1, m2, dst, count);
+#elif defined(INCLUDE_NEON32)
+    if (isNeon32Enabled()) {
+        for (uint32_t i = 0; i < count; ++i) {
+            MathUtilNeon::multiplyMatrix(m1 + i * 16, m2 + i * 16, dst + i * 16);
+        }
+    } else {
+        MathUtilC::multiplyMatrices(m1, m2, dst, count);
+    }
+#elif defined(USE_SSE)
+    MathUtilSSE::multiplyMatrices(m1, m2, dst, count);
+#else
+    MathUtilC::multiplyMatrices(m1, m2, dst, count);
+#endif
+}
+
+void MathUtil::transformPoints(const float *m, const float *src, float *dst, uint32_t count) {
+#if defined(USE_NEON64)
+    MathUtilNeon64::transformPoints(m, src, dst, count);
+#elif defined(USE_SSE)
+    MathUtilSSE::transformPoints(m, src, dst, count);
+#else
+    MathUtilC::transformPoints(m, src, dst, count);
+#endif
+}
+
+void MathUtil::composeMatrices(const float *rotations, const float *translations, const float *scales, float *dst, uint32_t count) {
+#if defined(USE_NEON64)
+    MathUtilNeon64::composeMatrices(rotations, translations, scales, dst, count);
+#elif defined(USE_SSE)
+    MathUtilSSE::composeMatrices(rotations, translations, scales, dst, count);
+#else
+    MathUtilC::composeMatrices(rotations, translations, scales, dst, count);
+#endif
+}
+
+void MathUtil::multiplyQuaternions(const float *q1, const float *q2, float *dst, uint32_t count) {
+#if defined(USE_NEON64)
+    MathUtilNeon64::multiplyQuaternions(q1, q2, dst, count);
+#elif defined(USE_SSE)
+    MathUtilSSE::multiplyQuaternions(q1, q2, dst, count);
+#else
+    MathUtilC::multiplyQuaternions(q1, q2, dst, count);
+#endif
+}
+
 NS_CC_MATH_END
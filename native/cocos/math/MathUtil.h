@@ -23,10 +23,6 @@
 #ifndef MATHUTIL_H_
 #define MATHUTIL_H_
 
-#ifdef __SSE__
-    #include <xmmintrin.h>
-#endif
-
 #include "math/MathBase.h"
 
 /**
@@ -44,6 +40,7 @@ NS_CC_MATH_BEGIN
 class CC_DLL MathUtil {
     friend class Mat4;
     friend class Vec3;
+    friend class Quaternion;
 
 public:
     /**
@@ -101,23 +98,6 @@ private:
     static bool isNeon64Enabled();
 
 private:
-#ifdef __SSE__
-    static void addMatrix(const __m128 m[4], float scalar, __m128 dst[4]);
-
-    static void addMatrix(const __m128 m1[4], const __m128 m2[4], __m128 dst[4]);
-
-    static void subtractMatrix(const __m128 m1[4], const __m128 m2[4], __m128 dst[4]);
-
-    static void multiplyMatrix(const __m128 m[4], float scalar, __m128 dst[4]);
-
-    static void multiplyMatrix(const __m128 m1[4], const __m128 m2[4], __m128 dst[4]);
-
-    static void negateMatrix(const __m128 m[4], __m128 dst[4]);
-
-    static void transposeMatrix(const __m128 m[4], __m128 dst[4]);
-
-    static void transformVec4(const __m128 m[4], const __m128 &v, __m128 &dst);
-#endif
     static void addMatrix(const float *m, float scalar, float *dst);
 
     static void addMatrix(const float *m1, const float *m2, float *dst);
@@ -137,6 +117,21 @@ private:
     static void transformVec4(const float *m, const float *v, float *dst);
 
     static void crossVec3(const float *v1, const float *v2, float *dst);
+
+    // The batch helpers below run SIMD kernels over groups of four elements where available
+    // and hand the remaining count % 4 elements to the scalar MathUtilC path.
+
+    // dst[i] = m1[i] * m2[i], dst may alias m1 or m2
+    static void multiplyMatrices(const float *m1, const float *m2, float *dst, uint32_t count);
+
+    // transform packed xyz points by m, with perspective division like Vec3::transformMat4
+    static void transformPoints(const float *m, const float *src, float *dst, uint32_t count);
+
+    // compose matrices from packed xyzw rotations, xyz translations and xyz scales like Mat4::fromRTS
+    static void composeMatrices(const float *rotations, const float *translations, const float *scales, float *dst, uint32_t count);
+
+    // dst[i] = q1[i] * q2[i] for packed xyzw quaternions like Quaternion::multiply, dst may alias q1 or q2
+    static void multiplyQuaternions(const float *q1, const float *q2, float *dst, uint32_t count);
 };
 
 NS_CC_MATH_END
@@ -42,6 +42,14 @@ public:
     inline static void transformVec4(const float* m, const float* v, float* dst);
     
     inline static void crossVec3(const float* v1, const float* v2, float* dst);
+
+    inline static void multiplyMatrices(const float* m1, const float* m2, float* dst, uint32_t count);
+
+    inline static void transformPoints(const float* m, const float* src, float* dst, uint32_t count);
+
+    inline static void composeMatrices(const float* rotations, const float* translations, const float* scales, float* dst, uint32_t count);
+
+    inline static void multiplyQuaternions(const float* q1, const float* q2, float* dst, uint32_t count);
 };
 
 inline void MathUtilC::addMatrix(const float* m, float scalar, float* dst)
@@ -215,4 +223,81 @@ inline void MathUtilC::crossVec3(const float* v1, const float* v2, float* dst)
     dst[2] = z;
 }
 
+inline void MathUtilC::multiplyMatrices(const float* m1, const float* m2, float* dst, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i, m1 += 16, m2 += 16, dst += 16)
+    {
+        multiplyMatrix(m1, m2, dst);
+    }
+}
+
+inline void MathUtilC::transformPoints(const float* m, const float* src, float* dst, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i, src += 3, dst += 3)
+    {
+        float tmp[4] = {src[0], src[1], src[2], 1.0F};
+        transformVec4(m, tmp, tmp);
+        const float rhw = std::fabs(tmp[3]) > 0.000001F ? 1.0F / tmp[3] : 1.0F;
+        dst[0] = tmp[0] * rhw;
+        dst[1] = tmp[1] * rhw;
+        dst[2] = tmp[2] * rhw;
+    }
+}
+
+inline void MathUtilC::composeMatrices(const float* rotations, const float* translations, const float* scales, float* dst, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i, rotations += 4, translations += 3, scales += 3, dst += 16)
+    {
+        const float x = rotations[0];
+        const float y = rotations[1];
+        const float z = rotations[2];
+        const float w = rotations[3];
+        const float x2 = x + x;
+        const float y2 = y + y;
+        const float z2 = z + z;
+
+        const float xx = x * x2;
+        const float xy = x * y2;
+        const float xz = x * z2;
+        const float yy = y * y2;
+        const float yz = y * z2;
+        const float zz = z * z2;
+        const float wx = w * x2;
+        const float wy = w * y2;
+        const float wz = w * z2;
+
+        dst[0] = (1 - (yy + zz)) * scales[0];
+        dst[1] = (xy + wz) * scales[0];
+        dst[2] = (xz - wy) * scales[0];
+        dst[3] = 0;
+        dst[4] = (xy - wz) * scales[1];
+        dst[5] = (1 - (xx + zz)) * scales[1];
+        dst[6] = (yz + wx) * scales[1];
+        dst[7] = 0;
+        dst[8] = (xz + wy) * scales[2];
+        dst[9] = (yz - wx) * scales[2];
+        dst[10] = (1 - (xx + yy)) * scales[2];
+        dst[11] = 0;
+        dst[12] = translations[0];
+        dst[13] = translations[1];
+        dst[14] = translations[2];
+        dst[15] = 1;
+    }
+}
+
+inline void MathUtilC::multiplyQuaternions(const float* q1, const float* q2, float* dst, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i, q1 += 4, q2 += 4, dst += 4)
+    {
+        const float x = q1[3] * q2[0] + q1[0] * q2[3] + q1[1] * q2[2] - q1[2] * q2[1];
+        const float y = q1[3] * q2[1] - q1[0] * q2[2] + q1[1] * q2[3] + q1[2] * q2[0];
+        const float z = q1[3] * q2[2] + q1[0] * q2[1] - q1[1] * q2[0] + q1[2] * q2[3];
+        const float w = q1[3] * q2[3] - q1[0] * q2[0] - q1[1] * q2[1] - q1[2] * q2[2];
+        dst[0] = x;
+        dst[1] = y;
+        dst[2] = z;
+        dst[3] = w;
+    }
+}
+
 NS_CC_MATH_END
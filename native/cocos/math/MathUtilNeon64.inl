@@ -42,6 +42,14 @@ public:
     inline static void transformVec4(const float* m, const float* v, float* dst);
     
     inline static void crossVec3(const float* v1, const float* v2, float* dst);
+
+    inline static void multiplyMatrices(const float* m1, const float* m2, float* dst, uint32_t count);
+
+    inline static void transformPoints(const float* m, const float* src, float* dst, uint32_t count);
+
+    inline static void composeMatrices(const float* rotations, const float* translations, const float* scales, float* dst, uint32_t count);
+
+    inline static void multiplyQuaternions(const float* q1, const float* q2, float* dst, uint32_t count);
 };
 
 inline void MathUtilNeon64::addMatrix(const float* m, float scalar, float* dst)
@@ -260,4 +268,129 @@ inline void MathUtilNeon64::crossVec3(const float* v1, const float* v2, float* d
     );
 }
 
+// The batch kernels use intrinsics instead of inline assembly, vld3q/vld4q do the AoS to SoA conversion.
+inline void MathUtilNeon64::multiplyMatrices(const float* m1, const float* m2, float* dst, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i, m1 += 16, m2 += 16, dst += 16)
+    {
+        const float32x4_t a[4] = {vld1q_f32(m1), vld1q_f32(m1 + 4), vld1q_f32(m1 + 8), vld1q_f32(m1 + 12)};
+        const float32x4_t b[4] = {vld1q_f32(m2), vld1q_f32(m2 + 4), vld1q_f32(m2 + 8), vld1q_f32(m2 + 12)};
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            float32x4_t r = vmulq_laneq_f32(a[0], b[c], 0);
+            r = vfmaq_laneq_f32(r, a[1], b[c], 1);
+            r = vfmaq_laneq_f32(r, a[2], b[c], 2);
+            r = vfmaq_laneq_f32(r, a[3], b[c], 3);
+            vst1q_f32(dst + c * 4, r);
+        }
+    }
+}
+
+inline void MathUtilNeon64::transformPoints(const float* m, const float* src, float* dst, uint32_t count)
+{
+    const uint32_t simdCount = count & ~3U;
+    const float32x4_t one = vdupq_n_f32(1.0F);
+    const float32x4_t precision = vdupq_n_f32(0.000001F);
+    for (uint32_t i = 0; i < simdCount; i += 4, src += 12, dst += 12)
+    {
+        const float32x4x3_t p = vld3q_f32(src);
+        float32x4_t r[4];
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            r[c] = vfmaq_n_f32(vfmaq_n_f32(vfmaq_n_f32(vdupq_n_f32(m[12 + c]), p.val[0], m[c]), p.val[1], m[4 + c]), p.val[2], m[8 + c]);
+        }
+        // rhw = |w| > precision ? 1 / w : 1
+        const uint32x4_t valid = vcagtq_f32(r[3], precision);
+        const float32x4_t rhw = vbslq_f32(valid, vdivq_f32(one, r[3]), one);
+        float32x4x3_t out;
+        out.val[0] = vmulq_f32(r[0], rhw);
+        out.val[1] = vmulq_f32(r[1], rhw);
+        out.val[2] = vmulq_f32(r[2], rhw);
+        vst3q_f32(dst, out);
+    }
+
+    MathUtilC::transformPoints(m, src, dst, count - simdCount);
+}
+
+inline void MathUtilNeon64::composeMatrices(const float* rotations, const float* translations, const float* scales, float* dst, uint32_t count)
+{
+    const uint32_t simdCount = count & ~3U;
+    const float32x4_t one = vdupq_n_f32(1.0F);
+    const float32x4_t zero = vdupq_n_f32(0.0F);
+    for (uint32_t i = 0; i < simdCount; i += 4, rotations += 16, translations += 12, scales += 12, dst += 64)
+    {
+        const float32x4x4_t q = vld4q_f32(rotations);
+        const float32x4x3_t t = vld3q_f32(translations);
+        const float32x4x3_t s = vld3q_f32(scales);
+
+        const float32x4_t x2 = vaddq_f32(q.val[0], q.val[0]);
+        const float32x4_t y2 = vaddq_f32(q.val[1], q.val[1]);
+        const float32x4_t z2 = vaddq_f32(q.val[2], q.val[2]);
+        const float32x4_t xx = vmulq_f32(q.val[0], x2);
+        const float32x4_t xy = vmulq_f32(q.val[0], y2);
+        const float32x4_t xz = vmulq_f32(q.val[0], z2);
+        const float32x4_t yy = vmulq_f32(q.val[1], y2);
+        const float32x4_t yz = vmulq_f32(q.val[1], z2);
+        const float32x4_t zz = vmulq_f32(q.val[2], z2);
+        const float32x4_t wx = vmulq_f32(q.val[3], x2);
+        const float32x4_t wy = vmulq_f32(q.val[3], y2);
+        const float32x4_t wz = vmulq_f32(q.val[3], z2);
+
+        // element k of the 4 matrices, same expressions as Mat4::fromRTS
+        float32x4x4_t c[4];
+        c[0].val[0] = vmulq_f32(vsubq_f32(one, vaddq_f32(yy, zz)), s.val[0]);
+        c[0].val[1] = vmulq_f32(vaddq_f32(xy, wz), s.val[0]);
+        c[0].val[2] = vmulq_f32(vsubq_f32(xz, wy), s.val[0]);
+        c[0].val[3] = zero;
+        c[1].val[0] = vmulq_f32(vsubq_f32(xy, wz), s.val[1]);
+        c[1].val[1] = vmulq_f32(vsubq_f32(one, vaddq_f32(xx, zz)), s.val[1]);
+        c[1].val[2] = vmulq_f32(vaddq_f32(yz, wx), s.val[1]);
+        c[1].val[3] = zero;
+        c[2].val[0] = vmulq_f32(vaddq_f32(xz, wy), s.val[2]);
+        c[2].val[1] = vmulq_f32(vsubq_f32(yz, wx), s.val[2]);
+        c[2].val[2] = vmulq_f32(vsubq_f32(one, vaddq_f32(xx, yy)), s.val[2]);
+        c[2].val[3] = zero;
+        c[3].val[0] = t.val[0];
+        c[3].val[1] = t.val[1];
+        c[3].val[2] = t.val[2];
+        c[3].val[3] = one;
+
+        // vst4q interleaves the 4 elements of a column, so each store writes that column for the 4 matrices
+        float columns[4][16];
+        for (uint32_t col = 0; col < 4; ++col)
+        {
+            vst4q_f32(columns[col], c[col]);
+        }
+        for (uint32_t mat = 0; mat < 4; ++mat)
+        {
+            for (uint32_t col = 0; col < 4; ++col)
+            {
+                vst1q_f32(dst + mat * 16 + col * 4, vld1q_f32(columns[col] + mat * 4));
+            }
+        }
+    }
+
+    MathUtilC::composeMatrices(rotations, translations, scales, dst, count - simdCount);
+}
+
+inline void MathUtilNeon64::multiplyQuaternions(const float* q1, const float* q2, float* dst, uint32_t count)
+{
+    const uint32_t simdCount = count & ~3U;
+    for (uint32_t i = 0; i < simdCount; i += 4, q1 += 16, q2 += 16, dst += 16)
+    {
+        const float32x4x4_t a = vld4q_f32(q1);
+        const float32x4x4_t b = vld4q_f32(q2);
+
+        // same expressions as Quaternion::multiply
+        float32x4x4_t r;
+        r.val[0] = vsubq_f32(vaddq_f32(vaddq_f32(vmulq_f32(a.val[3], b.val[0]), vmulq_f32(a.val[0], b.val[3])), vmulq_f32(a.val[1], b.val[2])), vmulq_f32(a.val[2], b.val[1]));
+        r.val[1] = vaddq_f32(vaddq_f32(vsubq_f32(vmulq_f32(a.val[3], b.val[1]), vmulq_f32(a.val[0], b.val[2])), vmulq_f32(a.val[1], b.val[3])), vmulq_f32(a.val[2], b.val[0]));
+        r.val[2] = vaddq_f32(vsubq_f32(vaddq_f32(vmulq_f32(a.val[3], b.val[2]), vmulq_f32(a.val[0], b.val[1])), vmulq_f32(a.val[1], b.val[0])), vmulq_f32(a.val[2], b.val[3]));
+        r.val[3] = vsubq_f32(vsubq_f32(vsubq_f32(vmulq_f32(a.val[3], b.val[3]), vmulq_f32(a.val[0], b.val[0])), vmulq_f32(a.val[1], b.val[1])), vmulq_f32(a.val[2], b.val[2]));
+        vst4q_f32(dst, r);
+    }
+
+    MathUtilC::multiplyQuaternions(q1, q2, dst, count - simdCount);
+}
+
 NS_CC_MATH_END
@@ -1,157 +1,324 @@
 NS_CC_MATH_BEGIN
 
-#ifdef __SSE__
+// All the kernels use unaligned loads and stores, so they work on the plain float layout of Mat4/Vec3/Vec4.
+// Products are accumulated in the same order as MathUtilC to keep the results identical to the scalar path.
+class MathUtilSSE
+{
+public:
+    inline static void addMatrix(const float* m, float scalar, float* dst);
+
+    inline static void addMatrix(const float* m1, const float* m2, float* dst);
+
+    inline static void subtractMatrix(const float* m1, const float* m2, float* dst);
+
+    inline static void multiplyMatrix(const float* m, float scalar, float* dst);
+
+    inline static void multiplyMatrix(const float* m1, const float* m2, float* dst);
+
+    inline static void negateMatrix(const float* m, float* dst);
+
+    inline static void transposeMatrix(const float* m, float* dst);
+
+    inline static void transformVec4(const float* m, float x, float y, float z, float w, float* dst);
+
+    inline static void transformVec4(const float* m, const float* v, float* dst);
+
+    inline static void multiplyMatrices(const float* m1, const float* m2, float* dst, uint32_t count);
+
+    inline static void transformPoints(const float* m, const float* src, float* dst, uint32_t count);
+
+    inline static void composeMatrices(const float* rotations, const float* translations, const float* scales, float* dst, uint32_t count);
+
+    inline static void multiplyQuaternions(const float* q1, const float* q2, float* dst, uint32_t count);
+
+private:
+    inline static __m128 linearCombine(const __m128 m[4], const __m128& v);
 
-void MathUtil::addMatrix(const __m128 m[4], float scalar, __m128 dst[4])
+    inline static void loadVec3x4(const float* src, __m128& x, __m128& y, __m128& z);
+
+    inline static void storeVec3x4(const __m128& x, const __m128& y, const __m128& z, float* dst);
+};
+
+inline void MathUtilSSE::addMatrix(const float* m, float scalar, float* dst)
 {
     __m128 s = _mm_set1_ps(scalar);
-    dst[0] = _mm_add_ps(m[0], s);
-    dst[1] = _mm_add_ps(m[1], s);
-    dst[2] = _mm_add_ps(m[2], s);
-    dst[3] = _mm_add_ps(m[3], s);
+    _mm_storeu_ps(dst + 0, _mm_add_ps(_mm_loadu_ps(m + 0), s));
+    _mm_storeu_ps(dst + 4, _mm_add_ps(_mm_loadu_ps(m + 4), s));
+    _mm_storeu_ps(dst + 8, _mm_add_ps(_mm_loadu_ps(m + 8), s));
+    _mm_storeu_ps(dst + 12, _mm_add_ps(_mm_loadu_ps(m + 12), s));
 }
 
-void MathUtil::addMatrix(const __m128 m1[4], const __m128 m2[4], __m128 dst[4])
+inline void MathUtilSSE::addMatrix(const float* m1, const float* m2, float* dst)
 {
-    dst[0] = _mm_add_ps(m1[0], m2[0]);
-    dst[1] = _mm_add_ps(m1[1], m2[1]);
-    dst[2] = _mm_add_ps(m1[2], m2[2]);
-    dst[3] = _mm_add_ps(m1[3], m2[3]);
+    _mm_storeu_ps(dst + 0, _mm_add_ps(_mm_loadu_ps(m1 + 0), _mm_loadu_ps(m2 + 0)));
+    _mm_storeu_ps(dst + 4, _mm_add_ps(_mm_loadu_ps(m1 + 4), _mm_loadu_ps(m2 + 4)));
+    _mm_storeu_ps(dst + 8, _mm_add_ps(_mm_loadu_ps(m1 + 8), _mm_loadu_ps(m2 + 8)));
+    _mm_storeu_ps(dst + 12, _mm_add_ps(_mm_loadu_ps(m1 + 12), _mm_loadu_ps(m2 + 12)));
 }
 
-void MathUtil::subtractMatrix(const __m128 m1[4], const __m128 m2[4], __m128 dst[4])
+inline void MathUtilSSE::subtractMatrix(const float* m1, const float* m2, float* dst)
 {
-    dst[0] = _mm_sub_ps(m1[0], m2[0]);
-    dst[1] = _mm_sub_ps(m1[1], m2[1]);
-    dst[2] = _mm_sub_ps(m1[2], m2[2]);
-    dst[3] = _mm_sub_ps(m1[3], m2[3]);
+    _mm_storeu_ps(dst + 0, _mm_sub_ps(_mm_loadu_ps(m1 + 0), _mm_loadu_ps(m2 + 0)));
+    _mm_storeu_ps(dst + 4, _mm_sub_ps(_mm_loadu_ps(m1 + 4), _mm_loadu_ps(m2 + 4)));
+    _mm_storeu_ps(dst + 8, _mm_sub_ps(_mm_loadu_ps(m1 + 8), _mm_loadu_ps(m2 + 8)));
+    _mm_storeu_ps(dst + 12, _mm_sub_ps(_mm_loadu_ps(m1 + 12), _mm_loadu_ps(m2 + 12)));
 }
 
-void MathUtil::multiplyMatrix(const __m128 m[4], float scalar, __m128 dst[4])
+inline void MathUtilSSE::multiplyMatrix(const float* m, float scalar, float* dst)
 {
     __m128 s = _mm_set1_ps(scalar);
-    dst[0] = _mm_mul_ps(m[0], s);
-    dst[1] = _mm_mul_ps(m[1], s);
-    dst[2] = _mm_mul_ps(m[2], s);
-    dst[3] = _mm_mul_ps(m[3], s);
-}
-
-void MathUtil::multiplyMatrix(const __m128 m1[4], const __m128 m2[4], __m128 dst[4])
-{
-    __m128 dst0, dst1, dst2, dst3;
-	{
-		__m128 e0 = _mm_shuffle_ps(m2[0], m2[0], _MM_SHUFFLE(0, 0, 0, 0));
-		__m128 e1 = _mm_shuffle_ps(m2[0], m2[0], _MM_SHUFFLE(1, 1, 1, 1));
-		__m128 e2 = _mm_shuffle_ps(m2[0], m2[0], _MM_SHUFFLE(2, 2, 2, 2));
-		__m128 e3 = _mm_shuffle_ps(m2[0], m2[0], _MM_SHUFFLE(3, 3, 3, 3));
-        
-		__m128 v0 = _mm_mul_ps(m1[0], e0);
-		__m128 v1 = _mm_mul_ps(m1[1], e1);
-		__m128 v2 = _mm_mul_ps(m1[2], e2);
-		__m128 v3 = _mm_mul_ps(m1[3], e3);
-        
-		__m128 a0 = _mm_add_ps(v0, v1);
-		__m128 a1 = _mm_add_ps(v2, v3);
-		__m128 a2 = _mm_add_ps(a0, a1);
-        
-		dst0 = a2;
-	}
-    
-	{
-		__m128 e0 = _mm_shuffle_ps(m2[1], m2[1], _MM_SHUFFLE(0, 0, 0, 0));
-		__m128 e1 = _mm_shuffle_ps(m2[1], m2[1], _MM_SHUFFLE(1, 1, 1, 1));
-		__m128 e2 = _mm_shuffle_ps(m2[1], m2[1], _MM_SHUFFLE(2, 2, 2, 2));
-		__m128 e3 = _mm_shuffle_ps(m2[1], m2[1], _MM_SHUFFLE(3, 3, 3, 3));
-        
-		__m128 v0 = _mm_mul_ps(m1[0], e0);
-		__m128 v1 = _mm_mul_ps(m1[1], e1);
-		__m128 v2 = _mm_mul_ps(m1[2], e2);
-		__m128 v3 = _mm_mul_ps(m1[3], e3);
-        
-		__m128 a0 = _mm_add_ps(v0, v1);
-		__m128 a1 = _mm_add_ps(v2, v3);
-		__m128 a2 = _mm_add_ps(a0, a1);
-        
-		dst1 = a2;
-	}
-    
-	{
-		__m128 e0 = _mm_shuffle_ps(m2[2], m2[2], _MM_SHUFFLE(0, 0, 0, 0));
-		__m128 e1 = _mm_shuffle_ps(m2[2], m2[2], _MM_SHUFFLE(1, 1, 1, 1));
-		__m128 e2 = _mm_shuffle_ps(m2[2], m2[2], _MM_SHUFFLE(2, 2, 2, 2));
-		__m128 e3 = _mm_shuffle_ps(m2[2], m2[2], _MM_SHUFFLE(3, 3, 3, 3));
-        
-		__m128 v0 = _mm_mul_ps(m1[0], e0);
-		__m128 v1 = _mm_mul_ps(m1[1], e1);
-		__m128 v2 = _mm_mul_ps(m1[2], e2);
-		__m128 v3 = _mm_mul_ps(m1[3], e3);
-        
-		__m128 a0 = _mm_add_ps(v0, v1);
-		__m128 a1 = _mm_add_ps(v2, v3);
-		__m128 a2 = _mm_add_ps(a0, a1);
-        
-		dst2 = a2;
-	}
-    
-	{
-		__m128 e0 = _mm_shuffle_ps(m2[3], m2[3], _MM_SHUFFLE(0, 0, 0, 0));
-		__m128 e1 = _mm_shuffle_ps(m2[3], m2[3], _MM_SHUFFLE(1, 1, 1, 1));
-		__m128 e2 = _mm_shuffle_ps(m2[3], m2[3], _MM_SHUFFLE(2, 2, 2, 2));
-		__m128 e3 = _mm_shuffle_ps(m2[3], m2[3], _MM_SHUFFLE(3, 3, 3, 3));
-        
-		__m128 v0 = _mm_mul_ps(m1[0], e0);
-		__m128 v1 = _mm_mul_ps(m1[1], e1);
-		__m128 v2 = _mm_mul_ps(m1[2], e2);
-		__m128 v3 = _mm_mul_ps(m1[3], e3);
-        
-		__m128 a0 = _mm_add_ps(v0, v1);
-		__m128 a1 = _mm_add_ps(v2, v3);
-		__m128 a2 = _mm_add_ps(a0, a1);
-        
-		dst3 = a2;
-	}
-    dst[0] = dst0;
-    dst[1] = dst1;
-    dst[2] = dst2;
-    dst[3] = dst3;
-}
-
-void MathUtil::negateMatrix(const __m128 m[4], __m128 dst[4])
+    _mm_storeu_ps(dst + 0, _mm_mul_ps(_mm_loadu_ps(m + 0), s));
+    _mm_storeu_ps(dst + 4, _mm_mul_ps(_mm_loadu_ps(m + 4), s));
+    _mm_storeu_ps(dst + 8, _mm_mul_ps(_mm_loadu_ps(m + 8), s));
+    _mm_storeu_ps(dst + 12, _mm_mul_ps(_mm_loadu_ps(m + 12), s));
+}
+
+inline __m128 MathUtilSSE::linearCombine(const __m128 m[4], const __m128& v)
+{
+    __m128 r = _mm_mul_ps(m[0], _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)));
+    r = _mm_add_ps(r, _mm_mul_ps(m[1], _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))));
+    r = _mm_add_ps(r, _mm_mul_ps(m[2], _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))));
+    r = _mm_add_ps(r, _mm_mul_ps(m[3], _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3))));
+    return r;
+}
+
+inline void MathUtilSSE::multiplyMatrix(const float* m1, const float* m2, float* dst)
+{
+    // Support the case where m1 or m2 is the same array as dst.
+    const __m128 a[4] = {_mm_loadu_ps(m1 + 0), _mm_loadu_ps(m1 + 4), _mm_loadu_ps(m1 + 8), _mm_loadu_ps(m1 + 12)};
+    const __m128 b0 = _mm_loadu_ps(m2 + 0);
+    const __m128 b1 = _mm_loadu_ps(m2 + 4);
+    const __m128 b2 = _mm_loadu_ps(m2 + 8);
+    const __m128 b3 = _mm_loadu_ps(m2 + 12);
+    _mm_storeu_ps(dst + 0, linearCombine(a, b0));
+    _mm_storeu_ps(dst + 4, linearCombine(a, b1));
+    _mm_storeu_ps(dst + 8, linearCombine(a, b2));
+    _mm_storeu_ps(dst + 12, linearCombine(a, b3));
+}
+
+inline void MathUtilSSE::negateMatrix(const float* m, float* dst)
 {
     __m128 z = _mm_setzero_ps();
-    dst[0] = _mm_sub_ps(z, m[0]);
-    dst[1] = _mm_sub_ps(z, m[1]);
-    dst[2] = _mm_sub_ps(z, m[2]);
-    dst[3] = _mm_sub_ps(z, m[3]);
+    _mm_storeu_ps(dst + 0, _mm_sub_ps(z, _mm_loadu_ps(m + 0)));
+    _mm_storeu_ps(dst + 4, _mm_sub_ps(z, _mm_loadu_ps(m + 4)));
+    _mm_storeu_ps(dst + 8, _mm_sub_ps(z, _mm_loadu_ps(m + 8)));
+    _mm_storeu_ps(dst + 12, _mm_sub_ps(z, _mm_loadu_ps(m + 12)));
 }
 
-void MathUtil::transposeMatrix(const __m128 m[4], __m128 dst[4])
+inline void MathUtilSSE::transposeMatrix(const float* m, float* dst)
 {
-    __m128 tmp0 = _mm_shuffle_ps(m[0], m[1], 0x44);
-    __m128 tmp2 = _mm_shuffle_ps(m[0], m[1], 0xEE);
-    __m128 tmp1 = _mm_shuffle_ps(m[2], m[3], 0x44);
-    __m128 tmp3 = _mm_shuffle_ps(m[2], m[3], 0xEE);
-    
-    dst[0] = _mm_shuffle_ps(tmp0, tmp1, 0x88);
-    dst[1] = _mm_shuffle_ps(tmp0, tmp1, 0xDD);
-    dst[2] = _mm_shuffle_ps(tmp2, tmp3, 0x88);
-    dst[3] = _mm_shuffle_ps(tmp2, tmp3, 0xDD);
+    __m128 c0 = _mm_loadu_ps(m + 0);
+    __m128 c1 = _mm_loadu_ps(m + 4);
+    __m128 c2 = _mm_loadu_ps(m + 8);
+    __m128 c3 = _mm_loadu_ps(m + 12);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    _mm_storeu_ps(dst + 0, c0);
+    _mm_storeu_ps(dst + 4, c1);
+    _mm_storeu_ps(dst + 8, c2);
+    _mm_storeu_ps(dst + 12, c3);
 }
 
-void MathUtil::transformVec4(const __m128 m[4], const __m128& v, __m128& dst)
+inline void MathUtilSSE::transformVec4(const float* m, float x, float y, float z, float w, float* dst)
 {
-    __m128 col1 = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
-    __m128 col2 = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
-    __m128 col3 = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
-    __m128 col4 = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
-    
-    dst = _mm_add_ps(
-                     _mm_add_ps(_mm_mul_ps(m[0], col1), _mm_mul_ps(m[1], col2)),
-                     _mm_add_ps(_mm_mul_ps(m[2], col3), _mm_mul_ps(m[3], col4))
-                     );
+    const __m128 a[4] = {_mm_loadu_ps(m + 0), _mm_loadu_ps(m + 4), _mm_loadu_ps(m + 8), _mm_loadu_ps(m + 12)};
+    const __m128 r = linearCombine(a, _mm_setr_ps(x, y, z, w));
+    // only xyz are written, same as MathUtilC
+    _mm_storel_pi(reinterpret_cast<__m64*>(dst), r);
+    _mm_store_ss(dst + 2, _mm_movehl_ps(r, r));
 }
 
+inline void MathUtilSSE::transformVec4(const float* m, const float* v, float* dst)
+{
+    const __m128 a[4] = {_mm_loadu_ps(m + 0), _mm_loadu_ps(m + 4), _mm_loadu_ps(m + 8), _mm_loadu_ps(m + 12)};
+    _mm_storeu_ps(dst, linearCombine(a, _mm_loadu_ps(v)));
+}
+
+inline void MathUtilSSE::multiplyMatrices(const float* m1, const float* m2, float* dst, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i, m1 += 16, m2 += 16, dst += 16) {
+#ifdef __AVX__
+        // two columns of the result per 256-bit register
+        const __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m1 + 0));
+        const __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m1 + 4));
+        const __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m1 + 8));
+        const __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m1 + 12));
+        const __m256 b01 = _mm256_loadu_ps(m2 + 0);
+        const __m256 b23 = _mm256_loadu_ps(m2 + 8);
+
+        __m256 r01 = _mm256_mul_ps(a0, _mm256_permute_ps(b01, _MM_SHUFFLE(0, 0, 0, 0)));
+        r01 = _mm256_add_ps(r01, _mm256_mul_ps(a1, _mm256_permute_ps(b01, _MM_SHUFFLE(1, 1, 1, 1))));
+        r01 = _mm256_add_ps(r01, _mm256_mul_ps(a2, _mm256_permute_ps(b01, _MM_SHUFFLE(2, 2, 2, 2))));
+        r01 = _mm256_add_ps(r01, _mm256_mul_ps(a3, _mm256_permute_ps(b01, _MM_SHUFFLE(3, 3, 3, 3))));
+
+        __m256 r23 = _mm256_mul_ps(a0, _mm256_permute_ps(b23, _MM_SHUFFLE(0, 0, 0, 0)));
+        r23 = _mm256_add_ps(r23, _mm256_mul_ps(a1, _mm256_permute_ps(b23, _MM_SHUFFLE(1, 1, 1, 1))));
+        r23 = _mm256_add_ps(r23, _mm256_mul_ps(a2, _mm256_permute_ps(b23, _MM_SHUFFLE(2, 2, 2, 2))));
+        r23 = _mm256_add_ps(r23, _mm256_mul_ps(a3, _mm256_permute_ps(b23, _MM_SHUFFLE(3, 3, 3, 3))));
+
+        _mm256_storeu_ps(dst + 0, r01);
+        _mm256_storeu_ps(dst + 8, r23);
+#else
+        multiplyMatrix(m1, m2, dst);
 #endif
+    }
+}
+
+inline void MathUtilSSE::loadVec3x4(const float* src, __m128& x, __m128& y, __m128& z)
+{
+    // v0 = x0 y0 z0 x1, v1 = y1 z1 x2 y2, v2 = z2 x3 y3 z3
+    const __m128 v0 = _mm_loadu_ps(src + 0);
+    const __m128 v1 = _mm_loadu_ps(src + 4);
+    const __m128 v2 = _mm_loadu_ps(src + 8);
+    x = _mm_shuffle_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 2, 3, 0)), _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 1, 0));
+    y = _mm_shuffle_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(0, 0, 0, 1)), _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+    z = _mm_shuffle_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(v2, v2, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+inline void MathUtilSSE::storeVec3x4(const __m128& x, const __m128& y, const __m128& z, float* dst)
+{
+    const __m128 xy01 = _mm_unpacklo_ps(x, y); // x0 y0 x1 y1
+    const __m128 xy23 = _mm_unpackhi_ps(x, y); // x2 y2 x3 y3
+    _mm_storeu_ps(dst + 0, _mm_shuffle_ps(xy01, _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0)));
+    _mm_storeu_ps(dst + 4, _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), xy23, _MM_SHUFFLE(1, 0, 2, 0)));
+    _mm_storeu_ps(dst + 8, _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+inline void MathUtilSSE::transformPoints(const float* m, const float* src, float* dst, uint32_t count)
+{
+    const uint32_t simdCount = count & ~3U;
+    const __m128 one = _mm_set1_ps(1.0F);
+    const __m128 precision = _mm_set1_ps(0.000001F);
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    for (uint32_t i = 0; i < simdCount; i += 4, src += 12, dst += 12) {
+        __m128 x;
+        __m128 y;
+        __m128 z;
+        loadVec3x4(src, x, y, z);
+
+        __m128 r[4];
+        for (uint32_t c = 0; c < 4; ++c) {
+            r[c] = _mm_mul_ps(x, _mm_set1_ps(m[c]));
+            r[c] = _mm_add_ps(r[c], _mm_mul_ps(y, _mm_set1_ps(m[4 + c])));
+            r[c] = _mm_add_ps(r[c], _mm_mul_ps(z, _mm_set1_ps(m[8 + c])));
+            r[c] = _mm_add_ps(r[c], _mm_mul_ps(one, _mm_set1_ps(m[12 + c])));
+        }
+
+        // rhw = |w| > precision ? 1 / w : 1
+        const __m128 valid = _mm_cmpgt_ps(_mm_and_ps(r[3], absMask), precision);
+        const __m128 rhw = _mm_or_ps(_mm_and_ps(valid, _mm_div_ps(one, r[3])), _mm_andnot_ps(valid, one));
+        storeVec3x4(_mm_mul_ps(r[0], rhw), _mm_mul_ps(r[1], rhw), _mm_mul_ps(r[2], rhw), dst);
+    }
 
+    MathUtilC::transformPoints(m, src, dst, count - simdCount);
+}
+
+inline void MathUtilSSE::composeMatrices(const float* rotations, const float* translations, const float* scales, float* dst, uint32_t count)
+{
+    const uint32_t simdCount = count & ~3U;
+    const __m128 one = _mm_set1_ps(1.0F);
+    const __m128 zero = _mm_setzero_ps();
+    for (uint32_t i = 0; i < simdCount; i += 4, rotations += 16, translations += 12, scales += 12, dst += 64) {
+        __m128 x = _mm_loadu_ps(rotations + 0);
+        __m128 y = _mm_loadu_ps(rotations + 4);
+        __m128 z = _mm_loadu_ps(rotations + 8);
+        __m128 w = _mm_loadu_ps(rotations + 12);
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+        __m128 tx;
+        __m128 ty;
+        __m128 tz;
+        loadVec3x4(translations, tx, ty, tz);
+        __m128 sx;
+        __m128 sy;
+        __m128 sz;
+        loadVec3x4(scales, sx, sy, sz);
+
+        const __m128 x2 = _mm_add_ps(x, x);
+        const __m128 y2 = _mm_add_ps(y, y);
+        const __m128 z2 = _mm_add_ps(z, z);
+        const __m128 xx = _mm_mul_ps(x, x2);
+        const __m128 xy = _mm_mul_ps(x, y2);
+        const __m128 xz = _mm_mul_ps(x, z2);
+        const __m128 yy = _mm_mul_ps(y, y2);
+        const __m128 yz = _mm_mul_ps(y, z2);
+        const __m128 zz = _mm_mul_ps(z, z2);
+        const __m128 wx = _mm_mul_ps(w, x2);
+        const __m128 wy = _mm_mul_ps(w, y2);
+        const __m128 wz = _mm_mul_ps(w, z2);
+
+        // element k of the 4 matrices, same expressions as Mat4::fromRTS
+        __m128 c00 = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(yy, zz)), sx);
+        __m128 c01 = _mm_mul_ps(_mm_add_ps(xy, wz), sx);
+        __m128 c02 = _mm_mul_ps(_mm_sub_ps(xz, wy), sx);
+        __m128 c03 = zero;
+        __m128 c10 = _mm_mul_ps(_mm_sub_ps(xy, wz), sy);
+        __m128 c11 = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, zz)), sy);
+        __m128 c12 = _mm_mul_ps(_mm_add_ps(yz, wx), sy);
+        __m128 c13 = zero;
+        __m128 c20 = _mm_mul_ps(_mm_add_ps(xz, wy), sz);
+        __m128 c21 = _mm_mul_ps(_mm_sub_ps(yz, wx), sz);
+        __m128 c22 = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, yy)), sz);
+        __m128 c23 = zero;
+        __m128 c30 = tx;
+        __m128 c31 = ty;
+        __m128 c32 = tz;
+        __m128 c33 = one;
+        _MM_TRANSPOSE4_PS(c00, c01, c02, c03);
+        _MM_TRANSPOSE4_PS(c10, c11, c12, c13);
+        _MM_TRANSPOSE4_PS(c20, c21, c22, c23);
+        _MM_TRANSPOSE4_PS(c30, c31, c32, c33);
+
+        // after the transpose cXY holds column X of matrix Y
+        _mm_storeu_ps(dst + 0, c00);
+        _mm_storeu_ps(dst + 4, c10);
+        _mm_storeu_ps(dst + 8, c20);
+        _mm_storeu_ps(dst + 12, c30);
+        _mm_storeu_ps(dst + 16, c01);
+        _mm_storeu_ps(dst + 20, c11);
+        _mm_storeu_ps(dst + 24, c21);
+        _mm_storeu_ps(dst + 28, c31);
+        _mm_storeu_ps(dst + 32, c02);
+        _mm_storeu_ps(dst + 36, c12);
+        _mm_storeu_ps(dst + 40, c22);
+        _mm_storeu_ps(dst + 44, c32);
+        _mm_storeu_ps(dst + 48, c03);
+        _mm_storeu_ps(dst + 52, c13);
+        _mm_storeu_ps(dst + 56, c23);
+        _mm_storeu_ps(dst + 60, c33);
+    }
+
+    MathUtilC::composeMatrices(rotations, translations, scales, dst, count - simdCount);
+}
+
+inline void MathUtilSSE::multiplyQuaternions(const float* q1, const float* q2, float* dst, uint32_t count)
+{
+    const uint32_t simdCount = count & ~3U;
+    for (uint32_t i = 0; i < simdCount; i += 4, q1 += 16, q2 += 16, dst += 16) {
+        __m128 ax = _mm_loadu_ps(q1 + 0);
+        __m128 ay = _mm_loadu_ps(q1 + 4);
+        __m128 az = _mm_loadu_ps(q1 + 8);
+        __m128 aw = _mm_loadu_ps(q1 + 12);
+        _MM_TRANSPOSE4_PS(ax, ay, az, aw);
+        __m128 bx = _mm_loadu_ps(q2 + 0);
+        __m128 by = _mm_loadu_ps(q2 + 4);
+        __m128 bz = _mm_loadu_ps(q2 + 8);
+        __m128 bw = _mm_loadu_ps(q2 + 12);
+        _MM_TRANSPOSE4_PS(bx, by, bz, bw);
+
+        // same expressions as Quaternion::multiply
+        __m128 x = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, bx), _mm_mul_ps(ax, bw)), _mm_mul_ps(ay, bz)), _mm_mul_ps(az, by));
+        __m128 y = _mm_add_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(aw, by), _mm_mul_ps(ax, bz)), _mm_mul_ps(ay, bw)), _mm_mul_ps(az, bx));
+        __m128 z = _mm_add_ps(_mm_sub_ps(_mm_add_ps(_mm_mul_ps(aw, bz), _mm_mul_ps(ax, by)), _mm_mul_ps(ay, bx)), _mm_mul_ps(az, bw));
+        __m128 w = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_mul_ps(aw, bw), _mm_mul_ps(ax, bx)), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+
+        // after the transpose x, y, z and w hold the quaternions 0 to 3
+        _mm_storeu_ps(dst + 0, x);
+        _mm_storeu_ps(dst + 4, y);
+        _mm_storeu_ps(dst + 8, z);
+        _mm_storeu_ps(dst + 12, w);
+    }
+
+    MathUtilC::multiplyQuaternions(q1, q2, dst, count - simdCount);
+}
 
 NS_CC_MATH_END
@@ -27,6 +27,7 @@
 #include "base/Macros.h"
 #include "math/Mat3.h"
 #include "math/Math.h"
+#include "math/MathUtil.h"
 #include "math/Utils.h"
 
 NS_CC_MATH_BEGIN
@@ -159,6 +160,11 @@ void Quaternion::multiply(const Quaternion &q1, const Quaternion &q2, Quaternion
     dst->w = w;
 }
 
+void Quaternion::multiplyBatch(const Quaternion *q1, const Quaternion *q2, Quaternion *dst, uint32_t count) {
+    static_assert(sizeof(Quaternion) == 4 * sizeof(float), "packed layout is required");
+    MathUtil::multiplyQuaternions(&q1->x, &q2->x, &dst->x, count);
+}
+
 void Quaternion::normalize() {
     float n = x * x + y * y + z * z + w * w;
 
@@ -237,6 +237,17 @@ public:
      */
     static void multiply(const Quaternion &q1, const Quaternion &q2, Quaternion *dst);
 
+    /**
+     * Multiplies count pairs of quaternions, dst[i] = q1[i] * q2[i].
+     * dst may be the same array as q1 or q2.
+     *
+     * @param q1 The first quaternion array.
+     * @param q2 The second quaternion array.
+     * @param dst The quaternion array to store the results in.
+     * @param count The number of quaternions.
+     */
+    static void multiplyBatch(const Quaternion *q1, const Quaternion *q2, Quaternion *dst, uint32_t count);
+
     /**
      * Normalizes this quaternion to have unit length.
      *
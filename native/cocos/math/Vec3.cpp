@@ -278,6 +278,11 @@ void Vec3::transformMat4(const Vec3 &v, const Mat4 &m, Vec3 *dst) {
     dst->transformMat4(v, m);
 }
 
+void Vec3::transformMat4Batch(const Vec3 *v, const Mat4 &m, Vec3 *dst, uint32_t count) {
+    static_assert(sizeof(Vec3) == 3 * sizeof(float), "packed layout is required");
+    MathUtil::transformPoints(m.m, &v->x, &dst->x, count);
+}
+
 void Vec3::transformMat4Normal(const Vec3 &v, const Mat4 &m, Vec3 *dst) {
     float x = v.x;
     float y = v.y;
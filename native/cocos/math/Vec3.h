@@ -260,6 +260,16 @@ public:
      */
     static void transformMat4(const Vec3 &v, const Mat4 &m, Vec3 *dst);
 
+    /**
+     * Transforms count vectors by the specified Mat4, same as calling transformMat4 for each element.
+     * dst may be the same array as v.
+     * @param v The Vec3 array to transform.
+     * @param m The matrix.
+     * @param dst The destination vector array.
+     * @param count The number of vectors.
+     */
+    static void transformMat4Batch(const Vec3 *v, const Mat4 &m, Vec3 *dst, uint32_t count);
+
     /**
      * @en Vector and fourth order matrix multiplication, will complete the vector with a fourth element as one
      * @zh 向量与四维矩阵乘法，默认向量第四位为 0。
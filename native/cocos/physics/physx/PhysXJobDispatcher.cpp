@@ -0,0 +1,66 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "physics/physx/PhysXJobDispatcher.h"
+#include <utility>
+
+namespace cc {
+namespace physics {
+
+PhysXJobDispatcher::~PhysXJobDispatcher() {
+    reclaim();
+}
+
+void PhysXJobDispatcher::submitTask(physx::PxBaseTask &task) {
+    // tasks are submitted from PhysX threads and the workers alike, each one gets its own graph:
+    // graphs are not rerun, the dummy backend clears a graph once it has run
+    auto graph = std::make_unique<JobGraph>(JobSystem::getInstance(), task.getName());
+    graph->createJob([&task]() {
+        task.run();
+        task.release();
+    });
+    graph->run();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _graphs.emplace_back(std::move(graph));
+}
+
+uint32_t PhysXJobDispatcher::getWorkerCount() const {
+    return JobSystem::getInstance()->threadCount();
+}
+
+void PhysXJobDispatcher::reclaim() {
+    ccstd::vector<std::unique_ptr<JobGraph>> graphs;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        graphs.swap(_graphs);
+    }
+    for (auto &graph : graphs) {
+        graph->waitForAll();
+    }
+}
+
+} // namespace physics
+} // namespace cc
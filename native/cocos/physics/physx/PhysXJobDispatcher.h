@@ -0,0 +1,61 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include "base/Macros.h"
+#include "base/job-system/JobSystem.h"
+#include "base/std/container/vector.h"
+#include "physics/physx/PhysXInc.h"
+
+namespace cc {
+namespace physics {
+
+/**
+ * Runs the tasks of PhysX on the engine job system instead of threads owned by PhysX,
+ * so physics shares the workers with the renderer rather than competing with them.
+ */
+class PhysXJobDispatcher final : public physx::PxCpuDispatcher {
+public:
+    PhysXJobDispatcher() = default;
+    ~PhysXJobDispatcher() override;
+
+    void submitTask(physx::PxBaseTask &task) override;
+    uint32_t getWorkerCount() const override;
+
+    // waits for and frees the jobs of finished tasks, called on the main thread once a simulation is fetched
+    void reclaim();
+
+private:
+    std::mutex _mutex;
+    ccstd::vector<std::unique_ptr<JobGraph>> _graphs;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(PhysXJobDispatcher);
+};
+
+} // namespace physics
+} // namespace cc
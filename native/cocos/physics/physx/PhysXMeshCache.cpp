@@ -0,0 +1,216 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "physics/physx/PhysXMeshCache.h"
+#include <cstdio>
+#include <cstring>
+#include "platform/FileView.h"
+
+namespace cc {
+namespace physics {
+
+namespace {
+
+constexpr uint32_t BLOB_MAGIC = 0x4D585043U; // "CPXM"
+constexpr uint32_t BLOB_VERSION = 1U;
+
+struct BlobHeader {
+    uint32_t magic{BLOB_MAGIC};
+    uint32_t version{BLOB_VERSION};
+    uint64_t key{0};
+    uint32_t type{0};
+    uint32_t size{0};
+};
+
+uint64_t fnv1a(const void *data, size_t size, uint64_t hash = 14695981039346656037ULL) {
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+template <typename T>
+uint64_t hashValue(const T &value, uint64_t hash) {
+    return fnv1a(&value, sizeof(value), hash);
+}
+
+// hashes the elements only, so the same data with a different stride gets the same key
+uint64_t hashData(const physx::PxBoundedData &data, size_t elementSize, uint64_t hash) {
+    hash = hashValue(data.count, hash);
+    const auto *bytes = static_cast<const uint8_t *>(data.data);
+    if (data.stride == elementSize) {
+        return fnv1a(bytes, static_cast<size_t>(data.count) * elementSize, hash);
+    }
+    for (physx::PxU32 i = 0; i < data.count; ++i) {
+        hash = fnv1a(bytes + static_cast<size_t>(i) * data.stride, elementSize, hash);
+    }
+    return hash;
+}
+
+// cooked data depends on the PhysX version, it goes into every key
+uint64_t initialHash(uint32_t type) {
+    uint64_t hash = hashValue(BLOB_VERSION, 14695981039346656037ULL);
+    hash = hashValue(static_cast<uint32_t>(PX_PHYSICS_VERSION), hash);
+    return hashValue(type, hash);
+}
+
+} // namespace
+
+PhysXMeshCache::PhysXMeshCache(physx::PxPhysics &physics, physx::PxCooking &cooking)
+: _physics(physics), _cooking(cooking) {
+}
+
+PhysXMeshCache::~PhysXMeshCache() {
+    clear();
+}
+
+void PhysXMeshCache::setCacheDirectory(const ccstd::string &path) {
+    _cacheDirectory = path;
+    if (!_cacheDirectory.empty() && _cacheDirectory.back() != '/') {
+        _cacheDirectory += '/';
+    }
+}
+
+template <typename Cook, typename Create>
+physx::PxBase *PhysXMeshCache::get(Type type, uint64_t key, Cook &&cook, Create &&create) {
+    auto iter = _objects.find(key);
+    if (iter != _objects.end()) {
+        ++_memoryHits;
+        return iter->second;
+    }
+
+    physx::PxBase *object = nullptr;
+    if (!_cacheDirectory.empty()) {
+        // saving replaces the blob, which a live mapping would lock on windows, so it is read instead
+        FileView file = FileView::read(getBlobPath(key));
+        BlobHeader header;
+        if (file.size() >= sizeof(header)) {
+            memcpy(&header, file.data(), sizeof(header));
+        }
+        if (header.key == key && header.magic == BLOB_MAGIC && header.version == BLOB_VERSION &&
+            header.type == static_cast<uint32_t>(type) && file.size() == sizeof(header) + header.size) {
+            physx::PxDefaultMemoryInputData input(const_cast<physx::PxU8 *>(file.data() + sizeof(header)), header.size);
+            object = create(input);
+            _diskHits += object ? 1 : 0;
+        }
+    }
+
+    if (!object) {
+        physx::PxDefaultMemoryOutputStream stream;
+        if (!cook(stream)) {
+            return nullptr;
+        }
+        ++_cookCount;
+        physx::PxDefaultMemoryInputData input(stream.getData(), stream.getSize());
+        object = create(input);
+        if (object) {
+            store(type, key, stream);
+        }
+    }
+
+    if (object) {
+        _objects.emplace(key, object);
+    }
+    return object;
+}
+
+physx::PxConvexMesh *PhysXMeshCache::getConvexMesh(const physx::PxConvexMeshDesc &desc) {
+    uint64_t key = initialHash(static_cast<uint32_t>(Type::CONVEX_MESH));
+    key = hashValue(static_cast<uint32_t>(desc.flags), key);
+    key = hashData(desc.points, sizeof(physx::PxVec3), key);
+    auto *object = get(
+        Type::CONVEX_MESH, key,
+        [&](physx::PxOutputStream &stream) { return _cooking.cookConvexMesh(desc, stream); },
+        [&](physx::PxInputStream &stream) { return _physics.createConvexMesh(stream); });
+    return static_cast<physx::PxConvexMesh *>(object);
+}
+
+physx::PxTriangleMesh *PhysXMeshCache::getTriangleMesh(const physx::PxTriangleMeshDesc &desc) {
+    const bool is16Bit = desc.flags.isSet(physx::PxMeshFlag::e16_BIT_INDICES);
+    uint64_t key = initialHash(static_cast<uint32_t>(Type::TRIANGLE_MESH));
+    key = hashValue(static_cast<uint32_t>(desc.flags), key);
+    key = hashData(desc.points, sizeof(physx::PxVec3), key);
+    key = hashData(desc.triangles, 3 * (is16Bit ? sizeof(physx::PxU16) : sizeof(physx::PxU32)), key);
+    auto *object = get(
+        Type::TRIANGLE_MESH, key,
+        [&](physx::PxOutputStream &stream) { return _cooking.cookTriangleMesh(desc, stream); },
+        [&](physx::PxInputStream &stream) { return _physics.createTriangleMesh(stream); });
+    return static_cast<physx::PxTriangleMesh *>(object);
+}
+
+physx::PxHeightField *PhysXMeshCache::getHeightField(const physx::PxHeightFieldDesc &desc) {
+    uint64_t key = initialHash(static_cast<uint32_t>(Type::HEIGHT_FIELD));
+    key = hashValue(desc.nbRows, key);
+    key = hashValue(desc.nbColumns, key);
+    key = hashValue(static_cast<uint32_t>(desc.flags), key);
+    physx::PxBoundedData samples;
+    samples.count = desc.nbRows * desc.nbColumns;
+    samples.stride = desc.samples.stride;
+    samples.data = desc.samples.data;
+    key = hashData(samples, sizeof(physx::PxHeightFieldSample), key);
+    auto *object = get(
+        Type::HEIGHT_FIELD, key,
+        [&](physx::PxOutputStream &stream) { return _cooking.cookHeightField(desc, stream); },
+        [&](physx::PxInputStream &stream) { return _physics.createHeightField(stream); });
+    return static_cast<physx::PxHeightField *>(object);
+}
+
+void PhysXMeshCache::clear() {
+    for (auto &object : _objects) {
+        object.second->release();
+    }
+    _objects.clear();
+}
+
+void PhysXMeshCache::store(Type type, uint64_t key, physx::PxDefaultMemoryOutputStream &stream) const {
+    if (_cacheDirectory.empty()) return;
+
+    BlobHeader header;
+    header.key = key;
+    header.type = static_cast<uint32_t>(type);
+    header.size = stream.getSize();
+
+    // write aside and rename, readers never see a partial blob
+    auto path = getBlobPath(key);
+    auto tempPath = path + ".tmp";
+    FILE *file = fopen(tempPath.c_str(), "wb");
+    if (!file) return;
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   fwrite(stream.getData(), 1, header.size, file) == header.size;
+    fclose(file);
+    if (!written || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+    }
+}
+
+ccstd::string PhysXMeshCache::getBlobPath(uint64_t key) const {
+    char name[24];
+    snprintf(name, sizeof(name), "%016llx.pxm", static_cast<unsigned long long>(key));
+    return _cacheDirectory + name;
+}
+
+} // namespace physics
+} // namespace cc
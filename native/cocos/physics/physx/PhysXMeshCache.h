@@ -0,0 +1,84 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include "base/Macros.h"
+#include "base/std/container/string.h"
+#include "base/std/container/unordered_map.h"
+#include "physics/physx/PhysXInc.h"
+
+namespace cc {
+namespace physics {
+
+/**
+ * Cooked collision meshes keyed by a hash of their content. Identical meshes share one PhysX object,
+ * and with a cache directory set, cooked data is stored on disk so the next load only deserializes it.
+ */
+class PhysXMeshCache final {
+public:
+    PhysXMeshCache(physx::PxPhysics &physics, physx::PxCooking &cooking);
+    ~PhysXMeshCache();
+
+    void setCacheDirectory(const ccstd::string &path);
+    inline const ccstd::string &getCacheDirectory() const { return _cacheDirectory; }
+
+    physx::PxConvexMesh *getConvexMesh(const physx::PxConvexMeshDesc &desc);
+    physx::PxTriangleMesh *getTriangleMesh(const physx::PxTriangleMeshDesc &desc);
+    physx::PxHeightField *getHeightField(const physx::PxHeightFieldDesc &desc);
+
+    // drops the in memory entries, meshes still used by shapes stay alive
+    void clear();
+
+    inline uint32_t getMemoryHits() const { return _memoryHits; }
+    inline uint32_t getDiskHits() const { return _diskHits; }
+    inline uint32_t getCookCount() const { return _cookCount; }
+
+private:
+    enum class Type : uint32_t {
+        CONVEX_MESH = 1,
+        TRIANGLE_MESH = 2,
+        HEIGHT_FIELD = 3,
+    };
+
+    template <typename Cook, typename Create>
+    physx::PxBase *get(Type type, uint64_t key, Cook &&cook, Create &&create);
+    void store(Type type, uint64_t key, physx::PxDefaultMemoryOutputStream &stream) const;
+    ccstd::string getBlobPath(uint64_t key) const;
+
+    physx::PxPhysics &_physics;
+    physx::PxCooking &_cooking;
+    ccstd::string _cacheDirectory;
+    ccstd::unordered_map<uint64_t, physx::PxBase *> _objects;
+    uint32_t _memoryHits{0};
+    uint32_t _diskHits{0};
+    uint32_t _cookCount{0};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(PhysXMeshCache);
+};
+
+} // namespace physics
+} // namespace cc
@@ -69,7 +69,7 @@ void PhysXRigidBody::onDestroy() {
 
 bool PhysXRigidBody::isAwake() {
     if (!getSharedBody().isInWorld() || getSharedBody().isStatic()) return false;
-    return !getSharedBody().getImpl().rigidDynamic->isSleeping();
+    return !getSharedBody().peekImpl().rigidDynamic->isSleeping();
 }
 
 bool PhysXRigidBody::isSleepy() {
@@ -78,7 +78,7 @@ bool PhysXRigidBody::isSleepy() {
 
 bool PhysXRigidBody::isSleeping() {
     if (!getSharedBody().isInWorld() || getSharedBody().isStatic()) return true;
-    return getSharedBody().getImpl().rigidDynamic->isSleeping();
+    return getSharedBody().peekImpl().rigidDynamic->isSleeping();
 }
 
 void PhysXRigidBody::setType(ERigidBodyType v) {
@@ -161,13 +161,13 @@ void PhysXRigidBody::setSleepThreshold(float v) {
 }
 
 float PhysXRigidBody::getSleepThreshold() {
-    return getSharedBody().getImpl().rigidDynamic->getSleepThreshold();
+    return getSharedBody().peekImpl().rigidDynamic->getSleepThreshold();
 }
 
 cc::Vec3 PhysXRigidBody::getLinearVelocity() {
     if (getSharedBody().isStatic()) return cc::Vec3::ZERO;
     cc::Vec3 cv;
-    pxSetVec3Ext(cv, getSharedBody().getImpl().rigidDynamic->getLinearVelocity());
+    pxSetVec3Ext(cv, getSharedBody().peekImpl().rigidDynamic->getLinearVelocity());
     return cv;
 }
 
@@ -179,7 +179,7 @@ void PhysXRigidBody::setLinearVelocity(float x, float y, float z) {
 cc::Vec3 PhysXRigidBody::getAngularVelocity() {
     if (getSharedBody().isStatic()) return cc::Vec3::ZERO;
     cc::Vec3 cv;
-    pxSetVec3Ext(cv, getSharedBody().getImpl().rigidDynamic->getAngularVelocity());
+    pxSetVec3Ext(cv, getSharedBody().peekImpl().rigidDynamic->getAngularVelocity());
     return cv;
 }
 
@@ -58,6 +58,7 @@ PhysXSharedBody::PhysXSharedBody(
                                   _mIsStatic(true),
                                   _mIndex(-1),
                                   _mFilterData(1, 1, 0, 0),
+                                  _mPoseSynced(false),
                                   _mStaticActor(nullptr),
                                   _mDynamicActor(nullptr),
                                   _mWrappedWorld(world),
@@ -86,12 +87,18 @@ PhysXSharedBody *PhysXSharedBody::getSharedBody(const Node *node, PhysXWorld *co
 }
 
 PhysXSharedBody::~PhysXSharedBody() {
+    _mWrappedWorld->fetchPendingResults();
     sharedBodesMap.erase(_mNode);
     if (_mStaticActor != nullptr) PX_RELEASE(_mStaticActor);
     if (_mDynamicActor != nullptr) PX_RELEASE(_mDynamicActor);
 }
 
 PhysXSharedBody::UActor PhysXSharedBody::getImpl() {
+    _mWrappedWorld->fetchPendingResults();
+    return peekImpl();
+}
+
+PhysXSharedBody::UActor PhysXSharedBody::peekImpl() {
     initActor();
     _mImpl.ptr = isStatic() ? reinterpret_cast<uintptr_t>(_mStaticActor) : reinterpret_cast<uintptr_t>(_mDynamicActor);
     return _mImpl;
@@ -99,6 +106,7 @@ PhysXSharedBody::UActor PhysXSharedBody::getImpl() {
 
 void PhysXSharedBody::setType(ERigidBodyType v) {
     if (_mType == v) return;
+    _mWrappedWorld->fetchPendingResults();
     _mType = v;
     initActor();
     if (isStatic()) {
@@ -148,6 +156,9 @@ void PhysXSharedBody::initActor() {
 
 void PhysXSharedBody::switchActor(const bool isStaticBefore) {
     if (_mStaticActor == nullptr || _mDynamicActor == nullptr) return;
+    _mWrappedWorld->fetchPendingResults();
+    // the other actor still has the pose it was created with
+    _mPoseSynced = false;
     PxRigidActor &a0 = isStaticBefore ? *reinterpret_cast<PxRigidActor *>(_mStaticActor) : *reinterpret_cast<PxRigidActor *>(_mDynamicActor);
     PxRigidActor &a1 = !isStaticBefore ? *reinterpret_cast<PxRigidActor *>(_mStaticActor) : *reinterpret_cast<PxRigidActor *>(_mDynamicActor);
     if (_mIndex >= 0) {
@@ -206,57 +217,84 @@ void PhysXSharedBody::syncScale() {
     }
 }
 
+PxTransform PhysXSharedBody::getNodePose() const {
+    PxTransform pose;
+    getNode()->updateWorldTransform();
+    pxSetVec3Ext(pose.p, getNode()->getWorldPosition());
+    pxSetQuatExt(pose.q, getNode()->getWorldRotation());
+    return pose;
+}
+
+bool PhysXSharedBody::isSyncedPose(const PxTransform &np) const {
+    // the actor was left at this pose, or is being simulated from it
+    return _mPoseSynced && np.p == _mSyncedPose.p && np.q == _mSyncedPose.q;
+}
+
+void PhysXSharedBody::writeNodePose(const PxTransform &np, uint32_t flags, bool asKinematicTarget) {
+    const bool simulating = _mWrappedWorld->isSimulating();
+    _mWrappedWorld->fetchPendingResults();
+    auto wp = getImpl().rigidActor->getGlobalPose();
+    if (flags & static_cast<uint32_t>(TransformBit::POSITION)) wp.p = np.p;
+    if (flags & static_cast<uint32_t>(TransformBit::ROTATION)) wp.q = np.q;
+
+    if (asKinematicTarget) {
+        getImpl().rigidDynamic->setKinematicTarget(wp);
+    } else {
+        getImpl().rigidActor->setGlobalPose(wp, true);
+    }
+    if (simulating && !isStaticOrKinematic()) {
+        // the fetch wrote the simulated pose to the node, the one read from it before wins
+        getNode()->setWorldPosition(wp.p.x, wp.p.y, wp.p.z);
+        getNode()->setWorldRotation(wp.q.x, wp.q.y, wp.q.z, wp.q.w);
+    }
+    _mSyncedPose = getNodePose();
+    _mPoseSynced = true;
+}
+
 void PhysXSharedBody::syncSceneToPhysics() {
     uint32_t getChangedFlags = getNode()->getChangedFlags();
     if (getChangedFlags) {
         if (getChangedFlags & static_cast<uint32_t>(TransformBit::SCALE)) syncScale();
-        auto wp = getImpl().rigidActor->getGlobalPose();
-        if (getChangedFlags & static_cast<uint32_t>(TransformBit::POSITION)) {
-            getNode()->updateWorldTransform();
-            pxSetVec3Ext(wp.p, getNode()->getWorldPosition());
-        }
-        if (getChangedFlags & static_cast<uint32_t>(TransformBit::ROTATION)) {
-            getNode()->updateWorldTransform();
-            pxSetQuatExt(wp.q, getNode()->getWorldRotation());
-        }
-
-        if (isKinematic()) {
-            getImpl().rigidDynamic->setKinematicTarget(wp);
-        } else {
-            getImpl().rigidActor->setGlobalPose(wp, true);
-        }
+        // syncPhysicsToScene flags every awake body, only a node moved since then needs a write, which
+        // completes a step left running by the async mode
+        const auto np = getNodePose();
+        if (isSyncedPose(np)) return;
+        writeNodePose(np, getChangedFlags, isKinematic());
     }
 }
 
 void PhysXSharedBody::syncSceneWithCheck() {
     if (getNode()->getChangedFlags() & static_cast<uint32_t>(TransformBit::SCALE)) syncScale();
-    auto wp = getImpl().rigidActor->getGlobalPose();
-    bool needUpdate = false;
-    getNode()->updateWorldTransform();
+    const auto np = getNodePose();
+    if (isSyncedPose(np)) return;
+    const auto wp = peekImpl().rigidActor->getGlobalPose();
+    uint32_t flags = 0;
     if (wp.p != getNode()->getWorldPosition()) {
-        pxSetVec3Ext(wp.p, getNode()->getWorldPosition());
-        needUpdate = true;
+        flags |= static_cast<uint32_t>(TransformBit::POSITION);
     }
     const auto nr = getNode()->getWorldRotation();
     if (wp.q.x != nr.x && wp.q.y != nr.y && wp.q.z != nr.z) {
-        pxSetQuatExt(wp.q, getNode()->getWorldRotation());
-        needUpdate = true;
+        flags |= static_cast<uint32_t>(TransformBit::ROTATION);
     }
-    if (needUpdate) {
-        getImpl().rigidActor->setGlobalPose(wp, true);
+    if (flags) {
+        writeNodePose(np, flags, false);
     }
 }
 
 void PhysXSharedBody::syncPhysicsToScene() {
     if (isStaticOrKinematic()) return;
     if (_mDynamicActor->isSleeping()) return;
-    const PxTransform &wp = getImpl().rigidActor->getGlobalPose();
+    const PxTransform &wp = peekImpl().rigidActor->getGlobalPose();
     getNode()->setWorldPosition(wp.p.x, wp.p.y, wp.p.z);
     getNode()->setWorldRotation(wp.q.x, wp.q.y, wp.q.z, wp.q.w);
     getNode()->setChangedFlags(getNode()->getChangedFlags() | static_cast<uint32_t>(TransformBit::POSITION) | static_cast<uint32_t>(TransformBit::ROTATION));
+    // read back as the next syncSceneToPhysics sees it, a parent transform rounds it a little
+    _mSyncedPose = getNodePose();
+    _mPoseSynced = true;
 }
 
 void PhysXSharedBody::addShape(const PhysXShape &shape) {
+    _mWrappedWorld->fetchPendingResults();
     auto beg = _mWrappedShapes.begin();
     auto end = _mWrappedShapes.end();
     auto iter = find(beg, end, &shape);
@@ -272,6 +310,7 @@ void PhysXSharedBody::addShape(const PhysXShape &shape) {
 }
 
 void PhysXSharedBody::removeShape(const PhysXShape &shape) {
+    _mWrappedWorld->fetchPendingResults();
     auto beg = _mWrappedShapes.begin();
     auto end = _mWrappedShapes.end();
     auto iter = find(beg, end, &shape);
@@ -285,6 +324,7 @@ void PhysXSharedBody::removeShape(const PhysXShape &shape) {
 }
 
 void PhysXSharedBody::addJoint(const PhysXJoint &joint, const PxJointActorIndex::Enum index) {
+    _mWrappedWorld->fetchPendingResults();
     if (index == PxJointActorIndex::eACTOR1) {
         auto beg = _mWrappedJoints1.begin();
         auto end = _mWrappedJoints1.end();
@@ -299,6 +339,7 @@ void PhysXSharedBody::addJoint(const PhysXJoint &joint, const PxJointActorIndex:
 }
 
 void PhysXSharedBody::removeJoint(const PhysXJoint &joint, const PxJointActorIndex::Enum index) {
+    _mWrappedWorld->fetchPendingResults();
     if (index == PxJointActorIndex::eACTOR1) {
         auto beg = _mWrappedJoints1.begin();
         auto end = _mWrappedJoints1.end();
@@ -329,6 +370,7 @@ void PhysXSharedBody::setMask(uint32_t v) {
 }
 
 void PhysXSharedBody::setCollisionFilter(const PxFilterData &data) {
+    _mWrappedWorld->fetchPendingResults();
     if (isDynamic()) _mDynamicActor->wakeUp();
     for (auto const &ws : _mWrappedShapes) {
         ws->getShape().setQueryFilterData(data);
@@ -339,6 +381,7 @@ void PhysXSharedBody::setCollisionFilter(const PxFilterData &data) {
 void PhysXSharedBody::clearForces() {
     if (!isInWorld()) return;
     if (isStaticOrKinematic()) return;
+    _mWrappedWorld->fetchPendingResults();
     _mDynamicActor->clearForce(PxForceMode::eFORCE);
     _mDynamicActor->clearForce(PxForceMode::eIMPULSE);
     _mDynamicActor->clearTorque(PxForceMode::eFORCE);
@@ -347,6 +390,7 @@ void PhysXSharedBody::clearForces() {
 
 void PhysXSharedBody::clearVelocity() {
     if (isStaticOrKinematic()) return;
+    _mWrappedWorld->fetchPendingResults();
     _mDynamicActor->setLinearVelocity(PxVec3{PxIdentity}, false);
     _mDynamicActor->setAngularVelocity(PxVec3{PxIdentity}, false);
 }
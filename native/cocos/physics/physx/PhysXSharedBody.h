@@ -61,7 +61,10 @@ public:
         physx::PxRigidStatic *rigidStatic;
         physx::PxRigidDynamic *rigidDynamic;
     };
+    // completes a simulation left running by the async step first, for writes to the actor
     UActor getImpl();
+    // leaves a running async step alone, PhysX reads return the state from before it
+    UActor peekImpl();
     void setType(ERigidBodyType v);
     void setMass(float v);
     void syncScale();
@@ -91,6 +94,8 @@ private:
     physx::PxFilterData _mFilterData;
     Node *_mNode;
     UActor _mImpl;
+    bool _mPoseSynced;
+    physx::PxTransform _mSyncedPose;
     physx::PxRigidStatic *_mStaticActor;
     physx::PxRigidDynamic *_mDynamicActor;
     PhysXWorld *_mWrappedWorld;
@@ -104,6 +109,9 @@ private:
     void switchActor(bool isStaticBefore);
     void initStaticActor();
     void initDynamicActor();
+    physx::PxTransform getNodePose() const;
+    bool isSyncedPose(const physx::PxTransform &np) const;
+    void writeNodePose(const physx::PxTransform &np, uint32_t flags, bool asKinematicTarget);
 };
 
 } // namespace physics
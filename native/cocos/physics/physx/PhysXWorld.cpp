@@ -24,7 +24,10 @@
 ****************************************************************************/
 
 #include "physics/physx/PhysXWorld.h"
+#include <algorithm>
+#include "base/job-system/JobSystem.h"
 #include "base/memory/Memory.h"
+#include "platform/FileUtils.h"
 #include "physics/physx/PhysXFilterShader.h"
 #include "physics/physx/PhysXInc.h"
 #include "physics/physx/PhysXUtils.h"
@@ -34,6 +37,121 @@
 namespace cc {
 namespace physics {
 
+namespace {
+
+constexpr uint32_t SCENE_QUERIES_PER_JOB{64};
+
+physx::PxSceneQueryFilterData getSceneQueryFilterData(const SceneQuery &query, bool singleHit) {
+    physx::PxSceneQueryFilterData filterData;
+    filterData.data.word0 = query.mask;
+    filterData.data.word3 = QUERY_FILTER | (query.queryTrigger ? 0 : QUERY_CHECK_TRIGGER) | (singleHit ? QUERY_SINGLE_HIT : 0);
+    filterData.flags = physx::PxQueryFlag::eSTATIC | physx::PxQueryFlag::eDYNAMIC | physx::PxQueryFlag::ePREFILTER;
+    return filterData;
+}
+
+physx::PxGeometryHolder getSceneQueryGeometry(const SceneQuery &query) {
+    switch (query.type) {
+        case ESceneQueryType::SWEEP_BOX:
+        case ESceneQueryType::OVERLAP_BOX:
+            return physx::PxBoxGeometry{query.extents[0], query.extents[1], query.extents[2]};
+        case ESceneQueryType::SWEEP_SPHERE:
+        case ESceneQueryType::OVERLAP_SPHERE:
+            return physx::PxSphereGeometry{query.extents[0]};
+        default:
+            return physx::PxCapsuleGeometry{query.extents[0], query.extents[1]};
+    }
+}
+
+physx::PxTransform getSceneQueryPose(const SceneQuery &query) {
+    physx::PxQuat rotation{query.rotation[0], query.rotation[1], query.rotation[2], query.rotation[3]};
+    if (query.type == ESceneQueryType::SWEEP_CAPSULE || query.type == ESceneQueryType::OVERLAP_CAPSULE) {
+        // capsules of PhysX are along x
+        rotation = rotation * physx::PxQuat(physx::PxPiDivTwo, physx::PxVec3{0.F, 0.F, 1.F});
+    }
+    return physx::PxTransform{physx::PxVec3{query.origin[0], query.origin[1], query.origin[2]}, rotation};
+}
+
+bool setSceneQueryHit(SceneQueryHit &out, const physx::PxQueryHit &hit) {
+    const auto &shapeIter = getPxShapeMap().find(reinterpret_cast<uintptr_t>(hit.shape));
+    if (shapeIter == getPxShapeMap().end()) return false;
+    out.shape = shapeIter->second;
+    return true;
+}
+
+bool setSceneQueryHit(SceneQueryHit &out, const physx::PxLocationHit &hit) {
+    if (!setSceneQueryHit(out, static_cast<const physx::PxQueryHit &>(hit))) return false;
+    out.distance = hit.distance;
+    out.hitPoint[0] = hit.position.x;
+    out.hitPoint[1] = hit.position.y;
+    out.hitPoint[2] = hit.position.z;
+    out.hitNormal[0] = hit.normal.x;
+    out.hitNormal[1] = hit.normal.y;
+    out.hitNormal[2] = hit.normal.z;
+    return true;
+}
+
+// scratch buffers of one job, so queries on different workers never share them
+struct SceneQueryScratch {
+    ccstd::vector<physx::PxRaycastHit> raycastHits;
+    ccstd::vector<physx::PxOverlapHit> overlapHits;
+};
+
+uint32_t runSceneQuery(physx::PxScene &scene, const SceneQuery &query, SceneQueryHit *hits, uint32_t maxHits, SceneQueryScratch &scratch) {
+    const physx::PxHitFlags flags = physx::PxHitFlag::ePOSITION | physx::PxHitFlag::eNORMAL;
+    physx::PxVec3 unitDir{query.unitDir[0], query.unitDir[1], query.unitDir[2]};
+    unitDir.normalize();
+    uint32_t count = 0;
+    switch (query.type) {
+        case ESceneQueryType::RAYCAST: {
+            scratch.raycastHits.resize(maxHits);
+            bool blockingHit = false;
+            const auto nbTouches = physx::PxSceneQueryExt::raycastMultiple(
+                scene, physx::PxVec3{query.origin[0], query.origin[1], query.origin[2]}, unitDir, query.distance, flags,
+                scratch.raycastHits.data(), maxHits, blockingHit, getSceneQueryFilterData(query, false), &getQueryFilterShader());
+            // -1 means the buffer overflowed, it is still filled with maxHits touches
+            const auto nbHits = nbTouches < 0 ? maxHits : static_cast<uint32_t>(nbTouches);
+            for (uint32_t i = 0; i < nbHits; ++i) {
+                count += setSceneQueryHit(hits[count], scratch.raycastHits[i]) ? 1 : 0;
+            }
+            break;
+        }
+        case ESceneQueryType::RAYCAST_CLOSEST: {
+            physx::PxRaycastHit hit;
+            if (physx::PxSceneQueryExt::raycastSingle(
+                    scene, physx::PxVec3{query.origin[0], query.origin[1], query.origin[2]}, unitDir, query.distance, flags,
+                    hit, getSceneQueryFilterData(query, true), &getQueryFilterShader())) {
+                count += setSceneQueryHit(hits[0], hit) ? 1 : 0;
+            }
+            break;
+        }
+        case ESceneQueryType::SWEEP_BOX:
+        case ESceneQueryType::SWEEP_SPHERE:
+        case ESceneQueryType::SWEEP_CAPSULE: {
+            physx::PxSweepHit hit;
+            if (physx::PxSceneQueryExt::sweepSingle(
+                    scene, getSceneQueryGeometry(query).any(), getSceneQueryPose(query), unitDir, query.distance, flags,
+                    hit, getSceneQueryFilterData(query, true), &getQueryFilterShader())) {
+                count += setSceneQueryHit(hits[0], hit) ? 1 : 0;
+            }
+            break;
+        }
+        default: {
+            scratch.overlapHits.resize(maxHits);
+            const auto nbTouches = physx::PxSceneQueryExt::overlapMultiple(
+                scene, getSceneQueryGeometry(query).any(), getSceneQueryPose(query),
+                scratch.overlapHits.data(), maxHits, getSceneQueryFilterData(query, false), &getQueryFilterShader());
+            const auto nbHits = nbTouches < 0 ? maxHits : static_cast<uint32_t>(nbTouches);
+            for (uint32_t i = 0; i < nbHits; ++i) {
+                count += setSceneQueryHit(hits[count], scratch.overlapHits[i]) ? 1 : 0;
+            }
+            break;
+        }
+    }
+    return count;
+}
+
+} // namespace
+
 PhysXWorld *PhysXWorld::instance = nullptr;
 uint32_t PhysXWorld::_msWrapperObjectID = 0;
 uint32_t PhysXWorld::_msPXObjectID = 0;
@@ -70,7 +188,12 @@ PhysXWorld::PhysXWorld() {
 #endif
     _mPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *_mFoundation, scale, true, pvd);
     PxInitExtensions(*_mPhysics, pvd);
-    _mDispatcher = physx::PxDefaultCpuDispatcherCreate(0);
+    _mMeshCache = ccnew PhysXMeshCache(*_mPhysics, *_mCooking);
+    auto meshCachePath = FileUtils::getInstance()->getWritablePath() + "physx-mesh-cache/";
+    if (FileUtils::getInstance()->createDirectory(meshCachePath)) {
+        _mMeshCache->setCacheDirectory(meshCachePath);
+    }
+    _mDispatcher = ccnew PhysXJobDispatcher();
 
     _mEventMgr = ccnew PhysXEventManager();
 
@@ -80,6 +203,8 @@ PhysXWorld::PhysXWorld() {
     sceneDesc.kineKineFilteringMode = physx::PxPairFilteringMode::eKEEP;
     sceneDesc.staticKineFilteringMode = physx::PxPairFilteringMode::eKEEP;
     sceneDesc.flags |= physx::PxSceneFlag::eENABLE_CCD;
+    // results must not depend on how the tasks were spread over the workers
+    sceneDesc.flags |= physx::PxSceneFlag::eENABLE_ENHANCED_DETERMINISM;
     sceneDesc.filterShader = simpleFilterShader;
     sceneDesc.simulationEventCallback = &_mEventMgr->getEventCallback();
     _mScene = _mPhysics->createScene(sceneDesc);
@@ -87,16 +212,21 @@ PhysXWorld::PhysXWorld() {
     _mCollisionMatrix[0] = 1;
 
     createMaterial(0, 0.6F, 0.6F, 0.1F, 2, 2);
+
+    // the Tick event is broadcast between two frames, after the previous one has been rendered
+    _mTickListener.bind([this](float /*dt*/) { fetchPendingResults(); });
 }
 
 PhysXWorld::~PhysXWorld() {
+    fetchPendingResults();
     auto &materialMap = getPxMaterialMap();
     // clear material cache
     materialMap.clear();
     delete _mEventMgr;
     PhysXJoint::releaseTempRigidActor();
     PX_RELEASE(_mScene);
-    PX_RELEASE(_mDispatcher);
+    CC_SAFE_DELETE(_mDispatcher);
+    CC_SAFE_DELETE(_mMeshCache);
     PX_RELEASE(_mPhysics);
 #ifdef CC_DEBUG
     physx::PxPvdTransport *transport = _mPvd->getTransport();
@@ -110,16 +240,43 @@ PhysXWorld::~PhysXWorld() {
 }
 
 void PhysXWorld::step(float fixedTimeStep) {
+    // sub steps run in the same order in both modes, only the last one of a frame is left running
+    fetchPendingResults();
     _mScene->simulate(fixedTimeStep);
+    if (_mAsyncStep) {
+        _mSimulating = true;
+        return;
+    }
     _mScene->fetchResults(true);
+    _mDispatcher->reclaim();
+    syncPhysicsToScene();
+}
+
+void PhysXWorld::setAsyncStep(bool v) {
+    if (!v) {
+        fetchPendingResults();
+    }
+    _mAsyncStep = v;
+}
+
+void PhysXWorld::fetchPendingResults() {
+    if (!_mSimulating) {
+        return;
+    }
+    _mSimulating = false;
+    _mScene->fetchResults(true);
+    _mDispatcher->reclaim();
     syncPhysicsToScene();
 }
 
 void PhysXWorld::setGravity(float x, float y, float z) {
+    // scene settings can not be changed while a simulation is running
+    fetchPendingResults();
     _mScene->setGravity(physx::PxVec3(x, y, z));
 }
 
 void PhysXWorld::destroy() {
+    fetchPendingResults();
 }
 
 void PhysXWorld::setCollisionMatrix(uint32_t index, uint32_t mask) {
@@ -133,7 +290,7 @@ uint32_t PhysXWorld::createConvex(ConvexDesc &desc) {
     convexDesc.points.stride = sizeof(physx::PxVec3);
     convexDesc.points.data = static_cast<physx::PxVec3 *>(desc.positions);
     convexDesc.flags = physx::PxConvexFlag::eCOMPUTE_CONVEX;
-    physx::PxConvexMesh *convexMesh = getCooking().createConvexMesh(convexDesc, PxGetPhysics().getPhysicsInsertionCallback());
+    physx::PxConvexMesh *convexMesh = _mMeshCache->getConvexMesh(convexDesc);
     uint32_t pxObjectID = addPXObject(reinterpret_cast<uintptr_t>(convexMesh));
     return pxObjectID;
 }
@@ -152,7 +309,7 @@ uint32_t PhysXWorld::createTrimesh(TrimeshDesc &desc) {
         meshDesc.triangles.stride = 3 * sizeof(physx::PxU32);
         meshDesc.triangles.data = static_cast<physx::PxU32 *>(desc.triangles);
     }
-    physx::PxTriangleMesh *triangleMesh = getCooking().createTriangleMesh(meshDesc, PxGetPhysics().getPhysicsInsertionCallback());
+    physx::PxTriangleMesh *triangleMesh = _mMeshCache->getTriangleMesh(meshDesc);
     uint32_t pxObjectID = addPXObject(reinterpret_cast<uintptr_t>(triangleMesh));
     return pxObjectID;
 }
@@ -161,7 +318,8 @@ uint32_t PhysXWorld::createHeightField(HeightFieldDesc &desc) {
     const auto rows = desc.rows;
     const auto columns = desc.columns;
     const physx::PxU32 counts = rows * columns;
-    auto *samples = ccnew physx::PxHeightFieldSample[counts];
+    // zeroed, material indices are part of the cooked data and of the cache key
+    auto *samples = ccnew physx::PxHeightFieldSample[counts]();
     for (physx::PxU32 r = 0; r < rows; r++) {
         for (physx::PxU32 c = 0; c < columns; c++) {
             const auto index = c + r * columns;
@@ -174,7 +332,7 @@ uint32_t PhysXWorld::createHeightField(HeightFieldDesc &desc) {
     hfDesc.nbColumns = columns;
     hfDesc.samples.data = samples;
     hfDesc.samples.stride = sizeof(physx::PxHeightFieldSample);
-    physx::PxHeightField *hf = getCooking().createHeightField(hfDesc, PxGetPhysics().getPhysicsInsertionCallback());
+    physx::PxHeightField *hf = _mMeshCache->getHeightField(hfDesc);
     delete[] samples;
     uint32_t pxObjectID = addPXObject(reinterpret_cast<uintptr_t>(hf));
     return pxObjectID;
@@ -182,6 +340,7 @@ uint32_t PhysXWorld::createHeightField(HeightFieldDesc &desc) {
 
 bool PhysXWorld::createMaterial(uint16_t id, float f, float df, float r,
                                 uint8_t m0, uint8_t m1) {
+    fetchPendingResults();
     physx::PxMaterial *mat;
     auto &m = getPxMaterialMap();
     if (m.find(id) == m.end()) {
@@ -243,6 +402,7 @@ void PhysXWorld::setAllowSleep(bool val) {
 }
 
 void PhysXWorld::addActor(const PhysXSharedBody &sb) {
+    fetchPendingResults();
     auto beg = _mSharedBodies.begin();
     auto end = _mSharedBodies.end();
     auto iter = find(beg, end, &sb);
@@ -253,6 +413,7 @@ void PhysXWorld::addActor(const PhysXSharedBody &sb) {
 }
 
 void PhysXWorld::removeActor(const PhysXSharedBody &sb) {
+    fetchPendingResults();
     auto beg = _mSharedBodies.begin();
     auto end = _mSharedBodies.end();
     auto iter = find(beg, end, &sb);
@@ -331,6 +492,40 @@ RaycastResult &PhysXWorld::raycastClosestResult() {
     return hit;
 }
 
+uint32_t PhysXWorld::sceneQuery(SceneQueryBatch &batch, uint32_t count) {
+    count = std::min(count, batch.getCapacity());
+    if (count == 0) return 0;
+
+    const auto job = [&](uint32_t jobIndex) {
+        SceneQueryScratch scratch;
+        const uint32_t end = std::min(count, (jobIndex + 1) * SCENE_QUERIES_PER_JOB);
+        for (uint32_t i = jobIndex * SCENE_QUERIES_PER_JOB; i < end; ++i) {
+            batch.hitCounts[i] = runSceneQuery(getScene(), batch.queries[i], &batch.hits[i * batch.maxHits], batch.maxHits, scratch);
+        }
+    };
+    const uint32_t jobCount = (count + SCENE_QUERIES_PER_JOB - 1) / SCENE_QUERIES_PER_JOB;
+    if (jobCount > 1) {
+        // scene queries only read the scene, they may run concurrently
+        JobGraph graph(JobSystem::getInstance(), "PhysXSceneQuery");
+        graph.createForEachIndexJob(1U, jobCount, 1U, job);
+        graph.run();
+        job(0);
+        graph.waitForAll();
+    } else {
+        job(0);
+    }
+
+    uint32_t hitQueries = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        hitQueries += batch.hitCounts[i] > 0 ? 1 : 0;
+    }
+    return hitQueries;
+}
+
+SceneQueryBatch &PhysXWorld::sceneQueryBatch() {
+    return _mSceneQueryBatch;
+}
+
 uint32_t PhysXWorld::addPXObject(uintptr_t PXObjectPtr) {
     uint32_t pxObjectID = _msPXObjectID;
     _msPXObjectID++;
@@ -29,9 +29,12 @@
 #include "base/Macros.h"
 #include "base/std/container/vector.h"
 #include "core/scene-graph/Node.h"
+#include "engine/EngineEvents.h"
 #include "physics/physx/PhysXEventManager.h"
 #include "physics/physx/PhysXFilterShader.h"
 #include "physics/physx/PhysXInc.h"
+#include "physics/physx/PhysXJobDispatcher.h"
+#include "physics/physx/PhysXMeshCache.h"
 #include "physics/physx/PhysXRigidBody.h"
 #include "physics/physx/PhysXSharedBody.h"
 #include "physics/spec/IWorld.h"
@@ -44,10 +47,12 @@ public:
     static PhysXWorld &getInstance();
     static physx::PxFoundation &getFundation();
     static physx::PxCooking &getCooking();
+    inline PhysXMeshCache &getMeshCache() const { return *_mMeshCache; }
     static physx::PxPhysics &getPhysics();
     PhysXWorld();
     ~PhysXWorld() override;
     void step(float fixedTimeStep) override;
+    void setAsyncStep(bool v) override;
     void setGravity(float x, float y, float z) override;
     void setAllowSleep(bool v) override;
     void emitEvents() override;
@@ -56,6 +61,8 @@ public:
     bool raycastClosest(RaycastOptions &opt) override;
     ccstd::vector<RaycastResult> &raycastResult() override;
     RaycastResult &raycastClosestResult() override;
+    uint32_t sceneQuery(SceneQueryBatch &batch, uint32_t count) override;
+    SceneQueryBatch &sceneQueryBatch() override;
     uint32_t createConvex(ConvexDesc &desc) override;
     uint32_t createTrimesh(TrimeshDesc &desc) override;
     uint32_t createHeightField(HeightFieldDesc &desc) override;
@@ -80,6 +87,11 @@ public:
     inline physx::PxScene &getScene() const { return *_mScene; }
     uint32_t getMaskByIndex(uint32_t i);
     void syncPhysicsToScene();
+    // completes a simulation left running by the async step, every write to the scene or to its bodies,
+    // shapes and joints calls it first as PhysX ignores or defers writes while simulating
+    void fetchPendingResults();
+    inline bool isAsyncStep() const { return _mAsyncStep; }
+    inline bool isSimulating() const { return _mSimulating; }
     void addActor(const PhysXSharedBody &sb);
     void removeActor(const PhysXSharedBody &sb);
 
@@ -99,15 +111,20 @@ private:
     static PhysXWorld *instance;
     physx::PxFoundation *_mFoundation;
     physx::PxCooking *_mCooking;
+    PhysXMeshCache *_mMeshCache;
     physx::PxPhysics *_mPhysics;
 #ifdef CC_DEBUG
     physx::PxPvd *_mPvd;
 #endif
-    physx::PxDefaultCpuDispatcher *_mDispatcher;
+    PhysXJobDispatcher *_mDispatcher;
     physx::PxScene *_mScene;
     PhysXEventManager *_mEventMgr;
     uint32_t _mCollisionMatrix[31];
     ccstd::vector<PhysXSharedBody *> _mSharedBodies;
+    bool _mAsyncStep{false};
+    bool _mSimulating{false};
+    events::Tick::Listener _mTickListener;
+    SceneQueryBatch _mSceneQueryBatch;
 
     static uint32_t _msWrapperObjectID;
     static uint32_t _msPXObjectID;
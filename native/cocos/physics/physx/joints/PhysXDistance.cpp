@@ -27,6 +27,7 @@
 #include "math/Quaternion.h"
 #include "physics/physx/PhysXSharedBody.h"
 #include "physics/physx/PhysXUtils.h"
+#include "physics/physx/PhysXWorld.h"
 
 namespace cc {
 namespace physics {
@@ -54,6 +55,7 @@ void PhysXDistance::updateScale1() {
 }
 
 void PhysXDistance::updatePose() {
+    PhysXWorld::getInstance().fetchPendingResults();
     physx::PxTransform pose0{physx::PxIdentity};
     physx::PxTransform pose1{physx::PxIdentity};
     auto *node0 = _mSharedBody->getNode();
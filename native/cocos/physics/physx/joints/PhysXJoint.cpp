@@ -59,6 +59,7 @@ void PhysXJoint::onEnable() {
 }
 
 void PhysXJoint::onDisable() {
+    PhysXWorld::getInstance().fetchPendingResults();
     _mJoint->setActors(&getTempRigidActor(), nullptr);
     _mSharedBody->removeJoint(*this, physx::PxJointActorIndex::eACTOR0);
     if (_mConnectedBody) _mConnectedBody->removeJoint(*this, physx::PxJointActorIndex::eACTOR1);
@@ -88,6 +89,7 @@ void PhysXJoint::setConnectedBody(uint32_t rigidBodyID) {
 void PhysXJoint::setEnableCollision(const bool v) {
     _mEnableCollision = v;
     if (_mJoint) {
+        PhysXWorld::getInstance().fetchPendingResults();
         _mJoint->setConstraintFlag(physx::PxConstraintFlag::eCOLLISION_ENABLED, _mEnableCollision);
     }
 }
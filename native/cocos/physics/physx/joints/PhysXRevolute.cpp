@@ -27,6 +27,7 @@
 #include "math/Quaternion.h"
 #include "physics/physx/PhysXSharedBody.h"
 #include "physics/physx/PhysXUtils.h"
+#include "physics/physx/PhysXWorld.h"
 
 namespace cc {
 namespace physics {
@@ -59,6 +60,7 @@ void PhysXRevolute::updateScale1() {
 }
 
 void PhysXRevolute::updatePose() {
+    PhysXWorld::getInstance().fetchPendingResults();
     physx::PxTransform pose0{physx::PxIdentity};
     physx::PxTransform pose1{physx::PxIdentity};
     auto *node0 = _mSharedBody->getNode();
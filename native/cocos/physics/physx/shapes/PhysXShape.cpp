@@ -40,6 +40,11 @@ PhysXShape::~PhysXShape() {
     PhysXWorld::getInstance().removeWrapperObject(_mObjectID);
 }
 
+physx::PxShape &PhysXShape::getShape() const {
+    PhysXWorld::getInstance().fetchPendingResults();
+    return *_mShape;
+}
+
 void PhysXShape::initialize(Node *node) {
     PhysXWorld &ins = PhysXWorld::getInstance();
     _mSharedBody = ins.getSharedBody(node);
@@ -114,7 +119,7 @@ void PhysXShape::updateEventListener(EShapeFilterFlag flag) {
 geometry::AABB &PhysXShape::getAABB() {
     static geometry::AABB aabb;
     if (_mShape) {
-        auto bounds = physx::PxShapeExt::getWorldBounds(getShape(), *getSharedBody().getImpl().rigidActor);
+        auto bounds = physx::PxShapeExt::getWorldBounds(peekShape(), *getSharedBody().peekImpl().rigidActor);
         pxSetVec3Ext(aabb.center, (bounds.maximum + bounds.minimum) / 2);
         pxSetVec3Ext(aabb.halfExtents, (bounds.maximum - bounds.minimum) / 2);
     }
@@ -141,13 +146,13 @@ void PhysXShape::updateCenter() {
 
 void PhysXShape::insertToShapeMap() {
     if (_mShape) {
-        getPxShapeMap().insert(std::pair<uintptr_t, uint32_t>(reinterpret_cast<uintptr_t>(&getShape()), getObjectID()));
+        getPxShapeMap().insert(std::pair<uintptr_t, uint32_t>(reinterpret_cast<uintptr_t>(&peekShape()), getObjectID()));
     }
 }
 
 void PhysXShape::eraseFromShapeMap() {
     if (_mShape) {
-        getPxShapeMap().erase(reinterpret_cast<uintptr_t>(&getShape()));
+        getPxShapeMap().erase(reinterpret_cast<uintptr_t>(&peekShape()));
     }
 }
 
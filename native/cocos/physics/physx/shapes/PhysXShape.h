@@ -63,10 +63,13 @@ public:
     void setMask(uint32_t m) override;
     virtual void updateScale() = 0;
     inline physx::PxVec3 &getCenter() { return _mCenter; }
-    inline physx::PxShape &getShape() const { return *_mShape; }
+    // completes a simulation left running by the async step first, for writes to the shape
+    physx::PxShape &getShape() const;
+    // leaves a running async step alone, PhysX reads return the state from before it
+    inline physx::PxShape &peekShape() const { return *_mShape; }
     inline PhysXSharedBody &getSharedBody() const { return *_mSharedBody; }
     inline bool isTrigger() const {
-        return getShape().getFlags().isSet(physx::PxShapeFlag::eTRIGGER_SHAPE);
+        return peekShape().getFlags().isSet(physx::PxShapeFlag::eTRIGGER_SHAPE);
     }
     void updateFilterData(const physx::PxFilterData &data);
     uint32_t getObjectID() const override { return _mObjectID; };
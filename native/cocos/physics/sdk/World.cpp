@@ -46,6 +46,10 @@ void World::step(float fixedTimeStep) {
     _impl->step(fixedTimeStep);
 }
 
+void World::setAsyncStep(bool v) {
+    _impl->setAsyncStep(v);
+}
+
 void World::setAllowSleep(bool v) {
     _impl->setAllowSleep(v);
 }
@@ -111,5 +115,13 @@ RaycastResult &World::raycastClosestResult() {
     return _impl->raycastClosestResult();
 }
 
+uint32_t World::sceneQuery(SceneQueryBatch &batch, uint32_t count) {
+    return _impl->sceneQuery(batch, count);
+}
+
+SceneQueryBatch &World::sceneQueryBatch() {
+    return _impl->sceneQueryBatch();
+}
+
 } // namespace physics
 } // namespace cc
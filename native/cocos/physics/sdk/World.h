@@ -38,6 +38,7 @@ public:
     void setGravity(float x, float y, float z) override;
     void setAllowSleep(bool v) override;
     void step(float fixedTimeStep) override;
+    void setAsyncStep(bool v) override;
     void emitEvents() override;
     void syncSceneToPhysics() override;
     void syncSceneWithCheck() override;
@@ -48,6 +49,8 @@ public:
     bool raycastClosest(RaycastOptions &opt) override;
     ccstd::vector<RaycastResult> &raycastResult() override;
     RaycastResult &raycastClosestResult() override;
+    uint32_t sceneQuery(SceneQueryBatch &batch, uint32_t count) override;
+    SceneQueryBatch &sceneQueryBatch() override;
     uint32_t createConvex(ConvexDesc &desc) override;
     uint32_t createTrimesh(TrimeshDesc &desc) override;
     uint32_t createHeightField(HeightFieldDesc &desc) override;
@@ -106,6 +106,61 @@ struct RaycastResult {
     RaycastResult() = default;
 };
 
+enum class ESceneQueryType : uint32_t {
+    RAYCAST = 0,
+    RAYCAST_CLOSEST = 1,
+    SWEEP_BOX = 2,
+    SWEEP_SPHERE = 3,
+    SWEEP_CAPSULE = 4,
+    OVERLAP_BOX = 5,
+    OVERLAP_SPHERE = 6,
+    OVERLAP_CAPSULE = 7,
+};
+
+// A query of a batch, 17 words so script can fill a batch through Float32Array and Uint32Array views.
+// Raycasts and sweeps go from origin along unitDir, overlaps test the shape placed at origin.
+struct SceneQuery {
+    ESceneQueryType type{ESceneQueryType::RAYCAST_CLOSEST};
+    uint32_t mask{0xffffffff};
+    uint32_t queryTrigger{1};
+    float distance{0.0F};
+    float origin[3]{};
+    float unitDir[3]{};
+    // box half extents, sphere radius in x, capsule radius in x and half height of the cylinder in y
+    float extents[3]{};
+    // rotation of the shape as quaternion xyzw, the capsule is along its local y axis
+    float rotation[4]{0.0F, 0.0F, 0.0F, 1.0F};
+};
+
+// A hit of a batch, 8 words. Overlaps only write the shape.
+struct SceneQueryHit {
+    uint32_t shape{0};
+    float distance{0.0F};
+    float hitPoint[3]{};
+    float hitNormal[3]{};
+};
+
+// Input and output of IPhysicsWorld::sceneQuery, the hits of query i are
+// hits[i * maxHits, i * maxHits + hitCounts[i]). The batch only borrows its arrays,
+// the owner keeps them alive while the batch points at them.
+struct SceneQueryBatch {
+    SceneQuery *queries{nullptr};
+    SceneQueryHit *hits{nullptr};
+    uint32_t *hitCounts{nullptr};
+    uint32_t capacity{0};
+    uint32_t maxHits{1};
+
+    // queries and hitCounts hold capacity elements, hits capacity * maxHitsPerQuery
+    void attach(SceneQuery *queryData, SceneQueryHit *hitData, uint32_t *hitCountData, uint32_t queryCapacity, uint32_t maxHitsPerQuery) {
+        queries = queryData;
+        hits = hitData;
+        hitCounts = hitCountData;
+        capacity = queryCapacity;
+        maxHits = maxHitsPerQuery > 0 ? maxHitsPerQuery : 1;
+    }
+    inline uint32_t getCapacity() const { return capacity; }
+};
+
 class IPhysicsWorld {
 public:
     virtual ~IPhysicsWorld() = default;
@@ -113,6 +168,9 @@ public:
     virtual void setGravity(float x, float y, float z) = 0;
     virtual void setAllowSleep(bool v) = 0;
     virtual void step(float s) = 0;
+    // When enabled the last step of a frame keeps simulating while the frame is rendered,
+    // its results are fetched and synced to the scene before the next frame starts.
+    virtual void setAsyncStep(bool v) = 0;
     virtual void emitEvents() = 0;
     virtual void syncSceneToPhysics() = 0;
     virtual void syncSceneWithCheck() = 0;
@@ -124,6 +182,10 @@ public:
     virtual bool raycastClosest(RaycastOptions &opt) = 0;
     virtual ccstd::vector<RaycastResult> &raycastResult() = 0;
     virtual RaycastResult &raycastClosestResult() = 0;
+    // Runs the first count queries of the batch in parallel on the job system, returns how many of them hit.
+    virtual uint32_t sceneQuery(SceneQueryBatch &batch, uint32_t count) = 0;
+    // the batch of this world shared with script, it borrows the array buffers created by reserveSceneQueries
+    virtual SceneQueryBatch &sceneQueryBatch() = 0;
     virtual uint32_t createConvex(ConvexDesc &desc) = 0;
     virtual uint32_t createTrimesh(TrimeshDesc &desc) = 0;
     virtual uint32_t createHeightField(HeightFieldDesc &desc) = 0;
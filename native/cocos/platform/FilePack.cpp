@@ -0,0 +1,200 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "platform/FilePack.h"
+#include <zlib.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "base/Log.h"
+
+namespace cc {
+
+namespace {
+
+constexpr uint64_t ENTRY_ALIGNMENT = 16U;
+
+uint64_t alignUp(uint64_t value) {
+    return (value + ENTRY_ALIGNMENT - 1) & ~(ENTRY_ALIGNMENT - 1);
+}
+
+int compareName(const char *lhs, size_t lhsLength, const char *rhs, size_t rhsLength) {
+    int result = memcmp(lhs, rhs, std::min(lhsLength, rhsLength));
+    if (result) return result;
+    return lhsLength < rhsLength ? -1 : (lhsLength > rhsLength ? 1 : 0);
+}
+
+bool writePadding(FILE *file, uint64_t &offset) {
+    static const uint8_t ZEROS[ENTRY_ALIGNMENT]{};
+    auto padding = static_cast<size_t>(alignUp(offset) - offset);
+    offset += padding;
+    return !padding || fwrite(ZEROS, 1, padding, file) == padding;
+}
+
+} // namespace
+
+std::shared_ptr<FilePack> FilePack::open(const ccstd::string &fullPath) {
+    auto pack = std::make_shared<FilePack>(FileView::map(fullPath));
+    return pack->isValid() ? pack : nullptr;
+}
+
+FilePack::FilePack(FileView view)
+: _view(std::move(view)) {
+    Header header;
+    if (_view.size() < sizeof(Header)) return;
+    memcpy(&header, _view.data(), sizeof(Header));
+    if (header.magic != MAGIC || header.version != VERSION || header.indexOffset % alignof(Entry) ||
+        header.indexOffset + static_cast<uint64_t>(header.entryCount) * sizeof(Entry) > _view.size()) {
+        CC_LOG_WARNING("FilePack: invalid header");
+        return;
+    }
+
+    const auto *entries = reinterpret_cast<const Entry *>(_view.data() + header.indexOffset);
+    const auto namesOffset = header.indexOffset + static_cast<uint64_t>(header.entryCount) * sizeof(Entry);
+    const auto namesSize = _view.size() - namesOffset;
+    for (uint32_t i = 0; i < header.entryCount; ++i) {
+        const auto &entry = entries[i];
+        if (entry.offset + entry.storedSize > header.indexOffset ||
+            static_cast<uint64_t>(entry.nameOffset) + entry.nameLength > namesSize ||
+            (!(entry.flags & COMPRESSED) && entry.size != entry.storedSize)) {
+            CC_LOG_WARNING("FilePack: invalid entry %u", i);
+            return;
+        }
+    }
+
+    _entries = entries;
+    _names = reinterpret_cast<const char *>(_view.data() + namesOffset);
+    _entryCount = header.entryCount;
+}
+
+const FilePack::Entry *FilePack::find(const ccstd::string &name) const {
+    const Entry *first = _entries;
+    const Entry *last = _entries + _entryCount;
+    const Entry *iter = std::lower_bound(first, last, name, [this](const Entry &entry, const ccstd::string &key) {
+        return compareName(_names + entry.nameOffset, entry.nameLength, key.data(), key.size()) < 0;
+    });
+    if (iter == last || compareName(_names + iter->nameOffset, iter->nameLength, name.data(), name.size()) != 0) {
+        return nullptr;
+    }
+    return iter;
+}
+
+bool FilePack::contains(const ccstd::string &name) const {
+    return find(name) != nullptr;
+}
+
+FileView FilePack::getView(const ccstd::string &name) const {
+    const Entry *entry = find(name);
+    if (!entry) return {};
+
+    auto stored = _view.slice(static_cast<size_t>(entry->offset), static_cast<size_t>(entry->storedSize));
+    if (!(entry->flags & COMPRESSED)) {
+        return stored;
+    }
+
+    auto *bytes = static_cast<uint8_t *>(malloc(static_cast<size_t>(entry->size)));
+    auto size = static_cast<uLongf>(entry->size);
+    if (!bytes || uncompress(bytes, &size, stored.data(), static_cast<uLong>(stored.size())) != Z_OK || size != entry->size) {
+        CC_LOG_ERROR("FilePack: failed to inflate %s", name.c_str());
+        free(bytes);
+        return {};
+    }
+    return FileView::fromBuffer(bytes, size);
+}
+
+std::unique_ptr<FileStream> FilePack::openStream(const ccstd::string &name) const {
+    const Entry *entry = find(name);
+    if (!entry) return nullptr;
+
+    auto stored = _view.slice(static_cast<size_t>(entry->offset), static_cast<size_t>(entry->storedSize));
+    if (entry->flags & COMPRESSED) {
+        return std::make_unique<InflateStream>(std::move(stored), static_cast<size_t>(entry->size));
+    }
+    return std::make_unique<FileViewStream>(std::move(stored));
+}
+
+bool FilePack::write(const ccstd::string &fullPath, const ccstd::vector<Source> &sources) {
+    ccstd::vector<const Source *> sorted;
+    sorted.reserve(sources.size());
+    for (const auto &source : sources) {
+        sorted.push_back(&source);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Source *lhs, const Source *rhs) {
+        return lhs->name < rhs->name;
+    });
+
+    FILE *file = fopen(fullPath.c_str(), "wb");
+    if (!file) return false;
+
+    Header header;
+    header.entryCount = static_cast<uint32_t>(sorted.size());
+    bool ok = fwrite(&header, sizeof(Header), 1, file) == 1;
+    uint64_t offset = sizeof(Header);
+
+    ccstd::vector<Entry> entries(sorted.size());
+    ccstd::string names;
+    ccstd::vector<uint8_t> compressed;
+    for (size_t i = 0; ok && i < sorted.size(); ++i) {
+        const auto &source = *sorted[i];
+        auto &entry = entries[i];
+        const uint8_t *bytes = source.contents.data();
+        size_t size = source.contents.size();
+
+        entry.size = size;
+        if (source.compress && size) {
+            auto compressedSize = compressBound(static_cast<uLong>(size));
+            compressed.resize(compressedSize);
+            if (compress2(compressed.data(), &compressedSize, bytes, static_cast<uLong>(size), Z_BEST_COMPRESSION) == Z_OK &&
+                compressedSize < size) {
+                bytes = compressed.data();
+                size = compressedSize;
+                entry.flags |= COMPRESSED;
+            }
+        }
+
+        ok = writePadding(file, offset) && fwrite(bytes, 1, size, file) == size;
+        entry.offset = offset;
+        entry.storedSize = size;
+        entry.nameOffset = static_cast<uint32_t>(names.size());
+        entry.nameLength = static_cast<uint32_t>(source.name.size());
+        names += source.name;
+        offset += size;
+    }
+
+    ok = ok && writePadding(file, offset);
+    header.indexOffset = offset;
+    ok = ok && fwrite(entries.data(), sizeof(Entry), entries.size(), file) == entries.size() &&
+         fwrite(names.data(), 1, names.size(), file) == names.size() &&
+         fseek(file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(Header), 1, file) == 1;
+    fclose(file);
+
+    if (!ok) {
+        remove(fullPath.c_str());
+    }
+    return ok;
+}
+
+} // namespace cc
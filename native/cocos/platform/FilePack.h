@@ -0,0 +1,103 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include "base/std/container/string.h"
+#include "base/std/container/vector.h"
+#include "platform/FileView.h"
+
+namespace cc {
+
+/**
+ * Read only archive of many small files with a sorted index for random access. The pack is
+ * memory mapped once and stored entries are handed out as views into that mapping, compressed
+ * entries are inflated on request.
+ *
+ * Layout: Header | entry contents, each aligned to 16 bytes | Entry[entryCount] sorted by name | names
+ */
+class CC_DLL FilePack final {
+public:
+    static constexpr uint32_t MAGIC = 0x4b504343U; // "CCPK"
+    static constexpr uint32_t VERSION = 1U;
+    static constexpr uint32_t COMPRESSED = 1U;
+
+    struct Header {
+        uint32_t magic{MAGIC};
+        uint32_t version{VERSION};
+        uint32_t entryCount{0};
+        uint32_t reserved{0};
+        uint64_t indexOffset{0};
+    };
+
+    struct Entry {
+        uint64_t offset{0};
+        uint64_t size{0};       // decoded size
+        uint64_t storedSize{0}; // size in the pack
+        uint32_t nameOffset{0}; // into the names following the index
+        uint32_t nameLength{0};
+        uint32_t flags{0};
+        uint32_t reserved{0};
+    };
+
+    struct Source {
+        ccstd::string name;
+        FileView contents;
+        bool compress{false};
+    };
+
+    /**
+     * Maps the pack at the given full path, nullptr if it doesn't exist or is malformed.
+     */
+    static std::shared_ptr<FilePack> open(const ccstd::string &fullPath);
+
+    /**
+     * Builds a pack from the given sources, compression is skipped for entries which don't shrink.
+     */
+    static bool write(const ccstd::string &fullPath, const ccstd::vector<Source> &sources);
+
+    explicit FilePack(FileView view);
+
+    bool contains(const ccstd::string &name) const;
+
+    // views of stored entries share the mapping, compressed entries are inflated to the heap
+    FileView getView(const ccstd::string &name) const;
+
+    std::unique_ptr<FileStream> openStream(const ccstd::string &name) const;
+
+    inline uint32_t getEntryCount() const { return _entryCount; }
+    inline bool isValid() const { return _entries != nullptr; }
+
+private:
+    const Entry *find(const ccstd::string &name) const;
+
+    FileView _view;
+    const Entry *_entries{nullptr};
+    const char *_names{nullptr};
+    uint32_t _entryCount{0};
+};
+
+} // namespace cc
@@ -28,7 +28,9 @@
 #include <cstring>
 #include <stack>
 
+#include <algorithm>
 #include <cerrno>
+#include <climits>
 #include <cstring>
 #include <iostream>
 
@@ -43,6 +45,7 @@
 #include "base/Data.h"
 #include "base/Log.h"
 #include "base/memory/Memory.h"
+#include "platform/FilePack.h"
 #include "platform/SAXParser.h"
 
 #include "tinydir/tinydir.h"
@@ -561,6 +564,10 @@ FileUtils::Status FileUtils::getContents(const ccstd::string &filename, Resizabl
         return Status::NOT_EXISTS;
     }
 
+    if (getPackContents(filename, buffer)) {
+        return Status::OK;
+    }
+
     auto *fs = FileUtils::getInstance();
 
     ccstd::string fullPath = fs->fullPathForFilename(filename);
@@ -635,6 +642,161 @@ unsigned char *FileUtils::getFileDataFromZip(const ccstd::string &zipFilePath, c
     return buffer;
 }
 
+namespace {
+
+class ZipEntryStream final : public FileStream {
+public:
+    ZipEntryStream(unzFile file, size_t size) : _file(file), _size(size) {}
+
+    ~ZipEntryStream() override {
+        unzCloseCurrentFile(_file);
+        unzClose(_file);
+    }
+
+    size_t read(void *dst, size_t size) override {
+        int count = unzReadCurrentFile(_file, dst, static_cast<unsigned>(std::min<size_t>(size, UINT_MAX)));
+        return count > 0 ? static_cast<size_t>(count) : 0;
+    }
+
+    size_t getSize() const override { return _size; }
+
+private:
+    unzFile _file{nullptr};
+    size_t _size{0};
+};
+
+} // namespace
+
+FileView FileUtils::getFileView(const ccstd::string &filename) {
+    if (filename.empty()) {
+        return {};
+    }
+
+    ccstd::string entryName;
+    if (const auto *pack = findPack(filename, &entryName)) {
+        return pack->getView(entryName);
+    }
+
+    ccstd::string fullPath = fullPathForFilename(filename);
+    if (fullPath.empty()) {
+        return {};
+    }
+
+    // a mapping faults once its file is truncated and locks the file on windows, downloads
+    // and caches in the writable path may be rewritten, so they are read instead
+    const auto writablePath = getWritablePath();
+    const bool mutableFile = !writablePath.empty() && fullPath.compare(0, writablePath.size(), writablePath) == 0;
+    auto view = mutableFile ? FileView() : FileView::map(fullPath);
+    if (view.empty()) {
+        // not a regular file, e.g. android assets
+        Data data;
+        if (getContents(fullPath, &data) == Status::OK) {
+            view = FileView::fromData(std::move(data));
+        }
+    }
+    return view;
+}
+
+bool FileUtils::isPackEntry(const ccstd::string &filename) const {
+    return findPack(filename, nullptr) != nullptr;
+}
+
+std::unique_ptr<FileStream> FileUtils::openFileStream(const ccstd::string &filename) {
+    ccstd::string entryName;
+    if (const auto *pack = findPack(filename, &entryName)) {
+        return pack->openStream(entryName);
+    }
+
+    auto view = getFileView(filename);
+    if (view.empty()) {
+        return nullptr;
+    }
+    return std::make_unique<FileViewStream>(std::move(view));
+}
+
+std::unique_ptr<FileStream> FileUtils::openZipEntryStream(const ccstd::string &zipFilePath, const ccstd::string &filename) {
+    if (zipFilePath.empty()) {
+        return nullptr;
+    }
+
+    unzFile file = unzOpen(getSuitableFOpen(zipFilePath).c_str());
+    if (!file) {
+        return nullptr;
+    }
+
+    unz_file_info fileInfo;
+    if (unzLocateFile(file, filename.c_str(), nullptr) != UNZ_OK ||
+        unzGetCurrentFileInfo(file, &fileInfo, nullptr, 0, nullptr, 0, nullptr, 0) != UNZ_OK ||
+        unzOpenCurrentFile(file) != UNZ_OK) {
+        unzClose(file);
+        return nullptr;
+    }
+    return std::make_unique<ZipEntryStream>(file, fileInfo.uncompressed_size);
+}
+
+bool FileUtils::mountPack(const ccstd::string &packPath, const ccstd::string &mountPoint) {
+    // packs are immutable, so they stay mapped while mounted wherever they are
+    ccstd::string fullPath = fullPathForFilename(packPath);
+    auto view = FileView::map(fullPath);
+    if (view.empty()) {
+        Data data;
+        if (!fullPath.empty() && getContents(fullPath, &data) == Status::OK) {
+            view = FileView::fromData(std::move(data));
+        }
+    }
+    auto pack = std::make_shared<FilePack>(std::move(view));
+    if (!pack->isValid()) {
+        CC_LOG_ERROR("FileUtils: can't mount %s", packPath.c_str());
+        return false;
+    }
+
+    unmountPack(packPath);
+    MountedPack mounted{packPath, mountPoint, std::move(pack)};
+    if (!mounted.mountPoint.empty() && mounted.mountPoint.back() != '/') {
+        mounted.mountPoint += '/';
+    }
+    _mountedPacks.push_back(std::move(mounted));
+    return true;
+}
+
+void FileUtils::unmountPack(const ccstd::string &packPath) {
+    _mountedPacks.erase(std::remove_if(_mountedPacks.begin(), _mountedPacks.end(), [&](const MountedPack &mounted) {
+                            return mounted.path == packPath;
+                        }),
+                        _mountedPacks.end());
+}
+
+const FilePack *FileUtils::findPack(const ccstd::string &filename, ccstd::string *entryName) const {
+    for (auto iter = _mountedPacks.rbegin(); iter != _mountedPacks.rend(); ++iter) {
+        const auto &mountPoint = iter->mountPoint;
+        if (filename.compare(0, mountPoint.size(), mountPoint) != 0) {
+            continue;
+        }
+        auto name = filename.substr(mountPoint.size());
+        if (iter->pack->contains(name)) {
+            if (entryName) {
+                *entryName = std::move(name);
+            }
+            return iter->pack.get();
+        }
+    }
+    return nullptr;
+}
+
+bool FileUtils::getPackContents(const ccstd::string &filename, ResizableBuffer *buffer) const {
+    ccstd::string entryName;
+    const auto *pack = findPack(filename, &entryName);
+    if (!pack) {
+        return false;
+    }
+    auto view = pack->getView(entryName);
+    buffer->resize(view.size());
+    if (!view.empty()) {
+        memcpy(buffer->buffer(), view.data(), view.size());
+    }
+    return true;
+}
+
 ccstd::string FileUtils::getPathForFilename(const ccstd::string &filename, const ccstd::string &searchPath) const {
     ccstd::string file{filename};
     ccstd::string filePath;
@@ -658,6 +820,10 @@ ccstd::string FileUtils::fullPathForFilename(const ccstd::string &filename) cons
         return "";
     }
 
+    if (findPack(filename, nullptr)) {
+        return filename;
+    }
+
     if (isAbsolutePath(filename)) {
         return normalizePath(filename);
     }
@@ -783,6 +949,9 @@ ccstd::string FileUtils::getFullPathForDirectoryAndFilename(const ccstd::string
 }
 
 bool FileUtils::isFileExist(const ccstd::string &filename) const {
+    if (findPack(filename, nullptr)) {
+        return true;
+    }
     if (isAbsolutePath(filename)) {
         return isFileExistInternal(normalizePath(filename));
     }
@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include <memory>
 #include <type_traits>
 #include "base/Data.h"
 #include "base/Macros.h"
@@ -32,9 +33,12 @@
 #include "base/std/container/string.h"
 #include "base/std/container/unordered_map.h"
 #include "base/std/container/vector.h"
+#include "platform/FileView.h"
 
 namespace cc {
 
+class FilePack;
+
 class ResizableBuffer {
 public:
     ~ResizableBuffer() = default;
@@ -239,6 +243,51 @@ public:
      */
     virtual unsigned char *getFileDataFromZip(const ccstd::string &zipFilePath, const ccstd::string &filename, uint32_t *size);
 
+    /**
+     *  Gets the contents of a file without copying them.
+     *
+     *  Files in mounted packs are looked up first, their views share the mapping of the pack.
+     *  Other files are memory mapped, unless they are in the writable path, which may be rewritten,
+     *  or the platform can't map them, e.g. android assets. These are read into the heap.
+     *  Views of files which aren't in a pack should not be kept, see isPackEntry.
+     *
+     *  @param filename The resource file name, relative or absolute.
+     *  @return A shared read only view, empty if the file doesn't exist.
+     */
+    virtual FileView getFileView(const ccstd::string &filename);
+
+    /**
+     *  Checks whether a file is an entry of a mounted pack, views of such files may be kept for long.
+     */
+    bool isPackEntry(const ccstd::string &filename) const;
+
+    /**
+     *  Opens a sequential reader, compressed pack entries are inflated chunk by chunk.
+     *
+     *  @return nullptr if the file doesn't exist.
+     */
+    virtual std::unique_ptr<FileStream> openFileStream(const ccstd::string &filename);
+
+    /**
+     *  Opens a sequential reader over an entry of a zip file, which is inflated chunk by chunk.
+     *
+     *  @return nullptr if the zip file or the entry doesn't exist.
+     */
+    std::unique_ptr<FileStream> openZipEntryStream(const ccstd::string &zipFilePath, const ccstd::string &filename);
+
+    /**
+     *  Mounts a pack built by FilePack::write, its entries are then found as mountPoint + entry name
+     *  by getContents, getFileView, openFileStream and isFileExist. Packs mounted later take precedence.
+     *  Mount packs before loading from other threads. A pack stays mapped while mounted,
+     *  unmount it before rewriting it.
+     *
+     *  @param packPath The path of the pack, resolved like other files.
+     *  @param mountPoint The prefix of the entry names, e.g. "assets/".
+     *  @return False if the pack can't be read.
+     */
+    bool mountPack(const ccstd::string &packPath, const ccstd::string &mountPoint = "");
+    void unmountPack(const ccstd::string &packPath);
+
     /** Returns the fullpath for a given filename.
 
      First it will try to get a new filename from the "filenameLookup" dictionary.
@@ -619,6 +668,26 @@ protected:
      */
     ccstd::string _writablePath;
 
+    struct MountedPack {
+        ccstd::string path;
+        ccstd::string mountPoint;
+        std::shared_ptr<FilePack> pack;
+    };
+
+    /**
+     *  Finds the mounted pack containing a file.
+     *  @param entryName Receives the name of the file in the pack if not nullptr.
+     */
+    const FilePack *findPack(const ccstd::string &filename, ccstd::string *entryName) const;
+
+    /**
+     *  Reads a file from the mounted packs, returns false if no pack contains it.
+     *  Platform implementations of getContents should try it first.
+     */
+    bool getPackContents(const ccstd::string &filename, ResizableBuffer *buffer) const;
+
+    ccstd::vector<MountedPack> _mountedPacks;
+
     /**
      *  The singleton pointer of FileUtils.
      */
@@ -0,0 +1,232 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "platform/FileView.h"
+#include <zlib.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "base/Data.h"
+#include "base/Log.h"
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN 1
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace cc {
+
+class FileView::Storage {
+public:
+    Storage(uint8_t *bytes, size_t size, bool mapped) : _bytes(bytes), _size(size), _mapped(mapped) {}
+
+    ~Storage() {
+        if (!_mapped) {
+            free(_bytes);
+        } else {
+#if defined(_WIN32)
+            UnmapViewOfFile(_bytes);
+#else
+            munmap(_bytes, _size);
+#endif
+        }
+    }
+
+    Storage(const Storage &) = delete;
+    Storage &operator=(const Storage &) = delete;
+
+    inline const uint8_t *bytes() const { return _bytes; }
+    inline size_t size() const { return _size; }
+    inline bool isMapped() const { return _mapped; }
+
+private:
+    uint8_t *_bytes{nullptr};
+    size_t _size{0};
+    bool _mapped{false};
+};
+
+namespace {
+
+#if defined(_WIN32)
+std::wstring toWidePath(const ccstd::string &path) {
+    int length = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+    std::wstring widePath(length, L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &widePath[0], length);
+    return widePath;
+}
+#endif
+
+} // namespace
+
+FileView::FileView(std::shared_ptr<const Storage> storage, const uint8_t *data, size_t size)
+: _storage(std::move(storage)), _data(data), _size(size) {}
+
+FileView FileView::map(const ccstd::string &fullPath) {
+    uint8_t *bytes = nullptr;
+    size_t size = 0;
+#if defined(_WIN32)
+    HANDLE file = CreateFileW(toWidePath(fullPath).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return {};
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            bytes = static_cast<uint8_t *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            size = bytes ? static_cast<size_t>(fileSize.QuadPart) : 0;
+            CloseHandle(mapping); // the view keeps the mapping alive
+        }
+    }
+    CloseHandle(file);
+#else
+    int fd = open(fullPath.c_str(), O_RDONLY);
+    if (fd < 0) return {};
+    struct stat statBuf;
+    if (fstat(fd, &statBuf) == 0 && statBuf.st_size > 0) {
+        void *address = mmap(nullptr, static_cast<size_t>(statBuf.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+            bytes = static_cast<uint8_t *>(address);
+            size = static_cast<size_t>(statBuf.st_size);
+        }
+    }
+    close(fd); // the mapping stays valid
+#endif
+    if (!bytes) return {};
+    return {std::make_shared<const Storage>(bytes, size, true), bytes, size};
+}
+
+FileView FileView::read(const ccstd::string &fullPath) {
+#if defined(_WIN32)
+    FILE *file = _wfopen(toWidePath(fullPath).c_str(), L"rb");
+#else
+    FILE *file = fopen(fullPath.c_str(), "rb");
+#endif
+    if (!file) return {};
+
+    uint8_t *bytes = nullptr;
+    size_t size = 0;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        long length = ftell(file);
+        if (length > 0 && fseek(file, 0, SEEK_SET) == 0) {
+            bytes = static_cast<uint8_t *>(malloc(static_cast<size_t>(length)));
+            size = bytes ? fread(bytes, 1, static_cast<size_t>(length), file) : 0;
+        }
+    }
+    fclose(file);
+    if (size == 0) {
+        free(bytes);
+        return {};
+    }
+    return fromBuffer(bytes, size);
+}
+
+FileView FileView::fromBuffer(uint8_t *bytes, size_t size) {
+    if (!bytes) return {};
+    return {std::make_shared<const Storage>(bytes, size, false), bytes, size};
+}
+
+FileView FileView::fromData(Data &&data) {
+    uint32_t size = 0;
+    uint8_t *bytes = data.takeBuffer(&size);
+    return fromBuffer(bytes, size);
+}
+
+FileView FileView::slice(size_t offset, size_t size) const {
+    CC_ASSERT(offset + size <= _size);
+    return {_storage, _data + offset, size};
+}
+
+bool FileView::isMapped() const {
+    return _storage && _storage->isMapped();
+}
+
+Data FileView::toData() const {
+    Data data;
+    data.copy(_data, static_cast<uint32_t>(_size));
+    return data;
+}
+
+FileView FileStream::readAll() {
+    auto capacity = getSize();
+    auto *bytes = static_cast<uint8_t *>(malloc(capacity ? capacity : 1));
+    size_t size = 0;
+    while (size < capacity) {
+        size_t count = read(bytes + size, capacity - size);
+        if (!count) break;
+        size += count;
+    }
+    return FileView::fromBuffer(bytes, size);
+}
+
+size_t FileViewStream::read(void *dst, size_t size) {
+    size = std::min(size, _view.size() - _offset);
+    memcpy(dst, _view.data() + _offset, size);
+    _offset += size;
+    return size;
+}
+
+InflateStream::InflateStream(FileView view, size_t size)
+: _view(std::move(view)), _size(size) {
+    auto *zstream = static_cast<z_stream *>(calloc(1, sizeof(z_stream)));
+    zstream->next_in = const_cast<Bytef *>(_view.data());
+    zstream->avail_in = static_cast<uInt>(_view.size());
+    // detect zlib or gzip headers
+    if (inflateInit2(zstream, 15 + 32) != Z_OK) {
+        free(zstream);
+        _finished = true;
+        return;
+    }
+    _zstream = zstream;
+}
+
+InflateStream::~InflateStream() {
+    if (_zstream) {
+        inflateEnd(static_cast<z_stream *>(_zstream));
+        free(_zstream);
+    }
+}
+
+size_t InflateStream::read(void *dst, size_t size) {
+    if (_finished || !size) return 0;
+
+    auto *zstream = static_cast<z_stream *>(_zstream);
+    zstream->next_out = static_cast<Bytef *>(dst);
+    zstream->avail_out = static_cast<uInt>(size);
+    int err = inflate(zstream, Z_NO_FLUSH);
+    if (err == Z_STREAM_END) {
+        _finished = true;
+    } else if (err != Z_OK) {
+        CC_LOG_ERROR("InflateStream: inflate failed with %d", err);
+        _finished = true;
+    }
+    return size - zstream->avail_out;
+}
+
+} // namespace cc
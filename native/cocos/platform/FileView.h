@@ -0,0 +1,138 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include "base/Macros.h"
+#include "base/std/container/string.h"
+
+namespace cc {
+
+class Data;
+
+/**
+ * Read only bytes of a file shared by reference counting. Files are memory mapped read only,
+ * slices (e.g. the entries of a pack file) keep the whole mapping alive, and nothing is copied
+ * unless the platform can't map the file.
+ * A mapped file must not be truncated or replaced while views of it are alive, so only immutable
+ * files such as packs are kept mapped for long, see FileUtils::getFileView.
+ */
+class CC_DLL FileView final {
+public:
+    FileView() = default;
+
+    /**
+     * Maps a file by its full path, empty if the file doesn't exist, is empty or can't be mapped.
+     */
+    static FileView map(const ccstd::string &fullPath);
+
+    /**
+     * Reads a file by its full path into the heap, for files that may be rewritten, e.g. caches.
+     */
+    static FileView read(const ccstd::string &fullPath);
+
+    /**
+     * Wraps heap contents, the bytes have to be allocated by malloc and are freed with the last view.
+     */
+    static FileView fromBuffer(uint8_t *bytes, size_t size);
+    static FileView fromData(Data &&data);
+
+    FileView slice(size_t offset, size_t size) const;
+
+    inline const uint8_t *data() const { return _data; }
+    inline size_t size() const { return _size; }
+    inline bool empty() const { return _size == 0; }
+    bool isMapped() const;
+
+    // copies the bytes for APIs taking ownership
+    Data toData() const;
+
+private:
+    class Storage;
+
+    FileView(std::shared_ptr<const Storage> storage, const uint8_t *data, size_t size);
+
+    std::shared_ptr<const Storage> _storage;
+    const uint8_t *_data{nullptr};
+    size_t _size{0};
+};
+
+/**
+ * Sequential reader for contents which are not kept in memory as a whole, e.g. compressed entries.
+ */
+class CC_DLL FileStream {
+public:
+    virtual ~FileStream() = default;
+
+    /**
+     * Reads up to size bytes into dst.
+     * @return The number of bytes read, 0 at the end of the contents or on errors.
+     */
+    virtual size_t read(void *dst, size_t size) = 0;
+
+    /**
+     * @return The size of the decoded contents.
+     */
+    virtual size_t getSize() const = 0;
+
+    // reads what is left into a view, for consumers that need the contents at once
+    FileView readAll();
+};
+
+/**
+ * Reads a view as it is.
+ */
+class CC_DLL FileViewStream final : public FileStream {
+public:
+    explicit FileViewStream(FileView view) : _view(std::move(view)) {}
+
+    size_t read(void *dst, size_t size) override;
+    inline size_t getSize() const override { return _view.size(); }
+
+private:
+    FileView _view;
+    size_t _offset{0};
+};
+
+/**
+ * Inflates zlib or gzip compressed contents of a view chunk by chunk.
+ */
+class CC_DLL InflateStream final : public FileStream {
+public:
+    InflateStream(FileView view, size_t size);
+    ~InflateStream() override;
+
+    size_t read(void *dst, size_t size) override;
+    inline size_t getSize() const override { return _size; }
+
+private:
+    FileView _view;
+    size_t _size{0};
+    void *_zstream{nullptr};
+    bool _finished{false};
+};
+
+} // namespace cc
@@ -259,6 +259,36 @@ void pngReadCallback(png_structp pngPtr, png_bytep data, png_size_t length) {
     }
 }
 #endif //CC_USE_PNG
+
+// value * alpha / 255 rounded to nearest, exact for 8 bit channels
+inline uint8_t multiplyAlpha(uint32_t value, uint32_t alpha) {
+    const uint32_t product = value * alpha + 128;
+    return static_cast<uint8_t>((product + (product >> 8)) >> 8);
+}
+
+// alpha is the last channel of LA8 and RGBA8
+void premultiplyRow(uint8_t *row, int width, int channels) {
+    for (int i = 0; i < width; ++i, row += channels) {
+        const uint32_t alpha = row[channels - 1];
+        for (int c = 0; c < channels - 1; ++c) {
+            row[c] = multiplyAlpha(row[c], alpha);
+        }
+    }
+}
+
+// expands the L8 or RGB8 pixels stored at the end of a RGBA8 row in place
+void expandRowToRGBA(uint8_t *row, int width, int channels) {
+    const uint8_t *src = row + width * (4 - channels);
+    for (int i = 0; i < width; ++i, src += channels, row += 4) {
+        const uint8_t r = src[0];
+        const uint8_t g = channels == 1 ? r : src[1];
+        const uint8_t b = channels == 1 ? r : src[2];
+        row[0] = r;
+        row[1] = g;
+        row[2] = b;
+        row[3] = 255;
+    }
+}
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -278,10 +308,10 @@ bool Image::initWithImageFile(const ccstd::string &path) {
     //    _filePath = FileUtils::getInstance()->fullPathForFilename(path);
     _filePath = path;
 
-    Data data = FileUtils::getInstance()->getDataFromFile(_filePath);
+    FileView view = FileUtils::getInstance()->getFileView(_filePath);
 
-    if (!data.isNull()) {
-        ret = initWithImageData(data.getBytes(), data.getSize());
+    if (!view.empty()) {
+        ret = initWithImageData(view.data(), static_cast<uint32_t>(view.size()));
     }
 
     return ret;
@@ -551,6 +581,15 @@ bool Image::initWithJpgData(const unsigned char *data, uint32_t dataLen) {
         } else {
             cinfo.out_color_space = JCS_RGB;
             _renderFormat = gfx::Format::RGB8;
+    #ifdef JCS_EXTENSIONS
+            // libjpeg-turbo writes RGBA itself
+            if (_decodeOptions.expandToRGBA) {
+                cinfo.out_color_space = JCS_EXT_RGBA;
+            }
+    #endif
+        }
+        if (_decodeOptions.expandToRGBA) {
+            _renderFormat = gfx::Format::RGBA8;
         }
 
         /* Start decompression jpeg here */
@@ -560,16 +599,23 @@ bool Image::initWithJpgData(const unsigned char *data, uint32_t dataLen) {
         _isCompressed = false;
         _width = cinfo.output_width;
         _height = cinfo.output_height;
-        _dataLen = cinfo.output_width * cinfo.output_height * cinfo.output_components;
+        const int components = cinfo.output_components;
+        const int channels = _decodeOptions.expandToRGBA ? 4 : components;
+        const uint32_t rowBytes = cinfo.output_width * channels;
+        _dataLen = rowBytes * cinfo.output_height;
         _data = static_cast<unsigned char *>(malloc(_dataLen * sizeof(unsigned char)));
         CC_BREAK_IF(!_data);
 
         /* now actually read the jpeg into the raw buffer */
         /* read one scan line at a time */
         while (cinfo.output_scanline < cinfo.output_height) {
-            rowPointer[0] = _data + location;
-            location += cinfo.output_width * cinfo.output_components;
+            // scan lines to be expanded are read to the end of their row
+            rowPointer[0] = _data + location + (channels - components) * cinfo.output_width;
             jpeg_read_scanlines(&cinfo, rowPointer, 1);
+            if (channels != components) {
+                expandRowToRGBA(_data + location, static_cast<int>(cinfo.output_width), components);
+            }
+            location += rowBytes;
         }
 
         /* When read image file with broken data, jpeg_finish_decompress() may cause error.
@@ -645,9 +691,11 @@ bool Image::initWithPngData(const unsigned char *data, uint32_t dataLen) {
             png_set_expand_gray_1_2_4_to_8(pngPtr);
         }
         // expand any tRNS chunk data into a full alpha channel
-        if (png_get_valid(pngPtr, infoPtr, PNG_INFO_tRNS)) {
+        const bool hasTRNS = png_get_valid(pngPtr, infoPtr, PNG_INFO_tRNS);
+        if (hasTRNS) {
             png_set_tRNS_to_alpha(pngPtr);
         }
+        const bool hasAlpha = hasTRNS || (colorType & PNG_COLOR_MASK_ALPHA);
         // reduce images with 16-bit samples to 8 bits
         if (bitDepth == 16) {
             png_set_strip_16(pngPtr);
@@ -657,6 +705,14 @@ bool Image::initWithPngData(const unsigned char *data, uint32_t dataLen) {
         if (bitDepth < 8) {
             png_set_packing(pngPtr);
         }
+        if (_decodeOptions.expandToRGBA) {
+            if (colorType == PNG_COLOR_TYPE_GRAY || colorType == PNG_COLOR_TYPE_GRAY_ALPHA) {
+                png_set_gray_to_rgb(pngPtr);
+            }
+            // only fills images without alpha
+            png_set_add_alpha(pngPtr, 0xff, PNG_FILLER_AFTER);
+        }
+        const int passes = png_set_interlace_handling(pngPtr);
         // update info
         png_read_update_info(pngPtr, infoPtr);
         colorType = png_get_color_type(pngPtr, infoPtr);
@@ -696,8 +752,20 @@ bool Image::initWithPngData(const unsigned char *data, uint32_t dataLen) {
         for (int i = 0; i < _height; ++i) {
             rowPointers[i] = _data + i * rowbytes;
         }
-        png_read_image(pngPtr, rowPointers);
+        for (int pass = 1; pass < passes; ++pass) {
+            png_read_rows(pngPtr, rowPointers, nullptr, _height);
+        }
+        // the last pass completes the rows one by one, premultiply them while they are in cache
+        const bool premultiply = _decodeOptions.premultiplyAlpha && hasAlpha;
+        const int channels = png_get_channels(pngPtr, infoPtr);
+        for (int i = 0; i < _height; ++i) {
+            png_read_row(pngPtr, rowPointers[i], nullptr);
+            if (premultiply) {
+                premultiplyRow(rowPointers[i], _width, channels);
+            }
+        }
         png_read_end(pngPtr, nullptr);
+        _hasPremultipliedAlpha = premultiply;
 
         if (rowPointers != nullptr) {
             free(rowPointers);
@@ -895,17 +963,23 @@ bool Image::initWithWebpData(const unsigned char *data, uint32_t dataLen) {
         if (WebPGetFeatures(static_cast<const uint8_t *>(data), dataLen, &config.input) != VP8_STATUS_OK) break;
         if (config.input.width == 0 || config.input.height == 0) break;
 
-        config.output.colorspace = config.input.has_alpha ? MODE_rgbA : MODE_RGB;
-        _renderFormat = config.input.has_alpha ? gfx::Format::RGBA8 : gfx::Format::RGB8;
+        const int channels = config.input.has_alpha || _decodeOptions.expandToRGBA ? 4 : 3;
+        if (config.input.has_alpha) {
+            config.output.colorspace = MODE_rgbA;
+        } else {
+            config.output.colorspace = channels == 4 ? MODE_RGBA : MODE_RGB;
+        }
+        _renderFormat = channels == 4 ? gfx::Format::RGBA8 : gfx::Format::RGB8;
+        _hasPremultipliedAlpha = config.input.has_alpha;
         _width = config.input.width;
         _height = config.input.height;
         _isCompressed = false;
 
-        _dataLen = _width * _height * (config.input.has_alpha ? 4 : 3);
+        _dataLen = _width * _height * channels;
         _data = static_cast<unsigned char *>(malloc(_dataLen * sizeof(unsigned char)));
 
         config.output.u.RGBA.rgba = static_cast<uint8_t *>(_data);
-        config.output.u.RGBA.stride = _width * (config.input.has_alpha ? 4 : 3);
+        config.output.u.RGBA.stride = _width * channels;
         config.output.u.RGBA.size = _dataLen;
         config.output.is_external_memory = 1;
 
@@ -921,7 +995,7 @@ bool Image::initWithWebpData(const unsigned char *data, uint32_t dataLen) {
 }
 #endif // CC_USE_WEBP
 
-bool Image::initWithRawData(const unsigned char *data, uint32_t /*dataLen*/, int width, int height, int /*bitsPerComponent*/, bool /*preMulti*/) {
+bool Image::initWithRawData(const unsigned char *data, uint32_t /*dataLen*/, int width, int height, int /*bitsPerComponent*/, bool preMulti) {
     bool ret = false;
     do {
         CC_BREAK_IF(0 == width || 0 == height);
@@ -930,6 +1004,7 @@ bool Image::initWithRawData(const unsigned char *data, uint32_t /*dataLen*/, int
         _width = width;
         _renderFormat = gfx::Format::RGBA8;
         _isCompressed = false;
+        _hasPremultipliedAlpha = preMulti;
 
         // only RGBA8888 supported
         int bytesPerComponent = 4;
@@ -1023,10 +1098,8 @@ bool Image::saveImageToPNG(const std::string &filePath, bool isToRGB) {
                 for (int i = 0; i < _height; i++) {
                     rowPointers[i] = static_cast<png_bytep>(tempData) + i * _width * 3;
                 }
-                if (tempData != nullptr) {
-                    CC_FREE(tempData);
-                }
                 png_write_image(pngPtr, rowPointers);
+                CC_FREE(tempData);
             } else {
                 for (int i = 0; i < _height; i++) {
                     rowPointers[i] = static_cast<png_bytep>(_data) + i * _width * 4 /*Bytes per pixel*/;
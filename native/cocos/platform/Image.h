@@ -60,6 +60,17 @@ public:
         UNKNOWN
     };
 
+    struct DecodeOptions {
+        // expand L8, LA8 and RGB8 to RGBA8 while decoding, the layout textures are uploaded in
+        bool expandToRGBA{false};
+        // multiply color by alpha while decoding, WebP images with alpha are always premultiplied
+        bool premultiplyAlpha{false};
+    };
+
+    // applies to the following init calls
+    inline void setDecodeOptions(const DecodeOptions &options) { _decodeOptions = options; }
+    inline const DecodeOptions &getDecodeOptions() const { return _decodeOptions; }
+
     bool initWithImageFile(const ccstd::string &path);
     bool initWithImageData(const unsigned char *data, uint32_t dataLen);
 
@@ -81,6 +92,7 @@ public:
     inline int getHeight() const { return _height; }
     inline ccstd::string getFilePath() const { return _filePath; }
     inline bool isCompressed() const { return _isCompressed; }
+    inline bool hasPremultipliedAlpha() const { return _hasPremultipliedAlpha; }
 
     /**
      @brief    Save Image data to the specified file, with specified format.
@@ -113,6 +125,8 @@ protected:
     gfx::Format _renderFormat;
     ccstd::string _filePath;
     bool _isCompressed = false;
+    bool _hasPremultipliedAlpha = false;
+    DecodeOptions _decodeOptions;
 
     static Format detectFormat(const unsigned char *data, uint32_t dataLen);
     static bool isPng(const unsigned char *data, uint32_t dataLen);
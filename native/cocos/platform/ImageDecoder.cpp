@@ -0,0 +1,177 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "platform/ImageDecoder.h"
+#include <algorithm>
+#include <thread>
+#include "base/ThreadPool.h"
+#include "profiler/Profiler.h"
+
+namespace cc {
+
+namespace {
+
+ImageDecoder *instance = nullptr;
+
+} // namespace
+
+ImageDecoder *ImageDecoder::getInstance() {
+    if (!instance) {
+        instance = ccnew ImageDecoder();
+    }
+    return instance;
+}
+
+void ImageDecoder::destroyInstance() {
+    delete instance;
+    instance = nullptr;
+}
+
+ImageDecoder::ImageDecoder(uint32_t threadCount) {
+    if (!threadCount) {
+        threadCount = std::max(std::thread::hardware_concurrency(), 2U) - 1;
+    }
+    _threadCount = threadCount;
+    // pushing tasks to a fixed pool is thread safe, workers schedule the next decode themselves
+    _pool = LegacyThreadPool::newFixedThreadPool(static_cast<int>(threadCount));
+}
+
+ImageDecoder::~ImageDecoder() {
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _pending.clear();
+        _idle.wait(lock, [this] { return _running == 0; });
+    }
+    delete _pool;
+}
+
+uint32_t ImageDecoder::push(Request &&request) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    uint32_t id = ++_nextId;
+    _pending.push_back({id, std::move(request)});
+    std::push_heap(_pending.begin(), _pending.end(), isLowerPriority);
+    schedule();
+    return id;
+}
+
+bool ImageDecoder::cancel(uint32_t id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto iter = std::find_if(_pending.begin(), _pending.end(), [id](const Task &task) { return task.id == id; });
+    if (iter == _pending.end()) {
+        return false;
+    }
+    _pending.erase(iter);
+    std::make_heap(_pending.begin(), _pending.end(), isLowerPriority);
+    return true;
+}
+
+uint32_t ImageDecoder::flush(uint32_t maxCount) {
+    ccstd::vector<Result> results;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_finished.empty()) {
+            return 0;
+        }
+        auto count = std::min(static_cast<size_t>(maxCount), _finished.size());
+        results.assign(std::make_move_iterator(_finished.begin()), std::make_move_iterator(_finished.begin() + count));
+        _finished.erase(_finished.begin(), _finished.begin() + count);
+        for (const auto &result : results) {
+            if (result.image) {
+                _finishedBytes -= result.image->getDataLen();
+            }
+        }
+        schedule();
+    }
+
+    // callbacks may push new requests
+    for (auto &result : results) {
+        if (result.callback) {
+            result.callback(result.image);
+        }
+    }
+    return static_cast<uint32_t>(results.size());
+}
+
+void ImageDecoder::waitForAll() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _idle.wait(lock, [this] {
+        return _running == 0 && (_pending.empty() || _finishedBytes >= _memoryBudget);
+    });
+}
+
+uint32_t ImageDecoder::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return static_cast<uint32_t>(_pending.size()) + _running;
+}
+
+bool ImageDecoder::isLowerPriority(const Task &lhs, const Task &rhs) {
+    // earlier requests first among equal priorities
+    return lhs.request.priority != rhs.request.priority ? lhs.request.priority < rhs.request.priority : lhs.id > rhs.id;
+}
+
+bool ImageDecoder::canStart() const {
+    return !_pending.empty() && _running < _threadCount && _finishedBytes < _memoryBudget;
+}
+
+// called with _mutex locked
+void ImageDecoder::schedule() {
+    while (canStart()) {
+        std::pop_heap(_pending.begin(), _pending.end(), isLowerPriority);
+        auto task = std::make_shared<Task>(std::move(_pending.back()));
+        _pending.pop_back();
+        ++_running;
+        _pool->pushTask([this, task](int /*threadId*/) {
+            decode(std::move(*task));
+        });
+    }
+}
+
+void ImageDecoder::decode(Task &&task) {
+    IntrusivePtr<Image> image;
+    {
+        CC_PROFILE(ImageDecode);
+        image = ccnew Image();
+        image->setDecodeOptions(task.request.options);
+        const auto &data = task.request.data;
+        bool succeeded = data.empty()
+                             ? image->initWithImageFile(task.request.path)
+                             : image->initWithImageData(data.data(), static_cast<uint32_t>(data.size()));
+        if (!succeeded) {
+            image = nullptr;
+        }
+        task.request.data = FileView();
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    --_running;
+    if (image) {
+        _finishedBytes += image->getDataLen();
+    }
+    _finished.push_back({std::move(image), std::move(task.request.callback)});
+    schedule();
+    _idle.notify_all();
+}
+
+} // namespace cc
@@ -0,0 +1,121 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include "base/Ptr.h"
+#include "base/std/container/string.h"
+#include "base/std/container/vector.h"
+#include "platform/FileView.h"
+#include "platform/Image.h"
+
+namespace cc {
+
+class LegacyThreadPool;
+
+/**
+ * Decodes many images at once on worker threads. Requests with a higher priority start first,
+ * finished images are handed back on the thread calling flush, which the engine does every frame.
+ * Decoding pauses while finished but undelivered images hold more than the memory budget.
+ */
+class CC_DLL ImageDecoder final {
+public:
+    // image is nullptr if decoding failed
+    using Callback = std::function<void(const IntrusivePtr<Image> &image)>;
+
+    struct Request {
+        // full path of the file, fullPathForFilename isn't thread safe
+        ccstd::string path;
+        // encoded bytes, used instead of the path if not empty
+        FileView data;
+        Image::DecodeOptions options;
+        int32_t priority{0};
+        Callback callback;
+    };
+
+    static ImageDecoder *getInstance();
+    static void destroyInstance();
+
+    // threadCount 0 uses all cores but one
+    explicit ImageDecoder(uint32_t threadCount = 0);
+    // waits for running decodes, pending requests are dropped
+    ~ImageDecoder();
+    ImageDecoder(const ImageDecoder &) = delete;
+    ImageDecoder &operator=(const ImageDecoder &) = delete;
+
+    // returns an id for cancel
+    uint32_t push(Request &&request);
+    // cancels a request which hasn't started yet
+    bool cancel(uint32_t id);
+
+    /**
+     * Calls the callbacks of finished decodes on this thread.
+     * @return The number of delivered images.
+     */
+    uint32_t flush(uint32_t maxCount = UINT32_MAX);
+
+    // blocks until all requests are decoded or the memory budget is hit, results still need a flush
+    void waitForAll();
+
+    inline void setMemoryBudget(size_t bytes) { _memoryBudget = bytes; }
+    inline size_t getMemoryBudget() const { return _memoryBudget; }
+    inline uint32_t getThreadCount() const { return _threadCount; }
+    uint32_t getPendingCount() const;
+
+private:
+    struct Task {
+        uint32_t id{0};
+        Request request;
+    };
+
+    struct Result {
+        IntrusivePtr<Image> image;
+        Callback callback;
+    };
+
+    static bool isLowerPriority(const Task &lhs, const Task &rhs);
+
+    void schedule();
+    void decode(Task &&task);
+    bool canStart() const;
+
+    LegacyThreadPool *_pool{nullptr};
+    uint32_t _threadCount{0};
+    size_t _memoryBudget{256U * 1024U * 1024U};
+
+    mutable std::mutex _mutex;
+    std::condition_variable _idle;
+    ccstd::vector<Task> _pending; // heap by priority, then by id
+    ccstd::vector<Result> _finished;
+    size_t _finishedBytes{0};
+    uint32_t _running{0};
+    uint32_t _nextId{0};
+};
+
+} // namespace cc
@@ -167,6 +167,10 @@ FileUtils::Status FileUtilsAndroid::getContents(const ccstd::string &filename, R
         return FileUtils::Status::NOT_EXISTS;
     }
 
+    if (getPackContents(filename, buffer)) {
+        return FileUtils::Status::OK;
+    }
+
     ccstd::string fullPath = fullPathForFilename(filename);
     if (fullPath.empty()) {
         return FileUtils::Status::NOT_EXISTS;
@@ -113,6 +113,10 @@ FileUtils::Status FileUtilsOHOS::getContents(const ccstd::string &filename, Resi
         return FileUtils::Status::NOT_EXISTS;
     }
 
+    if (getPackContents(filename, buffer)) {
+        return FileUtils::Status::OK;
+    }
+
     ccstd::string fullPath = fullPathForFilename(filename);
     if (fullPath.empty()) {
         return FileUtils::Status::NOT_EXISTS;
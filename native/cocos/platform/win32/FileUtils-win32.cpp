@@ -137,6 +137,10 @@ FileUtils::Status FileUtilsWin32::getContents(const ccstd::string &filename, Res
     if (filename.empty())
         return FileUtils::Status::NOT_EXISTS;
 
+    if (getPackContents(filename, buffer)) {
+        return FileUtils::Status::OK;
+    }
+
     // read the file from hardware
     ccstd::string fullPath = FileUtils::getInstance()->fullPathForFilename(filename);
 
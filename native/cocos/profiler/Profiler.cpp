@@ -132,6 +132,7 @@ Profiler::Profiler() {
     _mainThreadId = std::this_thread::get_id();
     _root = ccnew ProfilerBlock(nullptr, "MainThread");
     _current = _root;
+    TimelineRecorder::getInstance()->setThreadName("MainThread");
 
     Profiler::instance = this;
 }
@@ -161,6 +162,7 @@ void Profiler::beginFrame() {
 
     _current = _root;
     _root->onFrameBegin();
+    TimelineRecorder::getInstance()->markFrame("Frame");
     _root->begin();
 }
 
@@ -214,6 +216,8 @@ void Profiler::doFrameUpdate() {
     CC_PROFILE_RENDER_UPDATE(DrawCalls, device->getNumDrawCalls());
     CC_PROFILE_RENDER_UPDATE(Instances, device->getNumInstances());
     CC_PROFILE_RENDER_UPDATE(Triangles, device->getNumTris());
+    CC_PROFILE_COUNTER(DrawCalls, device->getNumDrawCalls());
+    CC_PROFILE_COUNTER(Triangles, device->getNumTris());
 
 #if USE_MEMORY_LEAK_DETECTOR
     CC_PROFILE_MEMORY_UPDATE(HeapMemory, GMemoryHook.getTotalSize());
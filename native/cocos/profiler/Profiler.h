@@ -27,6 +27,7 @@
 #include <string_view>
 #include <thread>
 #include "GameStats.h"
+#include "TimelineRecorder.h"
 #include "base/Config.h"
 #include "base/Timer.h"
 #include "gfx-base/GFXDef-common.h"
@@ -93,12 +94,12 @@ private:
 };
 
 /**
- * AutoProfiler: profile code block automatically
+ * AutoProfiler: profile code block automatically, name should be a string literal as it is also recorded by TimelineRecorder
  */
 class AutoProfiler {
 public:
     AutoProfiler(Profiler *profiler, const std::string_view &name)
-    : _profiler(profiler) {
+    : _profiler(profiler), _scope(name.data()) {
         _profiler->beginBlock(name);
     }
 
@@ -108,6 +109,7 @@ public:
 
 private:
     Profiler *_profiler{nullptr};
+    TimelineScope _scope;
 };
 
 } // namespace cc
@@ -174,6 +176,9 @@ private:
         if (CC_PROFILER && CC_PROFILER->isMainThread()) {            \
             CC_PROFILER->getObjectStats().objects[#name] -= (count); \
         }
+    #define CC_PROFILE_COUNTER(name, value) cc::TimelineRecorder::getInstance()->counter(#name, static_cast<double>(value))
+    #define CC_PROFILE_FRAME_MARK(name)     cc::TimelineRecorder::getInstance()->markFrame(#name)
+    #define CC_PROFILE_THREAD_NAME(name)    cc::TimelineRecorder::getInstance()->setThreadName(#name)
 #else
     #define CC_PROFILER
     #define CC_PROFILER_SET_ENABLE(option, b)
@@ -191,4 +196,7 @@ private:
     #define CC_PROFILE_OBJECT_UPDATE(name, count)
     #define CC_PROFILE_OBJECT_INC(name, count)
     #define CC_PROFILE_OBJECT_DEC(name, count)
+    #define CC_PROFILE_COUNTER(name, value)
+    #define CC_PROFILE_FRAME_MARK(name)
+    #define CC_PROFILE_THREAD_NAME(name)
 #endif
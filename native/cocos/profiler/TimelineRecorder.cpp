@@ -0,0 +1,236 @@
+/****************************************************************************
+ Copyright (c) 2021-2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "TimelineRecorder.h"
+#include <algorithm>
+#include <cstring>
+#include "base/Log.h"
+#include "base/StringUtil.h"
+#include "base/memory/Memory.h"
+#include "platform/FileUtils.h"
+
+namespace cc {
+
+namespace {
+
+thread_local void *tlsBuffer{nullptr};
+
+void appendEvent(ccstd::string &out, const ccstd::string &event) {
+    if (out.back() != '[') {
+        out += ",\n";
+    }
+    out += event;
+}
+
+// names are free text, quotes, backslashes and control characters must not end up raw in the json
+ccstd::string escapeJson(const char *str) {
+    ccstd::string out;
+    for (const char *c = str; *c != '\0'; ++c) {
+        switch (*c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20) {
+                    out += StringUtil::format("\\u%04x", static_cast<unsigned>(static_cast<unsigned char>(*c)));
+                } else {
+                    out += *c;
+                }
+                break;
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+TimelineRecorder *TimelineRecorder::getInstance() {
+    static TimelineRecorder instance;
+    return &instance;
+}
+
+TimelineRecorder::ThreadBuffer::ThreadBuffer(uint32_t tid, uint32_t capacity)
+: tid(tid),
+  mask(capacity - 1),
+  events(std::make_unique<Event[]>(capacity)),
+  name(StringUtil::format("Thread %u", tid)) {}
+
+void TimelineRecorder::start() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _beginTime = now();
+        _beginTicks = ticks();
+        _endTicks = UINT64_MAX;
+    }
+    _recording.store(true, std::memory_order_release);
+}
+
+void TimelineRecorder::stop() {
+    _recording.store(false, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(_mutex);
+    _endTicks = ticks();
+    _endTime = now();
+}
+
+void TimelineRecorder::setCapacity(uint32_t capacity) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    // round up to a power of two, ring indices are masked
+    uint32_t size = 2;
+    while (size < capacity && size < (1U << 31U)) {
+        size <<= 1U;
+    }
+    _capacity = size;
+}
+
+TimelineRecorder::ThreadBuffer *TimelineRecorder::currentBuffer() {
+    if (CC_PREDICT_TRUE(tlsBuffer != nullptr)) {
+        return static_cast<ThreadBuffer *>(tlsBuffer);
+    }
+    return registerThread();
+}
+
+TimelineRecorder::ThreadBuffer *TimelineRecorder::registerThread() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    // buffers stay alive after their thread exits, so the thread still shows up in the export
+    auto *buffer = ccnew ThreadBuffer(static_cast<uint32_t>(_buffers.size()), _capacity);
+    _buffers.emplace_back(buffer);
+    tlsBuffer = buffer;
+    return buffer;
+}
+
+void TimelineRecorder::setThreadName(const char *name) {
+    ThreadBuffer *buffer = currentBuffer();
+    std::lock_guard<std::mutex> lock(_mutex);
+    buffer->name = name;
+}
+
+void TimelineRecorder::counter(const char *name, double value) {
+    if (isRecording()) {
+        uint64_t bits{0U};
+        static_assert(sizeof(bits) == sizeof(value), "counter values are stored as raw bits");
+        memcpy(&bits, &value, sizeof(bits));
+        write(EventType::COUNTER, name, bits);
+    }
+}
+
+void TimelineRecorder::markFrame(const char *name) {
+    if (isRecording()) {
+        ThreadBuffer *buffer = currentBuffer();
+        write(EventType::FRAME, name, buffer->frames++);
+    }
+}
+
+void TimelineRecorder::copyEvents(const ThreadBuffer &buffer, ccstd::vector<EventCopy> &out) const {
+    const uint64_t capacity = buffer.mask + 1ULL;
+    const uint64_t head = buffer.head.load(std::memory_order_acquire);
+    uint64_t first = head > capacity ? head - capacity : 0U;
+    out.clear();
+    out.reserve(head - first);
+    for (uint64_t i = first; i < head; ++i) {
+        const Event &event = buffer.events[i & buffer.mask];
+        out.push_back({event.name.load(std::memory_order_relaxed),
+                       event.time.load(std::memory_order_relaxed),
+                       event.value.load(std::memory_order_relaxed),
+                       event.type.load(std::memory_order_relaxed)});
+    }
+
+    // the owner may have wrapped around while copying, drop the slots it could have overwritten
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t newHead = buffer.head.load(std::memory_order_relaxed);
+    const uint64_t valid = newHead + 1 > capacity ? newHead + 1 - capacity : 0U;
+    if (valid > first) {
+        out.erase(out.begin(), out.begin() + static_cast<std::ptrdiff_t>(std::min(valid, head) - first));
+    }
+}
+
+ccstd::string TimelineRecorder::dumpTrace() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const uint64_t begin = _beginTicks;
+    const uint64_t end = _endTicks;
+    // calibrate against the system clock up to now if the session is still running
+    const uint64_t endTicks = end != UINT64_MAX ? end : ticks();
+    const uint64_t endTime = end != UINT64_MAX ? _endTime : now();
+    const double microsecondsPerTick = endTicks > begin ? static_cast<double>(endTime - _beginTime) / static_cast<double>(endTicks - begin) / 1000.0 : 0.001;
+    auto toMicroseconds = [&](uint64_t time) {
+        return static_cast<double>(time - begin) * microsecondsPerTick;
+    };
+
+    ccstd::string out{R"({"displayTimeUnit":"ns","traceEvents":[)"};
+    ccstd::vector<EventCopy> events;
+    ccstd::vector<const EventCopy *> stack;
+
+    for (const auto &buffer : _buffers) {
+        appendEvent(out, StringUtil::format(R"({"name":"thread_name","ph":"M","pid":0,"tid":%u,"args":{"name":"%s"}})", buffer->tid, escapeJson(buffer->name.c_str()).c_str()));
+
+        copyEvents(*buffer, events);
+        stack.clear();
+        for (const auto &event : events) {
+            if (event.time < begin || event.time > end) {
+                continue;
+            }
+            switch (event.type) {
+                case EventType::BEGIN:
+                    stack.push_back(&event);
+                    break;
+                case EventType::END:
+                    // scopes which began before the oldest kept event are dropped
+                    if (!stack.empty()) {
+                        const EventCopy *scope = stack.back();
+                        stack.pop_back();
+                        appendEvent(out, StringUtil::format(R"({"name":"%s","cat":"cpu","ph":"X","pid":0,"tid":%u,"ts":%.3f,"dur":%.3f})",
+                                                            escapeJson(scope->name).c_str(), buffer->tid, toMicroseconds(scope->time),
+                                                            static_cast<double>(event.time - scope->time) * microsecondsPerTick));
+                    }
+                    break;
+                case EventType::COUNTER: {
+                    double value{0.0};
+                    memcpy(&value, &event.value, sizeof(value));
+                    appendEvent(out, StringUtil::format(R"({"name":"%s","ph":"C","pid":0,"tid":%u,"ts":%.3f,"args":{"value":%.17g}})",
+                                                        escapeJson(event.name).c_str(), buffer->tid, toMicroseconds(event.time), value));
+                    break;
+                }
+                case EventType::FRAME:
+                    appendEvent(out, StringUtil::format(R"({"name":"%s","cat":"frame","ph":"i","s":"p","pid":0,"tid":%u,"ts":%.3f,"args":{"frame":%llu}})",
+                                                        escapeJson(event.name).c_str(), buffer->tid, toMicroseconds(event.time),
+                                                        static_cast<unsigned long long>(event.value))); // NOLINT(google-runtime-int)
+                    break;
+            }
+        }
+    }
+    out += "]}\n";
+    return out;
+}
+
+bool TimelineRecorder::writeTrace(const ccstd::string &path) const {
+    const bool succeeded = FileUtils::getInstance()->writeStringToFile(dumpTrace(), path);
+    if (!succeeded) {
+        CC_LOG_WARNING("Failed to write timeline trace to %s", path.c_str());
+    }
+    return succeeded;
+}
+
+} // namespace cc
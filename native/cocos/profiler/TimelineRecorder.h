@@ -0,0 +1,198 @@
+/****************************************************************************
+ Copyright (c) 2021-2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include "base/Macros.h"
+#include "base/std/container/string.h"
+#include "base/std/container/vector.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+#endif
+
+namespace cc {
+
+/**
+ * TimelineRecorder: records scopes, counters and frame markers of every thread into per-thread
+ * lock-free ring buffers, and exports them in the Chrome trace event format (chrome://tracing, Perfetto).
+ * Recording is disabled by default, a disabled scope costs one relaxed atomic load.
+ */
+class CC_DLL TimelineRecorder final {
+public:
+    static constexpr uint32_t DEFAULT_CAPACITY{1U << 14U};
+
+    static TimelineRecorder *getInstance();
+
+    static inline uint64_t now() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /**
+     * Raw timestamp of recorded events, the cycle counter where available as it is much cheaper than the system clock.
+     * Ticks are converted to nanoseconds on export, calibrated against now() over the recording session.
+     */
+    static inline uint64_t ticks() {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t value{0U};
+        asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+        return value;
+#else
+        return now();
+#endif
+    }
+
+    TimelineRecorder() = default;
+    ~TimelineRecorder() = default;
+    TimelineRecorder(const TimelineRecorder &) = delete;
+    TimelineRecorder(TimelineRecorder &&) = delete;
+    TimelineRecorder &operator=(const TimelineRecorder &) = delete;
+    TimelineRecorder &operator=(TimelineRecorder &&) = delete;
+
+    /**
+     * Starts a new recording session, events of previous sessions are dropped from the export.
+     */
+    void start();
+    void stop();
+    inline bool isRecording() const { return _recording.load(std::memory_order_relaxed); }
+
+    /**
+     * Events kept per thread, the oldest events are overwritten once a ring is full.
+     * Only applies to threads which have not recorded anything yet.
+     */
+    void setCapacity(uint32_t capacity);
+
+    /**
+     * Names the calling thread in the exported trace.
+     */
+    void setThreadName(const char *name);
+
+    // names must be string literals or otherwise outlive the export
+    inline void beginScope(const char *name) { write(EventType::BEGIN, name, 0U); }
+    inline void endScope() { write(EventType::END, nullptr, 0U); }
+    void counter(const char *name, double value);
+    void markFrame(const char *name);
+
+    ccstd::string dumpTrace() const;
+    bool writeTrace(const ccstd::string &path) const;
+
+private:
+    enum class EventType : uint32_t {
+        BEGIN,
+        END,
+        COUNTER,
+        FRAME,
+    };
+
+    // fields are relaxed atomics so that exporting while other threads are recording is well defined
+    struct Event {
+        std::atomic<const char *> name{nullptr};
+        std::atomic<uint64_t> time{0U};
+        std::atomic<uint64_t> value{0U};
+        std::atomic<EventType> type{EventType::BEGIN};
+    };
+
+    struct ThreadBuffer {
+        ThreadBuffer(uint32_t tid, uint32_t capacity);
+
+        uint32_t tid{0U};
+        uint32_t mask{0U};
+        uint64_t frames{0U};
+        std::unique_ptr<Event[]> events;
+        std::atomic<uint64_t> head{0U};
+        ccstd::string name;
+    };
+
+    struct EventCopy {
+        const char *name;
+        uint64_t time;
+        uint64_t value;
+        EventType type;
+    };
+
+    inline void write(EventType type, const char *name, uint64_t value) {
+        ThreadBuffer *buffer = currentBuffer();
+        const uint64_t index = buffer->head.load(std::memory_order_relaxed);
+        Event &event = buffer->events[index & buffer->mask];
+        event.name.store(name, std::memory_order_relaxed);
+        event.time.store(ticks(), std::memory_order_relaxed);
+        event.value.store(value, std::memory_order_relaxed);
+        event.type.store(type, std::memory_order_relaxed);
+        buffer->head.store(index + 1, std::memory_order_release);
+    }
+
+    ThreadBuffer *currentBuffer();
+    ThreadBuffer *registerThread();
+    void copyEvents(const ThreadBuffer &buffer, ccstd::vector<EventCopy> &out) const;
+
+    std::atomic<bool> _recording{false};
+    // session bounds in ticks and in nanoseconds, for the tick to nanosecond conversion
+    uint64_t _beginTicks{0U};
+    uint64_t _beginTime{0U};
+    uint64_t _endTicks{UINT64_MAX};
+    uint64_t _endTime{0U};
+    uint32_t _capacity{DEFAULT_CAPACITY};
+    mutable std::mutex _mutex;
+    ccstd::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+};
+
+/**
+ * TimelineScope: records a scope of the calling thread while the recorder is running.
+ */
+class TimelineScope final {
+public:
+    explicit TimelineScope(const char *name) {
+        auto *recorder = TimelineRecorder::getInstance();
+        if (recorder->isRecording()) {
+            _recorder = recorder;
+            _recorder->beginScope(name);
+        }
+    }
+
+    ~TimelineScope() {
+        if (_recorder) {
+            _recorder->endScope();
+        }
+    }
+
+    TimelineScope(const TimelineScope &) = delete;
+    TimelineScope(TimelineScope &&) = delete;
+    TimelineScope &operator=(const TimelineScope &) = delete;
+    TimelineScope &operator=(TimelineScope &&) = delete;
+
+private:
+    TimelineRecorder *_recorder{nullptr};
+};
+
+} // namespace cc
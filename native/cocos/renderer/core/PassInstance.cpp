@@ -74,7 +74,7 @@ bool PassInstance::tryCompile(const ccstd::optional<MacroRecord> &defineOverride
     if (defineOverrides.has_value()) {
         if (!overrideMacros(_defines, defineOverrides.value())) return false;
     }
-    bool ret = Super::tryCompile();
+    bool ret = compileShader(true);
     onStateChange();
     return ret;
 }
@@ -25,11 +25,15 @@
 
 #include "renderer/core/ProgramLib.h"
 #include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <numeric>
 #include <ostream>
 #include "base/Log.h"
+#include "base/job-system/JobSystem.h"
 #include "core/assets/EffectAsset.h"
+#include "platform/FileUtils.h"
+#include "profiler/Profiler.h"
 #include "renderer/gfx-base/GFXDevice.h"
 #include "renderer/pipeline/custom/RenderInterfaceTypes.h"
 
@@ -223,6 +227,42 @@ ccstd::vector<gfx::Attribute> getActiveAttributes(const IProgramInfo &tmpl, cons
     return out;
 }
 
+// one define per token: name=<b|i|s>value
+void writeDefines(std::ostream &out, const MacroRecord &defines) {
+    for (const auto &define : defines) {
+        out << define.first << '=';
+        if (ccstd::holds_alternative<bool>(define.second)) {
+            out << 'b' << (ccstd::get<bool>(define.second) ? 1 : 0);
+        } else if (ccstd::holds_alternative<int32_t>(define.second)) {
+            out << 'i' << ccstd::get<int32_t>(define.second);
+        } else {
+            out << 's' << ccstd::get<ccstd::string>(define.second);
+        }
+        out << ';';
+    }
+}
+
+MacroRecord readDefines(const ccstd::string &str) {
+    MacroRecord defines;
+    std::istringstream in(str);
+    ccstd::string token;
+    while (std::getline(in, token, ';')) {
+        auto pos = token.find('=');
+        if (pos == ccstd::string::npos || pos + 1 >= token.size()) {
+            continue;
+        }
+        auto name = token.substr(0, pos);
+        auto value = token.substr(pos + 2);
+        switch (token[pos + 1]) {
+            case 'b': defines[name] = value == "1"; break;
+            case 'i': defines[name] = static_cast<int32_t>(std::strtol(value.c_str(), nullptr, 10)); break;
+            case 's': defines[name] = value; break;
+            default: break;
+        }
+    }
+    return defines;
+}
+
 } // namespace
 
 const char *getDeviceShaderVersion(const gfx::Device *device) {
@@ -648,6 +688,26 @@ void ProgramLib::destroyShaderByDefines(const MacroRecord &defines) {
     }
 }
 
+bool ProgramLib::getCompiledShader(const ccstd::string &instanceName, gfx::Shader *&shader, gfx::PipelineLayout *&pipelineLayout) {
+    auto itInstance = _instances.find(instanceName);
+    if (itInstance == _instances.end()) {
+        return false;
+    }
+    const auto &programName = itInstance->second.first;
+    auto itRes = _cache.find(itInstance->second.second);
+    if (itRes == _cache.end()) { // destroyed by defines
+        _instances.erase(itInstance);
+        return false;
+    }
+    const auto *tmplInfo = getTemplateInfo(programName);
+    if (!tmplInfo || !tmplInfo->pipelineLayout) {
+        return false;
+    }
+    shader = itRes->second;
+    pipelineLayout = tmplInfo->pipelineLayout;
+    return true;
+}
+
 gfx::Shader *ProgramLib::getGFXShader(gfx::Device *device, const ccstd::string &name, MacroRecord &defines,
                                       render::PipelineRuntime *pipeline, ccstd::string *keyOut) {
     for (const auto &it : pipeline->getMacros()) {
@@ -666,6 +726,179 @@ gfx::Shader *ProgramLib::getGFXShader(gfx::Device *device, const ccstd::string &
         return itRes->second;
     }
 
+    getPreparedTemplateInfo(device, name, pipeline);
+    return createShader(device, name, defines, getShaderInfo(device, name, defines, pipeline), key);
+}
+
+gfx::Shader *ProgramLib::getGFXShaderAsync(gfx::Device *device, const ccstd::string &name, MacroRecord &defines,
+                                           render::PipelineRuntime *pipeline, gfx::Shader *fallback) {
+    for (const auto &it : pipeline->getMacros()) {
+        defines[it.first] = it.second;
+    }
+
+    auto key = getKey(name, defines);
+    auto itRes = _cache.find(key);
+    if (itRes != _cache.end()) {
+        return itRes->second;
+    }
+
+    if (_pendingKeys.insert(key).second) {
+        _pendingShaders.push_back({std::move(key), name, defines, device, pipeline});
+    }
+    return fallback;
+}
+
+void ProgramLib::update() {
+    queueDeferredVariants();
+    CC_PROFILE_COUNTER(ProgramLibPendingShaders, _pendingShaders.size());
+    if (_pendingShaders.empty()) {
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto batchSize = std::max(JobSystem::getInstance()->threadCount(), 1U);
+    size_t compiled = 0;
+    ccstd::vector<PendingShader> batch;
+    while (compiled < _pendingShaders.size()) {
+        batch.clear();
+        while (compiled < _pendingShaders.size() && batch.size() < batchSize) {
+            auto &pending = _pendingShaders[compiled++];
+            _pendingKeys.erase(pending.key);
+            if (_cache.count(pending.key) == 0) { // may have been requested synchronously meanwhile
+                batch.emplace_back(std::move(pending));
+            }
+        }
+        compileShaders(batch);
+
+        std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() >= _compileBudget) {
+            break;
+        }
+    }
+    _pendingShaders.erase(_pendingShaders.begin(), _pendingShaders.begin() + static_cast<std::ptrdiff_t>(compiled));
+    ++_shaderGeneration;
+}
+
+bool ProgramLib::saveRecordedVariants(const ccstd::string &path) const {
+    std::stringstream ss;
+    for (const auto *variants : {&_recordedVariants, &_deferredVariants}) {
+        for (const auto &variant : *variants) {
+            ss << variant.effectName << '\t' << variant.programName << '\t';
+            writeDefines(ss, variant.defines);
+            ss << '\n';
+        }
+    }
+    return FileUtils::getInstance()->writeStringToFile(ss.str(), path);
+}
+
+ccstd::vector<IProgramVariant> ProgramLib::loadVariants(const ccstd::string &path) {
+    ccstd::vector<IProgramVariant> variants;
+    auto *fileUtils = FileUtils::getInstance();
+    if (!fileUtils->isFileExist(path)) {
+        return variants;
+    }
+    std::istringstream in(fileUtils->getStringFromFile(path));
+    ccstd::string line;
+    while (std::getline(in, line)) {
+        auto first = line.find('\t');
+        auto second = first == ccstd::string::npos ? first : line.find('\t', first + 1);
+        if (second == ccstd::string::npos) {
+            continue;
+        }
+        auto &variant = variants.emplace_back();
+        variant.effectName = line.substr(0, first);
+        variant.programName = line.substr(first + 1, second - first - 1);
+        variant.defines = readDefines(line.substr(second + 1));
+    }
+    return variants;
+}
+
+uint32_t ProgramLib::prewarm(gfx::Device *device, render::PipelineRuntime *pipeline, const ccstd::vector<IProgramVariant> &variants) {
+    CC_PROFILE(ProgramLibPrewarm);
+    ccstd::vector<PendingShader> shaders;
+    ccstd::unordered_set<ccstd::string> keys;
+    for (const auto &variant : variants) {
+        if (!hasProgram(variant.programName)) {
+            continue; // effect not registered in this session
+        }
+        MacroRecord defines = variant.defines;
+        for (const auto &it : pipeline->getMacros()) {
+            defines[it.first] = it.second;
+        }
+        auto key = getKey(variant.programName, defines);
+        if (_cache.count(key) || !keys.insert(key).second) {
+            continue;
+        }
+        shaders.push_back({std::move(key), variant.programName, std::move(defines), device, pipeline});
+    }
+    compileShaders(shaders);
+    return static_cast<uint32_t>(shaders.size());
+}
+
+void ProgramLib::prewarmAsync(gfx::Device *device, render::PipelineRuntime *pipeline, const ccstd::string &path) {
+    auto variants = loadVariants(path);
+    _deferredVariants.insert(_deferredVariants.end(), std::make_move_iterator(variants.begin()), std::make_move_iterator(variants.end()));
+    _deferredDevice = device;
+    _deferredPipeline = pipeline;
+    _deferredTemplateCount = 0;
+}
+
+void ProgramLib::queueDeferredVariants() {
+    // only effects registered since the last call can resolve more variants
+    if (_deferredVariants.empty() || _templates.size() == _deferredTemplateCount) {
+        return;
+    }
+    _deferredTemplateCount = _templates.size();
+
+    auto iter = std::remove_if(_deferredVariants.begin(), _deferredVariants.end(), [this](const IProgramVariant &variant) {
+        if (!hasProgram(variant.programName)) {
+            return false;
+        }
+        MacroRecord defines = variant.defines;
+        for (const auto &it : _deferredPipeline->getMacros()) {
+            defines[it.first] = it.second;
+        }
+        auto key = getKey(variant.programName, defines);
+        if (_cache.count(key) == 0 && _pendingKeys.insert(key).second) {
+            _pendingShaders.push_back({std::move(key), variant.programName, std::move(defines), _deferredDevice, _deferredPipeline});
+        }
+        return true;
+    });
+    _deferredVariants.erase(iter, _deferredVariants.end());
+}
+
+void ProgramLib::compileShaders(const ccstd::vector<PendingShader> &shaders) {
+    for (const auto &shader : shaders) {
+        getPreparedTemplateInfo(shader.device, shader.name, shader.pipeline);
+    }
+
+    // generating the sources only reads the prepared templates
+    const auto count = static_cast<uint32_t>(shaders.size());
+    ccstd::vector<gfx::ShaderInfo> infos(count);
+    auto prepareJob = [&](uint32_t i) {
+        infos[i] = getShaderInfo(shaders[i].device, shaders[i].name, shaders[i].defines, shaders[i].pipeline);
+    };
+    if (count > 1) {
+        JobGraph g(JobSystem::getInstance(), "ProgramLibCompile");
+        g.createForEachIndexJob(0U, count, 1U, prepareJob);
+        g.run();
+        g.waitForAll();
+    } else {
+        for (uint32_t i = 0; i < count; ++i) {
+            prepareJob(i);
+        }
+    }
+
+    // the backends compile on the thread owning the device, the whole batch at once where they can
+    if (count > 1) {
+        shaders.front().device->precompileShaders(infos.data(), count);
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        createShader(shaders[i].device, shaders[i].name, shaders[i].defines, infos[i], shaders[i].key);
+    }
+}
+
+ITemplateInfo &ProgramLib::getPreparedTemplateInfo(gfx::Device *device, const ccstd::string &name, render::PipelineRuntime *pipeline) {
     auto itTpl = _templates.find(name);
     CC_ASSERT(itTpl != _templates.end());
 
@@ -680,6 +913,13 @@ gfx::Shader *ProgramLib::getGFXShader(gfx::Device *device, const ccstd::string &
         tmplInfo.setLayouts.replace(static_cast<index_t>(pipeline::SetIndex::GLOBAL), pipeline->getDescriptorSetLayout());
         tmplInfo.pipelineLayout = device->createPipelineLayout(gfx::PipelineLayoutInfo{tmplInfo.setLayouts.get()});
     }
+    return tmplInfo;
+}
+
+gfx::ShaderInfo ProgramLib::getShaderInfo(gfx::Device *device, const ccstd::string &name, const MacroRecord &defines,
+                                          render::PipelineRuntime *pipeline) const {
+    const auto &tmpl = _templates.at(name);
+    const auto &tmplInfo = _templateInfos.at(tmpl.hash);
 
     ccstd::vector<IMacroInfo> macroArray = prepareDefines(defines, tmpl.defines);
     std::stringstream ss;
@@ -696,17 +936,29 @@ gfx::Shader *ProgramLib::getGFXShader(gfx::Device *device, const ccstd::string &
     } else {
         CC_LOG_ERROR("Invalid GFX API!");
     }
-    tmplInfo.shaderInfo.stages[0].source = prefix + src->vert;
-    tmplInfo.shaderInfo.stages[1].source = prefix + src->frag;
+
+    gfx::ShaderInfo shaderInfo = tmplInfo.shaderInfo;
+    shaderInfo.stages[0].source = prefix + src->vert;
+    shaderInfo.stages[1].source = prefix + src->frag;
 
     // strip out the active attributes only, instancing depend on this
-    tmplInfo.shaderInfo.attributes = getActiveAttributes(tmpl, tmplInfo, defines);
+    shaderInfo.attributes = getActiveAttributes(tmpl, tmplInfo, defines);
 
-    tmplInfo.shaderInfo.name = getShaderInstanceName(name, macroArray);
+    shaderInfo.name = getShaderInstanceName(name, macroArray);
+    return shaderInfo;
+}
 
-    auto *shader = device->createShader(tmplInfo.shaderInfo);
+gfx::Shader *ProgramLib::createShader(gfx::Device *device, const ccstd::string &name, const MacroRecord &defines,
+                                      const gfx::ShaderInfo &info, const ccstd::string &key) {
+    CC_PROFILE(ProgramLibCreateShader);
+    auto *shader = device->createShader(info);
     _cache[key] = shader;
+    _instances[info.name] = {name, key};
+    ++_createdShaderCount;
     //    CC_LOG_DEBUG("ProgramLib::_cache[%s]=%p, defines: %d", key.c_str(), shader, defines.size());
+    if (_variantRecording) {
+        _recordedVariants.push_back({_templates.at(name).effectName, name, defines});
+    }
     return shader;
 }
 
@@ -31,6 +31,7 @@
 #include "base/RefVector.h"
 #include "base/std/container/string.h"
 #include "base/std/container/unordered_map.h"
+#include "base/std/container/unordered_set.h"
 #include "base/std/optional.h"
 #include "core/Types.h"
 #include "core/assets/EffectAsset.h"
@@ -75,6 +76,16 @@ struct IProgramInfo : public IShaderInfo {
     void copyFrom(const IShaderInfo &o);
 };
 
+/**
+ * @en A shader variant touched at runtime, the program name identifies the technique and pass
+ * @zh 运行时用到的 shader 变体，程序名对应具体的 technique 和 pass
+ */
+struct IProgramVariant {
+    ccstd::string effectName;
+    ccstd::string programName;
+    MacroRecord defines;
+};
+
 const char *getDeviceShaderVersion(const gfx::Device *device);
 
 /**
@@ -146,6 +157,18 @@ public:
 
     void destroyShaderByDefines(const MacroRecord &defines);
 
+    /**
+     * @en Gets a compiled shader instance by its instance name, together with the pipeline layout of its template.
+     * This is the resolver of [[pipeline::PipelineStateManager.prewarm]].
+     * @zh 通过实例名获取已编译的 shader 实例及其模板的管线布局，用于 [[pipeline::PipelineStateManager.prewarm]]。
+     * @param instanceName The name of the shader instance, e.g. "builtin-standard|USE_INSTANCING1"
+     * @return false if no such instance has been compiled
+     */
+    bool getCompiledShader(const ccstd::string &instanceName, gfx::Shader *&shader, gfx::PipelineLayout *&pipelineLayout);
+
+    // increased on every shader instance created
+    inline uint32_t getCreatedShaderCount() const { return _createdShaderCount; }
+
     /**
      * @en Gets the shader resource instance with given information
      * @zh 获取指定 shader 的渲染资源实例
@@ -157,13 +180,103 @@ public:
     gfx::Shader *getGFXShader(gfx::Device *device, const ccstd::string &name, MacroRecord &defines,
                               render::PipelineRuntime *pipeline, ccstd::string *key = nullptr);
 
+    /**
+     * @en Gets the shader resource instance without blocking, the variant is compiled in a later [[update]]
+     * @zh 非阻塞地获取指定 shader 的渲染资源实例，变体会在之后的 [[update]] 中编译
+     * @param name Shader name
+     * @param defines Preprocess macros
+     * @param pipeline The [[RenderPipeline]] which owns the render command
+     * @param fallback The shader returned until the variant is ready
+     */
+    gfx::Shader *getGFXShaderAsync(gfx::Device *device, const ccstd::string &name, MacroRecord &defines,
+                                   render::PipelineRuntime *pipeline, gfx::Shader *fallback);
+
+    /**
+     * @en Compiles the pending variants requested by [[getGFXShaderAsync]] and [[prewarmAsync]] in batches until the compile budget is spent.
+     * The shader sources of a batch are prepared on worker threads, the backend compile runs on the thread owning the device,
+     * which is the render thread of a multithreaded device.
+     * @zh 分批编译 [[getGFXShaderAsync]] 与 [[prewarmAsync]] 请求的变体，直到用完编译预算。
+     * 每批的 shader 源码在工作线程中准备，后端编译在设备所属线程进行，多线程设备即其渲染线程。
+     */
+    void update();
+
+    inline bool hasPendingShaders() const { return !_pendingShaders.empty(); }
+    inline bool isShaderPending(const ccstd::string &key) const { return _pendingKeys.count(key) > 0; }
+
+    // bumped whenever update compiles pending variants, holders of a fallback re-fetch when it changes
+    inline uint32_t getShaderGeneration() const { return _shaderGeneration; }
+
+    // define changes and macro patches keep rendering with the current variant while the new one compiles
+    inline void setAsyncCompileEnabled(bool enabled) { _asyncCompileEnabled = enabled; }
+    inline bool isAsyncCompileEnabled() const { return _asyncCompileEnabled; }
+
+    // milliseconds spent on pending variants per update, at least one batch is compiled
+    inline void setCompileBudget(float milliseconds) { _compileBudget = milliseconds; }
+    inline float getCompileBudget() const { return _compileBudget; }
+
+    /**
+     * @en Records every variant compiled from now on, see [[saveRecordedVariants]]
+     * @zh 记录之后编译的所有变体，参见 [[saveRecordedVariants]]
+     */
+    inline void setVariantRecording(bool enabled) { _variantRecording = enabled; }
+    inline bool isVariantRecording() const { return _variantRecording; }
+    inline const ccstd::vector<IProgramVariant> &getRecordedVariants() const { return _recordedVariants; }
+    inline void clearRecordedVariants() { _recordedVariants.clear(); }
+
+    // variants loaded by [[prewarmAsync]] whose effect was not registered in this session are saved as well
+    bool saveRecordedVariants(const ccstd::string &path) const;
+    static ccstd::vector<IProgramVariant> loadVariants(const ccstd::string &path);
+
+    /**
+     * @en Compiles the given variants ahead of use, the shader sources are prepared on worker threads
+     * @zh 预先编译指定的变体，shader 源码在工作线程中准备
+     * @return The number of variants compiled
+     */
+    uint32_t prewarm(gfx::Device *device, render::PipelineRuntime *pipeline, const ccstd::vector<IProgramVariant> &variants);
+
+    /**
+     * @en Loads the variants saved by [[saveRecordedVariants]], each one is compiled by [[update]] once its effect is registered
+     * @zh 加载 [[saveRecordedVariants]] 保存的变体，每个变体在其 effect 注册后由 [[update]] 编译
+     */
+    void prewarmAsync(gfx::Device *device, render::PipelineRuntime *pipeline, const ccstd::string &path);
+
 private:
+    struct PendingShader {
+        ccstd::string key;
+        ccstd::string name;
+        MacroRecord defines;
+        gfx::Device *device{nullptr};
+        render::PipelineRuntime *pipeline{nullptr};
+    };
+
+    void queueDeferredVariants();
+    void compileShaders(const ccstd::vector<PendingShader> &shaders);
+    ITemplateInfo &getPreparedTemplateInfo(gfx::Device *device, const ccstd::string &name, render::PipelineRuntime *pipeline);
+    gfx::ShaderInfo getShaderInfo(gfx::Device *device, const ccstd::string &name, const MacroRecord &defines,
+                                  render::PipelineRuntime *pipeline) const;
+    gfx::Shader *createShader(gfx::Device *device, const ccstd::string &name, const MacroRecord &defines,
+                              const gfx::ShaderInfo &info, const ccstd::string &key);
+
     CC_DISALLOW_COPY_MOVE_ASSIGN(ProgramLib);
 
     static ProgramLib *instance;
     Record<ccstd::string, IProgramInfo> _templates; // per shader
     Record<ccstd::string, IntrusivePtr<gfx::Shader>> _cache;
     Record<uint64_t, ITemplateInfo> _templateInfos;
+    Record<ccstd::string, std::pair<ccstd::string, ccstd::string>> _instances; // instance name -> program name, cache key
+
+    ccstd::vector<PendingShader> _pendingShaders;
+    ccstd::unordered_set<ccstd::string> _pendingKeys;
+    ccstd::vector<IProgramVariant> _recordedVariants;
+    ccstd::vector<IProgramVariant> _deferredVariants; // waiting for their effects to be registered
+    gfx::Device *_deferredDevice{nullptr};
+    render::PipelineRuntime *_deferredPipeline{nullptr};
+    size_t _deferredTemplateCount{0};
+    float _compileBudget{4.F};
+    uint32_t _shaderGeneration{0};
+    uint32_t _createdShaderCount{0};
+    bool _asyncCompileEnabled{true};
+    bool _variantRecording{false};
 };
 
 } // namespace cc
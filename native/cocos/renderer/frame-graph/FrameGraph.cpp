@@ -150,6 +150,10 @@ void FrameGraph::gc(uint32_t const unusedFrameCount) noexcept {
     Texture::Allocator::getInstance().gc(unusedFrameCount);
 }
 
+void FrameGraph::endFrame() noexcept {
+    Texture::Allocator::getInstance().endFrame();
+}
+
 void FrameGraph::move(const TextureHandle from, const TextureHandle to, uint8_t mipmapLevel, uint8_t faceId, uint8_t arrayPosition) noexcept {
     const ResourceNode &fromResourceNode = getResourceNode(from);
     const ResourceNode &toResourceNode = getResourceNode(to);
@@ -59,6 +59,7 @@ public:
     void execute() noexcept;
     void reset() noexcept;
     static void gc(uint32_t unusedFrameCount = 30) noexcept;
+    static void endFrame() noexcept;
 
     template <typename Data, typename SetupMethod, typename ExecuteMethod>
     const CallbackPass<Data, ExecuteMethod> &addPass(PassInsertPoint insertPoint, const StringHandle &name, SetupMethod setup, ExecuteMethod &&execute) noexcept;
@@ -152,5 +152,12 @@ DEFINE_GFX_RESOURCE(Framebuffer)
 DEFINE_GFX_RESOURCE(RenderPass)
 DEFINE_GFX_RESOURCE(Texture)
 
+template <>
+struct ResourceInvalidator<gfx::Texture> final {
+    inline void operator()(gfx::Texture *texture) const {
+        Framebuffer::Allocator::getInstance().invalidate(texture);
+    }
+};
+
 } // namespace framegraph
 } // namespace cc
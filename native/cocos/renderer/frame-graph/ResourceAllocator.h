@@ -26,14 +26,36 @@
 #pragma once
 
 #include <algorithm>
+#include <limits>
 #include "base/RefVector.h"
 #include "base/memory/Memory.h"
 #include "base/std/container/unordered_map.h"
+#include "base/std/hash/hash.h"
 #include "gfx-base/GFXDef.h"
 
 namespace cc {
 namespace framegraph {
 
+struct ResourceAllocatorStats final {
+    uint64_t liveBytes{0};   // bytes held by resources handed out and not yet freed
+    uint64_t pooledBytes{0}; // bytes held by every resource the allocator owns, live or idle
+    uint64_t peakBytes{0};   // high-water mark of pooledBytes
+    uint64_t allocCount{0};
+    uint64_t reuseCount{0};  // allocations served by an idle resource, resized or not
+    uint64_t resizeCount{0}; // reuses which had to resize the idle resource first
+    uint64_t evictCount{0};  // idle resources destroyed to stay within the budget
+
+    inline float getReuseRate() const noexcept {
+        return allocCount ? static_cast<float>(reuseCount) / static_cast<float>(allocCount) : 0.F;
+    }
+};
+
+// called before a pooled resource is resized or destroyed, so pooled resources referring to it can be dropped
+template <typename DeviceResourceType>
+struct ResourceInvalidator final {
+    inline void operator()(DeviceResourceType * /*resource*/) const {}
+};
+
 template <typename DeviceResourceType, typename DescriptorType, typename DeviceResourceCreatorType>
 class ResourceAllocator final {
 public:
@@ -164,6 +186,10 @@ public:
     void free(DeviceResourceType *resource) noexcept;
     inline void tick() noexcept;
     void gc(uint32_t unusedFrameCount) noexcept;
+    // drops the pooled framebuffers with the texture attached, they are keyed by its address
+    // and would match again once the texture is recreated or resized back to an earlier size
+    template <typename TextureType>
+    void invalidate(const TextureType *texture) noexcept;
 
 private:
     using DeviceResourcePool = RefVector<DeviceResourceType *>;
@@ -266,5 +292,309 @@ void ResourceAllocator<DeviceResourceType, gfx::FramebufferInfo, DeviceResourceC
     }
 }
 
+template <typename DeviceResourceType, typename DeviceResourceCreatorType>
+template <typename TextureType>
+void ResourceAllocator<DeviceResourceType, gfx::FramebufferInfo, DeviceResourceCreatorType>::invalidate(const TextureType *const texture) noexcept {
+    for (auto &pair : _pool) {
+        DeviceResourcePool &pool = pair.second;
+        for (auto i = static_cast<uint32_t>(pool.size()); i-- > 0;) {
+            DeviceResourceType *resource = pool.at(i);
+            const auto &colors = resource->getColorTextures();
+            if (resource->getDepthStencilTexture() != texture &&
+                std::find(colors.begin(), colors.end(), texture) == colors.end()) {
+                continue;
+            }
+            // framebuffers are freed along with their attachments
+            CC_ASSERT(_ages[resource] >= 0);
+            _ages.erase(resource);
+            std::swap(pool.at(i), pool.at(static_cast<uint32_t>(pool.size()) - 1));
+            pool.popBack();
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+// Textures are bucketed by everything but their extent plus a power-of-two size class, so a
+// render target that changes size (e.g. under dynamic resolution scaling) resizes an idle
+// texture of a neighbouring size class instead of allocating a new one next to it.
+// The pool can be given a memory budget, idle textures are evicted least recently used first
+// once it is exceeded.
+template <typename DeviceResourceType, typename DeviceResourceCreatorType>
+class ResourceAllocator<DeviceResourceType, gfx::TextureInfo, DeviceResourceCreatorType> final {
+public:
+    using DeviceResourceCreator = DeviceResourceCreatorType;
+
+    ResourceAllocator(const ResourceAllocator &) = delete;
+    ResourceAllocator(ResourceAllocator &&) noexcept = delete;
+    ResourceAllocator &operator=(const ResourceAllocator &) = delete;
+    ResourceAllocator &operator=(ResourceAllocator &&) noexcept = delete;
+
+    static ResourceAllocator &getInstance() noexcept;
+    DeviceResourceType *alloc(const gfx::TextureInfo &desc) noexcept;
+    void free(DeviceResourceType *resource) noexcept;
+    inline void tick() noexcept;
+    void gc(uint32_t unusedFrameCount) noexcept;
+    // call once the commands of every frame graph executed this frame are submitted
+    inline void endFrame() noexcept;
+
+    // 0 means unlimited
+    inline void setBudget(uint64_t bytes) noexcept { _budget = bytes; }
+    inline uint64_t getBudget() const noexcept { return _budget; }
+    inline const ResourceAllocatorStats &getStats() const noexcept { return _stats; }
+
+    static uint64_t getMemorySize(const gfx::TextureInfo &desc) noexcept;
+
+private:
+    using DeviceResourcePool = RefVector<DeviceResourceType *>;
+
+    struct PoolEntry final {
+        gfx::TextureInfo desc;
+        ccstd::hash_t bucket{0};
+        uint64_t bytes{0};
+        int64_t age{-1};
+    };
+
+    ResourceAllocator() noexcept = default;
+    ~ResourceAllocator() = default;
+
+    static bool isResizable(const gfx::TextureInfo &desc) noexcept;
+    static bool isCompatible(const gfx::TextureInfo &lhs, const gfx::TextureInfo &rhs) noexcept;
+    static ccstd::hash_t getBucket(const gfx::TextureInfo &desc, uint32_t sizeClass) noexcept;
+    static uint32_t getSizeClass(uint64_t bytes) noexcept;
+
+    DeviceResourceType *reuse(const gfx::TextureInfo &desc, uint64_t bytes, uint32_t sizeClass) noexcept;
+    void evict(uint64_t bytesNeeded) noexcept;
+    void destroy(DeviceResourcePool &pool, uint32_t index) noexcept;
+
+    ccstd::unordered_map<ccstd::hash_t, DeviceResourcePool> _pool{};
+    ccstd::unordered_map<DeviceResourceType *, PoolEntry> _records{};
+    ResourceAllocatorStats _stats{};
+    uint64_t _budget{0};
+    uint64_t _age{0};
+    int64_t _submittedAge{-1};
+};
+
+//////////////////////////////////////////////////////////////////////////
+
+template <typename DeviceResourceType, typename DeviceResourceCreatorType>
+ResourceAllocator<DeviceResourceType, gfx::TextureInfo, DeviceResourceCreatorType> &
+ResourceAllocator<DeviceResourceType, gfx::TextureInfo, DeviceResourceCreatorType>::getInstance() noexcept {
+    static ResourceAllocator instance;
+    return instance;
+}
+
+template <typename DeviceResourceType, typename DeviceResourceCreatorType>
+DeviceResourceType *ResourceAllocator<DeviceResourceType, gfx::TextureInfo, DeviceResourceCreatorType>::alloc(const gfx::TextureInfo &desc) noexcept {
+    const uint64_t bytes = getMemorySize(desc);
+    const uint32_t sizeClass = getSizeClass(bytes);
+    ++_stats.allocCount;
+
+    DeviceResourceType *resource = reuse(desc, bytes, sizeClass);
+    if (resource) {
+        ++_stats.reuseCount;
+    } else {
+        evict(bytes);
+
+        DeviceResourceCreator creator;
+        resource = creator(desc);
+
+        PoolEntry &record = _records[resource];
+        record.desc = desc;
+        record.bucket = getBucket(desc, sizeClass);
+        record.bytes = bytes;
+        _pool[record.bucket].pushBack(resource);
+
+        _stats.pooledBytes += bytes;
+        _stats.peakBytes = std::max(_stats.peakBytes, _stats.pooledBytes);
+    }
+
+    _records[resource].age = -1;
+    _stats.liveBytes += bytes;
+    return resource;
+}
+
+template <typename DeviceResourceType, typename DeviceResourceCreatorType>
+DeviceResourceType *ResourceAllocator<DeviceResourceType, gfx::TextureInfo, DeviceResourceCreatorType>::reuse(const gfx::TextureInfo &desc, uint64_t bytes, uint32_t sizeClass) noexcept {
+    // exact match first, any idle texture will do
+    auto iter = _pool.find(getBucket(desc, sizeClass));
+    if (iter != _pool.end()) {
+        for (DeviceResourceType *res : iter->second) {
+            const PoolEntry &record = _records[res];
+            if (record.age >= 0 && record.desc == desc) {
+                return res;
+            }
+        }
+    }
+
+    if (!isResizable(desc)) {
+        return nullptr;
+    }
+
+    // best fit among compatible textures of the same or a neighbouring size class;
+    // resizing drops the old storage, which unsubmitted commands may still refer to,
+    // so only textures freed before the last submission qualify
+    DeviceResourceType *bestFit{nullptr};
+    uint64_t bestDiff{std::numeric_limits<uint64_t>::max()};
+    const uint32_t firstClass = sizeClass ? sizeClass - 1 : 0;
+    for (uint32_t cls = firstClass; cls <= sizeClass + 1; ++cls) {
+        iter = _pool.find(getBucket(desc, cls));
+        if (iter == _pool.end()) {
+            continue;
+        }
+        for (DeviceResourceType *res : iter->second) {
+            const PoolEntry &record = _records[res];
+            if (record.age < 0 || record.age > _submittedAge || !isCompatible(record.desc, desc)) {
+                continue;
+            }
+            const uint64_t diff = record.bytes > bytes ? record.bytes - bytes : bytes - record.bytes;
+            if (diff < bestDiff) {
+                bestDiff = diff;
+                bestFit = res;
+            }
+        }
+    }
+    if (!bestFit) {
+        return nullptr;
+    }
+
+    ResourceInvalidator<DeviceResourceType>()(bestFit);
+    bestFit->resize(desc.width, desc.height);
+    ++_stats.resizeCount;
+
+    PoolEntry &record = _records[bestFit];
+    const ccstd::hash_t bucket = getBucket(desc, sizeClass);
+    if (bucket != record.bucket) {
+        _pool[bucket].pushBack(bestFit);
+        DeviceResourcePool &source = _pool[record.bucket];
+        for (uint32_t i = 0; i < source.size(); ++i) {
+            if (source.at(i) == bestFit) {
+                std::swap(source.at(i), source.at(static_cast<uint32_t>(source.size()) - 1));
+                source.popBack();
+                break;
+            }
+        }
+    }
+    _stats.pooledBytes = _stats.pooledBytes - record.bytes + bytes;
+    _stats.peakBytes = std::max(_stats.peakBytes, _stats.pooledBytes);
+    record.desc = desc;
+    record.bucket = bucket;
+    record.bytes = bytes;
+    return bestFit;
+}
+
+template <typename DeviceResourceType, typename DeviceResourceCreatorType>
+void ResourceAllocator<DeviceResourceType, gfx::TextureInfo, DeviceResourceCreatorType>::free(DeviceResourceType *const resource) noexcept {
+    CC_ASSERT(_records.count(resource) && _records[resource].age < 0);
+    PoolEntry &record = _records[resource];
+    record.age = static_cast<int64_t>(_age);
+    _stats.liveBytes -= record.bytes;
+}
+
+template <typename DeviceResourceType, typename DeviceResourceCreatorType>
+void ResourceAllocator<DeviceResourceType, gfx::TextureInfo, DeviceResourceCreatorType>::tick() noexcept {
+    ++_age;
+}
+
+template <typename DeviceResourceType, typename DeviceResourceCreatorType>
+void ResourceAllocator<DeviceResourceType, gfx::TextureInfo, DeviceResourceCreatorType>::gc(uint32_t const unusedFrameCount) noexcept {
+    for (auto &pair : _pool) {
+        DeviceResourcePool &pool = pair.second;
+        for (auto i = static_cast<uint32_t>(pool.size()); i-- > 0;) {
+            const int64_t age = _records[pool.at(i)].age;
+            if (age >= 0 && _age - age >= unusedFrameCount) {
+                destroy(pool, i);
+            }
+        }
+    }
+    evict(0);
+}
+
+template <typename DeviceResourceType, typename DeviceResourceCreatorType>
+void ResourceAllocator<DeviceResourceType, gfx::TextureInfo, DeviceResourceCreatorType>::endFrame() noexcept {
+    _submittedAge = static_cast<int64_t>(_age);
+}
+
+template <typename DeviceResourceType, typename DeviceResourceCreatorType>
+void ResourceAllocator<DeviceResourceType, gfx::TextureInfo, DeviceResourceCreatorType>::evict(uint64_t const bytesNeeded) noexcept {
+    if (!_budget) {
+        return;
+    }
+    while (_stats.pooledBytes + bytesNeeded > _budget) {
+        DeviceResourcePool *lruPool{nullptr};
+        uint32_t lruIndex{0};
+        int64_t lruAge{std::numeric_limits<int64_t>::max()};
+        for (auto &pair : _pool) {
+            DeviceResourcePool &pool = pair.second;
+            for (uint32_t i = 0; i < pool.size(); ++i) {
+                const int64_t age = _records[pool.at(i)].age;
+                // textures freed after the last submission may still be referenced by unsubmitted commands
+                if (age >= 0 && age <= _submittedAge && age < lruAge) {
+                    lruPool = &pool;
+                    lruIndex = i;
+                    lruAge = age;
+                }
+            }
+        }
+        if (!lruPool) {
+            break;
+        }
+        destroy(*lruPool, lruIndex);
+        ++_stats.evictCount;
+    }
+}
+
+template <typename DeviceResourceType, typename DeviceResourceCreatorType>
+void ResourceAllocator<DeviceResourceType, gfx::TextureInfo, DeviceResourceCreatorType>::destroy(DeviceResourcePool &pool, uint32_t index) noexcept {
+    DeviceResourceType *resource = pool.at(index);
+    ResourceInvalidator<DeviceResourceType>()(resource);
+    _stats.pooledBytes -= _records[resource].bytes;
+    _records.erase(resource);
+    std::swap(pool.at(index), pool.at(static_cast<uint32_t>(pool.size()) - 1));
+    pool.popBack();
+}
+
+template <typename DeviceResourceType, typename DeviceResourceCreatorType>
+uint64_t ResourceAllocator<DeviceResourceType, gfx::TextureInfo, DeviceResourceCreatorType>::getMemorySize(const gfx::TextureInfo &desc) noexcept {
+    uint64_t size{0};
+    for (uint32_t level = 0; level < desc.levelCount; ++level) {
+        size += gfx::formatSize(desc.format, std::max(desc.width >> level, 1U), std::max(desc.height >> level, 1U), std::max(desc.depth >> level, 1U));
+    }
+    return size * desc.layerCount * gfx::getMaxSampleCount(desc.samples);
+}
+
+template <typename DeviceResourceType, typename DeviceResourceCreatorType>
+bool ResourceAllocator<DeviceResourceType, gfx::TextureInfo, DeviceResourceCreatorType>::isResizable(const gfx::TextureInfo &desc) noexcept {
+    // Texture::resize only keeps single-level 2D textures intact,
+    // a 1x1 texture would grow a full mip chain
+    return desc.type == gfx::TextureType::TEX2D && desc.levelCount == 1 && desc.depth == 1 &&
+           !desc.externalRes && desc.width * desc.height > 1;
+}
+
+template <typename DeviceResourceType, typename DeviceResourceCreatorType>
+bool ResourceAllocator<DeviceResourceType, gfx::TextureInfo, DeviceResourceCreatorType>::isCompatible(const gfx::TextureInfo &lhs, const gfx::TextureInfo &rhs) noexcept {
+    return isResizable(lhs) && lhs.type == rhs.type && lhs.usage == rhs.usage && lhs.format == rhs.format &&
+           lhs.flags == rhs.flags && lhs.layerCount == rhs.layerCount && lhs.levelCount == rhs.levelCount &&
+           lhs.samples == rhs.samples && lhs.depth == rhs.depth && lhs.externalRes == rhs.externalRes;
+}
+
+template <typename DeviceResourceType, typename DeviceResourceCreatorType>
+ccstd::hash_t ResourceAllocator<DeviceResourceType, gfx::TextureInfo, DeviceResourceCreatorType>::getBucket(const gfx::TextureInfo &desc, uint32_t sizeClass) noexcept {
+    gfx::TextureInfo key{desc};
+    key.width = key.height = 0;
+    ccstd::hash_t seed = gfx::Hasher<gfx::TextureInfo>()(key);
+    ccstd::hash_combine(seed, sizeClass);
+    return seed;
+}
+
+template <typename DeviceResourceType, typename DeviceResourceCreatorType>
+uint32_t ResourceAllocator<DeviceResourceType, gfx::TextureInfo, DeviceResourceCreatorType>::getSizeClass(uint64_t bytes) noexcept {
+    uint32_t sizeClass{0};
+    while (bytes >>= 1) {
+        ++sizeClass;
+    }
+    return sizeClass;
+}
+
 } // namespace framegraph
 } // namespace cc
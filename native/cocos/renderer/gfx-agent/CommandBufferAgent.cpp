@@ -59,7 +59,7 @@ void CommandBufferAgent::flushCommands(uint32_t count, CommandBufferAgent *const
     uint32_t workForThisThread = (count - 1) / jobThreadCount + 1; // ceil(count / jobThreadCount)
 
     if (count > workForThisThread + 1 && multiThreaded) { // more than one job to dispatch
-        JobGraph g(JobSystem::getInstance());
+        JobGraph g(JobSystem::getInstance(), "FlushCommands");
         g.createForEachIndexJob(workForThisThread, count, 1U, [cmdBuffs](uint32_t i) {
             cmdBuffs[i]->getMessageQueue()->flushMessages();
         });
@@ -138,6 +138,8 @@ void CommandBufferAgent::doDestroy() {
 }
 
 void CommandBufferAgent::begin(RenderPass *renderPass, uint32_t subpass, Framebuffer *frameBuffer) {
+    _executor = nullptr;
+
     ENQUEUE_MESSAGE_4(
         _messageQueue,
         CommandBufferBegin,
@@ -208,12 +210,34 @@ void CommandBufferAgent::execute(CommandBuffer *const *cmdBuffs, uint32_t count)
         actorCmdBuffs[i] = static_cast<CommandBufferAgent *>(cmdBuffs[i])->getActor();
     }
 
-    ENQUEUE_MESSAGE_3(
+    // secondary command buffers can be recorded concurrently by different threads, each into its own message queue,
+    // the streams are closed here and replayed on the device thread in the given order right before the execution.
+    // a secondary can only be executed by one primary per recording: primaries may be flushed concurrently,
+    // so two of them would replay the same stream at the same time
+    CommandBufferAgent **agentCmdBuffs = nullptr;
+    if (!_messageQueue->isImmediateMode()) {
+        agentCmdBuffs = _messageQueue->allocate<CommandBufferAgent *>(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            agentCmdBuffs[i] = static_cast<CommandBufferAgent *>(cmdBuffs[i]);
+            CC_ASSERT(!agentCmdBuffs[i]->_executor || agentCmdBuffs[i]->_executor == this);
+            agentCmdBuffs[i]->_executor = this;
+            MessageQueue::freeChunksInFreeQueue(agentCmdBuffs[i]->_messageQueue);
+            agentCmdBuffs[i]->_messageQueue->finishWriting();
+        }
+    }
+
+    ENQUEUE_MESSAGE_4(
         _messageQueue, CommandBufferExecute,
         actor, getActor(),
         cmdBuffs, actorCmdBuffs,
+        agentCmdBuffs, agentCmdBuffs,
         count, count,
         {
+            if (agentCmdBuffs) {
+                for (uint32_t i = 0; i < count; ++i) {
+                    agentCmdBuffs[i]->getMessageQueue()->flushMessages();
+                }
+            }
             actor->execute(cmdBuffs, count);
         });
 }
@@ -87,6 +87,8 @@ protected:
     void initMessageQueue();
     void destroyMessageQueue();
     MessageQueue *_messageQueue = nullptr;
+    // the primary replaying the stream of this secondary command buffer, reset on begin and on device flush
+    CommandBufferAgent *_executor = nullptr;
 };
 
 } // namespace gfx
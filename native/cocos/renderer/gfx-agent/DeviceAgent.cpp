@@ -30,6 +30,7 @@
 #include "base/threading/ThreadSafeLinearAllocator.h"
 #include "application/ApplicationManager.h"
 #include "platform/interfaces/modules/IXRInterface.h"
+#include "profiler/Profiler.h"
 
 #include "BufferAgent.h"
 #include "CommandBufferAgent.h"
@@ -161,6 +162,7 @@ void DeviceAgent::present() {
             frameBoundarySemaphore, &_frameBoundarySemaphore,
             {
                 actor->present();
+                CC_PROFILE_FRAME_MARK(DevicePresent);
                 frameBoundarySemaphore->signal();
             });
 
@@ -184,6 +186,7 @@ void DeviceAgent::setMultithreaded(bool multithreaded) {
             actor, _actor,
             {
                 actor->bindContext(true);
+                CC_PROFILE_THREAD_NAME(DeviceThread);
                 CC_LOG_INFO("Device thread detached.");
             });
         for (CommandBufferAgent *cmdBuff : _cmdBuffRefs) {
@@ -388,16 +391,26 @@ void DeviceAgent::flushCommands(CommandBuffer *const *cmdBuffs, uint32_t count)
     if (!_multithreaded) return; // all command buffers are immediately executed
 
     auto **agentCmdBuffs = _mainMessageQueue->allocate<CommandBufferAgent *>(count);
+    uint32_t primaryCount = 0U;
 
     for (uint32_t i = 0; i < count; ++i) {
-        agentCmdBuffs[i] = static_cast<CommandBufferAgent *const>(cmdBuffs[i]);
-        MessageQueue::freeChunksInFreeQueue(agentCmdBuffs[i]->_messageQueue);
-        agentCmdBuffs[i]->_messageQueue->finishWriting();
+        auto *cmdBuff = static_cast<CommandBufferAgent *const>(cmdBuffs[i]);
+        // secondary streams are replayed by the primary command buffer executing them,
+        // the ones never executed are drained here so their recorded messages don't pile up
+        if (cmdBuff->getType() == CommandBufferType::SECONDARY && cmdBuff->_executor) {
+            cmdBuff->_executor = nullptr;
+            continue;
+        }
+
+        agentCmdBuffs[primaryCount++] = cmdBuff;
+        MessageQueue::freeChunksInFreeQueue(cmdBuff->_messageQueue);
+        cmdBuff->_messageQueue->finishWriting();
     }
+    if (!primaryCount) return;
 
     ENQUEUE_MESSAGE_3(
         _mainMessageQueue, DeviceFlushCommands,
-        count, count,
+        count, primaryCount,
         cmdBuffs, agentCmdBuffs,
         multiThreaded, _actor->_multithreadedCommandRecording,
         {
@@ -422,6 +435,28 @@ void DeviceAgent::getQueryPoolResults(QueryPool *queryPool) {
     queryPoolAgent->_results = actorQueryPoolAgent->_results;
 }
 
+bool DeviceAgent::getPipelineCacheData(ccstd::vector<uint8_t> &out) {
+    // pipelines may still be under construction on the device thread
+    _mainMessageQueue->kickAndWait();
+    return _actor->getPipelineCacheData(out);
+}
+
+void DeviceAgent::mergePipelineCacheData(const uint8_t *data, uint32_t size) {
+    _mainMessageQueue->kickAndWait();
+    _actor->mergePipelineCacheData(data, size);
+}
+
+void DeviceAgent::precompileShaders(const ShaderInfo *infos, uint32_t count) {
+    // queued ahead of the shader inits, so the device thread compiles the batch before the shaders are used
+    ENQUEUE_MESSAGE_2(
+        _mainMessageQueue, DevicePrecompileShaders,
+        actor, getActor(),
+        infos, ccstd::vector<ShaderInfo>(infos, infos + count),
+        {
+            actor->precompileShaders(infos.data(), utils::toUint(infos.size()));
+        });
+}
+
 void DeviceAgent::presentSignal() {
     _frameBoundarySemaphore.signal();
 }
@@ -619,6 +619,16 @@ uint32_t getTypeSize(Type type) {
     return 0;
 }
 
+uint32_t getMaxSampleCount(SampleCount sampleCount) {
+    switch (sampleCount) {
+        case SampleCount::ONE: return 1;
+        case SampleCount::MULTIPLE_PERFORMANCE: return 2;
+        case SampleCount::MULTIPLE_BALANCE: return 8;
+        case SampleCount::MULTIPLE_QUALITY: return 16;
+    }
+    return 1;
+}
+
 uint32_t formatSurfaceSize(Format format, uint32_t width, uint32_t height, uint32_t depth, uint32_t mips) {
     uint32_t size = 0;
 
@@ -143,6 +143,9 @@ uint32_t formatSurfaceSize(Format format, uint32_t width, uint32_t height, uint3
  */
 uint32_t getTypeSize(gfx::Type type);
 
+// the most samples a backend may pick for the requested quality, memory estimates must never be undercounted
+uint32_t getMaxSampleCount(SampleCount sampleCount);
+
 uint32_t gcd(uint32_t a, uint32_t b);
 
 uint32_t lcm(uint32_t a, uint32_t b);
@@ -96,6 +96,13 @@ public:
     virtual void copyTextureToBuffers(Texture *src, uint8_t *const *buffers, const BufferTextureCopy *region, uint32_t count) = 0;
     virtual void getQueryPoolResults(QueryPool *queryPool) = 0;
 
+    // opaque backend pipeline cache, e.g. VkPipelineCache data, returns false if the backend has none
+    virtual bool getPipelineCacheData(ccstd::vector<uint8_t> & /*out*/) { return false; }
+    virtual void mergePipelineCacheData(const uint8_t * /*data*/, uint32_t /*size*/) {}
+
+    // hint that these shaders are about to be created, backends compiling shaders themselves may compile them together
+    virtual void precompileShaders(const ShaderInfo * /*infos*/, uint32_t /*count*/) {}
+
     inline void copyTextureToBuffers(Texture *src, BufferSrcList &buffers, const BufferTextureCopyList &regions);
     inline void copyBuffersToTexture(const BufferDataList &buffers, Texture *dst, const BufferTextureCopyList &regions);
     inline void flushCommands(const ccstd::vector<CommandBuffer *> &cmdBuffs);
@@ -25,11 +25,15 @@
 
 #include "SPIRVUtils.h"
 
+#include <chrono>
+#include <cstdio>
 #include "base/Log.h"
 #include "base/Utils.h"
+#include "base/job-system/JobSystem.h"
 #include "glslang/Public/ShaderLang.h"
 #include "glslang/SPIRV/GlslangToSpv.h"
 #include "glslang/StandAlone/ResourceLimits.h"
+#include "platform/FileView.h"
 #include "spirv/spirv.h"
 
 namespace cc {
@@ -100,6 +104,26 @@ struct Id {
     uint32_t storageClass{0};
     uint32_t *pLocation{nullptr};
 };
+
+constexpr uint32_t BLOB_MAGIC = 0x56535043U; // "CPSV"
+constexpr uint32_t BLOB_VERSION = 1U;
+
+struct BlobHeader {
+    uint32_t magic{BLOB_MAGIC};
+    uint32_t version{BLOB_VERSION};
+    uint64_t key{0};
+    uint32_t locationCount{0};
+    uint32_t codeSize{0}; // in words
+};
+
+uint64_t fnv1a(const void *data, size_t size, uint64_t hash = 14695981039346656037ULL) {
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
 } // namespace
 
 SPIRVUtils SPIRVUtils::instance;
@@ -115,33 +139,129 @@ void SPIRVUtils::initialize(int vulkanMinorVersion) {
 void SPIRVUtils::destroy() {
     glslang::FinalizeProcess();
     _output.clear();
+    _activeLocations.clear();
+    _precompiled.clear();
+}
+
+void SPIRVUtils::setCacheDirectory(const ccstd::string &path) {
+    _cacheDirectory = path;
+    if (!_cacheDirectory.empty() && _cacheDirectory.back() != '/') {
+        _cacheDirectory += '/';
+    }
+}
+
+void SPIRVUtils::precompileGLSL(const ShaderStageList &stages) {
+    ccstd::vector<uint64_t> keys;
+    ccstd::vector<const ShaderStage *> misses;
+    for (const auto &stage : stages) {
+        uint64_t key = getKey(stage.stage, stage.source);
+        if (_precompiled.count(key) || std::find(keys.begin(), keys.end(), key) != keys.end()) continue;
+
+        Blob blob;
+        if (load(key, blob)) {
+            _precompiled.emplace(key, std::move(blob));
+            ++_cacheStats.hits;
+        } else {
+            keys.push_back(key);
+            misses.push_back(&stage);
+        }
+    }
+
+    const auto count = static_cast<uint32_t>(misses.size());
+    ccstd::vector<Blob> blobs(count);
+    ccstd::vector<uint8_t> succeeded(count, 0);
+    ccstd::vector<double> compileTimes(count, 0.0);
+    auto compileJob = [&](uint32_t i) {
+        auto start = std::chrono::steady_clock::now();
+        succeeded[i] = compile(misses[i]->stage, misses[i]->source, blobs[i]);
+        if (succeeded[i]) store(keys[i], blobs[i]);
+        compileTimes[i] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+    if (count > 1) {
+        JobGraph g(JobSystem::getInstance(), "SPIRVCompile");
+        g.createForEachIndexJob(1U, count, 1U, compileJob);
+        g.run();
+        compileJob(0);
+        g.waitForAll();
+    } else if (count) {
+        compileJob(0);
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        ++_cacheStats.misses;
+        _cacheStats.compileTime += compileTimes[i];
+        if (succeeded[i]) _precompiled.emplace(keys[i], std::move(blobs[i]));
+    }
 }
 
 void SPIRVUtils::compileGLSL(ShaderStageFlagBit type, const ccstd::string &source) {
+    uint64_t key = getKey(type, source);
+    Blob blob;
+
+    auto iter = _precompiled.find(key);
+    if (iter != _precompiled.end()) {
+        blob = std::move(iter->second);
+        _precompiled.erase(iter);
+    } else if (load(key, blob)) {
+        ++_cacheStats.hits;
+    } else {
+        auto start = std::chrono::steady_clock::now();
+        if (compile(type, source, blob)) store(key, blob);
+        _cacheStats.compileTime += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        ++_cacheStats.misses;
+    }
+
+    _output = std::move(blob.code);
+    _activeLocations = std::move(blob.activeLocations);
+}
+
+uint64_t SPIRVUtils::getKey(ShaderStageFlagBit type, const ccstd::string &source) const {
+    const uint32_t options[] = {
+        static_cast<uint32_t>(type),
+        static_cast<uint32_t>(_clientInputSemanticsVersion),
+        static_cast<uint32_t>(_clientVersion),
+        static_cast<uint32_t>(_targetVersion),
+        GLSLANG_VERSION_MAJOR,
+        GLSLANG_VERSION_MINOR,
+        GLSLANG_VERSION_PATCH,
+        CC_DEBUG > 0,
+    };
+    return fnv1a(source.data(), source.size(), fnv1a(options, sizeof(options)));
+}
+
+ccstd::string SPIRVUtils::getBlobPath(uint64_t key) const {
+    char name[24];
+    snprintf(name, sizeof(name), "%016llx.spv", static_cast<unsigned long long>(key));
+    return _cacheDirectory + name;
+}
+
+bool SPIRVUtils::compile(ShaderStageFlagBit type, const ccstd::string &source, Blob &blob) const {
     EShLanguage stage = getShaderStage(type);
     const char *string = source.c_str();
 
-    _shader = std::make_unique<glslang::TShader>(stage);
-    _shader->setStrings(&string, 1);
+    glslang::TShader shader(stage);
+    shader.setStrings(&string, 1);
 
-    _shader->setEnvInput(glslang::EShSourceGlsl, stage, glslang::EShClientVulkan, _clientInputSemanticsVersion);
-    _shader->setEnvClient(glslang::EShClientVulkan, _clientVersion);
-    _shader->setEnvTarget(glslang::EShTargetSpv, _targetVersion);
+    shader.setEnvInput(glslang::EShSourceGlsl, stage, glslang::EShClientVulkan, _clientInputSemanticsVersion);
+    shader.setEnvClient(glslang::EShClientVulkan, _clientVersion);
+    shader.setEnvTarget(glslang::EShTargetSpv, _targetVersion);
 
     auto messages = static_cast<EShMessages>(EShMsgSpvRules | EShMsgVulkanRules);
 
-    if (!_shader->parse(&glslang::DefaultTBuiltInResource, _clientInputSemanticsVersion, false, messages)) {
-        CC_LOG_ERROR("GLSL Parsing Failed:\n%s\n%s", _shader->getInfoLog(), _shader->getInfoDebugLog());
+    bool succeeded = true;
+    if (!shader.parse(&glslang::DefaultTBuiltInResource, _clientInputSemanticsVersion, false, messages)) {
+        CC_LOG_ERROR("GLSL Parsing Failed:\n%s\n%s", shader.getInfoLog(), shader.getInfoDebugLog());
+        succeeded = false;
     }
 
-    _program = std::make_unique<glslang::TProgram>();
-    _program->addShader(_shader.get());
+    glslang::TProgram program;
+    program.addShader(&shader);
 
-    if (!_program->link(messages)) {
-        CC_LOG_ERROR("GLSL Linking Failed:\n%s\n%s", _program->getInfoLog(), _program->getInfoDebugLog());
+    if (!program.link(messages)) {
+        CC_LOG_ERROR("GLSL Linking Failed:\n%s\n%s", program.getInfoLog(), program.getInfoDebugLog());
+        succeeded = false;
     }
 
-    _output.clear();
     spv::SpvBuildLogger logger;
     glslang::SpvOptions spvOptions;
     spvOptions.disableOptimizer = false;
@@ -151,12 +271,61 @@ void SPIRVUtils::compileGLSL(ShaderStageFlagBit type, const ccstd::string &sourc
 #else
     spvOptions.stripDebugInfo = true;
 #endif
-    glslang::GlslangToSpv(*_program->getIntermediate(stage), _output, &logger, &spvOptions);
+    glslang::GlslangToSpv(*program.getIntermediate(stage), blob.code, &logger, &spvOptions);
+
+    if (type == ShaderStageFlagBit::VERTEX) {
+        program.buildReflection();
+        int activeCount = program.getNumPipeInputs();
+        for (int i = 0; i < activeCount; ++i) {
+            blob.activeLocations.push_back(program.getPipeInput(i).getType()->getQualifier().layoutLocation);
+        }
+    }
+    return succeeded && !blob.code.empty();
+}
+
+bool SPIRVUtils::load(uint64_t key, Blob &blob) const {
+    if (_cacheDirectory.empty()) return false;
+
+    // saving replaces the blob, which a live mapping would lock on windows, so it is read instead
+    FileView file = FileView::read(getBlobPath(key));
+    BlobHeader header;
+    if (file.size() < sizeof(header)) return false;
+    memcpy(&header, file.data(), sizeof(header));
+    if (header.magic != BLOB_MAGIC || header.version != BLOB_VERSION || header.key != key ||
+        file.size() != sizeof(header) + (static_cast<size_t>(header.locationCount) + header.codeSize) * sizeof(uint32_t)) {
+        return false;
+    }
+
+    const auto *words = reinterpret_cast<const uint32_t *>(file.data() + sizeof(header));
+    blob.activeLocations.assign(words, words + header.locationCount);
+    blob.code.assign(words + header.locationCount, words + header.locationCount + header.codeSize);
+    return true;
+}
+
+void SPIRVUtils::store(uint64_t key, const Blob &blob) const {
+    if (_cacheDirectory.empty()) return;
+
+    BlobHeader header;
+    header.key = key;
+    header.locationCount = utils::toUint(blob.activeLocations.size());
+    header.codeSize = utils::toUint(blob.code.size());
+
+    // write aside and rename, readers never see a partial blob
+    auto path = getBlobPath(key);
+    auto tempPath = path + ".tmp";
+    FILE *file = fopen(tempPath.c_str(), "wb");
+    if (!file) return;
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   fwrite(blob.activeLocations.data(), sizeof(uint32_t), blob.activeLocations.size(), file) == blob.activeLocations.size() &&
+                   fwrite(blob.code.data(), sizeof(uint32_t), blob.code.size(), file) == blob.code.size();
+    fclose(file);
+    if (!written || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+    }
 }
 
 void SPIRVUtils::compressInputLocations(gfx::AttributeList &attributes) {
     static ccstd::vector<Id> ids;
-    static ccstd::vector<uint32_t> activeLocations;
     static ccstd::vector<uint32_t> newLocations;
 
     uint32_t *code = _output.data();
@@ -203,12 +372,8 @@ void SPIRVUtils::compressInputLocations(gfx::AttributeList &attributes) {
         insn += wordCount;
     }
 
-    _program->buildReflection();
-    activeLocations.clear();
-    int activeCount = _program->getNumPipeInputs();
-    for (int i = 0; i < activeCount; ++i) {
-        activeLocations.push_back(_program->getPipeInput(i).getType()->getQualifier().layoutLocation);
-    }
+    const auto &activeLocations = _activeLocations;
+    auto activeCount = utils::toUint(activeLocations.size());
 
     uint32_t location = 0;
     uint32_t unusedLocation = activeCount;
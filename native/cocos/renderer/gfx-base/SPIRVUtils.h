@@ -26,6 +26,7 @@
 #pragma once
 
 #include <memory>
+#include "base/std/container/unordered_map.h"
 #include "gfx-base/GFXDef.h"
 #include "glslang/Public/ShaderLang.h"
 
@@ -39,12 +40,20 @@ public:
     void initialize(int vulkanMinorVersion);
     void destroy();
 
+    /**
+     * Compiled blobs are kept under this directory across runs, keyed by the source (defines included),
+     * the stage, the target versions and the glslang version. An empty path disables the disk cache.
+     */
+    void setCacheDirectory(const ccstd::string &path);
+    inline const ccstd::string &getCacheDirectory() const { return _cacheDirectory; }
+
+    // compiles the stages missing from the cache on worker threads, picked up by the following compileGLSL calls
+    void precompileGLSL(const ShaderStageList &stages);
+
     void compileGLSL(ShaderStageFlagBit type, const ccstd::string &source);
     void compressInputLocations(gfx::AttributeList &attributes);
 
     inline uint32_t *getOutputData() {
-        _shader.reset();
-        _program.reset();
         return _output.data();
     }
 
@@ -52,14 +61,36 @@ public:
         return _output.size() * sizeof(uint32_t);
     }
 
+    struct CacheStats {
+        uint32_t hits{0};      // blobs loaded from disk
+        uint32_t misses{0};    // blobs compiled by glslang
+        double compileTime{0}; // milliseconds spent in glslang, worker threads included
+    };
+    inline const CacheStats &getCacheStats() const { return _cacheStats; }
+    inline void resetCacheStats() { _cacheStats = {}; }
+
 private:
+    struct Blob {
+        ccstd::vector<uint32_t> code;
+        ccstd::vector<uint32_t> activeLocations; // vertex inputs in use, for compressInputLocations
+    };
+
+    uint64_t getKey(ShaderStageFlagBit type, const ccstd::string &source) const;
+    ccstd::string getBlobPath(uint64_t key) const;
+    bool compile(ShaderStageFlagBit type, const ccstd::string &source, Blob &blob) const;
+    bool load(uint64_t key, Blob &blob) const;
+    void store(uint64_t key, const Blob &blob) const;
+
     int _clientInputSemanticsVersion{0};
     glslang::EShTargetClientVersion _clientVersion{glslang::EShTargetClientVersion::EShTargetVulkan_1_0};
     glslang::EShTargetLanguageVersion _targetVersion{glslang::EShTargetLanguageVersion::EShTargetSpv_1_0};
 
-    std::unique_ptr<glslang::TShader> _shader{nullptr};
-    std::unique_ptr<glslang::TProgram> _program{nullptr};
+    ccstd::string _cacheDirectory;
+    ccstd::unordered_map<uint64_t, Blob> _precompiled;
+    CacheStats _cacheStats;
+
     ccstd::vector<uint32_t> _output;
+    ccstd::vector<uint32_t> _activeLocations;
 
     static SPIRVUtils instance;
 };
@@ -478,7 +478,7 @@ void CommandBufferValidator::pipelineBarrier(const GeneralBarrier *barrier, cons
     }
     /////////// execute ///////////
 
-    static ccstd::vector<Texture *> textureActors;
+    static thread_local ccstd::vector<Texture *> textureActors;
     textureActors.resize(textureBarrierCount);
 
     Texture **actorTextures = nullptr;
@@ -489,7 +489,7 @@ void CommandBufferValidator::pipelineBarrier(const GeneralBarrier *barrier, cons
         }
     }
 
-    static ccstd::vector<Buffer *> bufferActors;
+    static thread_local ccstd::vector<Buffer *> bufferActors;
     bufferActors.resize(bufferBarrierCount);
 
     Buffer **actorBuffers = nullptr;
@@ -361,5 +361,19 @@ void DeviceValidator::getQueryPoolResults(QueryPool *queryPool) {
     queryPoolValidator->_results = actorQueryPoolValidator->_results;
 }
 
+bool DeviceValidator::getPipelineCacheData(ccstd::vector<uint8_t> &out) {
+    return _actor->getPipelineCacheData(out);
+}
+
+void DeviceValidator::mergePipelineCacheData(const uint8_t *data, uint32_t size) {
+    CC_ASSERT(data || !size);
+    _actor->mergePipelineCacheData(data, size);
+}
+
+void DeviceValidator::precompileShaders(const ShaderInfo *infos, uint32_t count) {
+    CC_ASSERT(infos || !count);
+    _actor->precompileShaders(infos, count);
+}
+
 } // namespace gfx
 } // namespace cc
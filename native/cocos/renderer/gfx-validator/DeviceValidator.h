@@ -81,6 +81,9 @@ public:
     void copyBuffersToTexture(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint32_t count) override;
     void copyTextureToBuffers(Texture *src, uint8_t *const *buffers, const BufferTextureCopy *region, uint32_t count) override;
     void getQueryPoolResults(QueryPool *queryPool) override;
+    bool getPipelineCacheData(ccstd::vector<uint8_t> &out) override;
+    void mergePipelineCacheData(const uint8_t *data, uint32_t size) override;
+    void precompileShaders(const ShaderInfo *infos, uint32_t count) override;
 
     void flushCommands(CommandBuffer *const *cmdBuffs, uint32_t count) override;
     MemoryStatus &getMemoryStatus() override { return _actor->getMemoryStatus(); }
@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <boost/functional/hash.hpp>
 #include <thread>
+#include <tuple>
 #include "VKStd.h"
 #include "base/std/container/map.h"
 #include "base/std/container/unordered_map.h"
@@ -268,6 +269,13 @@ void cmdFuncCCVKCreateBuffer(CCVKDevice *device, CCVKGPUBuffer *gpuBuffer) {
     } else if (gpuBuffer->memUsage == MemoryUsage::DEVICE) {
         bufferInfo.usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
         allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+        VkPhysicalDeviceType deviceType = device->gpuContext()->physicalDeviceProperties.deviceType;
+        if (deviceType == VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU || deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU) {
+            // unified memory, device local memory is usually host visible as well
+            allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+            allocInfo.preferredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        }
     } else if (gpuBuffer->memUsage == (MemoryUsage::HOST | MemoryUsage::DEVICE)) {
         gpuBuffer->instanceSize = roundUp(gpuBuffer->size, device->getCapabilities().uboOffsetAlignment);
         bufferInfo.size = gpuBuffer->instanceSize * device->gpuDevice()->backBufferCount;
@@ -281,6 +289,15 @@ void cmdFuncCCVKCreateBuffer(CCVKDevice *device, CCVKGPUBuffer *gpuBuffer) {
                              &gpuBuffer->vkBuffer, &gpuBuffer->vmaAllocation, &res));
 
     gpuBuffer->mappedData = reinterpret_cast<uint8_t *>(res.pMappedData);
+    gpuBuffer->creationSubmission = device->gpuDevice()->submissionCount;
+
+    if (gpuBuffer->memUsage == MemoryUsage::DEVICE && gpuBuffer->mappedData) {
+        VkMemoryPropertyFlags memoryFlags = 0U;
+        vmaGetMemoryTypeProperties(device->gpuDevice()->memoryAllocator, res.memoryType, &memoryFlags);
+        if (!(memoryFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)) {
+            gpuBuffer->mappedData = nullptr;
+        }
+    }
 
     // add special access types directly from usage
     if (hasFlag(gpuBuffer->usage, BufferUsageBit::VERTEX)) gpuBuffer->renderAccessTypes.push_back(THSVS_ACCESS_VERTEX_BUFFER);
@@ -836,6 +853,15 @@ void cmdFuncCCVKCreateFramebuffer(CCVKDevice *device, CCVKGPUFramebuffer *gpuFra
 void cmdFuncCCVKCreateShader(CCVKDevice *device, CCVKGPUShader *gpuShader) {
     SPIRVUtils *spirv = SPIRVUtils::getInstance();
 
+    // compile the stages missing from the cache in parallel
+    if (gpuShader->gpuStages.size() > 1) {
+        ShaderStageList stages;
+        for (const CCVKGPUShaderStage &stage : gpuShader->gpuStages) {
+            stages.push_back({stage.type, "#version 450\n" + stage.source});
+        }
+        spirv->precompileGLSL(stages);
+    }
+
     for (CCVKGPUShaderStage &stage : gpuShader->gpuStages) {
         spirv->compileGLSL(stage.type, "#version 450\n" + stage.source);
         if (stage.type == ShaderStageFlagBit::VERTEX) spirv->compressInputLocations(gpuShader->attributes);
@@ -849,6 +875,17 @@ void cmdFuncCCVKCreateShader(CCVKDevice *device, CCVKGPUShader *gpuShader) {
     CC_LOG_INFO("Shader '%s' compilation succeeded.", gpuShader->name.c_str());
 }
 
+void cmdFuncCCVKPrecompileShaders(const ShaderInfo *infos, uint32_t count) {
+    // the stages of every shader in the batch are compiled together, the blobs wait for cmdFuncCCVKCreateShader
+    ShaderStageList stages;
+    for (uint32_t i = 0; i < count; ++i) {
+        for (const ShaderStage &stage : infos[i].stages) {
+            stages.push_back({stage.stage, "#version 450\n" + stage.source});
+        }
+    }
+    SPIRVUtils::getInstance()->precompileGLSL(stages);
+}
+
 void cmdFuncCCVKCreateDescriptorSetLayout(CCVKDevice *device, CCVKGPUDescriptorSetLayout *gpuDescriptorSetLayout) {
     CCVKGPUDevice *gpuDevice = device->gpuDevice();
     size_t bindingCount = gpuDescriptorSetLayout->bindings.size();
@@ -1168,9 +1205,85 @@ void bufferUpload(const CCVKGPUBufferView &stagingBuffer, CCVKGPUBuffer &gpuBuff
     }
 #endif
     vkCmdCopyBuffer(gpuCommandBuffer->vkCommandBuffer, stagingBuffer.gpuBuffer->vkBuffer, gpuBuffer.vkBuffer, 1, &region);
+    CCVKDevice::getInstance()->frameTransferStats().copyCalls++;
 };
+
+bool rangesOverlap(VkDeviceSize offset, VkDeviceSize size, const std::pair<VkDeviceSize, VkDeviceSize> &range) {
+    return offset < range.second && range.first < offset + size;
+}
+
+void extendRange(std::pair<VkDeviceSize, VkDeviceSize> &range, VkDeviceSize offset, VkDeviceSize size, bool isNew) {
+    range.first = isNew ? offset : std::min(range.first, offset);
+    range.second = isNew ? offset + size : std::max(range.second, offset + size);
+}
 } // namespace
 
+void CCVKGPUTransportHub::checkIn(VkBuffer srcBuffer, VkBuffer dstBuffer, const VkBufferCopy &region) {
+    // regions of one copy command must not overlap with what the others write
+    auto conflicts = [&](const ccstd::unordered_map<VkBuffer, Range> &ranges, VkBuffer buffer, VkDeviceSize offset) {
+        auto iter = ranges.find(buffer);
+        return iter != ranges.end() && rangesOverlap(offset, region.size, iter->second);
+    };
+    if (conflicts(_pendingWrites, dstBuffer, region.dstOffset) || conflicts(_pendingWrites, srcBuffer, region.srcOffset) ||
+        conflicts(_pendingReads, dstBuffer, region.dstOffset)) {
+        recordPendingCopies();
+    }
+
+    _pendingCopies.push_back({srcBuffer, dstBuffer, region});
+    auto readIter = _pendingReads.emplace(srcBuffer, Range{});
+    extendRange(readIter.first->second, region.srcOffset, region.size, readIter.second);
+    auto writeIter = _pendingWrites.emplace(dstBuffer, Range{});
+    extendRange(writeIter.first->second, region.dstOffset, region.size, writeIter.second);
+}
+
+void CCVKGPUTransportHub::recordPendingCopies() {
+    if (_pendingCopies.empty()) return;
+
+    begin(&_earlyCmdBuff);
+    VkCommandBuffer vkCommandBuffer = _earlyCmdBuff.vkCommandBuffer;
+
+#if BARRIER_DEDUCTION_LEVEL >= BARRIER_DEDUCTION_LEVEL_BASIC
+    bool hasWAWHazard = std::any_of(_pendingCopies.begin(), _pendingCopies.end(), [this](const PendingCopy &copy) {
+        return _writtenBuffers.count(copy.dstBuffer) != 0;
+    });
+    if (hasWAWHazard) {
+        VkMemoryBarrier vkBarrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+        vkBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        vkBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        vkCmdPipelineBarrier(vkCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 1, &vkBarrier, 0, nullptr, 0, nullptr);
+    }
+#endif
+
+    std::stable_sort(_pendingCopies.begin(), _pendingCopies.end(), [](const PendingCopy &lhs, const PendingCopy &rhs) {
+        return std::tie(lhs.srcBuffer, lhs.dstBuffer, lhs.region.srcOffset) < std::tie(rhs.srcBuffer, rhs.dstBuffer, rhs.region.srcOffset);
+    });
+
+    uint32_t copyCalls = 0U;
+    for (size_t i = 0U, count = _pendingCopies.size(); i < count;) {
+        VkBuffer srcBuffer = _pendingCopies[i].srcBuffer;
+        VkBuffer dstBuffer = _pendingCopies[i].dstBuffer;
+        _regions.clear();
+        for (; i < count && _pendingCopies[i].srcBuffer == srcBuffer && _pendingCopies[i].dstBuffer == dstBuffer; ++i) {
+            const VkBufferCopy &region = _pendingCopies[i].region;
+            if (!_regions.empty() && _regions.back().srcOffset + _regions.back().size == region.srcOffset &&
+                _regions.back().dstOffset + _regions.back().size == region.dstOffset) {
+                _regions.back().size += region.size;
+            } else {
+                _regions.push_back(region);
+            }
+        }
+        vkCmdCopyBuffer(vkCommandBuffer, srcBuffer, dstBuffer, utils::toUint(_regions.size()), _regions.data());
+        _writtenBuffers.insert(dstBuffer);
+        ++copyCalls;
+    }
+    CCVKDevice::getInstance()->frameTransferStats().copyCalls += copyCalls;
+
+    _pendingCopies.clear();
+    _pendingReads.clear();
+    _pendingWrites.clear();
+}
+
 void cmdFuncCCVKUpdateBuffer(CCVKDevice *device, CCVKGPUBuffer *gpuBuffer, const void *buffer, uint32_t size, const CCVKGPUCommandBuffer *cmdBuffer) {
     if (!gpuBuffer) return;
 
@@ -1222,6 +1335,16 @@ void cmdFuncCCVKUpdateBuffer(CCVKDevice *device, CCVKGPUBuffer *gpuBuffer, const
         }
     }
 
+    // Write straight into the device memory if no submitted work can be using it yet. This only applies
+    // until the first queue submission after the buffer was created, later updates always go through staging.
+    if (!cmdBuffer && !gpuBuffer->instanceSize && gpuBuffer->mappedData &&
+        gpuBuffer->creationSubmission == device->gpuDevice()->submissionCount) {
+        memcpy(gpuBuffer->mappedData, dataToUpload, sizeToUpload);
+        device->frameTransferStats().directBytes += sizeToUpload;
+        return;
+    }
+    device->frameTransferStats().stagingBytes += sizeToUpload;
+
     // upload buffer by chunks
     uint32_t chunkSize = std::min(sizeToUpload, CCVKGPUStagingBufferPool::CHUNK_SIZE);
 
@@ -1244,11 +1367,8 @@ void cmdFuncCCVKUpdateBuffer(CCVKDevice *device, CCVKGPUBuffer *gpuBuffer, const
         if (cmdBuffer) {
             bufferUpload(*stagingBuffer, *gpuBuffer, region, cmdBuffer);
         } else {
-            device->gpuTransportHub()->checkIn(
-                // capture by ref is safe here since the transport function will be executed immediately in the same thread
-                [&stagingBuffer, &gpuBuffer, region](CCVKGPUCommandBuffer *gpuCommandBuffer) {
-                    bufferUpload(*stagingBuffer, *gpuBuffer, region, gpuCommandBuffer);
-                });
+            // the staging memory stays alive until this back buffer comes around again
+            device->gpuTransportHub()->checkIn(stagingBuffer->gpuBuffer->vkBuffer, gpuBuffer->vkBuffer, region);
         }
     }
 
@@ -1292,6 +1412,17 @@ void cmdFuncCCVKCopyBuffersToTexture(CCVKDevice *device, const uint8_t *const *b
 
     auto blockSize = formatAlignment(gpuTexture->format);
 
+    // regions sharing a staging buffer are copied together
+    VkBuffer stagingVkBuffer = VK_NULL_HANDLE;
+    ccstd::vector<VkBufferImageCopy> stagingRegions;
+    auto flushRegions = [&]() {
+        if (stagingRegions.empty()) return;
+        vkCmdCopyBufferToImage(gpuCommandBuffer->vkCommandBuffer, stagingVkBuffer, gpuTexture->vkImage,
+                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, utils::toUint(stagingRegions.size()), stagingRegions.data());
+        device->frameTransferStats().copyCalls++;
+        stagingRegions.clear();
+    };
+
     uint32_t idx = 0;
     for (size_t i = 0U; i < count; ++i) {
         const BufferTextureCopy &region{regions[i]};
@@ -1362,21 +1493,25 @@ void cmdFuncCCVKCopyBuffersToTexture(CCVKDevice *device, const uint8_t *const *b
                         buffOffset += buffStrideSize;
                     }
 
-                    VkBufferImageCopy stagingRegion;
+                    if (stagingBuffer->gpuBuffer->vkBuffer != stagingVkBuffer) {
+                        flushRegions();
+                        stagingVkBuffer = stagingBuffer->gpuBuffer->vkBuffer;
+                    }
+                    device->frameTransferStats().stagingBytes += stagingBufferSize;
+
+                    VkBufferImageCopy &stagingRegion = stagingRegions.emplace_back();
                     stagingRegion.bufferOffset = stagingBuffer->offset;
                     stagingRegion.bufferRowLength = rowPitch;
                     stagingRegion.bufferImageHeight = stepHeight;
                     stagingRegion.imageSubresource = {gpuTexture->aspectMask, mipLevel, l + baseLayer, 1};
                     stagingRegion.imageOffset = {offset.x, offset.y + heightOffset, offset.z + static_cast<int>(depth)};
                     stagingRegion.imageExtent = {destWidth, std::min(stepHeight, destHeight - heightOffset), 1};
-
-                    vkCmdCopyBufferToImage(gpuCommandBuffer->vkCommandBuffer, stagingBuffer->gpuBuffer->vkBuffer, gpuTexture->vkImage,
-                                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &stagingRegion);
                 }
             }
             idx++;
         }
     }
+    flushRegions();
 
     if (hasFlag(gpuTexture->flags, TextureFlags::GEN_MIPMAP)) {
         VkFormatProperties formatProperties;
@@ -1680,16 +1815,14 @@ void CCVKGPUBufferHub::flush(CCVKGPUTransportHub *transportHub) {
         }
     }
     if (needTransferCmds) {
-        transportHub->checkIn([&](const CCVKGPUCommandBuffer *gpuCommandBuffer) {
-            VkBufferCopy region;
-            for (auto &buffer : buffers) {
-                if (buffer.second.canMemcpy) continue;
-                region.srcOffset = buffer.first->getStartOffset(buffer.second.srcIndex);
-                region.dstOffset = buffer.first->getStartOffset(_device->curBackBufferIndex);
-                region.size = buffer.second.size;
-                vkCmdCopyBuffer(gpuCommandBuffer->vkCommandBuffer, buffer.first->vkBuffer, buffer.first->vkBuffer, 1, &region);
-            }
-        });
+        VkBufferCopy region;
+        for (auto &buffer : buffers) {
+            if (buffer.second.canMemcpy) continue;
+            region.srcOffset = buffer.first->getStartOffset(buffer.second.srcIndex);
+            region.dstOffset = buffer.first->getStartOffset(_device->curBackBufferIndex);
+            region.size = buffer.second.size;
+            transportHub->checkIn(buffer.first->vkBuffer, buffer.first->vkBuffer, region);
+        }
     }
 
     buffers.clear();
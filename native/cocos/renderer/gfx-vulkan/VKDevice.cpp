@@ -49,6 +49,7 @@
 
 #include "application/ApplicationManager.h"
 #include "gfx-base/SPIRVUtils.h"
+#include "platform/FileUtils.h"
 #include "platform/interfaces/modules/IXRInterface.h"
 #include "profiler/Profiler.h"
 
@@ -230,6 +231,10 @@ bool CCVKDevice::doInit(const DeviceInfo & /*info*/) {
     volkLoadDevice(_gpuDevice->vkDevice);
 
     SPIRVUtils::getInstance()->initialize(static_cast<int>(_gpuDevice->minorVersion));
+    auto spirvCachePath = FileUtils::getInstance()->getWritablePath() + "spirv-cache/";
+    if (FileUtils::getInstance()->createDirectory(spirvCachePath)) {
+        SPIRVUtils::getInstance()->setCacheDirectory(spirvCachePath);
+    }
 
     ///////////////////// Gather Device Properties /////////////////////
 
@@ -676,6 +681,9 @@ void CCVKDevice::present() {
     if (!_gpuTransportHub->empty(false)) _gpuTransportHub->packageForFlight(false);
     if (!_gpuTransportHub->empty(true)) _gpuTransportHub->packageForFlight(true);
 
+    _lastTransferStats = _transferStats;
+    _transferStats = {};
+
 #if CC_SWAPPY_ENABLED
     // tripple buffer?
     // static vector<uint8_t> queueFmlIdxBuff(_gpuDevice->backBufferCount);
@@ -944,6 +952,34 @@ void CCVKDevice::getQueryPoolResults(QueryPool *queryPool) {
     }
 }
 
+bool CCVKDevice::getPipelineCacheData(ccstd::vector<uint8_t> &out) {
+    if (!_gpuDevice->vkPipelineCache) return false;
+
+    size_t size = 0;
+    VK_CHECK(vkGetPipelineCacheData(_gpuDevice->vkDevice, _gpuDevice->vkPipelineCache, &size, nullptr));
+    out.resize(size);
+    VK_CHECK(vkGetPipelineCacheData(_gpuDevice->vkDevice, _gpuDevice->vkPipelineCache, &size, out.data()));
+    out.resize(size);
+    return size > 0;
+}
+
+void CCVKDevice::mergePipelineCacheData(const uint8_t *data, uint32_t size) {
+    if (!_gpuDevice->vkPipelineCache || !data || !size) return;
+
+    // the driver validates the header (vendor, device & cache UUID) and starts empty on mismatch
+    VkPipelineCacheCreateInfo pipelineCacheInfo{VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+    pipelineCacheInfo.initialDataSize = size;
+    pipelineCacheInfo.pInitialData = data;
+    VkPipelineCache srcCache = VK_NULL_HANDLE;
+    if (vkCreatePipelineCache(_gpuDevice->vkDevice, &pipelineCacheInfo, nullptr, &srcCache) != VK_SUCCESS) return;
+    VK_CHECK(vkMergePipelineCaches(_gpuDevice->vkDevice, _gpuDevice->vkPipelineCache, 1, &srcCache));
+    vkDestroyPipelineCache(_gpuDevice->vkDevice, srcCache, nullptr);
+}
+
+void CCVKDevice::precompileShaders(const ShaderInfo *infos, uint32_t count) {
+    cmdFuncCCVKPrecompileShaders(infos, count);
+}
+
 //////////////////////////// Function Fallbacks /////////////////////////////////////////
 
 static VkResult VKAPI_PTR vkCreateRenderPass2KHRFallback(
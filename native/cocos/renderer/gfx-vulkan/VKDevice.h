@@ -51,6 +51,12 @@ class CCVKGPUFencePool;
 class CCVKGPURecycleBin;
 class CCVKGPUStagingBufferPool;
 
+struct CCVKTransferStats {
+    uint32_t copyCalls{0U};    // upload copy commands recorded
+    uint64_t stagingBytes{0U}; // bytes written to staging memory
+    uint64_t directBytes{0U};  // bytes written straight into device local memory
+};
+
 class CC_VULKAN_API CCVKDevice final : public Device {
 public:
     static CCVKDevice *getInstance();
@@ -103,6 +109,11 @@ public:
 
     void updateBackBufferCount(uint32_t backBufferCount);
 
+    // upload counters of the last presented frame
+    inline const CCVKTransferStats &getTransferStats() const { return _lastTransferStats; }
+    // upload counters of the frame being recorded
+    inline CCVKTransferStats &frameTransferStats() { return _transferStats; }
+
 protected:
     static CCVKDevice *instance;
 
@@ -134,6 +145,9 @@ protected:
     void copyBuffersToTexture(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint32_t count) override;
     void copyTextureToBuffers(Texture *src, uint8_t *const *buffers, const BufferTextureCopy *region, uint32_t count) override;
     void getQueryPoolResults(QueryPool *queryPool) override;
+    bool getPipelineCacheData(ccstd::vector<uint8_t> &out) override;
+    void mergePipelineCacheData(const uint8_t *data, uint32_t size) override;
+    void precompileShaders(const ShaderInfo *infos, uint32_t count) override;
 
     void initFormatFeature();
 
@@ -155,6 +169,9 @@ protected:
     ccstd::vector<const char *> _layers;
     ccstd::vector<const char *> _extensions;
 
+    CCVKTransferStats _transferStats;
+    CCVKTransferStats _lastTransferStats;
+
     IXRInterface *_xr{nullptr};
 };
 
@@ -28,6 +28,7 @@
 #include "VKStd.h"
 #include "VKUtils.h"
 #include "base/Log.h"
+#include "base/std/container/unordered_map.h"
 #include "base/std/container/unordered_set.h"
 #include "core/memop/CachedArray.h"
 #include "gfx-base/GFXDeviceObject.h"
@@ -222,6 +223,7 @@ struct CCVKGPUBuffer : public CCVKGPUDeviceObject {
     VkDeviceSize size = 0U;
 
     VkDeviceSize instanceSize = 0U; // per-back-buffer instance
+    uint64_t creationSubmission = 0U; // mapped device buffers are written directly only until the first submission after creation
     ccstd::vector<ThsvsAccessType> currentAccessTypes;
 
     // for barrier manager
@@ -435,6 +437,7 @@ public:
 
     uint32_t curBackBufferIndex{0U};
     uint32_t backBufferCount{3U};
+    uint64_t submissionCount{0U};
 
     bool useDescriptorUpdateTemplate{false};
     bool useMultiDrawIndirect{false};
@@ -1214,7 +1217,7 @@ public:
     bool empty(bool late) const {
         const CCVKGPUCommandBuffer *cmdBuff = late ? &_lateCmdBuff : &_earlyCmdBuff;
 
-        return !cmdBuff->vkCommandBuffer;
+        return !cmdBuff->vkCommandBuffer && (late || _pendingCopies.empty());
     }
 
     template <typename TFunc>
@@ -1222,12 +1225,9 @@ public:
         CCVKGPUCommandBufferPool *commandBufferPool = _device->getCommandBufferPool();
         CCVKGPUCommandBuffer *cmdBuff = late ? &_lateCmdBuff : &_earlyCmdBuff;
 
-        if (!cmdBuff->vkCommandBuffer) {
-            commandBufferPool->request(cmdBuff);
-            VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
-            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-            VK_CHECK(vkBeginCommandBuffer(cmdBuff->vkCommandBuffer, &beginInfo));
-        }
+        // deferred copies go first to keep the recording order
+        if (!late) recordPendingCopies();
+        begin(cmdBuff);
 
         record(cmdBuff);
 
@@ -1236,15 +1236,24 @@ public:
             VkSubmitInfo submitInfo{VK_STRUCTURE_TYPE_SUBMIT_INFO};
             submitInfo.commandBufferCount = 1;
             submitInfo.pCommandBuffers = &cmdBuff->vkCommandBuffer;
+            ++_device->submissionCount;
             VK_CHECK(vkQueueSubmit(_queue->vkQueue, 1, &submitInfo, _fence));
             VK_CHECK(vkWaitForFences(_device->vkDevice, 1, &_fence, VK_TRUE, DEFAULT_TIMEOUT));
             vkResetFences(_device->vkDevice, 1, &_fence);
             commandBufferPool->yield(cmdBuff);
             cmdBuff->vkCommandBuffer = VK_NULL_HANDLE;
+            _writtenBuffers.clear();
         }
     }
 
+    /**
+     * Defers a buffer copy to the early command buffer. Copies checked in back to back are
+     * recorded with one vkCmdCopyBuffer per buffer pair, adjacent regions merged.
+     */
+    void checkIn(VkBuffer srcBuffer, VkBuffer dstBuffer, const VkBufferCopy &region);
+
     VkCommandBuffer packageForFlight(bool late) {
+        if (!late) recordPendingCopies();
         CCVKGPUCommandBuffer *cmdBuff = late ? &_lateCmdBuff : &_earlyCmdBuff;
 
         VkCommandBuffer vkCommandBuffer = cmdBuff->vkCommandBuffer;
@@ -1252,16 +1261,42 @@ public:
             VK_CHECK(vkEndCommandBuffer(vkCommandBuffer));
             _device->getCommandBufferPool()->yield(cmdBuff);
         }
+        if (!late) _writtenBuffers.clear();
         return vkCommandBuffer;
     }
 
 private:
+    struct PendingCopy {
+        VkBuffer srcBuffer = VK_NULL_HANDLE;
+        VkBuffer dstBuffer = VK_NULL_HANDLE;
+        VkBufferCopy region{};
+    };
+    // bounds of the pending reads or writes of a buffer
+    using Range = std::pair<VkDeviceSize, VkDeviceSize>;
+
+    void begin(CCVKGPUCommandBuffer *cmdBuff) {
+        if (!cmdBuff->vkCommandBuffer) {
+            _device->getCommandBufferPool()->request(cmdBuff);
+            VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            VK_CHECK(vkBeginCommandBuffer(cmdBuff->vkCommandBuffer, &beginInfo));
+        }
+    }
+
+    void recordPendingCopies();
+
     CCVKGPUDevice *_device = nullptr;
 
     CCVKGPUQueue *_queue = nullptr;
     CCVKGPUCommandBuffer _earlyCmdBuff;
     CCVKGPUCommandBuffer _lateCmdBuff;
     VkFence _fence = VK_NULL_HANDLE;
+
+    ccstd::vector<PendingCopy> _pendingCopies;
+    ccstd::unordered_map<VkBuffer, Range> _pendingReads;
+    ccstd::unordered_map<VkBuffer, Range> _pendingWrites;
+    ccstd::unordered_set<VkBuffer> _writtenBuffers; // copy destinations in the early command buffer
+    ccstd::vector<VkBufferCopy> _regions;
 };
 
 class CCVKGPUBarrierManager final {
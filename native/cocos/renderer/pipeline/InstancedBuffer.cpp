@@ -25,6 +25,7 @@
 
 #include "InstancedBuffer.h"
 #include "Define.h"
+#include "base/std/hash/hash.h"
 #include "gfx-base/GFXBuffer.h"
 #include "gfx-base/GFXCommandBuffer.h"
 #include "gfx-base/GFXDescriptorSet.h"
@@ -48,6 +49,7 @@ void InstancedBuffer::destroy() {
         CC_FREE(instance.data);
     }
     _instances.clear();
+    _batches.clear();
 }
 
 void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx) {
@@ -68,8 +70,11 @@ void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx, gfx::Sh
         shader = subModel->getShader(passIdx);
     }
 
-    for (auto &instance : _instances) {
-        if (instance.ia->getIndexBuffer() != sourceIA->getIndexBuffer() || instance.count >= MAX_CAPACITY) {
+    auto *indexBuffer = sourceIA->getIndexBuffer();
+    auto &batch = _batches[getBatchKey(indexBuffer, lightingMap, static_cast<uint32_t>(stride))];
+    for (const auto index : batch) {
+        auto &instance = _instances[index];
+        if (instance.ia->getIndexBuffer() != indexBuffer || instance.count >= MAX_CAPACITY) {
             continue;
         }
 
@@ -81,8 +86,8 @@ void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx, gfx::Sh
         if (instance.stride != stride) {
             continue;
         }
-        if (instance.count >= instance.capacity) { // resize buffers
-            instance.capacity <<= 1;
+        if (instance.count >= instance.capacity) { // resize buffers, the input assembler keeps referring to the same vb
+            instance.capacity = std::min(instance.capacity << 1, MAX_CAPACITY);
             const auto newSize = instance.stride * instance.capacity;
             instance.data = static_cast<uint8_t *>(CC_REALLOC(instance.data, newSize));
             instance.vb->resize(newSize);
@@ -94,6 +99,7 @@ void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx, gfx::Sh
             instance.descriptorSet = descriptorSet;
         }
         memcpy(instance.data + instance.stride * instance.count++, attrs.buffer.buffer()->getData(), stride);
+        ++_stats.instanceCount;
         _hasPendingModels = true;
         return;
     }
@@ -109,7 +115,6 @@ void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx, gfx::Sh
 
     auto vertexBuffers = sourceIA->getVertexBuffers();
     auto attributes = sourceIA->getAttributes();
-    auto *indexBuffer = sourceIA->getIndexBuffer();
 
     for (const auto &attribute : attrs.attributes) {
         attributes.emplace_back(gfx::Attribute{
@@ -127,7 +132,9 @@ void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx, gfx::Sh
     const gfx::InputAssemblerInfo iaInfo = {attributes, vertexBuffers, indexBuffer};
     auto *ia = _device->createInputAssembler(iaInfo);
     InstancedItem item = {1, INITIAL_CAPACITY, vb, data, ia, stride, shader, descriptorSet, lightingMap};
+    batch.emplace_back(static_cast<uint32_t>(_instances.size()));
     _instances.emplace_back(item);
+    ++_stats.instanceCount;
     _hasPendingModels = true;
 }
 
@@ -135,8 +142,12 @@ void InstancedBuffer::uploadBuffers(gfx::CommandBuffer *cmdBuff) {
     for (auto &instance : _instances) {
         if (!instance.count) continue;
 
-        cmdBuff->updateBuffer(instance.vb, instance.data, instance.vb->getSize());
+        // only the instances merged this frame, not the whole capacity
+        const auto size = instance.stride * instance.count;
+        cmdBuff->updateBuffer(instance.vb, instance.data, size);
         instance.ia->setInstanceCount(instance.count);
+        ++_stats.batchCount;
+        _stats.uploadedBytes += size;
     }
 }
 
@@ -144,9 +155,17 @@ void InstancedBuffer::clear() {
     for (auto &instance : _instances) {
         instance.count = 0;
     }
+    _stats = {};
     _hasPendingModels = false;
 }
 
+ccstd::hash_t InstancedBuffer::getBatchKey(const gfx::Buffer *indexBuffer, const gfx::Texture *lightingMap, uint32_t stride) {
+    ccstd::hash_t seed = stride;
+    ccstd::hash_combine(seed, indexBuffer);
+    ccstd::hash_combine(seed, lightingMap);
+    return seed;
+}
+
 void InstancedBuffer::setDynamicOffset(uint32_t idx, uint32_t value) {
     if (_dynamicOffsets.size() <= idx) _dynamicOffsets.resize(1 + idx);
     _dynamicOffsets[idx] = value;
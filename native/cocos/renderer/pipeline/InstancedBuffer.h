@@ -52,6 +52,13 @@ struct CC_DLL InstancedItem {
 using InstancedItemList = ccstd::vector<InstancedItem>;
 using DynamicOffsetList = ccstd::vector<uint32_t>;
 
+// reset by InstancedBuffer::clear, so it covers a single frame
+struct CC_DLL InstancedBufferStats {
+    uint32_t instanceCount = 0;
+    uint32_t batchCount = 0;
+    uint32_t uploadedBytes = 0;
+};
+
 class InstancedBuffer : public RefCounted {
 public:
     static constexpr uint32_t INITIAL_CAPACITY = 32;
@@ -71,9 +78,15 @@ public:
     inline const scene::Pass *getPass() const { return _pass; }
     inline bool hasPendingModels() const { return _hasPendingModels; }
     inline const DynamicOffsetList &dynamicOffsets() const { return _dynamicOffsets; }
+    inline const InstancedBufferStats &getStats() const { return _stats; }
 
 private:
+    static ccstd::hash_t getBatchKey(const gfx::Buffer *indexBuffer, const gfx::Texture *lightingMap, uint32_t stride);
+
     InstancedItemList _instances;
+    // indices into _instances of the batches sharing index buffer, lightmap and stride
+    ccstd::unordered_map<ccstd::hash_t, ccstd::vector<uint32_t>> _batches;
+    InstancedBufferStats _stats;
     // weak reference
     const scene::Pass *_pass{nullptr};
     bool _hasPendingModels{false};
@@ -24,56 +24,529 @@
 ****************************************************************************/
 
 #include "PipelineStateManager.h"
+#include <algorithm>
+#include <cstring>
+#include "base/Log.h"
+#include "base/Timer.h"
+#include "base/std/hash/hash.h"
 #include "gfx-base/GFXDef-common.h"
 #include "gfx-base/GFXDevice.h"
+#include "platform/FileUtils.h"
 #include "scene/Pass.h"
 
 namespace cc {
 namespace pipeline {
 
-ccstd::unordered_map<ccstd::hash_t, IntrusivePtr<gfx::PipelineState>> PipelineStateManager::psoHashMap;
+namespace {
+
+constexpr uint32_t CACHE_MAGIC = 0x53504343; // "CCPS"
+constexpr uint32_t CACHE_VERSION = 1;
+
+class CacheWriter {
+public:
+    explicit CacheWriter(ccstd::vector<uint8_t> &out) : _out(out) {}
+
+    template <typename T>
+    void write(const T &value) {
+        static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+        const auto *bytes = reinterpret_cast<const uint8_t *>(&value);
+        _out.insert(_out.end(), bytes, bytes + sizeof(T));
+    }
+
+    void writeBytes(const uint8_t *data, uint32_t size) {
+        write(size);
+        _out.insert(_out.end(), data, data + size);
+    }
+
+    void writeString(const ccstd::string &str) {
+        writeBytes(reinterpret_cast<const uint8_t *>(str.data()), static_cast<uint32_t>(str.size()));
+    }
+
+    template <typename T>
+    void writeList(const ccstd::vector<T> &list) {
+        write(static_cast<uint32_t>(list.size()));
+        for (const auto &item : list) write(item);
+    }
+
+private:
+    ccstd::vector<uint8_t> &_out;
+};
+
+class CacheReader {
+public:
+    CacheReader(const uint8_t *data, size_t size) : _cur(data), _end(data + size) {}
+
+    template <typename T>
+    bool read(T &value) {
+        static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+        if (static_cast<size_t>(_end - _cur) < sizeof(T)) return fail();
+        memcpy(&value, _cur, sizeof(T));
+        _cur += sizeof(T);
+        return true;
+    }
+
+    bool readBytes(ccstd::vector<uint8_t> &out) {
+        uint32_t size{0};
+        if (!read(size) || static_cast<size_t>(_end - _cur) < size) return fail();
+        out.assign(_cur, _cur + size);
+        _cur += size;
+        return true;
+    }
+
+    bool readString(ccstd::string &str) {
+        uint32_t size{0};
+        if (!read(size) || static_cast<size_t>(_end - _cur) < size) return fail();
+        str.assign(reinterpret_cast<const char *>(_cur), size);
+        _cur += size;
+        return true;
+    }
+
+    // every item takes at least itemSize bytes, so a corrupted count can not trigger a huge allocation
+    bool readCount(uint32_t &count, size_t itemSize) {
+        if (!read(count) || static_cast<uint64_t>(_end - _cur) < static_cast<uint64_t>(count) * itemSize) {
+            count = 0;
+            return fail();
+        }
+        return true;
+    }
+
+    template <typename T>
+    bool readList(ccstd::vector<T> &list) {
+        uint32_t count{0};
+        if (!readCount(count, sizeof(T))) return false;
+        list.resize(count);
+        for (auto &item : list) read(item);
+        return true;
+    }
+
+    inline bool good() const { return _good; }
+
+private:
+    bool fail() {
+        _good = false;
+        _cur = _end;
+        return false;
+    }
+
+    const uint8_t *_cur{nullptr};
+    const uint8_t *_end{nullptr};
+    bool _good{true};
+};
+
+gfx::GeneralBarrierInfo barrierInfoOf(const gfx::GeneralBarrier *barrier) {
+    return barrier ? barrier->getInfo() : gfx::GeneralBarrierInfo{};
+}
+
+gfx::GeneralBarrier *barrierOf(bool hasBarrier, const gfx::GeneralBarrierInfo &info) {
+    return hasBarrier ? gfx::Device::getInstance()->getGeneralBarrier(info) : nullptr;
+}
+
+// Barrier pointers are per-session, so they are stored by value and re-acquired from the device on load.
+void writeRenderPassInfo(CacheWriter &writer, const gfx::RenderPassInfo &info) {
+    writer.write(static_cast<uint32_t>(info.colorAttachments.size()));
+    for (const auto &color : info.colorAttachments) {
+        writer.write(color.format);
+        writer.write(color.sampleCount);
+        writer.write(color.loadOp);
+        writer.write(color.storeOp);
+        writer.write(color.isGeneralLayout);
+        writer.write(static_cast<uint8_t>(color.barrier != nullptr));
+        writer.write(barrierInfoOf(color.barrier));
+    }
+    const auto &ds = info.depthStencilAttachment;
+    writer.write(ds.format);
+    writer.write(ds.sampleCount);
+    writer.write(ds.depthLoadOp);
+    writer.write(ds.depthStoreOp);
+    writer.write(ds.stencilLoadOp);
+    writer.write(ds.stencilStoreOp);
+    writer.write(ds.isGeneralLayout);
+    writer.write(static_cast<uint8_t>(ds.barrier != nullptr));
+    writer.write(barrierInfoOf(ds.barrier));
+
+    writer.write(static_cast<uint32_t>(info.subpasses.size()));
+    for (const auto &subpass : info.subpasses) {
+        writer.writeList(subpass.inputs);
+        writer.writeList(subpass.colors);
+        writer.writeList(subpass.resolves);
+        writer.writeList(subpass.preserves);
+        writer.write(subpass.depthStencil);
+        writer.write(subpass.depthStencilResolve);
+        writer.write(subpass.depthResolveMode);
+        writer.write(subpass.stencilResolveMode);
+    }
+
+    // buffer & texture barriers reference live resources and don't affect pipeline compatibility
+    writer.write(static_cast<uint32_t>(info.dependencies.size()));
+    for (const auto &dependency : info.dependencies) {
+        writer.write(dependency.srcSubpass);
+        writer.write(dependency.dstSubpass);
+        writer.write(static_cast<uint8_t>(dependency.generalBarrier != nullptr));
+        writer.write(barrierInfoOf(dependency.generalBarrier));
+    }
+}
+
+bool readRenderPassInfo(CacheReader &reader, gfx::RenderPassInfo &info) {
+    uint32_t count{0};
+    uint8_t hasBarrier{0};
+    gfx::GeneralBarrierInfo barrierInfo;
+
+    reader.readCount(count, sizeof(gfx::Format));
+    info.colorAttachments.resize(count);
+    for (auto &color : info.colorAttachments) {
+        reader.read(color.format);
+        reader.read(color.sampleCount);
+        reader.read(color.loadOp);
+        reader.read(color.storeOp);
+        reader.read(color.isGeneralLayout);
+        reader.read(hasBarrier);
+        reader.read(barrierInfo);
+        if (!reader.good()) return false;
+        color.barrier = barrierOf(hasBarrier, barrierInfo);
+    }
+    auto &ds = info.depthStencilAttachment;
+    reader.read(ds.format);
+    reader.read(ds.sampleCount);
+    reader.read(ds.depthLoadOp);
+    reader.read(ds.depthStoreOp);
+    reader.read(ds.stencilLoadOp);
+    reader.read(ds.stencilStoreOp);
+    reader.read(ds.isGeneralLayout);
+    reader.read(hasBarrier);
+    reader.read(barrierInfo);
+    if (!reader.good()) return false;
+    ds.barrier = barrierOf(hasBarrier, barrierInfo);
+
+    reader.readCount(count, 4 * sizeof(uint32_t));
+    info.subpasses.resize(count);
+    for (auto &subpass : info.subpasses) {
+        reader.readList(subpass.inputs);
+        reader.readList(subpass.colors);
+        reader.readList(subpass.resolves);
+        reader.readList(subpass.preserves);
+        reader.read(subpass.depthStencil);
+        reader.read(subpass.depthStencilResolve);
+        reader.read(subpass.depthResolveMode);
+        reader.read(subpass.stencilResolveMode);
+    }
+
+    reader.readCount(count, 2 * sizeof(uint32_t));
+    info.dependencies.resize(count);
+    for (auto &dependency : info.dependencies) {
+        reader.read(dependency.srcSubpass);
+        reader.read(dependency.dstSubpass);
+        reader.read(hasBarrier);
+        reader.read(barrierInfo);
+        if (!reader.good()) return false;
+        dependency.generalBarrier = barrierOf(hasBarrier, barrierInfo);
+    }
+    return reader.good();
+}
+
+void writePipelineStateInfo(CacheWriter &writer, const gfx::PipelineStateInfo &info) {
+    writer.write(static_cast<uint32_t>(info.inputState.attributes.size()));
+    for (const auto &attribute : info.inputState.attributes) {
+        writer.writeString(attribute.name);
+        writer.write(attribute.format);
+        writer.write(attribute.isNormalized);
+        writer.write(attribute.stream);
+        writer.write(attribute.isInstanced);
+        writer.write(attribute.location);
+    }
+    // rasterizer & depth stencil states are plain uint32 arrays
+    writer.write(info.rasterizerState);
+    writer.write(info.depthStencilState);
+    writer.write(info.blendState.isA2C);
+    writer.write(info.blendState.isIndepend);
+    writer.write(info.blendState.blendColor);
+    writer.writeList(info.blendState.targets);
+    writer.write(info.primitive);
+    writer.write(info.dynamicStates);
+    writer.write(info.bindPoint);
+    writer.write(info.subpass);
+}
+
+bool readPipelineStateInfo(CacheReader &reader, gfx::PipelineStateInfo &info) {
+    uint32_t count{0};
+    reader.readCount(count, sizeof(uint32_t));
+    info.inputState.attributes.resize(count);
+    for (auto &attribute : info.inputState.attributes) {
+        reader.readString(attribute.name);
+        reader.read(attribute.format);
+        reader.read(attribute.isNormalized);
+        reader.read(attribute.stream);
+        reader.read(attribute.isInstanced);
+        reader.read(attribute.location);
+    }
+    reader.read(info.rasterizerState);
+    reader.read(info.depthStencilState);
+    reader.read(info.blendState.isA2C);
+    reader.read(info.blendState.isIndepend);
+    reader.read(info.blendState.blendColor);
+    reader.readList(info.blendState.targets);
+    reader.read(info.primitive);
+    reader.read(info.dynamicStates);
+    reader.read(info.bindPoint);
+    reader.read(info.subpass);
+    return reader.good();
+}
+
+gfx::RenderPassInfo renderPassInfoOf(const gfx::RenderPass *renderPass) {
+    gfx::RenderPassInfo info;
+    info.colorAttachments = renderPass->getColorAttachments();
+    info.depthStencilAttachment = renderPass->getDepthStencilAttachment();
+    info.subpasses = renderPass->getSubpasses();
+    info.dependencies = renderPass->getDependencies();
+    return info;
+}
+
+} // namespace
+
+ccstd::hash_t PipelineStateKeyHasher::operator()(const PipelineStateKey &key) const {
+    ccstd::hash_t seed = 5;
+    ccstd::hash_combine(seed, key.passHash);
+    ccstd::hash_combine(seed, key.renderPassHash);
+    ccstd::hash_combine(seed, key.attributesHash);
+    ccstd::hash_combine(seed, key.shaderID);
+    ccstd::hash_combine(seed, key.subpass);
+    return seed;
+}
+
+ccstd::unordered_map<PipelineStateKey, IntrusivePtr<gfx::PipelineState>, PipelineStateKeyHasher> PipelineStateManager::psoHashMap;
+ccstd::unordered_map<PipelineStateKey, PipelineStateManager::PipelineStateRecord, PipelineStateKeyHasher> PipelineStateManager::records;
+ccstd::vector<PipelineStateManager::PipelineStateRecord> PipelineStateManager::pendingRecords;
+ccstd::unordered_map<ccstd::hash_t, IntrusivePtr<gfx::RenderPass>> PipelineStateManager::prewarmRenderPasses;
+ccstd::vector<uint8_t> PipelineStateManager::pipelineCacheBlob;
+PipelineStateCacheStats PipelineStateManager::stats;
 
 gfx::PipelineState *PipelineStateManager::getOrCreatePipelineState(const scene::Pass *pass,
                                                                    gfx::Shader *shader,
                                                                    gfx::InputAssembler *inputAssembler,
                                                                    gfx::RenderPass *renderPass,
                                                                    uint32_t subpass) {
-    const auto passHash = pass->getHash();
-    const auto renderPassHash = renderPass->getHash();
-    const auto iaHash = inputAssembler->getAttributesHash();
-    const auto shaderID = shader->getTypedID();
-    auto hash = passHash ^ renderPassHash ^ iaHash ^ shaderID;
-    if (subpass != 0) {
-        hash = hash << subpass;
-    }
-
-    auto *pso = psoHashMap[static_cast<ccstd::hash_t>(hash)].get();
-    if (!pso) {
-        auto *pipelineLayout = pass->getPipelineLayout();
-
-        pso = gfx::Device::getInstance()->createPipelineState({shader,
-                                                               pipelineLayout,
-                                                               renderPass,
-                                                               {inputAssembler->getAttributes()},
-                                                               *(pass->getRasterizerState()),
-                                                               *(pass->getDepthStencilState()),
-                                                               *(pass->getBlendState()),
-                                                               pass->getPrimitive(),
-                                                               pass->getDynamicStates(),
-                                                               gfx::PipelineBindPoint::GRAPHICS,
-                                                               subpass});
-
-        psoHashMap[static_cast<ccstd::hash_t>(hash)] = pso;
+    const PipelineStateKey key{pass->getHash(), renderPass->getHash(), inputAssembler->getAttributesHash(), shader->getTypedID(), subpass};
+
+    auto iter = psoHashMap.find(key);
+    if (iter != psoHashMap.end()) {
+        ++stats.hits;
+        return iter->second.get();
     }
 
+    ++stats.misses;
+    return createPipelineState(key, {shader,
+                                     pass->getPipelineLayout(),
+                                     renderPass,
+                                     {inputAssembler->getAttributes()},
+                                     *(pass->getRasterizerState()),
+                                     *(pass->getDepthStencilState()),
+                                     *(pass->getBlendState()),
+                                     pass->getPrimitive(),
+                                     pass->getDynamicStates(),
+                                     gfx::PipelineBindPoint::GRAPHICS,
+                                     subpass});
+}
+
+gfx::PipelineState *PipelineStateManager::getOrCreatePipelineState(const PipelineStateKey &key, const gfx::PipelineStateInfo &info) {
+    auto iter = psoHashMap.find(key);
+    if (iter != psoHashMap.end()) {
+        ++stats.hits;
+        return iter->second.get();
+    }
+
+    ++stats.misses;
+    return createPipelineState(key, info);
+}
+
+gfx::PipelineState *PipelineStateManager::createPipelineState(const PipelineStateKey &key, const gfx::PipelineStateInfo &info) {
+    utils::Timer timer;
+    auto *pso = gfx::Device::getInstance()->createPipelineState(info);
+    const auto elapsed = static_cast<uint64_t>(timer.getMicroseconds());
+    stats.creationTimeUS += elapsed;
+    stats.maxCreationTimeUS = std::max(stats.maxCreationTimeUS, elapsed);
+
+    psoHashMap[key] = pso;
+    recordPipelineState(key, info);
     return pso;
 }
 
+void PipelineStateManager::recordPipelineState(const PipelineStateKey &key, const gfx::PipelineStateInfo &info) {
+    if (!info.shader || !info.renderPass) return;
+
+    PipelineStateRecord record;
+    record.shaderName = info.shader->getName();
+    record.passHash = key.passHash;
+    record.attributesHash = key.attributesHash;
+    record.renderPassInfo = renderPassInfoOf(info.renderPass);
+    record.info = info;
+    // object references are resolved again when the record is loaded
+    record.info.shader = nullptr;
+    record.info.pipelineLayout = nullptr;
+    record.info.renderPass = nullptr;
+    records[key] = std::move(record);
+}
+
 void PipelineStateManager::destroyAll() {
     for (auto &pair : psoHashMap) {
         CC_SAFE_DESTROY_NULL(pair.second);
     }
     psoHashMap.clear();
+    records.clear();
+    pendingRecords.clear();
+    for (auto &pair : prewarmRenderPasses) {
+        CC_SAFE_DESTROY_NULL(pair.second);
+    }
+    prewarmRenderPasses.clear();
+    pipelineCacheBlob.clear();
+}
+
+bool PipelineStateManager::serializeCache(ccstd::vector<uint8_t> &out) {
+    auto *device = gfx::Device::getInstance();
+    if (!device) return false;
+
+    CacheWriter writer(out);
+    writer.write(CACHE_MAGIC);
+    writer.write(CACHE_VERSION);
+    writer.write(device->getGfxAPI());
+    writer.writeString(device->getRenderer());
+
+    // records that were never resolved in this session are kept for the next one
+    writer.write(static_cast<uint32_t>(records.size() + pendingRecords.size()));
+    auto writeRecord = [&](const PipelineStateRecord &record) {
+        writer.writeString(record.shaderName);
+        writer.write(record.passHash);
+        writer.write(record.attributesHash);
+        writeRenderPassInfo(writer, record.renderPassInfo);
+        writePipelineStateInfo(writer, record.info);
+    };
+    for (const auto &pair : records) {
+        writeRecord(pair.second);
+    }
+    for (const auto &record : pendingRecords) {
+        writeRecord(record);
+    }
+
+    ccstd::vector<uint8_t> blob;
+    if (!device->getPipelineCacheData(blob)) {
+        blob = pipelineCacheBlob;
+    }
+    writer.writeBytes(blob.data(), static_cast<uint32_t>(blob.size()));
+    return true;
+}
+
+bool PipelineStateManager::deserializeCache(const uint8_t *data, size_t size) {
+    auto *device = gfx::Device::getInstance();
+    if (!device || !data) return false;
+
+    CacheReader reader(data, size);
+    uint32_t magic{0};
+    uint32_t version{0};
+    gfx::API api{gfx::API::UNKNOWN};
+    ccstd::string renderer;
+    reader.read(magic);
+    reader.read(version);
+    reader.read(api);
+    reader.readString(renderer);
+    if (!reader.good() || magic != CACHE_MAGIC || version != CACHE_VERSION) {
+        CC_LOG_WARNING("Pipeline state cache is invalid or outdated, ignored.");
+        return false;
+    }
+    if (api != device->getGfxAPI() || renderer != device->getRenderer()) {
+        CC_LOG_INFO("Pipeline state cache was recorded on another device, ignored.");
+        return false;
+    }
+
+    uint32_t count{0};
+    reader.readCount(count, sizeof(uint32_t));
+    ccstd::vector<PipelineStateRecord> loaded(count);
+    for (auto &record : loaded) {
+        reader.readString(record.shaderName);
+        reader.read(record.passHash);
+        reader.read(record.attributesHash);
+        if (!readRenderPassInfo(reader, record.renderPassInfo) || !readPipelineStateInfo(reader, record.info)) {
+            CC_LOG_WARNING("Pipeline state cache is corrupted, ignored.");
+            return false;
+        }
+    }
+    ccstd::vector<uint8_t> blob;
+    if (!reader.readBytes(blob)) {
+        CC_LOG_WARNING("Pipeline state cache is corrupted, ignored.");
+        return false;
+    }
+
+    if (!blob.empty()) {
+        device->mergePipelineCacheData(blob.data(), static_cast<uint32_t>(blob.size()));
+    }
+    pipelineCacheBlob = std::move(blob);
+
+    stats.recordsLoaded += count;
+    pendingRecords.insert(pendingRecords.end(), std::make_move_iterator(loaded.begin()), std::make_move_iterator(loaded.end()));
+    stats.recordsPending = static_cast<uint32_t>(pendingRecords.size());
+    return true;
+}
+
+bool PipelineStateManager::saveCache(const ccstd::string &path) {
+    ccstd::vector<uint8_t> bytes;
+    if (!serializeCache(bytes)) return false;
+
+    Data data;
+    data.copy(bytes.data(), static_cast<uint32_t>(bytes.size()));
+    return FileUtils::getInstance()->writeDataToFile(data, path);
+}
+
+bool PipelineStateManager::loadCache(const ccstd::string &path) {
+    auto *fileUtils = FileUtils::getInstance();
+    if (!fileUtils->isFileExist(path)) return false;
+
+    // the cache is rewritten on save, so it's read instead of mapped
+    Data data = fileUtils->getDataFromFile(path);
+    return deserializeCache(data.getBytes(), data.getSize());
+}
+
+gfx::RenderPass *PipelineStateManager::getOrCreateRenderPass(const gfx::RenderPassInfo &info) {
+    const auto hash = gfx::RenderPass::computeHash(info);
+    auto &renderPass = prewarmRenderPasses[hash];
+    if (!renderPass) {
+        renderPass = gfx::Device::getInstance()->createRenderPass(info);
+    }
+    return renderPass.get();
+}
+
+uint32_t PipelineStateManager::prewarm(const PipelineStateShaderResolver &resolver, uint32_t maxCount) {
+    uint32_t created = 0;
+    auto iter = pendingRecords.begin();
+    while (iter != pendingRecords.end() && created < maxCount) {
+        gfx::Shader *shader{nullptr};
+        gfx::PipelineLayout *pipelineLayout{nullptr};
+        if (!resolver(iter->shaderName, shader, pipelineLayout) || !shader || !pipelineLayout) {
+            ++iter;
+            continue;
+        }
+
+        auto *renderPass = getOrCreateRenderPass(iter->renderPassInfo);
+        gfx::PipelineStateInfo info = iter->info;
+        info.shader = shader;
+        info.pipelineLayout = pipelineLayout;
+        info.renderPass = renderPass;
+
+        // render pass compatibility hash of the live object, barriers are interned by the device
+        const PipelineStateKey key{iter->passHash, renderPass->getHash(), iter->attributesHash, shader->getTypedID(), info.subpass};
+        if (psoHashMap.find(key) == psoHashMap.end()) {
+            createPipelineState(key, info);
+            ++stats.prewarmed;
+            ++created;
+        }
+        iter = pendingRecords.erase(iter);
+    }
+    stats.recordsPending = static_cast<uint32_t>(pendingRecords.size());
+    return stats.recordsPending;
+}
+
+void PipelineStateManager::resetStats() {
+    const auto loaded = stats.recordsLoaded;
+    const auto pending = stats.recordsPending;
+    stats = {};
+    stats.recordsLoaded = loaded;
+    stats.recordsPending = pending;
 }
 
 } // namespace pipeline
@@ -25,7 +25,11 @@
 
 #pragma once
 
+#include <functional>
 #include "cocos/base/Ptr.h"
+#include "base/std/container/string.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
 #include "gfx-base/GFXDef.h"
 
 namespace cc {
@@ -34,6 +38,47 @@ class Pass;
 }
 namespace pipeline {
 
+/**
+ * Every component is compared on lookup, so different pass/render pass/IA/shader combinations
+ * can never alias each other the way a folded hash could.
+ */
+struct CC_DLL PipelineStateKey {
+    ccstd::hash_t passHash{0};
+    ccstd::hash_t renderPassHash{0};
+    ccstd::hash_t attributesHash{0};
+    uint32_t shaderID{0};
+    uint32_t subpass{0};
+
+    bool operator==(const PipelineStateKey &rhs) const {
+        return passHash == rhs.passHash &&
+               renderPassHash == rhs.renderPassHash &&
+               attributesHash == rhs.attributesHash &&
+               shaderID == rhs.shaderID &&
+               subpass == rhs.subpass;
+    }
+    bool operator!=(const PipelineStateKey &rhs) const { return !(*this == rhs); }
+};
+
+struct CC_DLL PipelineStateKeyHasher {
+    ccstd::hash_t operator()(const PipelineStateKey &key) const;
+};
+
+struct PipelineStateCacheStats {
+    uint32_t hits{0};
+    uint32_t misses{0};
+    uint32_t prewarmed{0};
+    uint32_t recordsLoaded{0};
+    uint32_t recordsPending{0};
+    uint64_t creationTimeUS{0};
+    uint64_t maxCreationTimeUS{0};
+};
+
+/**
+ * Resolves the shader instance named in a cached record (ProgramLib instance name, e.g. "builtin-standard|USE_INSTANCING1")
+ * together with the pipeline layout it is used with. Returns false if the shader can not be provided at the moment.
+ */
+using PipelineStateShaderResolver = std::function<bool(const ccstd::string &shaderName, gfx::Shader *&shader, gfx::PipelineLayout *&pipelineLayout)>;
+
 class CC_DLL PipelineStateManager {
 public:
     static gfx::PipelineState *getOrCreatePipelineState(const scene::Pass *pass,
@@ -41,10 +86,47 @@ public:
                                                         gfx::InputAssembler *inputAssembler,
                                                         gfx::RenderPass *renderPass,
                                                         uint32_t subpass = 0);
+    static gfx::PipelineState *getOrCreatePipelineState(const PipelineStateKey &key, const gfx::PipelineStateInfo &info);
     static void destroyAll();
 
+    /**
+     * Persistent cache: records every PSO created in this session (plus the backend pipeline cache blob
+     * on backends supporting it) so the next launch can create them before they are first drawn.
+     */
+    static bool saveCache(const ccstd::string &path);
+    static bool loadCache(const ccstd::string &path);
+    static bool serializeCache(ccstd::vector<uint8_t> &out);
+    static bool deserializeCache(const uint8_t *data, size_t size);
+
+    /**
+     * Creates PSOs for the loaded records whose shader can be resolved, at most `maxCount` of them per call.
+     * With the multi-threaded device agent, backend compilation runs on the device thread.
+     * Returns the number of records still pending.
+     */
+    static uint32_t prewarm(const PipelineStateShaderResolver &resolver, uint32_t maxCount = UINT32_MAX);
+
+    static inline const PipelineStateCacheStats &getStats() { return stats; }
+    static void resetStats();
+
 private:
-    static ccstd::unordered_map<ccstd::hash_t, IntrusivePtr<gfx::PipelineState>> psoHashMap;
+    struct PipelineStateRecord {
+        ccstd::string shaderName;
+        ccstd::hash_t passHash{0};
+        ccstd::hash_t attributesHash{0};
+        gfx::RenderPassInfo renderPassInfo;
+        gfx::PipelineStateInfo info;
+    };
+
+    static gfx::PipelineState *createPipelineState(const PipelineStateKey &key, const gfx::PipelineStateInfo &info);
+    static gfx::RenderPass *getOrCreateRenderPass(const gfx::RenderPassInfo &info);
+    static void recordPipelineState(const PipelineStateKey &key, const gfx::PipelineStateInfo &info);
+
+    static ccstd::unordered_map<PipelineStateKey, IntrusivePtr<gfx::PipelineState>, PipelineStateKeyHasher> psoHashMap;
+    static ccstd::unordered_map<PipelineStateKey, PipelineStateRecord, PipelineStateKeyHasher> records;
+    static ccstd::vector<PipelineStateRecord> pendingRecords;
+    static ccstd::unordered_map<ccstd::hash_t, IntrusivePtr<gfx::RenderPass>> prewarmRenderPasses;
+    static ccstd::vector<uint8_t> pipelineCacheBlob;
+    static PipelineStateCacheStats stats;
 };
 
 } // namespace pipeline
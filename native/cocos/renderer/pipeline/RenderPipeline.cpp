@@ -378,6 +378,7 @@ bool RenderPipeline::isOccluded(const scene::Camera *camera, const scene::SubMod
 void RenderPipeline::framegraphGC() {
     static uint64_t frameCount{0U};
     static constexpr uint32_t INTERVAL_IN_SECONDS = 30;
+    framegraph::FrameGraph::endFrame();
     if (++frameCount % (INTERVAL_IN_SECONDS * 60) == 0) {
         framegraph::FrameGraph::gc(INTERVAL_IN_SECONDS * 60);
     }
@@ -31,7 +31,9 @@
 #include "RenderPipeline.h"
 #include "SceneCulling.h"
 #include "base/std/container/map.h"
+#include "base/std/container/unordered_set.h"
 #include "core/geometry/AABB.h"
+#include "core/geometry/AABBSoA.h"
 #include "core/geometry/Frustum.h"
 #include "core/geometry/Intersect.h"
 #include "core/geometry/Sphere.h"
@@ -97,39 +99,161 @@ void validPunctualLightsCulling(const RenderPipeline *pipeline, const scene::Cam
     }
 }
 
-// Todo If you want to optimize the cutting efficiency, you can get it from the octree
 void shadowCulling(const RenderPipeline *pipeline, const scene::Camera *camera, ShadowTransformInfo *layer) {
     const auto *sceneData = pipeline->getPipelineSceneData();
     auto *csmLayers = sceneData->getCSMLayers();
     const auto *const scene = camera->getScene();
     const auto *mainLight = scene->getMainLight();
+    auto &layerObjects = csmLayers->getLayerObjects();
 
     layer->clearShadowObjects();
-    for (size_t i = 0; i < csmLayers->getLayerObjects().size(); ++i) {
-        const auto *model = csmLayers->getLayerObjects()[i].model;
-        // filter model by view visibility
+
+    // filter model by view visibility, then do the frustum culling in batch
+    static thread_local ccstd::vector<uint32_t> candidates;
+    static thread_local ccstd::vector<uint8_t> results;
+    static thread_local geometry::AABBSoA bounds;
+    candidates.clear();
+    bounds.clear();
+    const uint32_t visibility = camera->getVisibility();
+    for (uint32_t i = 0; i < layerObjects.size(); ++i) {
+        const auto *model = layerObjects[i].model;
         if (model->isEnabled()) {
-            const uint32_t visibility = camera->getVisibility();
             const auto *node = model->getNode();
             if ((model->getNode() && ((visibility & node->getLayer()) == node->getLayer())) ||
                 (visibility & static_cast<uint32_t>(model->getVisFlags()))) {
-                // frustum culling
-                const bool accurate = model->getWorldBounds()->aabbFrustum(layer->getValidFrustum());
-                if (accurate) {
-                    layer->addShadowObject(genRenderObject(model, camera));
-                    if (layer->getLevel() < static_cast<uint32_t>(mainLight->getCSMLevel())) {
-                        if (static_cast<uint32_t>(mainLight->getCSMOptimizationMode()) == 2 &&
-                            aabbFrustumCompletelyInside(*model->getWorldBounds(), layer->getValidFrustum())) {
-                            csmLayers->getLayerObjects().erase(csmLayers->getLayerObjects().begin() + static_cast<uint32_t>(i));
-                            i--;
-                        }
-                    }
-                }
+                candidates.push_back(i);
+                bounds.push(*model->getWorldBounds());
+            }
+        }
+    }
+    results.resize(candidates.size());
+    geometry::aabbFrustumBatch(bounds, layer->getValidFrustum(), results.data());
+
+    const bool removeInside = layer->getLevel() < static_cast<uint32_t>(mainLight->getCSMLevel()) &&
+                              static_cast<uint32_t>(mainLight->getCSMOptimizationMode()) == 2;
+    uint32_t removed = 0;
+    uint32_t candidate = 0;
+    for (uint32_t i = 0; i < layerObjects.size(); ++i) {
+        bool keep = true;
+        if (candidate < candidates.size() && candidates[candidate] == i) {
+            if (results[candidate]) {
+                const auto *model = layerObjects[i].model;
+                layer->addShadowObject(genRenderObject(model, camera));
+                // models completely inside a CSM level don't need to be culled by the next levels
+                keep = !(removeInside && aabbFrustumCompletelyInside(*model->getWorldBounds(), layer->getValidFrustum()));
             }
+            ++candidate;
+        }
+        if (!keep) {
+            ++removed;
+        } else if (removed) {
+            layerObjects[i - removed] = layerObjects[i];
         }
     }
+    layerObjects.resize(layerObjects.size() - removed);
 }
 
+namespace {
+
+// queries for the camera and the shadow casters of every CSM level, spot light casters are queried separately
+// because they are filtered by the light visibility
+uint32_t collectCameraQueries(const PipelineSceneData *sceneData, const scene::Camera *camera, scene::OctreeQuery *queries) {
+    const scene::Shadows *shadowInfo = sceneData->getShadows();
+    const CSMLayers *csmLayers = sceneData->getCSMLayers();
+    const scene::DirectionalLight *mainLight = camera->getScene()->getMainLight();
+
+    uint32_t queryCount = 0;
+    queries[queryCount++] = {&camera->getFrustum(), false};
+    if (shadowInfo == nullptr || !shadowInfo->isEnabled() || shadowInfo->getType() != scene::ShadowType::SHADOW_MAP ||
+        !mainLight || !mainLight->getNode() || !mainLight->isShadowEnabled()) {
+        return queryCount;
+    }
+
+    if (mainLight->isShadowFixedArea()) {
+        queries[queryCount++] = {&csmLayers->getSpecialLayer()->getValidFrustum(), true};
+    } else {
+        const auto level = sceneData->getCSMSupported() ? static_cast<uint32_t>(mainLight->getCSMLevel()) : 1U;
+        for (uint32_t i = 0; i < level; ++i) {
+            queries[queryCount++] = {&csmLayers->getLayers()[i]->getValidFrustum(), true};
+        }
+    }
+    return queryCount;
+}
+
+void octreeCulling(const scene::Octree *octree, PipelineSceneData *sceneData, const scene::Camera *camera) {
+    CSMLayers *csmLayers = sceneData->getCSMLayers();
+    const scene::Shadows *shadowInfo = sceneData->getShadows();
+    const scene::RenderScene *const scene = camera->getScene();
+
+    static thread_local ccstd::vector<scene::Model *> results[scene::OCTREE_MAX_QUERIES];
+    static thread_local ccstd::unordered_set<const scene::Model *> casters;
+    casters.clear();
+
+    // a model is usually visible to several CSM levels, it's only added once to the layer objects
+    auto addCasters = [&](const ccstd::vector<scene::Model *> &models, bool isLayerObject) {
+        for (auto *model : models) {
+            if (LODModelsCachedUtils::isLODModelCulled(model) || !casters.insert(model).second) {
+                continue;
+            }
+            csmLayers->addCastShadowObject(genRenderObject(model, camera));
+            if (isLayerObject) {
+                csmLayers->addLayerObject(genRenderObject(model, camera));
+            }
+        }
+    };
+
+    scene::OctreeQuery queries[scene::OCTREE_MAX_QUERIES];
+    const uint32_t queryCount = collectCameraQueries(sceneData, camera, queries);
+    for (uint32_t i = 0; i < queryCount; ++i) {
+        results[i].clear();
+    }
+    octree->queryVisibility(camera->getVisibility(), queries, queryCount, results);
+
+    for (auto *model : results[0]) {
+        if (LODModelsCachedUtils::isLODModelCulled(model)) {
+            continue;
+        }
+        sceneData->addRenderObject(genRenderObject(model, camera));
+    }
+    for (uint32_t i = 1; i < queryCount; ++i) {
+        addCasters(results[i], true);
+    }
+
+    if (shadowInfo == nullptr || !shadowInfo->isEnabled() || shadowInfo->getType() != scene::ShadowType::SHADOW_MAP) {
+        return;
+    }
+
+    // spot light casters are filtered by the light frustum and visibility in ShadowMapBatchedQueue
+    uint32_t spotCount = 0;
+    uint32_t spotVisibility = 0;
+    auto flushSpotQueries = [&]() {
+        for (uint32_t i = 0; i < spotCount; ++i) {
+            results[i].clear();
+        }
+        octree->queryVisibility(spotVisibility, queries, spotCount, results);
+        for (uint32_t i = 0; i < spotCount; ++i) {
+            addCasters(results[i], false);
+        }
+        spotCount = 0;
+        spotVisibility = 0;
+    };
+    for (const auto &spotLight : scene->getSpotLights()) {
+        if (!spotLight->isShadowEnabled()) {
+            continue;
+        }
+        queries[spotCount++] = {&spotLight->getFrustum(), true};
+        spotVisibility |= spotLight->getVisibility();
+        if (spotCount == scene::OCTREE_MAX_QUERIES) {
+            flushSpotQueries();
+        }
+    }
+    if (spotCount) {
+        flushSpotQueries();
+    }
+}
+
+} // namespace
+
 void sceneCulling(const RenderPipeline *pipeline, scene::Camera *camera) {
     CC_PROFILE(SceneCulling);
     PipelineSceneData *const sceneData = pipeline->getPipelineSceneData();
@@ -162,40 +286,24 @@ void sceneCulling(const RenderPipeline *pipeline, scene::Camera *camera) {
 
     const scene::Octree *octree = scene->getOctree();
     if (octree && octree->isEnabled()) {
-        for (const auto &model : scene->getModels()) {
-            // filter model by view visibility
-            if (model->isEnabled()) {
-                if (LODModelsCachedUtils::isLODModelCulled(model)) {
-                    continue;
-                }
-
-                if (model->isCastShadow()) {
-                    csmLayers->addCastShadowObject(genRenderObject(model, camera));
-                    csmLayers->addLayerObject(genRenderObject(model, camera));
-                }
-
-                const auto visibility = camera->getVisibility();
-                const auto *const node = model->getNode();
-
-                if ((model->getNode() && ((visibility & node->getLayer()) == node->getLayer())) ||
-                    (visibility & static_cast<uint32_t>(model->getVisFlags()))) {
-                    const auto *modelWorldBounds = model->getWorldBounds();
-
-                    if (!modelWorldBounds && (skyBox == nullptr || skyBox->getModel() != model)) {
-                        sceneData->addRenderObject(genRenderObject(model, camera));
-                    }
-                }
-            }
-        }
+        octreeCulling(octree, sceneData, camera);
 
-        ccstd::vector<scene::Model *> models;
-        models.reserve(scene->getModels().size() / 4);
-        octree->queryVisibility(camera, camera->getFrustum(), false, models);
-        for (const auto &model : models) {
-            if (LODModelsCachedUtils::isLODModelCulled(model)) {
+        // models without world bounds are not in the tree
+        const auto visibility = camera->getVisibility();
+        for (const auto &model : octree->getUnboundedModels()) {
+            if (!model->isEnabled() || LODModelsCachedUtils::isLODModelCulled(model)) {
                 continue;
             }
-            sceneData->addRenderObject(genRenderObject(model, camera));
+            if (model->isCastShadow()) {
+                csmLayers->addCastShadowObject(genRenderObject(model, camera));
+            }
+            const auto *const node = model->getNode();
+            if ((node && ((visibility & node->getLayer()) == node->getLayer())) ||
+                (visibility & static_cast<uint32_t>(model->getVisFlags()))) {
+                if (skyBox == nullptr || skyBox->getModel() != model) {
+                    sceneData->addRenderObject(genRenderObject(model, camera));
+                }
+            }
         }
     } else {
         for (const auto &model : scene->getModels()) {
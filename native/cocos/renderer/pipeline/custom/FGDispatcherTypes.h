@@ -343,6 +343,15 @@ struct BarrierNode {
     std::vector<BarrierPair> subpassBarriers;
 };
 
+struct AliasedResource {
+    uint32_t memoryBlockID{0xFFFFFFFF};
+    uint64_t size{0};
+    ResourceAccessGraph::vertex_descriptor firstPassID{0xFFFFFFFF};
+    ResourceAccessGraph::vertex_descriptor lastPassID{0xFFFFFFFF};
+    // previous resource living in the same memory block, 0xFFFFFFFF if this one comes first
+    ResourceGraph::vertex_descriptor prevResourceID{0xFFFFFFFF};
+};
+
 struct FrameGraphDispatcher {
     using allocator_type = boost::container::pmr::polymorphic_allocator<char>;
     allocator_type get_allocator() const noexcept { // NOLINT
@@ -372,6 +381,12 @@ struct FrameGraphDispatcher {
 
     BarrierMap barrierMap;
 
+    // managed resources and the memory blocks they share, filled when memory aliasing is enabled
+    FlatMap<ResourceGraph::vertex_descriptor, AliasedResource> aliasedResources;
+    // total size of managed resources when each of them owns its memory, and when aliased
+    uint64_t transientMemoryBeforeAliasing{0};
+    uint64_t transientMemoryAfterAliasing{0};
+
     ResourceAccessGraph resourceAccessGraph;
     ResourceGraph& resourceGraph;
     const RenderGraph& graph;
@@ -32,6 +32,7 @@
 #include <boost/range/algorithm.hpp>
 #include <iterator>
 #include <limits>
+#include <queue>
 #include <vector>
 #include "FGDispatcherGraphs.h"
 #include "FGDispatcherTypes.h"
@@ -748,6 +749,44 @@ void buildBarriers(FrameGraphDispatcher &fgDispatcher) {
                 get(colors, rag));
         }
 
+        // memory handed over from the previous resource in the same block
+        if (fgDispatcher._enableMemoryAliasing) {
+            auto findStatus = [&rag](AccessVertex passID, ResourceHandle resID) {
+                const auto &status = get(ResourceAccessGraph::AccessNode, rag, passID).attachemntStatus;
+                auto iter = std::find_if(status.begin(), status.end(), [resID](const AccessStatus &access) {
+                    return access.vertID == resID;
+                });
+                CC_ASSERT(iter != status.end());
+                return *iter;
+            };
+
+            for (const auto &[resID, aliased] : fgDispatcher.aliasedResources) {
+                if (aliased.prevResourceID == INVALID_ID) {
+                    continue;
+                }
+                const auto &prev = fgDispatcher.aliasedResources.at(aliased.prevResourceID);
+                auto &frontBarriers = batchedBarriers[aliased.firstPassID].blockBarrier.frontBarriers;
+                auto found = std::find_if(frontBarriers.begin(), frontBarriers.end(), [resID = resID](const Barrier &barrier) {
+                    return barrier.resourceID == resID;
+                });
+                if (found != frontBarriers.end()) {
+                    continue;
+                }
+
+                // begin status is the last access to the memory by the previous resource
+                auto beginStatus = findStatus(prev.lastPassID, aliased.prevResourceID);
+                auto endStatus = findStatus(aliased.firstPassID, resID);
+                beginStatus.vertID = prev.lastPassID;
+                endStatus.vertID = aliased.firstPassID;
+                frontBarriers.emplace_back(Barrier{
+                    resID,
+                    gfx::BarrierType::FULL,
+                    beginStatus,
+                    endStatus,
+                });
+            }
+        }
+
         // external res barrier for next frame
         for (const auto &externalPair : externalResMap) {
             const auto &transition = externalPair.second;
@@ -1326,9 +1365,197 @@ void passReorder(FrameGraphDispatcher &fgDispatcher) {
 
 #pragma endregion PASS_REORDER
 
+#pragma region MEMORY_ALIASING
+
+uint64_t getTransientSize(const ResourceDesc &desc) {
+    if (desc.dimension == ResourceDimension::BUFFER) {
+        return desc.width;
+    }
+    const bool is3D = desc.dimension == ResourceDimension::TEXTURE3D;
+    const uint32_t layers = is3D ? 1U : std::max<uint32_t>(desc.depthOrArraySize, 1U);
+    const uint32_t levels = std::max<uint32_t>(desc.mipLevels, 1U);
+    uint32_t width = std::max(desc.width, 1U);
+    uint32_t height = std::max(desc.height, 1U);
+    uint32_t depth = is3D ? std::max<uint32_t>(desc.depthOrArraySize, 1U) : 1U;
+
+    uint64_t size = 0;
+    for (uint32_t level = 0; level < levels; ++level) {
+        size += gfx::formatSize(desc.format, width, height, depth);
+        width = std::max(width >> 1, 1U);
+        height = std::max(height >> 1, 1U);
+        depth = std::max(depth >> 1, 1U);
+    }
+    return size * layers * gfx::getMaxSampleCount(desc.sampleCount);
+}
+
+struct TransientLifetime {
+    ResourceHandle resourceID{INVALID_ID};
+    uint64_t size{0};
+    bool isBuffer{false};
+    uint32_t firstPosition{INVALID_ID};
+    std::vector<AccessVertex> passes; // in execution order
+};
+
+struct MemoryBlock {
+    uint64_t size{0};
+    bool isBuffer{false};
+    const TransientLifetime *lastLifetime{nullptr};
+};
+
 void memoryAliasing(FrameGraphDispatcher &fgDispatcher) {
+    const auto &graph = fgDispatcher.graph;
+    const auto &layoutGraph = fgDispatcher.layoutGraph;
+    const auto &resourceGraph = fgDispatcher.resourceGraph;
+    auto &relationGraph = fgDispatcher.relationGraph;
+    auto &rag = fgDispatcher.resourceAccessGraph;
+
+    if (!fgDispatcher._accessGraphBuilt) {
+        const Graphs graphs{resourceGraph, layoutGraph, rag, relationGraph};
+        buildAccessGraph(graph, graphs);
+        fgDispatcher._accessGraphBuilt = true;
+    }
+
+    auto &aliasedResources = fgDispatcher.aliasedResources;
+    aliasedResources.clear();
+    fgDispatcher.transientMemoryBeforeAliasing = 0;
+    fgDispatcher.transientMemoryAfterAliasing = 0;
+
+    // execution order: topological, ties broken by vertex id which follows the render graph
+    const auto numVerts = num_vertices(rag);
+    std::vector<uint32_t> inDegrees(numVerts);
+    std::priority_queue<AccessVertex, std::vector<AccessVertex>, std::greater<>> readyVerts;
+    for (const auto vert : makeRange(vertices(rag))) {
+        inDegrees[vert] = in_degree(vert, rag);
+        if (!inDegrees[vert]) {
+            readyVerts.push(vert);
+        }
+    }
+    std::vector<AccessVertex> order;
+    order.reserve(numVerts);
+    while (!readyVerts.empty()) {
+        const auto vert = readyVerts.top();
+        readyVerts.pop();
+        order.emplace_back(vert);
+        for (const auto e : makeRange(out_edges(vert, rag))) {
+            const auto next = target(e, rag);
+            if (!--inDegrees[next]) {
+                readyVerts.push(next);
+            }
+        }
+    }
+    CC_ASSERT(order.size() == numVerts);
+
+    // memory can only be handed over along a dependency path, otherwise the passes may overlap
+    std::vector<std::vector<bool>> reachable(numVerts, std::vector<bool>(numVerts, false));
+    for (auto iter = order.rbegin(); iter != order.rend(); ++iter) {
+        auto &reach = reachable[*iter];
+        for (const auto e : makeRange(out_edges(*iter, rag))) {
+            const auto next = target(e, rag);
+            reach[next] = true;
+            const auto &nextReach = reachable[next];
+            for (uint32_t v = 0; v < numVerts; ++v) {
+                if (nextReach[v]) {
+                    reach[v] = true;
+                }
+            }
+        }
+    }
+
+    // lifetimes of managed resources, the other residencies own their memory
+    FlatMap<ResourceHandle, TransientLifetime> lifetimes;
+    for (uint32_t position = 0; position < order.size(); ++position) {
+        const auto vert = order[position];
+        const ResourceAccessNode &access = get(ResourceAccessGraph::AccessNode, rag, vert);
+        // the first node collects the attachments of all subpasses
+        for (const auto &status : access.attachemntStatus) {
+            const auto resID = status.vertID;
+            if (get(ResourceGraph::Traits, resourceGraph, resID).residency != ResourceResidency::MANAGED) {
+                continue;
+            }
+            auto &lifetime = lifetimes[resID];
+            if (lifetime.passes.empty()) {
+                const auto &desc = get(ResourceGraph::Desc, resourceGraph, resID);
+                lifetime.resourceID = resID;
+                lifetime.size = getTransientSize(desc);
+                lifetime.isBuffer = desc.dimension == ResourceDimension::BUFFER;
+                lifetime.firstPosition = position;
+            }
+            if (lifetime.passes.empty() || lifetime.passes.back() != vert) {
+                lifetime.passes.emplace_back(vert);
+            }
+        }
+    }
+
+    // greedy interval coloring in order of first use, best fit among the blocks already released
+    std::vector<const TransientLifetime *> sortedLifetimes;
+    sortedLifetimes.reserve(lifetimes.size());
+    for (const auto &pair : lifetimes) {
+        sortedLifetimes.emplace_back(&pair.second);
+    }
+    std::sort(sortedLifetimes.begin(), sortedLifetimes.end(), [](const TransientLifetime *lhs, const TransientLifetime *rhs) {
+        return std::forward_as_tuple(lhs->firstPosition, rhs->size, lhs->resourceID) <
+               std::forward_as_tuple(rhs->firstPosition, lhs->size, rhs->resourceID);
+    });
+
+    std::vector<MemoryBlock> blocks;
+    for (const auto *lifetime : sortedLifetimes) {
+        const auto firstPass = lifetime->passes.front();
+        auto isReleased = [&](const MemoryBlock &block) {
+            return block.isBuffer == lifetime->isBuffer &&
+                   std::all_of(block.lastLifetime->passes.begin(), block.lastLifetime->passes.end(), [&](AccessVertex pass) {
+                       return reachable[pass][firstPass];
+                   });
+        };
+
+        uint32_t bestFit = INVALID_ID;
+        for (uint32_t i = 0; i < blocks.size(); ++i) {
+            if (!isReleased(blocks[i])) {
+                continue;
+            }
+            if (bestFit == INVALID_ID) {
+                bestFit = i;
+                continue;
+            }
+            const auto bestSize = blocks[bestFit].size;
+            const auto size = blocks[i].size;
+            const bool fits = size >= lifetime->size;
+            const bool bestFits = bestSize >= lifetime->size;
+            // the smallest block holding the resource, or the largest one to grow
+            if ((fits && (!bestFits || size < bestSize)) || (!fits && !bestFits && size > bestSize)) {
+                bestFit = i;
+            }
+        }
+
+        ResourceHandle prevResourceID = INVALID_ID;
+        if (bestFit == INVALID_ID) {
+            bestFit = static_cast<uint32_t>(blocks.size());
+            blocks.emplace_back(MemoryBlock{0, lifetime->isBuffer, nullptr});
+        } else {
+            prevResourceID = blocks[bestFit].lastLifetime->resourceID;
+        }
+        auto &block = blocks[bestFit];
+        block.size = std::max(block.size, lifetime->size);
+        block.lastLifetime = lifetime;
+
+        aliasedResources.emplace(
+            lifetime->resourceID,
+            AliasedResource{
+                bestFit,
+                lifetime->size,
+                firstPass,
+                lifetime->passes.back(),
+                prevResourceID,
+            });
+        fgDispatcher.transientMemoryBeforeAliasing += lifetime->size;
+    }
+
+    for (const auto &block : blocks) {
+        fgDispatcher.transientMemoryAfterAliasing += block.size;
+    }
 }
 
+#pragma endregion MEMORY_ALIASING
+
 #pragma region assisstantFuncDefinition
 template <typename Graph>
 bool tryAddEdge(uint32_t srcVertex, uint32_t dstVertex, Graph &graph) {
@@ -41,6 +41,10 @@ void DrawBatch2D::clear() {
 void DrawBatch2D::fillPass(Material *mat, const gfx::DepthStencilState *depthStencilState, ccstd::hash_t dsHash, const ccstd::vector<IMacroPatch> *patches) {
     const auto &passes = mat->getPasses();
     if (passes->empty()) return;
+    _material = mat;
+    _depthStencilState = depthStencilState;
+    _dsHash = dsHash;
+    _patched = patches != nullptr;
     _shaders.clear();
     if (_passes.size() < passes->size()) {
         auto num = static_cast<uint32_t>(passes->size() - _passes.size());
@@ -59,5 +63,21 @@ void DrawBatch2D::fillPass(Material *mat, const gfx::DepthStencilState *depthSte
     }
 }
 
+bool DrawBatch2D::isPassReusable(Material *mat, const gfx::DepthStencilState *depthStencilState, ccstd::hash_t dsHash) {
+    if (_material != mat || _depthStencilState != depthStencilState || _dsHash != dsHash || _patched) return false;
+    const auto &passes = mat->getPasses();
+    if (passes->empty() || passes->size() != _shaders.size()) return false;
+
+    bool reusable = true;
+    for (uint32_t i = 0; i < passes->size(); ++i) {
+        auto &pass = passes->at(i);
+        const auto &passInUse = _passes[i];
+        pass->update();
+        // the pass hash covers the pipeline states, the shader is compared as well since it is swapped on recompiles
+        reusable = reusable && passInUse->getHash() == (pass->getHash() ^ dsHash) && passInUse->getDescriptorSet() == pass->getDescriptorSet() && passInUse->getPriority() == pass->getPriority() && passInUse->getPhase() == pass->getPhase() && _shaders[i] != nullptr && _shaders[i] == pass->getShaderVariant();
+    }
+    return reusable;
+}
+
 } // namespace scene
 } // namespace cc
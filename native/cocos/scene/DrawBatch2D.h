@@ -48,6 +48,10 @@ public:
 
     void clear();
     void fillPass(Material *mat, const gfx::DepthStencilState *depthStencilState, ccstd::hash_t dsHash, const ccstd::vector<IMacroPatch> *patches = nullptr);
+    // Whether the passes filled last time are still valid for the given material and depth stencil state,
+    // in which case fillPass can be skipped. Not a pure query: the material passes are updated as fillPass would do.
+    // Patched batches are never reusable, their variant may have been a fallback while compiling.
+    bool isPassReusable(Material *mat, const gfx::DepthStencilState *depthStencilState, ccstd::hash_t dsHash);
 
     inline void setInputAssembler(gfx::InputAssembler *ia) { _inputAssembler = ia; }
     inline void setDescriptorSet(gfx::DescriptorSet *descriptorSet) { _descriptorSet = descriptorSet; }
@@ -70,6 +74,12 @@ protected:
 
     Model *_model{nullptr};
 
+    // weak reference, the source of the filled passes
+    Material *_material{nullptr};
+    const gfx::DepthStencilState *_depthStencilState{nullptr};
+    ccstd::hash_t _dsHash{0};
+    bool _patched{false};
+
     CC_DISALLOW_COPY_MOVE_ASSIGN(DrawBatch2D);
 };
 
@@ -0,0 +1,116 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "scene/LocalUBOArena.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include "base/Utils.h"
+#include "profiler/Profiler.h"
+#include "renderer/gfx-base/GFXBuffer.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/pipeline/Define.h"
+
+namespace cc {
+namespace scene {
+
+LocalUBOArena::LocalUBOArena(gfx::Device *device)
+: _device(device),
+  _stride(utils::alignTo(pipeline::UBOLocal::SIZE, device->getCapabilities().uboOffsetAlignment)) {
+}
+
+LocalUBOArena::~LocalUBOArena() {
+    for (auto &page : _pages) {
+        CC_SAFE_DESTROY_NULL(page.buffer);
+    }
+}
+
+void LocalUBOArena::addPage() {
+    const uint32_t size = _stride * SLOTS_PER_PAGE;
+    auto &page = _pages.emplace_back();
+    page.buffer = _device->createBuffer({gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
+                                         gfx::MemoryUsageBit::DEVICE,
+                                         size,
+                                         _stride});
+    page.data.resize(size);
+    page.freeSlots.resize(SLOTS_PER_PAGE);
+    for (uint32_t i = 0; i < SLOTS_PER_PAGE; ++i) {
+        page.freeSlots[i] = i;
+    }
+}
+
+gfx::Buffer *LocalUBOArena::allocate(uint32_t *slot) {
+    auto iter = std::find_if(_pages.begin(), _pages.end(), [](const Page &page) { return !page.freeSlots.empty(); });
+    if (iter == _pages.end()) {
+        addPage();
+        iter = _pages.end() - 1;
+    }
+
+    auto &freeSlots = iter->freeSlots;
+    std::pop_heap(freeSlots.begin(), freeSlots.end(), std::greater<>());
+    const uint32_t index = freeSlots.back();
+    freeSlots.pop_back();
+
+    const uint32_t offset = index * _stride;
+    memset(iter->data.data() + offset, 0, _stride);
+    *slot = static_cast<uint32_t>(iter - _pages.begin()) * SLOTS_PER_PAGE + index;
+    return _device->createBuffer(gfx::BufferViewInfo{iter->buffer, offset, pipeline::UBOLocal::SIZE});
+}
+
+void LocalUBOArena::free(uint32_t slot) {
+    auto &freeSlots = _pages[slot / SLOTS_PER_PAGE].freeSlots;
+    freeSlots.emplace_back(slot % SLOTS_PER_PAGE);
+    std::push_heap(freeSlots.begin(), freeSlots.end(), std::greater<>());
+}
+
+void LocalUBOArena::markDirty(uint32_t slot) {
+    auto &page = _pages[slot / SLOTS_PER_PAGE];
+    page.dirtyEnd = std::max(page.dirtyEnd, (slot % SLOTS_PER_PAGE + 1) * _stride);
+    ++page.dirtyCount;
+}
+
+void LocalUBOArena::flush() {
+    _dirtySlotCount = 0;
+    _uploadCount = 0;
+    _uploadBytes = 0;
+    for (auto &page : _pages) {
+        if (!page.dirtyCount) {
+            continue;
+        }
+        page.buffer->update(page.data.data(), page.dirtyEnd);
+        _dirtySlotCount += page.dirtyCount;
+        ++_uploadCount;
+        _uploadBytes += page.dirtyEnd;
+        page.dirtyEnd = 0;
+        page.dirtyCount = 0;
+    }
+
+    CC_PROFILE_COUNTER(LocalUBODirtySlots, _dirtySlotCount);
+    CC_PROFILE_COUNTER(LocalUBOUploads, _uploadCount);
+    CC_PROFILE_COUNTER(LocalUBOUploadBytes, _uploadBytes);
+}
+
+} // namespace scene
+} // namespace cc
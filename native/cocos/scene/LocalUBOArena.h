@@ -0,0 +1,98 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/Ptr.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+namespace gfx {
+class Buffer;
+class Device;
+} // namespace gfx
+
+namespace scene {
+
+/**
+ * @en Packs the UBOLocal blocks of all models into a few large uniform buffers.
+ * Every model binds a buffer view of its slot and writes its data into CPU memory,
+ * dirty pages are then uploaded in one transfer each per frame by flush.
+ * @zh 将所有模型的 UBOLocal 打包到少量大的 uniform buffer 中，每帧每页只上传一次。
+ */
+class CC_DLL LocalUBOArena final {
+public:
+    static constexpr uint32_t INVALID_SLOT{0xFFFFFFFF};
+    static constexpr uint32_t SLOTS_PER_PAGE{128};
+
+    explicit LocalUBOArena(gfx::Device *device);
+    ~LocalUBOArena();
+
+    // returns a view of the new slot to be bound at UBOLocal::BINDING
+    gfx::Buffer *allocate(uint32_t *slot);
+    void free(uint32_t slot);
+
+    inline float *getSlotData(uint32_t slot) {
+        auto &page = _pages[slot / SLOTS_PER_PAGE];
+        return reinterpret_cast<float *>(page.data.data() + (slot % SLOTS_PER_PAGE) * _stride);
+    }
+    void markDirty(uint32_t slot);
+
+    // uploads the written slots, called once per frame after the scenes are updated
+    void flush();
+
+    // statistics of the last flush, every dirty slot used to be one buffer update of UBOLocal::SIZE bytes
+    inline uint32_t getDirtySlotCount() const { return _dirtySlotCount; }
+    inline uint32_t getUploadCount() const { return _uploadCount; }
+    inline uint32_t getUploadBytes() const { return _uploadBytes; }
+    inline uint32_t getStride() const { return _stride; }
+
+private:
+    struct Page {
+        IntrusivePtr<gfx::Buffer> buffer;
+        ccstd::vector<uint8_t> data;
+        // min-heap, so live slots stay packed at the front of the page and uploads stay short
+        ccstd::vector<uint32_t> freeSlots;
+        // the upload always starts at the page begin, so only its end is tracked
+        uint32_t dirtyEnd{0};
+        uint32_t dirtyCount{0};
+    };
+
+    void addPage();
+
+    gfx::Device *_device{nullptr};
+    uint32_t _stride{0};
+    ccstd::vector<Page> _pages;
+    uint32_t _dirtySlotCount{0};
+    uint32_t _uploadCount{0};
+    uint32_t _uploadBytes{0};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(LocalUBOArena);
+};
+
+} // namespace scene
+} // namespace cc
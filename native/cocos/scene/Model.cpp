@@ -22,6 +22,7 @@
  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  THE SOFTWARE.
  ****************************************************************************/
+#include <cstring>
 #include "base/std/container/array.h"
 
 // #include "core/Director.h"
@@ -88,6 +89,7 @@ void Model::destroy() {
     _subModels.clear();
 
     CC_SAFE_DESTROY_NULL(_localBuffer);
+    releaseLocalSlot();
     CC_SAFE_DESTROY_NULL(_localSHBuffer);
     CC_SAFE_DESTROY_NULL(_worldBoundBuffer);
 
@@ -185,17 +187,11 @@ void Model::updateUBOs(uint32_t stamp) {
     }
 
     if (hasNonInstancingPass && _localBuffer) {
-        Mat4 mat4;
-        Mat4::inverseTranspose(worldMatrix, &mat4);
-
-        _localBuffer->write(worldMatrix, sizeof(float) * pipeline::UBOLocal::MAT_WORLD_OFFSET);
-        _localBuffer->write(mat4, sizeof(float) * pipeline::UBOLocal::MAT_WORLD_IT_OFFSET);
-        _localBuffer->write(_lightmapUVParam, sizeof(float) * pipeline::UBOLocal::LIGHTINGMAP_UVPARAM);
-        _localBuffer->write(_shadowBias, sizeof(float) * (pipeline::UBOLocal::LOCAL_SHADOW_BIAS));
-
-        _localBuffer->update();
-        const bool enableOcclusionQuery = Root::getInstance()->getPipeline()->isOcclusionQueryEnabled();
-        if (enableOcclusionQuery) {
+        writeLocalBuffer(worldMatrix);
+        uploadLocalBuffer();
+        // no pipeline is set up when models are updated headless, e.g. in tests
+        const auto *pipeline = Root::getInstance()->getPipeline();
+        if (pipeline && pipeline->isOcclusionQueryEnabled()) {
             updateWorldBoundUBOs();
         }
     }
@@ -208,6 +204,59 @@ void Model::updateOctree() {
     }
 }
 
+void Model::updateLocalData() {
+    const Node *node = _transform;
+    CC_ASSERT(!node->getDirtyFlag());
+    if (node->getChangedFlags()) {
+        _localDataUpdated = true;
+        if (_modelBounds != nullptr && _modelBounds->isValid() && _worldBounds != nullptr) {
+            _modelBounds->transform(node->getWorldMatrix(), _worldBounds);
+            _worldBoundsDirty = true;
+        }
+    }
+
+    if (!_localDataUpdated) {
+        return;
+    }
+    _localDataUpdated = false;
+    const auto &worldMatrix = node->getWorldMatrix();
+    bool hasNonInstancingPass = false;
+    for (const auto &subModel : _subModels) {
+        const auto idx = subModel->getInstancedWorldMatrixIndex();
+        if (idx >= 0) {
+            subModel->updateInstancedWorldMatrix(worldMatrix, idx);
+        } else {
+            hasNonInstancingPass = true;
+        }
+    }
+
+    if (hasNonInstancingPass && _localBuffer) {
+        writeLocalBuffer(worldMatrix);
+        _localBufferDirty = true;
+    }
+}
+
+void Model::commitLocalData(uint32_t stamp) {
+    for (SubModel *subModel : _subModels) {
+        subModel->update();
+    }
+    _updateStamp = stamp;
+
+    updateSHUBOs();
+
+    if (_localBufferDirty) {
+        _localBufferDirty = false;
+        uploadLocalBuffer();
+        // no pipeline is set up when models are updated headless, e.g. in tests
+        const auto *pipeline = Root::getInstance()->getPipeline();
+        if (pipeline && pipeline->isOcclusionQueryEnabled()) {
+            updateWorldBoundUBOs();
+        }
+    }
+
+    updateOctree();
+}
+
 void Model::updateWorldBoundUBOs() {
     if (_worldBoundBuffer) {
         const Vec3 &center = _worldBounds ? _worldBounds->getCenter() : Vec3{0.0F, 0.0F, 0.0F};
@@ -424,6 +473,11 @@ void Model::updateInstancedAttributes(const ccstd::vector<gfx::Attribute> &attri
 
 void Model::initLocalDescriptors(index_t /*subModelIndex*/) {
     if (!_localBuffer) {
+        auto *arena = Root::getInstance()->getLocalUBOArena();
+        if (arena) {
+            _localBuffer = arena->allocate(&_localSlot);
+            return;
+        }
         _localBuffer = _device->createBuffer({gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
                                               gfx::MemoryUsageBit::DEVICE,
                                               pipeline::UBOLocal::SIZE,
@@ -432,6 +486,54 @@ void Model::initLocalDescriptors(index_t /*subModelIndex*/) {
     }
 }
 
+void Model::setLocalBuffer(gfx::Buffer *buffer) {
+    if (_localBuffer == buffer) {
+        return;
+    }
+    releaseLocalSlot();
+    _localBuffer = buffer;
+}
+
+void Model::writeLocalBuffer(const Mat4 &worldMatrix) {
+    Mat4 mat4;
+    Mat4::inverseTranspose(worldMatrix, &mat4);
+
+    if (_localSlot != LocalUBOArena::INVALID_SLOT) {
+        float *data = Root::getInstance()->getLocalUBOArena()->getSlotData(_localSlot);
+        memcpy(data + pipeline::UBOLocal::MAT_WORLD_OFFSET, worldMatrix.m, sizeof(Mat4));
+        memcpy(data + pipeline::UBOLocal::MAT_WORLD_IT_OFFSET, mat4.m, sizeof(Mat4));
+        memcpy(data + pipeline::UBOLocal::LIGHTINGMAP_UVPARAM, &_lightmapUVParam, sizeof(Vec4));
+        memcpy(data + pipeline::UBOLocal::LOCAL_SHADOW_BIAS, &_shadowBias, sizeof(Vec4));
+        return;
+    }
+
+    _localBuffer->write(worldMatrix, sizeof(float) * pipeline::UBOLocal::MAT_WORLD_OFFSET);
+    _localBuffer->write(mat4, sizeof(float) * pipeline::UBOLocal::MAT_WORLD_IT_OFFSET);
+    _localBuffer->write(_lightmapUVParam, sizeof(float) * pipeline::UBOLocal::LIGHTINGMAP_UVPARAM);
+    _localBuffer->write(_shadowBias, sizeof(float) * (pipeline::UBOLocal::LOCAL_SHADOW_BIAS));
+}
+
+void Model::uploadLocalBuffer() {
+    if (_localSlot != LocalUBOArena::INVALID_SLOT) {
+        // uploaded together with the other models by LocalUBOArena::flush
+        Root::getInstance()->getLocalUBOArena()->markDirty(_localSlot);
+    } else {
+        _localBuffer->update();
+    }
+}
+
+void Model::releaseLocalSlot() {
+    if (_localSlot == LocalUBOArena::INVALID_SLOT) {
+        return;
+    }
+    // the arena is gone if Root was destroyed first, its pages are released with it
+    auto *root = Root::getInstance();
+    if (root && root->getLocalUBOArena()) {
+        root->getLocalUBOArena()->free(_localSlot);
+    }
+    _localSlot = LocalUBOArena::INVALID_SLOT;
+}
+
 void Model::initLocalSHDescriptors(index_t /*subModelIndex*/) {
 #if !CC_EDITOR
     if (!_useLightProbe) {
@@ -40,6 +40,7 @@
 #include "renderer/gfx-base/GFXBuffer.h"
 #include "renderer/gfx-base/GFXDef-common.h"
 #include "renderer/gfx-base/GFXTexture.h"
+#include "scene/LocalUBOArena.h"
 #include "scene/SubModel.h"
 #include "core/assets/TextureCube.h"
 
@@ -116,6 +117,13 @@ public:
     void updateReflctionProbeCubemap(TextureCube *texture);
     void updateReflctionProbePlanarMap(gfx::Texture *texture);
 
+    // Split form of updateTransform + updateUBOs used by RenderScene to update models in parallel.
+    // updateLocalData only touches this model's bounds and staging memory so it may run on a worker,
+    // the world transform of the node must already be resolved.
+    void updateLocalData();
+    // Uploads what updateLocalData prepared and updates the octree, must run on the main thread.
+    void commitLocalData(uint32_t stamp);
+
     inline void attachToScene(RenderScene *scene) {
         _scene = scene;
         _localDataUpdated = true;
@@ -123,7 +131,7 @@ public:
     inline void detachFromScene() { _scene = nullptr; };
     inline void setCastShadow(bool value) { _castShadow = value; }
     inline void setEnabled(bool value) { _enabled = value; }
-    inline void setLocalBuffer(gfx::Buffer *buffer) { _localBuffer = buffer; }
+    void setLocalBuffer(gfx::Buffer *buffer);
     inline void setLocalSHBuffer(gfx::Buffer *buffer) { _localSHBuffer = buffer; }
     inline void setWorldBoundBuffer(gfx::Buffer *buffer) { _worldBoundBuffer = buffer; }
 
@@ -199,12 +207,16 @@ public:
     }
     inline void setModelBounds(geometry::AABB *bounds) { _modelBounds = bounds; }
     inline bool isModelImplementedInJS() const { return (_type != Type::DEFAULT && _type != Type::SKINNING && _type != Type::BAKED_SKINNING); };
+    inline bool isParallelUpdatable() const { return _type == Type::DEFAULT; }
 
 protected:
     static SubModel *createSubModel();
 
     void updateAttributesAndBinding(index_t subModelIndex);
     bool isLightProbeAvailable() const;
+    void writeLocalBuffer(const Mat4 &worldMatrix);
+    void uploadLocalBuffer();
+    void releaseLocalSlot();
 
     // Please declare variables in descending order of memory size occupied by variables.
     Type _type{Type::DEFAULT};
@@ -213,6 +225,8 @@ protected:
     uint32_t _descriptorSetCount{1};
     uint32_t _priority{0};
     uint32_t _updateStamp{0};
+    // slot of _localBuffer in the LocalUBOArena of Root, or a standalone buffer if invalid
+    uint32_t _localSlot{LocalUBOArena::INVALID_SLOT};
     Float32Array _localSHData;
 
     OctreeNode *_octreeNode{nullptr};
@@ -241,6 +255,7 @@ protected:
     bool _isDynamicBatching{false};
     bool _inited{false};
     bool _localDataUpdated{false};
+    bool _localBufferDirty{false};
     bool _worldBoundsDirty{true};
     // For JS
     bool _isCalledFromJS{false};
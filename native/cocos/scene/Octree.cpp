@@ -24,14 +24,75 @@
  ****************************************************************************/
 
 #include "Octree.h"
-#include <future>
+#include <algorithm>
 #include <utility>
+#include "base/job-system/JobSystem.h"
+#include "core/geometry/AABBSoA.h"
 #include "scene/Camera.h"
 #include "scene/Model.h"
 
 namespace cc {
 namespace scene {
 
+namespace {
+
+struct CullingContext {
+    ccstd::vector<Model *> models;
+    ccstd::vector<uint32_t> masks;
+    ccstd::vector<uint8_t> results;
+    geometry::AABBSoA bounds;
+};
+
+void cullNodeModels(const OctreeNodeModels *begin, const OctreeNodeModels *end, uint32_t visibility,
+                    const OctreeQuery *queries, uint32_t queryCount, ccstd::vector<Model *> *results) {
+    thread_local CullingContext context;
+    context.models.clear();
+    context.masks.clear();
+    context.bounds.clear();
+
+    uint32_t usedMask = 0;
+    for (const auto *entry = begin; entry != end; ++entry) {
+        for (auto *model : *entry->models) {
+            if (!model->isEnabled()) {
+                continue;
+            }
+
+            const Node *node = model->getNode();
+            if ((node && ((visibility & node->getLayer()) == node->getLayer())) ||
+                (visibility & static_cast<uint32_t>(model->getVisFlags()))) {
+                const geometry::AABB *modelWorldBounds = model->getWorldBounds();
+                if (!modelWorldBounds) {
+                    continue;
+                }
+                context.models.push_back(model);
+                context.masks.push_back(entry->queryMask);
+                context.bounds.push(*modelWorldBounds);
+                usedMask |= entry->queryMask;
+            }
+        }
+    }
+
+    const uint32_t count = context.bounds.size();
+    context.results.resize(count);
+    for (uint32_t q = 0; q < queryCount; ++q) {
+        const uint32_t bit = 1U << q;
+        if (!(usedMask & bit)) {
+            continue;
+        }
+
+        geometry::aabbFrustumBatch(context.bounds, *queries[q].frustum, context.results.data());
+        auto &queryResults = results[q];
+        const bool isShadow = queries[q].isShadow;
+        for (uint32_t i = 0; i < count; ++i) {
+            if ((context.masks[i] & bit) && context.results[i] && (!isShadow || context.models[i]->isCastShadow())) {
+                queryResults.push_back(context.models[i]);
+            }
+        }
+    }
+}
+
+} // namespace
+
 void OctreeInfo::setEnabled(bool val) {
     if (_enabled == val) {
         return;
@@ -222,77 +283,31 @@ void OctreeNode::gatherModels(ccstd::vector<Model *> &results) const { // NOLINT
     }
 }
 
-void OctreeNode::doQueryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const {
-    const auto visibility = camera->getVisibility();
-    for (auto *model : _models) {
-        if (!model->isEnabled()) {
-            continue;
-        }
-
-        const Node *node = model->getNode();
-        if ((node && ((visibility & node->getLayer()) == node->getLayer())) ||
-            (visibility & static_cast<uint32_t>(model->getVisFlags()))) {
-            const geometry::AABB *modelWorldBounds = model->getWorldBounds();
-            if (!modelWorldBounds) {
-                continue;
-            }
-
-            if (isShadow) {
-                if (model->isCastShadow() && modelWorldBounds->aabbFrustum(frustum)) {
-                    results.push_back(model);
-                }
-            } else {
-                if (modelWorldBounds->aabbFrustum(frustum)) {
-                    results.push_back(model);
-                }
-            }
-        }
-    }
-}
-
-void OctreeNode::queryVisibilityParallelly(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const {
+uint32_t OctreeNode::gatherVisibleNodes(const OctreeQuery *queries, uint32_t queryCount, uint32_t queryMask, ccstd::vector<OctreeNodeModels> &results) const { // NOLINT(misc-no-recursion)
     geometry::AABB box;
     geometry::AABB::fromPoints(_aabb.min, _aabb.max, &box);
-    if (!box.aabbFrustum(frustum)) {
-        return;
-    }
-
-    ccstd::array<std::future<ccstd::vector<Model *>>, OCTREE_CHILDREN_NUM> futures{};
-    for (auto i = 0; i < OCTREE_CHILDREN_NUM; i++) {
-        if (_children[i]) {
-            futures[i] = std::async(std::launch::async, [=, &frustum] {
-                ccstd::vector<Model *> models;
-                _children[i]->queryVisibilitySequentially(camera, frustum, isShadow, models);
-                return models;
-            });
+    uint32_t mask = 0;
+    for (uint32_t i = 0; i < queryCount; ++i) {
+        if ((queryMask & (1U << i)) && box.aabbFrustum(*queries[i].frustum)) {
+            mask |= 1U << i;
         }
     }
-
-    doQueryVisibility(camera, frustum, isShadow, results);
-
-    for (auto i = 0; i < OCTREE_CHILDREN_NUM; i++) {
-        if (_children[i]) {
-            auto models = futures[i].get();
-            results.insert(results.end(), models.begin(), models.end());
-        }
+    if (!mask) {
+        return 0;
     }
-}
 
-void OctreeNode::queryVisibilitySequentially(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const { // NOLINT(misc-no-recursion)
-    geometry::AABB box;
-    geometry::AABB::fromPoints(_aabb.min, _aabb.max, &box);
-    if (!box.aabbFrustum(frustum)) {
-        return;
+    auto modelCount = static_cast<uint32_t>(_models.size());
+    if (modelCount) {
+        results.push_back({&_models, mask});
     }
 
-    doQueryVisibility(camera, frustum, isShadow, results);
-
     // query recursively.
     for (auto *child : _children) {
         if (child) {
-            child->queryVisibilitySequentially(camera, frustum, isShadow, results);
+            modelCount += child->gatherVisibleNodes(queries, queryCount, mask, results);
         }
     }
+    return modelCount;
 }
 
 /**
@@ -363,9 +378,16 @@ void Octree::resize(const Vec3 &minPos, const Vec3 &maxPos, uint32_t maxDepth) {
 void Octree::insert(Model *model) {
     CC_ASSERT(model);
 
+    auto unbounded = std::find(_unboundedModels.begin(), _unboundedModels.end(), model);
     if (!model->getWorldBounds()) {
+        if (unbounded == _unboundedModels.end()) {
+            _unboundedModels.push_back(model);
+        }
         return;
     }
+    if (unbounded != _unboundedModels.end()) {
+        _unboundedModels.erase(unbounded);
+    }
 
     if (isOutside(model)) {
         CC_LOG_WARNING("Octree insert: model is outside of the scene bounding box, please modify DEFAULT_WORLD_MIN_POS and DEFAULT_WORLD_MAX_POS.");
@@ -382,6 +404,11 @@ void Octree::insert(Model *model) {
 void Octree::remove(Model *model) {
     CC_ASSERT(model);
 
+    auto unbounded = std::find(_unboundedModels.begin(), _unboundedModels.end(), model);
+    if (unbounded != _unboundedModels.end()) {
+        _unboundedModels.erase(unbounded);
+    }
+
     OctreeNode *node = model->getOctreeNode();
     if (node) {
         node->remove(model);
@@ -395,10 +422,61 @@ void Octree::update(Model *model) {
 }
 
 void Octree::queryVisibility(Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const {
-    if (_totalCount > USE_MULTI_THRESHOLD) {
-        _root->queryVisibilityParallelly(camera, frustum, isShadow, results);
-    } else {
-        _root->queryVisibilitySequentially(camera, frustum, isShadow, results);
+    const OctreeQuery query{&frustum, isShadow};
+    queryVisibility(camera->getVisibility(), &query, 1, &results);
+}
+
+void Octree::queryVisibility(uint32_t visibility, const OctreeQuery *queries, uint32_t queryCount, ccstd::vector<Model *> *results) const {
+    CC_ASSERT(queryCount <= OCTREE_MAX_QUERIES);
+    if (!queryCount) {
+        return;
+    }
+
+    ccstd::vector<OctreeNodeModels> nodes;
+    const uint32_t fullMask = queryCount == OCTREE_MAX_QUERIES ? 0xFFFFFFFFU : (1U << queryCount) - 1;
+    const uint32_t modelCount = _root->gatherVisibleNodes(queries, queryCount, fullMask, nodes);
+    if (nodes.empty()) {
+        return;
+    }
+
+    if (_totalCount <= USE_MULTI_THRESHOLD || modelCount <= OCTREE_MODELS_PER_JOB) {
+        cullNodeModels(nodes.data(), nodes.data() + nodes.size(), visibility, queries, queryCount, results);
+        return;
+    }
+
+    // split the visible nodes into ranges of roughly OCTREE_MODELS_PER_JOB models
+    ccstd::vector<uint32_t> ranges{0};
+    uint32_t rangeModels = 0;
+    for (uint32_t i = 0; i < nodes.size(); ++i) {
+        rangeModels += static_cast<uint32_t>(nodes[i].models->size());
+        if (rangeModels >= OCTREE_MODELS_PER_JOB) {
+            ranges.push_back(i + 1);
+            rangeModels = 0;
+        }
+    }
+    if (ranges.back() != nodes.size()) {
+        ranges.push_back(static_cast<uint32_t>(nodes.size()));
+    }
+
+    // results of each range are merged in order, so the output doesn't depend on scheduling
+    const auto rangeCount = static_cast<uint32_t>(ranges.size() - 1);
+    ccstd::vector<ccstd::vector<Model *>> rangeResults(rangeCount * queryCount);
+    auto cullRange = [&](uint32_t index) {
+        cullNodeModels(nodes.data() + ranges[index], nodes.data() + ranges[index + 1], visibility,
+                       queries, queryCount, rangeResults.data() + index * queryCount);
+    };
+
+    JobGraph g(JobSystem::getInstance(), "OctreeCulling");
+    g.createForEachIndexJob(1U, rangeCount, 1U, cullRange);
+    g.run();
+    cullRange(0);
+    g.waitForAll();
+
+    for (uint32_t q = 0; q < queryCount; ++q) {
+        for (uint32_t r = 0; r < rangeCount; ++r) {
+            const auto &models = rangeResults[r * queryCount + q];
+            results[q].insert(results[q].end(), models.begin(), models.end());
+        }
     }
 }
 
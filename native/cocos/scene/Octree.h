@@ -44,6 +44,24 @@ const Vec3 DEFAULT_WORLD_MIN_POS = {-1024.0F, -1024.0F, -1024.0F};
 const Vec3 DEFAULT_WORLD_MAX_POS = {1024.0F, 1024.0F, 1024.0F};
 const float OCTREE_BOX_EXPAND_SIZE = 10.0F;
 constexpr int USE_MULTI_THRESHOLD = 1024; // use parallel culling if greater than this value
+constexpr uint32_t OCTREE_MODELS_PER_JOB = 512; // approximate number of models culled by each job
+constexpr uint32_t OCTREE_MAX_QUERIES = 32; // queries are tracked by a 32-bit mask during traversal
+
+/**
+ * @en A frustum query for Octree::queryVisibility, several queries can share one traversal
+ * @zh 八叉树可见性查询，多个查询可以共享一次遍历
+ */
+struct CC_DLL OctreeQuery final {
+    const geometry::Frustum *frustum{nullptr};
+    // only collect models casting shadow
+    bool isShadow{false};
+};
+
+// models of one octree node which are intersected with some of the queries
+struct OctreeNodeModels final {
+    const ccstd::vector<Model *> *models{nullptr};
+    uint32_t queryMask{0};
+};
 
 class CC_DLL OctreeInfo final : public RefCounted {
 public:
@@ -152,9 +170,7 @@ private:
     void remove(Model *model);
     void onRemoved();
     void gatherModels(ccstd::vector<Model *> &results) const;
-    void doQueryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const;
-    void queryVisibilityParallelly(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const;
-    void queryVisibilitySequentially(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const;
+    uint32_t gatherVisibleNodes(const OctreeQuery *queries, uint32_t queryCount, uint32_t queryMask, ccstd::vector<OctreeNodeModels> &results) const;
 
     Octree *_owner{nullptr};
     OctreeNode *_parent{nullptr};
@@ -221,11 +237,26 @@ public:
     // view frustum culling
     void queryVisibility(Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const;
 
+    /**
+     * @en Run several frustum queries with one traversal of the tree. Models are culled in batches on the job system
+     * when the tree is large, the order of the results is deterministic.
+     * @zh 一次遍历执行多个锥台查询，场景较大时在 job system 上批量剔除，结果顺序是确定的。
+     * @param visibility camera visibility mask
+     * @param queries queries, at most OCTREE_MAX_QUERIES
+     * @param queryCount number of queries
+     * @param results array of queryCount vectors, visible models are appended to results[i] for queries[i]
+     */
+    void queryVisibility(uint32_t visibility, const OctreeQuery *queries, uint32_t queryCount, ccstd::vector<Model *> *results) const;
+
+    // models without world bounds are not in the tree, they are not culled by the queries
+    inline const ccstd::vector<Model *> &getUnboundedModels() const { return _unboundedModels; }
+
 private:
     bool isInside(Model *model) const;
     bool isOutside(Model *model) const;
 
     OctreeNode *_root{nullptr};
+    ccstd::vector<Model *> _unboundedModels;
     uint32_t _maxDepth{DEFAULT_OCTREE_DEPTH};
     uint32_t _totalCount{0};
 
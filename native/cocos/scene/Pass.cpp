@@ -261,6 +261,7 @@ void Pass::update() {
         _rootBufferDirty = false;
     }
     _descriptorSet->update();
+    refreshPendingShader();
 }
 
 pipeline::InstancedBuffer *Pass::getInstancedBuffer(int32_t extraKey) {
@@ -418,27 +419,46 @@ void Pass::resetTextures() {
 }
 
 bool Pass::tryCompile() {
-    if (_root->getPipeline() == nullptr) {
+    return compileShader(false);
+}
+
+bool Pass::compileShader(bool async) {
+    auto *pipeline = _root->getPipeline();
+    if (pipeline == nullptr) {
         return false;
     }
 
     syncBatchingScheme();
-    auto *shader = ProgramLib::getInstance()->getGFXShader(_device, _programName, _defines, _root->getPipeline());
+    // the first compile has no shader to fall back to
+    auto *programLib = ProgramLib::getInstance();
+    async = async && _shader && programLib->isAsyncCompileEnabled();
+    auto *shader = async ? programLib->getGFXShaderAsync(_device, _programName, _defines, pipeline, _shader)
+                         : programLib->getGFXShader(_device, _programName, _defines, pipeline);
     if (!shader) {
         CC_LOG_WARNING("create shader %s failed", _programName.c_str());
         return false;
     }
     _shader = shader;
-    _pipelineLayout = ProgramLib::getInstance()->getTemplateInfo(_programName)->pipelineLayout;
+    _shaderPending = async && programLib->isShaderPending(programLib->getKey(_programName, _defines));
+    _shaderGeneration = programLib->getShaderGeneration();
+    _pipelineLayout = programLib->getTemplateInfo(_programName)->pipelineLayout;
     _hash = Pass::getPassHash(this);
     return true;
 }
 
+void Pass::refreshPendingShader() {
+    // swap in the recompiled variant once ProgramLib compiled it
+    if (_shaderPending && ProgramLib::getInstance()->getShaderGeneration() != _shaderGeneration) {
+        compileShader(true);
+    }
+}
+
 gfx::Shader *Pass::getShaderVariant() {
     return getShaderVariant({});
 }
 
 gfx::Shader *Pass::getShaderVariant(const ccstd::vector<IMacroPatch> &patches) {
+    refreshPendingShader();
     if (!_shader && !tryCompile()) {
         CC_LOG_WARNING("pass resources incomplete");
         return nullptr;
@@ -462,7 +482,11 @@ gfx::Shader *Pass::getShaderVariant(const ccstd::vector<IMacroPatch> &patches) {
         _defines[patch.name] = patch.value;
     }
 
-    auto *shader = ProgramLib::getInstance()->getGFXShader(_device, _programName, _defines, pipeline);
+    // new macro combinations fall back to the unpatched variant while compiling
+    auto *programLib = ProgramLib::getInstance();
+    auto *shader = programLib->isAsyncCompileEnabled()
+                       ? programLib->getGFXShaderAsync(_device, _programName, _defines, pipeline, _shader)
+                       : programLib->getGFXShader(_device, _programName, _defines, pipeline);
 
     for (const auto &patch : patches) {
         auto iter = _defines.find(patch.name);
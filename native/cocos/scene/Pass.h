@@ -246,15 +246,20 @@ public:
 
     /**
      * @en Try to compile the shader and retrieve related resources references.
+     * With async compile enabled a recompile for define overrides keeps the current shader
+     * until [[ProgramLib.update]] compiles the new one.
      * @zh 尝试编译 shader 并获取相关资源引用。
+     * 开启异步编译时，因宏覆盖而重新编译会沿用当前 shader，直到 [[ProgramLib.update]] 编译出新的 shader。
      */
     virtual bool tryCompile();
-    virtual bool tryCompile(const ccstd::optional<MacroRecord> & /*defineOverrides*/) { return Pass::tryCompile(); }
+    virtual bool tryCompile(const ccstd::optional<MacroRecord> & /*defineOverrides*/) { return compileShader(true); }
 
     /**
      * @en Gets the shader variant of the current pass and given macro patches
      * @zh 结合指定的编译宏组合获取当前 Pass 的 Shader Variant
      * @param patches The macro patches
+     * @note With async compile enabled a new combination returns the unpatched shader until
+     * [[ProgramLib.update]] compiles it, see [[ProgramLib.getShaderGeneration]]
      */
     gfx::Shader *getShaderVariant();
     gfx::Shader *getShaderVariant(const ccstd::vector<IMacroPatch> &patches);
@@ -267,6 +272,7 @@ public:
     inline IProgramInfo *getShaderInfo() const { return _shaderInfo; }
     gfx::DescriptorSetLayout *getLocalSetLayout() const;
     inline const ccstd::string &getProgram() const { return _programName; }
+    inline bool isShaderPending() const { return _shaderPending; }
     inline const Record<ccstd::string, IPropertyInfo> &getProperties() const { return _properties; }
     inline const MacroRecord &getDefines() const { return _defines; }
     inline MacroRecord &getDefines() { return _defines; }
@@ -311,6 +317,9 @@ protected:
     void setState(const gfx::BlendState &bs, const gfx::DepthStencilState &dss, const gfx::RasterizerState &rs, gfx::DescriptorSet *ds);
     void doInit(const IPassInfoFull &info, bool copyDefines = false);
     virtual void syncBatchingScheme();
+    // an async compile keeps the current shader until the new variant is compiled, see refreshPendingShader
+    bool compileShader(bool async);
+    void refreshPendingShader();
 
     // internal resources
     IntrusivePtr<gfx::Buffer> _rootBuffer;
@@ -330,6 +339,8 @@ protected:
     MacroRecord _defines;
     Record<ccstd::string, IPropertyInfo> _properties;
     IntrusivePtr<gfx::Shader> _shader;
+    uint32_t _shaderGeneration{0};
+    bool _shaderPending{false};
     gfx::BlendState _blendState{};
     gfx::DepthStencilState _depthStencilState{};
     gfx::RasterizerState _rs{};
@@ -30,8 +30,10 @@
 #include "3d/models/BakedSkinningModel.h"
 #include "3d/models/SkinningModel.h"
 #include "base/Log.h"
+#include "base/job-system/JobSystem.h"
 #include "core/Root.h"
 #include "core/scene-graph/Node.h"
+#include "core/scene-graph/TransformHierarchy.h"
 #include "profiler/Profiler.h"
 #include "renderer/pipeline/PipelineSceneData.h"
 #include "renderer/pipeline/custom/RenderInterfaceTypes.h"
@@ -88,26 +90,109 @@ void RenderScene::setMainLight(DirectionalLight *dl) {
 void RenderScene::update(uint32_t stamp) {
     CC_PROFILE(RenderSceneUpdate);
 
+    // resolve dirty world transforms in one pass before lights and models read them
+    if (_transformHierarchy) {
+        _transformHierarchy->update();
+    }
+
     if (_mainLight) {
         _mainLight->update();
     }
     for (const auto &light : _sphereLights) {
         light->update();
     }
+    updateSpotLights();
+    updateModels(stamp);
+
+    CC_PROFILE_OBJECT_UPDATE(Models, _models.size());
+    CC_PROFILE_OBJECT_UPDATE(Cameras, _cameras.size());
+    CC_PROFILE_OBJECT_UPDATE(DrawBatch2D, _batches.size());
+}
+
+void RenderScene::updateSpotLights() {
+    const auto count = static_cast<uint32_t>(_spotLights.size());
+    if (count <= SPOT_LIGHTS_PER_JOB) {
+        for (const auto &spotLight : _spotLights) {
+            spotLight->update();
+        }
+        return;
+    }
+
+    // nodes outside of the transform hierarchy may still be dirty, resolve them here so the jobs only read nodes
     for (const auto &spotLight : _spotLights) {
-        spotLight->update();
+        Node *node = spotLight->getNode();
+        if (node && node->getDirtyFlag()) {
+            node->updateWorldTransform();
+        }
     }
+
+    const uint32_t jobCount = (count + SPOT_LIGHTS_PER_JOB - 1) / SPOT_LIGHTS_PER_JOB;
+    auto updateJob = [this, count](uint32_t index) {
+        const uint32_t begin = index * SPOT_LIGHTS_PER_JOB;
+        const uint32_t end = std::min(begin + SPOT_LIGHTS_PER_JOB, count);
+        for (uint32_t i = begin; i < end; ++i) {
+            _spotLights[i]->update();
+        }
+    };
+
+    JobGraph g(JobSystem::getInstance(), "RenderSceneSpotLights");
+    g.createForEachIndexJob(1U, jobCount, 1U, updateJob);
+    g.run();
+    updateJob(0);
+    g.waitForAll();
+}
+
+void RenderScene::updateModels(uint32_t stamp) {
+    _parallelModels.clear();
+    _serialModels.clear();
     for (const auto &model : _models) {
-        if (model->isEnabled()) {
-            model->updateTransform(stamp);
-            model->updateUBOs(stamp);
-            model->updateOctree();
+        if (!model->isEnabled()) {
+            continue;
+        }
+        if (model->isParallelUpdatable()) {
+            Node *node = model->getTransform();
+            if (node->getDirtyFlag()) {
+                node->updateWorldTransform();
+            }
+            _parallelModels.emplace_back(model);
+        } else {
+            _serialModels.emplace_back(model);
         }
     }
 
-    CC_PROFILE_OBJECT_UPDATE(Models, _models.size());
-    CC_PROFILE_OBJECT_UPDATE(Cameras, _cameras.size());
-    CC_PROFILE_OBJECT_UPDATE(DrawBatch2D, _batches.size());
+    const auto count = static_cast<uint32_t>(_parallelModels.size());
+    if (count <= MODELS_PER_JOB) {
+        for (Model *model : _parallelModels) {
+            model->updateLocalData();
+        }
+    } else {
+        // bounds, instanced attributes and local UBO staging data are per model, device uploads are left to the commit below
+        const uint32_t jobCount = (count + MODELS_PER_JOB - 1) / MODELS_PER_JOB;
+        auto updateJob = [this, count](uint32_t index) {
+            const uint32_t begin = index * MODELS_PER_JOB;
+            const uint32_t end = std::min(begin + MODELS_PER_JOB, count);
+            for (uint32_t i = begin; i < end; ++i) {
+                _parallelModels[i]->updateLocalData();
+            }
+        };
+
+        JobGraph g(JobSystem::getInstance(), "RenderSceneModels");
+        g.createForEachIndexJob(1U, jobCount, 1U, updateJob);
+        g.run();
+        updateJob(0);
+        g.waitForAll();
+    }
+
+    for (Model *model : _parallelModels) {
+        model->commitLocalData(stamp);
+    }
+
+    // skinning and script implemented models keep their own update path
+    for (Model *model : _serialModels) {
+        model->updateTransform(stamp);
+        model->updateUBOs(stamp);
+        model->updateOctree();
+    }
 }
 
 void RenderScene::destroy() {
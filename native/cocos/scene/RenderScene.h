@@ -34,6 +34,7 @@
 namespace cc {
 
 class Node;
+class TransformHierarchy;
 class SkinningModel;
 class BakedSkinningModel;
 
@@ -111,8 +112,16 @@ public:
     inline Octree *getOctree() const { return _octree; }
     void updateOctree(Model *model);
     inline const ccstd::vector<DrawBatch2D *> &getBatches() const { return _batches; }
+    inline TransformHierarchy *getTransformHierarchy() const { return _transformHierarchy; }
+    inline void setTransformHierarchy(TransformHierarchy *hierarchy) { _transformHierarchy = hierarchy; }
 
 private:
+    static constexpr uint32_t MODELS_PER_JOB{256};
+    static constexpr uint32_t SPOT_LIGHTS_PER_JOB{64};
+
+    void updateSpotLights();
+    void updateModels(uint32_t stamp);
+
     ccstd::string _name;
     uint64_t _modelId{0};
     IntrusivePtr<DirectionalLight> _mainLight;
@@ -124,6 +133,10 @@ private:
     ccstd::vector<IntrusivePtr<SpotLight>> _spotLights;
     ccstd::vector<DrawBatch2D *> _batches;
     Octree *_octree{nullptr};
+    TransformHierarchy *_transformHierarchy{nullptr};
+    // per-frame work set of the parallel model update, kept as flat arrays to be reused across frames
+    ccstd::vector<Model *> _parallelModels;
+    ccstd::vector<Model *> _serialModels;
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(RenderScene);
 };
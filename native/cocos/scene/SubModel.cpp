@@ -28,6 +28,7 @@
 #include "core/platform/Debug.h"
 #include "pipeline/Define.h"
 #include "pipeline/InstancedBuffer.h"
+#include "renderer/core/ProgramLib.h"
 #include "renderer/pipeline/PipelineSceneData.h"
 #include "renderer/pipeline/custom/RenderInterfaceTypes.h"
 #include "renderer/pipeline/forward/ForwardPipeline.h"
@@ -74,6 +75,13 @@ cc::TypedArray getTypedArrayConstructor(const cc::gfx::FormatInfo &info, cc::Arr
     return cc::Float32Array(buffer, byteOffset, length);
 }
 
+namespace {
+// a patched combination still compiling asynchronously resolves to the unpatched shader
+bool isFallbackShader(const gfx::Shader *shader, const gfx::Shader *unpatched, const ccstd::vector<IMacroPatch> &patches) {
+    return shader && shader == unpatched && !patches.empty() && ProgramLib::getInstance()->isAsyncCompileEnabled();
+}
+} // namespace
+
 SubModel::SubModel() {
     _id = generateId();
 }
@@ -90,6 +98,31 @@ void SubModel::update() {
     if (_worldBoundDescriptorSet) {
         _worldBoundDescriptorSet->update();
     }
+
+    if (_fallbackShaders || _fallbackPlanarShaders) {
+        refreshFallbackShaders();
+    }
+}
+
+void SubModel::refreshFallbackShaders() {
+    const auto generation = ProgramLib::getInstance()->getShaderGeneration();
+    if (generation == _shaderGeneration) {
+        return;
+    }
+
+    if (_fallbackPlanarShaders) {
+        _fallbackPlanarShaders = false;
+        if (_planarShader) initPlanarShadowShader();
+        if (_planarInstanceShader) initPlanarShadowInstanceShader();
+    }
+    if (_fallbackShaders) {
+        flushPassInfo();
+        if (_owner && _shaders[0]) {
+            // the instanced attributes were taken from the fallback
+            _owner->updateInstancedAttributes(_shaders[0]->getAttributes(), this);
+        }
+    }
+    _shaderGeneration = generation;
 }
 
 void SubModel::setPasses(const std::shared_ptr<ccstd::vector<IntrusivePtr<Pass>>> &pPasses) {
@@ -150,6 +183,7 @@ void SubModel::initialize(RenderingSubMesh *subMesh, const std::shared_ptr<ccstd
     _subMesh = subMesh;
     _patches = patches;
     _passes = pPasses;
+    _fallbackPlanarShaders = false;
 
     flushPassInfo();
 
@@ -203,6 +237,7 @@ void SubModel::initPlanarShadowShader() {
     Shadows *shadowInfo = pipeline->getPipelineSceneData()->getShadows();
     if (shadowInfo != nullptr) {
         _planarShader = shadowInfo->getPlanarShader(_patches);
+        _fallbackPlanarShaders = _fallbackPlanarShaders || isFallbackShader(_planarShader, shadowInfo->getPlanarShader({}), _patches);
     } else {
         _planarShader = nullptr;
     }
@@ -216,6 +251,7 @@ void SubModel::initPlanarShadowInstanceShader() {
     Shadows *shadowInfo = pipeline->getPipelineSceneData()->getShadows();
     if (shadowInfo != nullptr) {
         _planarInstanceShader = shadowInfo->getPlanarInstanceShader(_patches);
+        _fallbackPlanarShaders = _fallbackPlanarShaders || isFallbackShader(_planarInstanceShader, shadowInfo->getPlanarInstanceShader({}), _patches);
     } else {
         _planarInstanceShader = nullptr;
     }
@@ -341,8 +377,10 @@ void SubModel::flushPassInfo() {
         _shaders.clear();
     }
     _shaders.resize(passes.size());
+    _fallbackShaders = false;
     for (size_t i = 0; i < passes.size(); ++i) {
         _shaders[i] = passes[i]->getShaderVariant(_patches);
+        _fallbackShaders = _fallbackShaders || passes[i]->isShaderPending() || isFallbackShader(_shaders[i], passes[i]->getShaderVariant(), _patches);
     }
 }
 
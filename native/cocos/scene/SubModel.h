@@ -94,6 +94,7 @@ public:
 
 protected:
     void flushPassInfo();
+    void refreshFallbackShaders();
 
     pipeline::RenderPriority _priority{pipeline::RenderPriority::DEFAULT};
 
@@ -119,6 +120,11 @@ protected:
     
     std::shared_ptr<ccstd::vector<IntrusivePtr<Pass>>> _passes;
 
+    // set while a shader is the unpatched fallback of a variant still compiling
+    uint32_t _shaderGeneration{0};
+    bool _fallbackShaders{false};
+    bool _fallbackPlanarShaders{false};
+
 private:
     static inline int32_t generateId() {
         static int32_t generator = 0;
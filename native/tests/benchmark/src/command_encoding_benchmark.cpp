@@ -0,0 +1,227 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include "base/job-system/job-system-native/NativeJobGraph.h"
+#include "base/job-system/job-system-native/NativeJobSystem.h"
+#include "benchmark/benchmark.h"
+#include "cocos/base/std/container/vector.h"
+#include "cocos/renderer/gfx-base/GFXDevice.h"
+
+namespace {
+
+using namespace cc::gfx;
+
+// everything a forward draw binds: render pass, pipeline state, descriptor set and input assembler
+struct EncodingScene {
+    EncodingScene() {
+        device = Device::getInstance();
+
+        RenderPassInfo renderPassInfo;
+        renderPassInfo.colorAttachments.emplace_back();
+        renderPassInfo.colorAttachments.back().format = Format::RGBA8;
+        renderPassInfo.depthStencilAttachment.format = Format::DEPTH_STENCIL;
+        renderPass = device->createRenderPass(renderPassInfo);
+
+        colorTexture = device->createTexture({TextureType::TEX2D, TextureUsageBit::COLOR_ATTACHMENT, Format::RGBA8, 64, 64});
+        depthTexture = device->createTexture({TextureType::TEX2D, TextureUsageBit::DEPTH_STENCIL_ATTACHMENT, Format::DEPTH_STENCIL, 64, 64});
+        framebuffer = device->createFramebuffer({renderPass, {colorTexture}, depthTexture});
+
+        dsLayout = device->createDescriptorSetLayout({});
+        pipelineLayout = device->createPipelineLayout({{dsLayout}});
+        descriptorSet = device->createDescriptorSet({dsLayout});
+
+        ShaderInfo shaderInfo;
+        shaderInfo.name = "benchmark|command-encoding";
+        shader = device->createShader(shaderInfo);
+
+        vertexBuffer = device->createBuffer({BufferUsageBit::VERTEX, MemoryUsageBit::DEVICE, 4 * 12, 12});
+        indexBuffer = device->createBuffer({BufferUsageBit::INDEX, MemoryUsageBit::DEVICE, 6 * 2, 2});
+        uniformBuffer = device->createBuffer({BufferUsageBit::UNIFORM | BufferUsageBit::TRANSFER_DST, MemoryUsageBit::DEVICE, 64, 64});
+        InputAssemblerInfo iaInfo;
+        iaInfo.attributes.push_back({ATTR_NAME_POSITION, Format::RGB32F});
+        iaInfo.vertexBuffers.push_back(vertexBuffer);
+        iaInfo.indexBuffer = indexBuffer;
+        inputAssembler = device->createInputAssembler(iaInfo);
+
+        PipelineStateInfo psoInfo;
+        psoInfo.shader = shader;
+        psoInfo.pipelineLayout = pipelineLayout;
+        psoInfo.renderPass = renderPass;
+        psoInfo.inputState.attributes = iaInfo.attributes;
+        pipelineState = device->createPipelineState(psoInfo);
+    }
+
+    ~EncodingScene() {
+        CC_SAFE_DESTROY_AND_DELETE(pipelineState);
+        CC_SAFE_DESTROY_AND_DELETE(inputAssembler);
+        CC_SAFE_DESTROY_AND_DELETE(uniformBuffer);
+        CC_SAFE_DESTROY_AND_DELETE(indexBuffer);
+        CC_SAFE_DESTROY_AND_DELETE(vertexBuffer);
+        CC_SAFE_DESTROY_AND_DELETE(shader);
+        CC_SAFE_DESTROY_AND_DELETE(descriptorSet);
+        CC_SAFE_DESTROY_AND_DELETE(pipelineLayout);
+        CC_SAFE_DESTROY_AND_DELETE(dsLayout);
+        CC_SAFE_DESTROY_AND_DELETE(framebuffer);
+        CC_SAFE_DESTROY_AND_DELETE(depthTexture);
+        CC_SAFE_DESTROY_AND_DELETE(colorTexture);
+        CC_SAFE_DESTROY_AND_DELETE(renderPass);
+    }
+
+    // one frame of drawCount draws, flushed, submitted and presented
+    void recordFrame(uint32_t drawCount) {
+        auto *cmdBuff = device->getCommandBuffer();
+        const Rect renderArea{0, 0, 64, 64};
+        const Color clearColor{0.0F, 0.0F, 0.0F, 1.0F};
+
+        device->acquire(nullptr, 0);
+        cmdBuff->begin();
+        cmdBuff->updateBuffer(uniformBuffer, uniformData, sizeof(uniformData));
+        cmdBuff->beginRenderPass(renderPass, framebuffer, renderArea, &clearColor, 1.0F, 0);
+        recordDraws(cmdBuff, drawCount);
+        cmdBuff->endRenderPass();
+        cmdBuff->end();
+        device->flushCommands(&cmdBuff, 1);
+        device->getQueue()->submit(&cmdBuff, 1);
+        device->present();
+    }
+
+    void recordDraws(CommandBuffer *cmdBuff, uint32_t drawCount) const {
+        DrawInfo drawInfo;
+        drawInfo.indexCount = 6;
+        for (uint32_t i = 0; i < drawCount; ++i) {
+            cmdBuff->bindPipelineState(pipelineState);
+            cmdBuff->bindDescriptorSet(0, descriptorSet);
+            cmdBuff->bindInputAssembler(inputAssembler);
+            cmdBuff->draw(drawInfo);
+        }
+    }
+
+    Device *device{nullptr};
+    RenderPass *renderPass{nullptr};
+    Texture *colorTexture{nullptr};
+    Texture *depthTexture{nullptr};
+    Framebuffer *framebuffer{nullptr};
+    DescriptorSetLayout *dsLayout{nullptr};
+    PipelineLayout *pipelineLayout{nullptr};
+    DescriptorSet *descriptorSet{nullptr};
+    Shader *shader{nullptr};
+    Buffer *vertexBuffer{nullptr};
+    Buffer *indexBuffer{nullptr};
+    Buffer *uniformBuffer{nullptr};
+    InputAssembler *inputAssembler{nullptr};
+    PipelineState *pipelineState{nullptr};
+    float uniformData[16]{};
+};
+
+// the draws of a frame split across secondary command buffers, each recorded by a different job
+struct ParallelEncodingScene : EncodingScene {
+    explicit ParallelEncodingScene(uint32_t streamCount) {
+        for (uint32_t i = 0; i < streamCount; ++i) {
+            secondaryCmdBuffs.push_back(device->createCommandBuffer({device->getQueue(), CommandBufferType::SECONDARY}));
+        }
+    }
+
+    ~ParallelEncodingScene() {
+        for (auto *cmdBuff : secondaryCmdBuffs) {
+            CC_SAFE_DESTROY_AND_DELETE(cmdBuff);
+        }
+    }
+
+    void recordStreams(cc::NativeJobSystem *system, uint32_t drawCount) {
+        const auto streamCount = static_cast<uint32_t>(secondaryCmdBuffs.size());
+        cc::NativeJobGraph g(system);
+        g.createForEachIndexJob(0U, streamCount, 1U, [this, drawCount, streamCount](uint32_t i) {
+            const uint32_t first = drawCount * i / streamCount;
+            const uint32_t last = drawCount * (i + 1) / streamCount;
+            CommandBuffer *cmdBuff = secondaryCmdBuffs[i];
+            cmdBuff->begin(renderPass, 0, framebuffer);
+            recordDraws(cmdBuff, last - first);
+            cmdBuff->end();
+        });
+        g.run();
+        g.waitForAll();
+    }
+
+    void executeStreams() {
+        auto *cmdBuff = device->getCommandBuffer();
+        const Rect renderArea{0, 0, 64, 64};
+        const Color clearColor{0.0F, 0.0F, 0.0F, 1.0F};
+
+        device->acquire(nullptr, 0);
+        cmdBuff->begin();
+        cmdBuff->updateBuffer(uniformBuffer, uniformData, sizeof(uniformData));
+        const auto streamCount = static_cast<uint32_t>(secondaryCmdBuffs.size());
+        cmdBuff->beginRenderPass(renderPass, framebuffer, renderArea, &clearColor, 1.0F, 0, secondaryCmdBuffs.data(), streamCount);
+        cmdBuff->execute(secondaryCmdBuffs.data(), streamCount);
+        cmdBuff->endRenderPass();
+        cmdBuff->end();
+        device->flushCommands(&cmdBuff, 1);
+        device->getQueue()->submit(&cmdBuff, 1);
+        device->present();
+    }
+
+    CommandBufferList secondaryCmdBuffs;
+};
+
+// recording streams from 1 to the number of hardware threads
+void streamCounts(benchmark::internal::Benchmark *b) {
+    const uint32_t maxThreads = std::max(1U, std::thread::hardware_concurrency());
+    for (uint32_t threads = 1; threads < maxThreads; threads *= 2) {
+        b->Arg(threads);
+    }
+    b->Arg(maxThreads);
+}
+
+} // namespace
+
+// with the device agent this is the main thread encoding into the message queues plus the wait on the device thread
+static void BM_CommandEncodingFrame(benchmark::State &state) {
+    EncodingScene scene;
+    const auto drawCount = static_cast<uint32_t>(state.range(0));
+    for (auto _ : state) {
+        scene.recordFrame(drawCount);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_CommandEncodingFrame)->Arg(100)->Arg(1000)->Arg(10000)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// only the recording is timed, the replay on the device thread overlaps with the next frame
+static void BM_CommandEncodingParallel(benchmark::State &state) {
+    constexpr uint32_t DRAW_COUNT = 10000;
+    const auto streamCount = static_cast<uint32_t>(state.range(0));
+    ParallelEncodingScene scene(streamCount);
+    // the calling thread helps in waitForAll, so one worker less gives streamCount recording threads
+    cc::NativeJobSystem system(std::max(1U, streamCount - 1));
+    for (auto _ : state) {
+        scene.recordStreams(&system, DRAW_COUNT);
+        state.PauseTiming();
+        scene.executeStreams();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * DRAW_COUNT);
+}
+BENCHMARK(BM_CommandEncodingParallel)->Apply(streamCounts)->UseRealTime()->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,125 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <cstdint>
+#include "benchmark/benchmark.h"
+#include "cocos/base/Data.h"
+#include "cocos/base/std/container/string.h"
+#include "cocos/base/std/container/vector.h"
+#include "cocos/platform/FilePack.h"
+#include "cocos/platform/FileUtils.h"
+
+namespace {
+
+constexpr uint32_t FILE_COUNT = 64;
+
+// FILE_COUNT assets of the given size as loose files and as one pack
+struct FileScene {
+    explicit FileScene(size_t fileSize) {
+        auto *fileUtils = cc::FileUtils::getInstance();
+        directory = fileUtils->getWritablePath() + "file-view-benchmark/";
+        fileUtils->removeDirectory(directory);
+        fileUtils->createDirectory(directory);
+
+        ccstd::vector<cc::FilePack::Source> sources;
+        for (uint32_t i = 0; i < FILE_COUNT; ++i) {
+            cc::Data data;
+            auto *bytes = static_cast<unsigned char *>(malloc(fileSize));
+            for (size_t j = 0; j < fileSize; ++j) {
+                bytes[j] = static_cast<unsigned char>((i * 31 + j * 7) & 0xff);
+            }
+            data.fastSet(bytes, static_cast<uint32_t>(fileSize));
+
+            ccstd::string name = "asset" + std::to_string(i) + ".bin";
+            paths.push_back(directory + name);
+            names.push_back(name);
+            fileUtils->writeDataToFile(data, paths.back());
+            sources.push_back({name, cc::FileView::fromData(std::move(data)), false});
+        }
+        packPath = directory + "assets.ccpk";
+        cc::FilePack::write(packPath, sources);
+    }
+
+    ~FileScene() {
+        cc::FileUtils::getInstance()->removeDirectory(directory);
+    }
+
+    ccstd::string directory;
+    ccstd::string packPath;
+    ccstd::vector<ccstd::string> paths;
+    ccstd::vector<ccstd::string> names;
+};
+
+uint64_t touch(const uint8_t *bytes, size_t size) {
+    // consumers read the contents once, e.g. decoders
+    uint64_t sum = 0;
+    for (size_t i = 0; i < size; i += 64) {
+        sum += bytes[i];
+    }
+    return sum;
+}
+
+} // namespace
+
+// every load reads into a fresh heap buffer
+static void BM_FileReadData(benchmark::State &state) {
+    FileScene scene(static_cast<size_t>(state.range(0)));
+    auto *fileUtils = cc::FileUtils::getInstance();
+    for (auto _ : state) {
+        for (const auto &path : scene.paths) {
+            cc::Data data = fileUtils->getDataFromFile(path);
+            benchmark::DoNotOptimize(touch(data.getBytes(), data.getSize()));
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * FILE_COUNT * state.range(0));
+}
+BENCHMARK(BM_FileReadData)->Arg(4 << 10)->Arg(1 << 20)->Unit(benchmark::kMicrosecond);
+
+// every load maps the file
+static void BM_FileMapView(benchmark::State &state) {
+    FileScene scene(static_cast<size_t>(state.range(0)));
+    auto *fileUtils = cc::FileUtils::getInstance();
+    for (auto _ : state) {
+        for (const auto &path : scene.paths) {
+            cc::FileView view = fileUtils->getFileView(path);
+            benchmark::DoNotOptimize(touch(view.data(), view.size()));
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * FILE_COUNT * state.range(0));
+}
+BENCHMARK(BM_FileMapView)->Arg(4 << 10)->Arg(1 << 20)->Unit(benchmark::kMicrosecond);
+
+// the pack is mapped once, loads are index lookups
+static void BM_FilePackView(benchmark::State &state) {
+    FileScene scene(static_cast<size_t>(state.range(0)));
+    auto pack = cc::FilePack::open(scene.packPath);
+    for (auto _ : state) {
+        for (const auto &name : scene.names) {
+            cc::FileView view = pack->getView(name);
+            benchmark::DoNotOptimize(touch(view.data(), view.size()));
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * FILE_COUNT * state.range(0));
+}
+BENCHMARK(BM_FilePackView)->Arg(4 << 10)->Arg(1 << 20)->Unit(benchmark::kMicrosecond);
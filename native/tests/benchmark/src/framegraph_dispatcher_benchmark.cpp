@@ -0,0 +1,69 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "benchmark/benchmark.h"
+#include "cocos/renderer/pipeline/custom/FGDispatcherGraphs.h"
+#include "cocos/renderer/pipeline/custom/test/test.h"
+
+namespace {
+
+// builds the render graph of a unit test case once, then times barrier and culling analysis
+void runDispatcher(benchmark::State &state, const cc::render::ViewInfo &rasterData, const cc::render::ResourceInfo &resources, const cc::render::LayoutInfo &layoutInfo) {
+    using namespace cc::render;
+    boost::container::pmr::memory_resource *resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+    fillTestGraph(rasterData, resources, layoutInfo, renderGraph, rescGraph, layoutGraphData);
+
+    for (auto _ : state) {
+        FrameGraphDispatcher fgDispatcher(rescGraph, renderGraph, layoutGraphData, resource, resource);
+        fgDispatcher.run();
+        benchmark::DoNotOptimize(fgDispatcher.getBarriers().size());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(num_vertices(renderGraph)));
+}
+
+} // namespace
+
+// a few raster passes
+static void BM_FrameGraphDispatcherSimple(benchmark::State &state) {
+    TEST_CASE_1;
+    runDispatcher(state, rasterData, resources, layoutInfo);
+}
+BENCHMARK(BM_FrameGraphDispatcherSimple)->Unit(benchmark::kMicrosecond);
+
+// raster, compute and copy passes with subpasses
+static void BM_FrameGraphDispatcherComplicated(benchmark::State &state) {
+    TEST_CASE_3;
+    runDispatcher(state, rasterData, resources, layoutInfo);
+}
+BENCHMARK(BM_FrameGraphDispatcherComplicated)->Unit(benchmark::kMicrosecond);
+
+// pass culling with leaf and external resources
+static void BM_FrameGraphDispatcherCulling(benchmark::State &state) {
+    TEST_CASE_4;
+    runDispatcher(state, rasterData, resources, layoutInfo);
+}
+BENCHMARK(BM_FrameGraphDispatcherCulling)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,130 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <cstdint>
+#include <cstdlib>
+#include "benchmark/benchmark.h"
+#include "cocos/base/std/container/string.h"
+#include "cocos/base/std/container/vector.h"
+#include "cocos/platform/FileUtils.h"
+#include "cocos/platform/Image.h"
+#include "cocos/platform/ImageDecoder.h"
+
+namespace {
+
+constexpr uint32_t IMAGE_COUNT = 128;
+constexpr int IMAGE_SIZE = 256;
+
+// IMAGE_COUNT RGB PNGs, like the opaque textures of a level
+struct ImageScene {
+    ImageScene() {
+        auto *fileUtils = cc::FileUtils::getInstance();
+        directory = fileUtils->getWritablePath() + "image-decode-benchmark/";
+        fileUtils->removeDirectory(directory);
+        fileUtils->createDirectory(directory);
+
+        ccstd::vector<uint8_t> pixels(IMAGE_SIZE * IMAGE_SIZE * 4);
+        for (uint32_t i = 0; i < IMAGE_COUNT; ++i) {
+            for (size_t j = 0; j < pixels.size(); ++j) {
+                // gradients with some noise, compresses like real textures
+                pixels[j] = static_cast<uint8_t>((j / 4 % IMAGE_SIZE + i * 13 + (rand() & 15)) & 0xff);
+            }
+            cc::IntrusivePtr<cc::Image> image = ccnew cc::Image();
+            image->initWithRawData(pixels.data(), static_cast<uint32_t>(pixels.size()), IMAGE_SIZE, IMAGE_SIZE, 8);
+            paths.push_back(directory + "image" + std::to_string(i) + ".png");
+            image->saveToFile(paths.back(), true);
+        }
+    }
+
+    ~ImageScene() {
+        cc::FileUtils::getInstance()->removeDirectory(directory);
+    }
+
+    ccstd::string directory;
+    ccstd::vector<ccstd::string> paths;
+};
+
+} // namespace
+
+// one image after another, RGB8 expanded to RGBA8 in a second pass as before
+static void BM_ImageDecodeSerialTwoPass(benchmark::State &state) {
+    ImageScene scene;
+    for (auto _ : state) {
+        for (const auto &path : scene.paths) {
+            cc::IntrusivePtr<cc::Image> image = ccnew cc::Image();
+            image->initWithImageFile(path);
+            const auto pixelCount = static_cast<size_t>(image->getWidth()) * image->getHeight();
+            auto *rgba = static_cast<uint8_t *>(malloc(pixelCount * 4));
+            const uint8_t *src = image->getData();
+            for (size_t i = 0; i < pixelCount; ++i, src += 3) {
+                rgba[i * 4] = src[0];
+                rgba[i * 4 + 1] = src[1];
+                rgba[i * 4 + 2] = src[2];
+                rgba[i * 4 + 3] = 255;
+            }
+            benchmark::DoNotOptimize(rgba);
+            free(rgba);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * IMAGE_COUNT);
+}
+BENCHMARK(BM_ImageDecodeSerialTwoPass)->Unit(benchmark::kMillisecond);
+
+// one image after another, expanded while decoding
+static void BM_ImageDecodeSerial(benchmark::State &state) {
+    ImageScene scene;
+    for (auto _ : state) {
+        for (const auto &path : scene.paths) {
+            cc::IntrusivePtr<cc::Image> image = ccnew cc::Image();
+            image->setDecodeOptions({true, false});
+            image->initWithImageFile(path);
+            benchmark::DoNotOptimize(image->getData());
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * IMAGE_COUNT);
+}
+BENCHMARK(BM_ImageDecodeSerial)->Unit(benchmark::kMillisecond);
+
+// all images through the decoder with the given thread count, delivered like a frame would
+static void BM_ImageDecodeParallel(benchmark::State &state) {
+    ImageScene scene;
+    cc::ImageDecoder decoder(static_cast<uint32_t>(state.range(0)));
+    uint32_t delivered = 0;
+    for (auto _ : state) {
+        for (const auto &path : scene.paths) {
+            cc::ImageDecoder::Request request;
+            request.path = path;
+            request.options.expandToRGBA = true;
+            request.callback = [&delivered](const cc::IntrusivePtr<cc::Image> &image) {
+                delivered += image ? 1 : 0;
+            };
+            decoder.push(std::move(request));
+        }
+        decoder.waitForAll();
+        decoder.flush();
+    }
+    benchmark::DoNotOptimize(delivered);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * IMAGE_COUNT);
+}
+BENCHMARK(BM_ImageDecodeParallel)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
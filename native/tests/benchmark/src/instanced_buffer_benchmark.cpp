@@ -0,0 +1,103 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <cstdint>
+#include "benchmark/benchmark.h"
+#include "cocos/base/Ptr.h"
+#include "cocos/base/memory/Memory.h"
+#include "cocos/base/std/container/vector.h"
+#include "cocos/renderer/gfx-base/GFXDevice.h"
+#include "cocos/renderer/pipeline/InstancedBuffer.h"
+#include "cocos/scene/SubModel.h"
+
+namespace {
+
+constexpr uint32_t INSTANCE_STRIDE = 48; // three vec4 rows of a world matrix
+
+// sub models sharing meshCount index buffers, as the instanced queue merges them every frame
+struct InstancingScene {
+    InstancingScene(uint32_t count, uint32_t meshCount) {
+        auto *device = cc::gfx::Device::getInstance();
+        dsLayout = device->createDescriptorSetLayout({});
+        descriptorSet = device->createDescriptorSet({dsLayout});
+
+        for (uint32_t m = 0; m < meshCount; ++m) {
+            auto *vb = device->createBuffer({cc::gfx::BufferUsageBit::VERTEX, cc::gfx::MemoryUsageBit::DEVICE, 4 * 12, 12});
+            auto *ib = device->createBuffer({cc::gfx::BufferUsageBit::INDEX, cc::gfx::MemoryUsageBit::DEVICE, 6 * 2, 2});
+            cc::gfx::InputAssemblerInfo iaInfo;
+            iaInfo.attributes.push_back({cc::gfx::ATTR_NAME_POSITION, cc::gfx::Format::RGB32F});
+            iaInfo.vertexBuffers.push_back(vb);
+            iaInfo.indexBuffer = ib;
+            buffers.emplace_back(vb);
+            buffers.emplace_back(ib);
+            inputAssemblers.emplace_back(device->createInputAssembler(iaInfo));
+        }
+
+        for (uint32_t i = 0; i < count; ++i) {
+            cc::IntrusivePtr<cc::scene::SubModel> subModel = ccnew cc::scene::SubModel();
+            subModel->setInputAssembler(inputAssemblers[i % meshCount]);
+            subModel->setDescriptorSet(descriptorSet);
+            auto &block = subModel->getInstancedAttributeBlock();
+            block.buffer = cc::Uint8Array(INSTANCE_STRIDE);
+            block.attributes.push_back({"a_matWorld0", cc::gfx::Format::RGBA32F});
+            block.attributes.push_back({"a_matWorld1", cc::gfx::Format::RGBA32F});
+            block.attributes.push_back({"a_matWorld2", cc::gfx::Format::RGBA32F});
+            subModels.push_back(subModel);
+        }
+    }
+
+    ~InstancingScene() {
+        subModels.clear();
+        inputAssemblers.clear();
+        buffers.clear();
+        descriptorSet = nullptr;
+        dsLayout = nullptr;
+    }
+
+    cc::IntrusivePtr<cc::gfx::DescriptorSetLayout> dsLayout;
+    cc::IntrusivePtr<cc::gfx::DescriptorSet> descriptorSet;
+    ccstd::vector<cc::IntrusivePtr<cc::gfx::Buffer>> buffers;
+    ccstd::vector<cc::IntrusivePtr<cc::gfx::InputAssembler>> inputAssemblers;
+    ccstd::vector<cc::IntrusivePtr<cc::scene::SubModel>> subModels;
+};
+
+} // namespace
+
+// merge every sub model and upload the instance data, as RenderInstancedQueue does per frame
+static void BM_InstancedBufferMerge(benchmark::State &state) {
+    InstancingScene scene(static_cast<uint32_t>(state.range(0)), static_cast<uint32_t>(state.range(1)));
+    cc::IntrusivePtr<cc::pipeline::InstancedBuffer> buffer = ccnew cc::pipeline::InstancedBuffer(nullptr);
+    auto *cmdBuff = cc::gfx::Device::getInstance()->getCommandBuffer();
+    for (auto _ : state) {
+        buffer->clear();
+        for (const auto &subModel : scene.subModels) {
+            buffer->merge(subModel, 0);
+        }
+        buffer->uploadBuffers(cmdBuff);
+        benchmark::DoNotOptimize(buffer->getInstances().data());
+    }
+    buffer->destroy();
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_InstancedBufferMerge)->Args({1000, 1})->Args({1000, 16})->Args({10000, 16})->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,110 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include "base/job-system/job-system-native/NativeJobGraph.h"
+#include "base/job-system/job-system-native/NativeJobSystem.h"
+#include "benchmark/benchmark.h"
+#include "cocos/base/std/container/vector.h"
+
+namespace {
+
+constexpr uint32_t ITEM_COUNT = 1U << 16;
+
+// worker counts from 1 to the number of hardware threads, the calling thread helps in waitForAll
+void threadCounts(benchmark::internal::Benchmark *b) {
+    const uint32_t maxThreads = std::max(1U, std::thread::hardware_concurrency());
+    for (uint32_t threads = 1; threads < maxThreads; threads *= 2) {
+        b->Arg(threads);
+    }
+    b->Arg(maxThreads);
+}
+
+// a few hundred nanoseconds of arithmetic, uneven across items
+inline float work(uint32_t i) {
+    float value = static_cast<float>(i);
+    const uint32_t rounds = 16 + (i & 31U);
+    for (uint32_t r = 0; r < rounds; ++r) {
+        value = std::sqrt(value * 1.0001F + 1.0F);
+    }
+    return value;
+}
+
+} // namespace
+
+static void BM_NativeJobParallelFor(benchmark::State &state) {
+    cc::NativeJobSystem system(static_cast<uint32_t>(state.range(0)));
+    ccstd::vector<float> results(ITEM_COUNT);
+    for (auto _ : state) {
+        cc::NativeJobGraph g(&system);
+        g.createForEachIndexJob(0U, ITEM_COUNT, 1U, [&results](uint32_t i) { results[i] = work(i); });
+        g.run();
+        g.waitForAll();
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * ITEM_COUNT);
+    state.counters["steals"] = benchmark::Counter(static_cast<double>(system.getStealCount()), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_NativeJobParallelFor)->Apply(threadCounts)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// many small jobs joined by one continuation, dominated by scheduling overhead
+static void BM_NativeJobFanOut(benchmark::State &state) {
+    constexpr uint32_t JOB_COUNT = 256;
+    constexpr uint32_t ITEMS_PER_JOB = ITEM_COUNT / JOB_COUNT;
+    cc::NativeJobSystem system(static_cast<uint32_t>(state.range(0)));
+    ccstd::vector<float> results(ITEM_COUNT);
+    std::atomic<uint32_t> joined{0};
+    for (auto _ : state) {
+        cc::NativeJobGraph g(&system);
+        const uint32_t join = g.createJob([&joined]() { joined.fetch_add(1, std::memory_order_relaxed); });
+        for (uint32_t j = 0; j < JOB_COUNT; ++j) {
+            const uint32_t job = g.createJob([&results, j]() {
+                for (uint32_t i = j * ITEMS_PER_JOB; i < (j + 1) * ITEMS_PER_JOB; ++i) {
+                    results[i] = work(i);
+                }
+            });
+            g.makeEdge(job, join);
+        }
+        g.run();
+        g.waitForAll();
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * ITEM_COUNT);
+}
+BENCHMARK(BM_NativeJobFanOut)->Apply(threadCounts)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+static void BM_NativeJobSerial(benchmark::State &state) {
+    ccstd::vector<float> results(ITEM_COUNT);
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < ITEM_COUNT; ++i) {
+            results[i] = work(i);
+        }
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * ITEM_COUNT);
+}
+BENCHMARK(BM_NativeJobSerial)->Unit(benchmark::kMicrosecond);
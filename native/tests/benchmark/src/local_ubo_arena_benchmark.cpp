@@ -0,0 +1,93 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <cstdint>
+#include "benchmark/benchmark.h"
+#include "cocos/base/Ptr.h"
+#include "cocos/base/std/container/vector.h"
+#include "cocos/math/Mat4.h"
+#include "cocos/renderer/gfx-base/GFXBuffer.h"
+#include "cocos/renderer/gfx-base/GFXDevice.h"
+#include "cocos/renderer/pipeline/Define.h"
+#include "cocos/scene/LocalUBOArena.h"
+
+namespace {
+
+constexpr uint32_t MODEL_COUNT = 4096;
+
+} // namespace
+
+// one standalone UBOLocal buffer per model, every moved model issues its own buffer update
+static void BM_LocalUBOPerModel(benchmark::State &state) {
+    auto *device = cc::gfx::Device::getInstance();
+    const auto movedCount = static_cast<uint32_t>(state.range(0));
+    const cc::Mat4 worldMatrix;
+    ccstd::vector<cc::IntrusivePtr<cc::gfx::Buffer>> buffers;
+    for (uint32_t i = 0; i < MODEL_COUNT; ++i) {
+        buffers.emplace_back(device->createBuffer({cc::gfx::BufferUsageBit::UNIFORM | cc::gfx::BufferUsageBit::TRANSFER_DST,
+                                                   cc::gfx::MemoryUsageBit::DEVICE,
+                                                   cc::pipeline::UBOLocal::SIZE,
+                                                   cc::pipeline::UBOLocal::SIZE,
+                                                   cc::gfx::BufferFlagBit::ENABLE_STAGING_WRITE}));
+    }
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < movedCount; ++i) {
+            buffers[i]->write(worldMatrix, sizeof(float) * cc::pipeline::UBOLocal::MAT_WORLD_OFFSET);
+            buffers[i]->write(worldMatrix, sizeof(float) * cc::pipeline::UBOLocal::MAT_WORLD_IT_OFFSET);
+            buffers[i]->update();
+        }
+    }
+    state.counters["updates"] = static_cast<double>(movedCount);
+    state.counters["bytes"] = static_cast<double>(movedCount * cc::pipeline::UBOLocal::SIZE);
+    for (const auto &buffer : buffers) {
+        buffer->destroy();
+    }
+}
+BENCHMARK(BM_LocalUBOPerModel)->Arg(64)->Arg(1024)->Arg(MODEL_COUNT)->Unit(benchmark::kMicrosecond);
+
+static void BM_LocalUBOArena(benchmark::State &state) {
+    cc::scene::LocalUBOArena arena(cc::gfx::Device::getInstance());
+    const auto movedCount = static_cast<uint32_t>(state.range(0));
+    const cc::Mat4 worldMatrix;
+    ccstd::vector<cc::IntrusivePtr<cc::gfx::Buffer>> views;
+    ccstd::vector<uint32_t> slots(MODEL_COUNT);
+    for (uint32_t i = 0; i < MODEL_COUNT; ++i) {
+        views.emplace_back(arena.allocate(&slots[i]));
+    }
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < movedCount; ++i) {
+            float *data = arena.getSlotData(slots[i]);
+            memcpy(data + cc::pipeline::UBOLocal::MAT_WORLD_OFFSET, worldMatrix.m, sizeof(cc::Mat4));
+            memcpy(data + cc::pipeline::UBOLocal::MAT_WORLD_IT_OFFSET, worldMatrix.m, sizeof(cc::Mat4));
+            arena.markDirty(slots[i]);
+        }
+        arena.flush();
+    }
+    state.counters["updates"] = static_cast<double>(arena.getUploadCount());
+    state.counters["bytes"] = static_cast<double>(arena.getUploadBytes());
+    for (const auto &view : views) {
+        view->destroy();
+    }
+}
+BENCHMARK(BM_LocalUBOArena)->Arg(64)->Arg(1024)->Arg(MODEL_COUNT)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,155 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include <cstdint>
+#include "benchmark/benchmark.h"
+#include "cocos/base/std/container/vector.h"
+#include "cocos/math/Mat4.h"
+#include "cocos/math/Quaternion.h"
+#include "cocos/math/Vec3.h"
+
+namespace {
+
+struct TransformData {
+    explicit TransformData(uint32_t count)
+    : rotations(count), localRotations(count), worldRotations(count), translations(count), scales(count), parents(count), locals(count), worlds(count), points(count), results(count) {
+        for (uint32_t i = 0; i < count; ++i) {
+            const auto f = static_cast<float>(i % 360);
+            cc::Quaternion::fromEuler(f, f * 0.5F, -f, &rotations[i]);
+            cc::Quaternion::fromEuler(-f, f, f * 0.25F, &localRotations[i]);
+            translations[i].set(f, -f, f * 0.25F);
+            scales[i].set(1.0F, 1.0F + f * 0.01F, 2.0F);
+            cc::Mat4::fromRTS(rotations[i], translations[i], scales[i], &parents[i]);
+            points[i].set(f * 0.1F, f * 0.2F, f * 0.3F);
+        }
+    }
+
+    ccstd::vector<cc::Quaternion> rotations;
+    ccstd::vector<cc::Quaternion> localRotations;
+    ccstd::vector<cc::Quaternion> worldRotations;
+    ccstd::vector<cc::Vec3> translations;
+    ccstd::vector<cc::Vec3> scales;
+    ccstd::vector<cc::Mat4> parents;
+    ccstd::vector<cc::Mat4> locals;
+    ccstd::vector<cc::Mat4> worlds;
+    ccstd::vector<cc::Vec3> points;
+    ccstd::vector<cc::Vec3> results;
+};
+
+} // namespace
+
+static void BM_Mat4Multiply(benchmark::State &state) {
+    const auto count = static_cast<uint32_t>(state.range(0));
+    TransformData data(count);
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < count; ++i) {
+            cc::Mat4::multiply(data.parents[i], data.locals[i], &data.worlds[i]);
+        }
+        benchmark::DoNotOptimize(data.worlds.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * count);
+}
+BENCHMARK(BM_Mat4Multiply)->Arg(1024)->Arg(16384);
+
+static void BM_Mat4MultiplyBatch(benchmark::State &state) {
+    const auto count = static_cast<uint32_t>(state.range(0));
+    TransformData data(count);
+    for (auto _ : state) {
+        cc::Mat4::multiplyBatch(data.parents.data(), data.locals.data(), data.worlds.data(), count);
+        benchmark::DoNotOptimize(data.worlds.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * count);
+}
+BENCHMARK(BM_Mat4MultiplyBatch)->Arg(1024)->Arg(16384);
+
+static void BM_Mat4FromRTS(benchmark::State &state) {
+    const auto count = static_cast<uint32_t>(state.range(0));
+    TransformData data(count);
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < count; ++i) {
+            cc::Mat4::fromRTS(data.rotations[i], data.translations[i], data.scales[i], &data.locals[i]);
+        }
+        benchmark::DoNotOptimize(data.locals.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * count);
+}
+BENCHMARK(BM_Mat4FromRTS)->Arg(1024)->Arg(16384);
+
+static void BM_Mat4FromRTSBatch(benchmark::State &state) {
+    const auto count = static_cast<uint32_t>(state.range(0));
+    TransformData data(count);
+    for (auto _ : state) {
+        cc::Mat4::fromRTSBatch(data.rotations.data(), data.translations.data(), data.scales.data(), data.locals.data(), count);
+        benchmark::DoNotOptimize(data.locals.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * count);
+}
+BENCHMARK(BM_Mat4FromRTSBatch)->Arg(1024)->Arg(16384);
+
+static void BM_Vec3TransformMat4(benchmark::State &state) {
+    const auto count = static_cast<uint32_t>(state.range(0));
+    TransformData data(count);
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < count; ++i) {
+            cc::Vec3::transformMat4(data.points[i], data.parents[0], &data.results[i]);
+        }
+        benchmark::DoNotOptimize(data.results.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * count);
+}
+BENCHMARK(BM_Vec3TransformMat4)->Arg(1024)->Arg(16384);
+
+static void BM_Vec3TransformMat4Batch(benchmark::State &state) {
+    const auto count = static_cast<uint32_t>(state.range(0));
+    TransformData data(count);
+    for (auto _ : state) {
+        cc::Vec3::transformMat4Batch(data.points.data(), data.parents[0], data.results.data(), count);
+        benchmark::DoNotOptimize(data.results.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * count);
+}
+BENCHMARK(BM_Vec3TransformMat4Batch)->Arg(1024)->Arg(16384);
+
+static void BM_QuaternionMultiply(benchmark::State &state) {
+    const auto count = static_cast<uint32_t>(state.range(0));
+    TransformData data(count);
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < count; ++i) {
+            cc::Quaternion::multiply(data.rotations[i], data.localRotations[i], &data.worldRotations[i]);
+        }
+        benchmark::DoNotOptimize(data.worldRotations.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * count);
+}
+BENCHMARK(BM_QuaternionMultiply)->Arg(1024)->Arg(16384);
+
+static void BM_QuaternionMultiplyBatch(benchmark::State &state) {
+    const auto count = static_cast<uint32_t>(state.range(0));
+    TransformData data(count);
+    for (auto _ : state) {
+        cc::Quaternion::multiplyBatch(data.rotations.data(), data.localRotations.data(), data.worldRotations.data(), count);
+        benchmark::DoNotOptimize(data.worldRotations.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * count);
+}
+BENCHMARK(BM_QuaternionMultiplyBatch)->Arg(1024)->Arg(16384);
@@ -0,0 +1,366 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include "base/job-system/job-system-native/NativeJobGraph.h"
+#include "base/job-system/job-system-native/NativeJobSystem.h"
+#include "base/std/container/string.h"
+#include "base/std/container/vector.h"
+#include "benchmark/benchmark.h"
+
+#if CC_USE_SPINE
+    #include "spine/spine.h"
+#endif
+
+#if CC_USE_DRAGONBONES
+    #include "dragonbones/DragonBonesHeaders.h"
+#endif
+
+namespace {
+
+constexpr uint32_t BONE_COUNT = 32;
+constexpr float FRAME_TIME = 1.0F / 60.0F;
+// same chunking as MiddlewareManager
+constexpr uint32_t SKELETONS_PER_JOB = 16;
+
+#if CC_USE_SPINE
+
+// a chain of BONE_COUNT bones, each with a looping rotate and translate timeline
+ccstd::string makeSpineSkeletonJson() {
+    ccstd::string bones = R"({"name":"root"})";
+    ccstd::string timelines;
+    for (uint32_t i = 1; i <= BONE_COUNT; ++i) {
+        const auto name = "b" + std::to_string(i);
+        const auto parent = i == 1 ? ccstd::string("root") : "b" + std::to_string(i - 1);
+        bones += R"(,{"name":")" + name + R"(","parent":")" + parent + R"(","length":10,"x":10})";
+        timelines += (i == 1 ? "" : ",");
+        timelines += "\"" + name + R"(":{"rotate":[{"time":0,"angle":0},{"time":0.5,"angle":30},{"time":1,"angle":0}],)";
+        timelines += R"("translate":[{"time":0,"x":0,"y":0},{"time":0.5,"x":2,"y":4},{"time":1,"x":0,"y":0}]})";
+    }
+    return R"({"skeleton":{"spine":"3.8.99"},"bones":[)" + bones + R"(],"animations":{"walk":{"bones":{)" + timelines + "}}}}";
+}
+
+// count skeletons sharing one skeleton data, as SkeletonAnimation instances of the same asset do
+struct SpineScene {
+    explicit SpineScene(uint32_t count) {
+        atlas = new (__FILE__, __LINE__) spine::Atlas("", 0, "", nullptr, false);
+        spine::SkeletonJson json(atlas);
+        skeletonData = json.readSkeletonData(makeSpineSkeletonJson().c_str());
+        stateData = new (__FILE__, __LINE__) spine::AnimationStateData(skeletonData);
+        for (uint32_t i = 0; i < count; ++i) {
+            auto *skeleton = new (__FILE__, __LINE__) spine::Skeleton(skeletonData);
+            auto *state = new (__FILE__, __LINE__) spine::AnimationState(stateData);
+            state->setAnimation(0, "walk", true);
+            // spread the instances over the animation
+            state->update(static_cast<float>(i) * FRAME_TIME);
+            skeletons.push_back(skeleton);
+            states.push_back(state);
+        }
+        scratchVertices.resize(count);
+        scratchIndices.resize(count);
+    }
+
+    ~SpineScene() {
+        for (auto *state : states) {
+            delete state;
+        }
+        for (auto *skeleton : skeletons) {
+            delete skeleton;
+        }
+        delete stateData;
+        delete skeletonData;
+        delete atlas;
+    }
+
+    // the per frame work of SkeletonAnimation::update before rendering
+    void update() {
+        for (size_t i = 0; i < skeletons.size(); ++i) {
+            states[i]->update(FRAME_TIME);
+            states[i]->apply(*skeletons[i]);
+            skeletons[i]->updateWorldTransform();
+        }
+    }
+
+    // the split MiddlewareManager::update makes: states are applied in order,
+    // then the world transforms are computed on the job system
+    void updateParallel(cc::NativeJobSystem *system) {
+        for (size_t i = 0; i < skeletons.size(); ++i) {
+            states[i]->update(FRAME_TIME);
+            states[i]->apply(*skeletons[i]);
+        }
+        const auto count = static_cast<uint32_t>(skeletons.size());
+        cc::NativeJobGraph g(system);
+        g.createForEachIndexJob(0U, (count + SKELETONS_PER_JOB - 1) / SKELETONS_PER_JOB, 1U, [this, count](uint32_t job) {
+            const uint32_t end = std::min(count, (job + 1) * SKELETONS_PER_JOB);
+            for (uint32_t i = job * SKELETONS_PER_JOB; i < end; ++i) {
+                skeletons[i]->updateWorldTransform();
+            }
+        });
+        g.run();
+        g.waitForAll();
+    }
+
+    // one quad per bone in the scratch buffers of a skeleton, as SkeletonRenderer::generateVertices
+    // does for a region attachment, indices start at 0 for every skeleton
+    void generateVertices(uint32_t index) {
+        auto &vertices = scratchVertices[index];
+        auto &indices = scratchIndices[index];
+        vertices.clear();
+        indices.clear();
+        auto &bones = skeletons[index]->getBones();
+        for (size_t i = 0; i < bones.size(); ++i) {
+            auto *bone = bones[i];
+            const auto base = static_cast<uint16_t>(vertices.size() / VERTEX_FLOATS);
+            for (const auto &corner : QUAD_CORNERS) {
+                vertices.push_back(corner[0] * bone->getA() + corner[1] * bone->getB() + bone->getWorldX());
+                vertices.push_back(corner[0] * bone->getC() + corner[1] * bone->getD() + bone->getWorldY());
+                vertices.push_back(0.F);
+                vertices.push_back(corner[2]);
+                vertices.push_back(corner[3]);
+                vertices.push_back(1.F);
+            }
+            for (const uint16_t quadIndex : QUAD_INDICES) {
+                indices.push_back(static_cast<uint16_t>(base + quadIndex));
+            }
+        }
+    }
+
+    // the serial step of SkeletonRenderer::render, copies the skeletons in order and rebases their indices
+    void commitVertices() {
+        vertexBuffer.clear();
+        indexBuffer.clear();
+        for (size_t i = 0; i < skeletons.size(); ++i) {
+            // the mesh buffer moves on to its next buffer once 16 bit indices run out
+            if ((vertexBuffer.size() + scratchVertices[i].size()) / VERTEX_FLOATS > UINT16_MAX) {
+                vertexBuffer.clear();
+                indexBuffer.clear();
+            }
+            const auto vertexOffset = static_cast<uint16_t>(vertexBuffer.size() / VERTEX_FLOATS);
+            vertexBuffer.insert(vertexBuffer.end(), scratchVertices[i].begin(), scratchVertices[i].end());
+            for (const auto index : scratchIndices[i]) {
+                indexBuffer.push_back(static_cast<uint16_t>(index + vertexOffset));
+            }
+        }
+    }
+
+    void render() {
+        for (uint32_t i = 0; i < skeletons.size(); ++i) {
+            generateVertices(i);
+        }
+        commitVertices();
+    }
+
+    // the split MiddlewareManager::render makes: vertices are generated on the job system,
+    // then committed in order
+    void renderParallel(cc::NativeJobSystem *system) {
+        const auto count = static_cast<uint32_t>(skeletons.size());
+        cc::NativeJobGraph g(system);
+        g.createForEachIndexJob(0U, (count + SKELETONS_PER_JOB - 1) / SKELETONS_PER_JOB, 1U, [this, count](uint32_t job) {
+            const uint32_t end = std::min(count, (job + 1) * SKELETONS_PER_JOB);
+            for (uint32_t i = job * SKELETONS_PER_JOB; i < end; ++i) {
+                generateVertices(i);
+            }
+        });
+        g.run();
+        g.waitForAll();
+        commitVertices();
+    }
+
+    static constexpr size_t VERTEX_FLOATS = 6;
+    // x, y, u, v
+    static constexpr float QUAD_CORNERS[4][4] = {{-5.F, -5.F, 0.F, 1.F}, {5.F, -5.F, 1.F, 1.F}, {5.F, 5.F, 1.F, 0.F}, {-5.F, 5.F, 0.F, 0.F}};
+    static constexpr uint16_t QUAD_INDICES[6] = {0, 1, 2, 2, 3, 0};
+
+    spine::Atlas *atlas{nullptr};
+    spine::SkeletonData *skeletonData{nullptr};
+    spine::AnimationStateData *stateData{nullptr};
+    ccstd::vector<spine::Skeleton *> skeletons;
+    ccstd::vector<spine::AnimationState *> states;
+    ccstd::vector<ccstd::vector<float>> scratchVertices;
+    ccstd::vector<ccstd::vector<uint16_t>> scratchIndices;
+    ccstd::vector<float> vertexBuffer;
+    ccstd::vector<uint16_t> indexBuffer;
+};
+
+#endif
+
+#if CC_USE_DRAGONBONES
+
+// a chain of BONE_COUNT bones, each with a looping rotate and translate timeline
+ccstd::string makeDragonBonesJson() {
+    ccstd::string bones = R"({"name":"root"})";
+    ccstd::string timelines;
+    for (uint32_t i = 1; i <= BONE_COUNT; ++i) {
+        const auto name = "b" + std::to_string(i);
+        const auto parent = i == 1 ? ccstd::string("root") : "b" + std::to_string(i - 1);
+        bones += R"(,{"name":")" + name + R"(","parent":")" + parent + R"(","length":10,"transform":{"x":10}})";
+        timelines += (i == 1 ? "" : ",");
+        timelines += R"({"name":")" + name + R"(","rotateFrame":[{"duration":30,"tweenEasing":0,"rotate":0},{"duration":30,"tweenEasing":0,"rotate":30},{"duration":0,"rotate":0}],)";
+        timelines += R"("translateFrame":[{"duration":30,"tweenEasing":0,"x":0,"y":0},{"duration":30,"tweenEasing":0,"x":2,"y":4},{"duration":0,"x":0,"y":0}]})";
+    }
+    return R"({"frameRate":60,"name":"benchmark","version":"5.5","compatibleVersion":"5.5","armature":[{"type":"Armature","frameRate":60,"name":"armature","bone":[)" +
+           bones + R"(],"animation":[{"duration":60,"playTimes":0,"name":"walk","bone":[)" + timelines + "]}]}]}";
+}
+
+// the display side of an armature, nothing is rendered
+class BenchmarkArmatureProxy : public dragonBones::IArmatureProxy {
+public:
+    void dbInit(dragonBones::Armature *armature) override { _armature = armature; }
+    void dbClear() override { _armature = nullptr; }
+    void dbUpdate() override {}
+    void dbRender() override {}
+    void dispose() override {
+        if (_armature != nullptr) {
+            _armature->dispose();
+            _armature = nullptr;
+        }
+    }
+    dragonBones::Armature *getArmature() const override { return _armature; }
+    dragonBones::Animation *getAnimation() const override { return _armature->getAnimation(); }
+
+    bool hasDBEventListener(const std::string & /*type*/) const override { return false; }
+    void dispatchDBEvent(const std::string & /*type*/, dragonBones::EventObject * /*value*/) override {}
+    void addDBEventListener(const std::string & /*type*/, const std::function<void(dragonBones::EventObject *)> & /*listener*/) override {}
+    void removeDBEventListener(const std::string & /*type*/, const std::function<void(dragonBones::EventObject *)> & /*listener*/) override {}
+
+private:
+    dragonBones::Armature *_armature{nullptr};
+};
+
+// builds armatures without slots, so no texture atlas or display is needed
+class BenchmarkFactory : public dragonBones::BaseFactory {
+public:
+    explicit BenchmarkFactory(dragonBones::DragonBones *dragonBones) {
+        _dragonBones = dragonBones;
+    }
+
+protected:
+    dragonBones::TextureAtlasData *_buildTextureAtlasData(dragonBones::TextureAtlasData *textureAtlasData, void * /*textureAtlas*/) const override {
+        return textureAtlasData;
+    }
+
+    dragonBones::Armature *_buildArmature(const dragonBones::BuildArmaturePackage &dataPackage) const override {
+        auto *armature = dragonBones::BaseObject::borrowObject<dragonBones::Armature>();
+        auto *proxy = new BenchmarkArmatureProxy();
+        proxies.push_back(proxy);
+        armature->init(dataPackage.armature, proxy, proxy, _dragonBones);
+        return armature;
+    }
+
+    dragonBones::Slot *_buildSlot(const dragonBones::BuildArmaturePackage & /*dataPackage*/, const dragonBones::SlotData * /*slotData*/, dragonBones::Armature * /*armature*/) const override {
+        return nullptr;
+    }
+
+public:
+    mutable ccstd::vector<BenchmarkArmatureProxy *> proxies;
+};
+
+// count armatures of one asset advanced by the world clock, as CCFactory::update does
+struct DragonBonesScene {
+    explicit DragonBonesScene(uint32_t count) : dragonBones(nullptr), factory(&dragonBones) {
+        factory.parseDragonBonesData(makeDragonBonesJson().c_str(), "benchmark");
+        for (uint32_t i = 0; i < count; ++i) {
+            auto *armature = factory.buildArmature("armature", "benchmark");
+            armature->getAnimation()->gotoAndPlayByTime("walk", static_cast<float>(i) * FRAME_TIME);
+            dragonBones.getClock()->add(armature);
+            armatures.push_back(armature);
+        }
+    }
+
+    ~DragonBonesScene() {
+        for (auto *armature : armatures) {
+            dragonBones.getClock()->remove(armature);
+            armature->dispose();
+        }
+        // disposed armatures return to the pool on the next advance, which clears their proxies
+        dragonBones.advanceTime(0.0F);
+        for (auto *proxy : factory.proxies) {
+            delete proxy;
+        }
+        factory.clear();
+    }
+
+    dragonBones::DragonBones dragonBones;
+    BenchmarkFactory factory;
+    ccstd::vector<dragonBones::Armature *> armatures;
+};
+
+#endif
+
+} // namespace
+
+#if CC_USE_SPINE
+static void BM_SpineAnimationUpdate(benchmark::State &state) {
+    SpineScene scene(static_cast<uint32_t>(state.range(0)));
+    for (auto _ : state) {
+        scene.update();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_SpineAnimationUpdate)->Arg(100)->Arg(300)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+static void BM_SpineAnimationUpdateParallel(benchmark::State &state) {
+    SpineScene scene(static_cast<uint32_t>(state.range(0)));
+    cc::NativeJobSystem system(std::max(2U, std::thread::hardware_concurrency()) - 1);
+    for (auto _ : state) {
+        scene.updateParallel(&system);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_SpineAnimationUpdateParallel)->Arg(100)->Arg(300)->Arg(1000)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+static void BM_SpineVertexGeneration(benchmark::State &state) {
+    SpineScene scene(static_cast<uint32_t>(state.range(0)));
+    scene.update();
+    for (auto _ : state) {
+        scene.render();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_SpineVertexGeneration)->Arg(100)->Arg(300)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+static void BM_SpineVertexGenerationParallel(benchmark::State &state) {
+    SpineScene scene(static_cast<uint32_t>(state.range(0)));
+    scene.update();
+    cc::NativeJobSystem system(std::max(2U, std::thread::hardware_concurrency()) - 1);
+    for (auto _ : state) {
+        scene.renderParallel(&system);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_SpineVertexGenerationParallel)->Arg(100)->Arg(300)->Arg(1000)->UseRealTime()->Unit(benchmark::kMicrosecond);
+#endif
+
+#if CC_USE_DRAGONBONES
+static void BM_DragonBonesAnimationUpdate(benchmark::State &state) {
+    DragonBonesScene scene(static_cast<uint32_t>(state.range(0)));
+    for (auto _ : state) {
+        scene.dragonBones.advanceTime(FRAME_TIME);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_DragonBonesAnimationUpdate)->Arg(100)->Arg(1000)->Unit(benchmark::kMicrosecond);
+#endif
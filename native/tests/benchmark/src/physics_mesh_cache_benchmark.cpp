@@ -0,0 +1,122 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#if CC_USE_PHYSICS_PHYSX
+
+    #include <cmath>
+    #include <cstdint>
+    #include "benchmark/benchmark.h"
+    #include "cocos/base/std/container/string.h"
+    #include "cocos/base/std/container/vector.h"
+    #include "cocos/physics/physx/PhysXMeshCache.h"
+    #include "cocos/physics/physx/PhysXWorld.h"
+    #include "cocos/physics/sdk/World.h"
+    #include "cocos/platform/FileUtils.h"
+
+namespace {
+
+constexpr uint32_t CONVEX_COUNT{200};
+constexpr uint32_t CONVEX_POINT_COUNT{64};
+constexpr uint32_t TERRAIN_SIZE{257};
+
+// the colliders of a level: distinct convex rocks and one terrain
+struct MeshLevel {
+    MeshLevel() {
+        uint32_t seed = 1;
+        auto random = [&seed]() {
+            seed = seed * 1664525U + 1013904223U;
+            return static_cast<float>(seed >> 8) / static_cast<float>(1U << 24);
+        };
+        convexPoints.resize(CONVEX_COUNT);
+        for (auto &points : convexPoints) {
+            for (uint32_t i = 0; i < CONVEX_POINT_COUNT; ++i) {
+                points.emplace_back(random() * 2.0F - 1.0F, random() * 2.0F - 1.0F, random() * 2.0F - 1.0F);
+            }
+        }
+        terrainSamples.resize(TERRAIN_SIZE * TERRAIN_SIZE);
+        for (uint32_t i = 0; i < TERRAIN_SIZE * TERRAIN_SIZE; ++i) {
+            const auto x = static_cast<float>(i % TERRAIN_SIZE);
+            const auto z = static_cast<float>(i / TERRAIN_SIZE);
+            terrainSamples[i].height = static_cast<physx::PxI16>(std::sin(x * 0.05F) * std::cos(z * 0.05F) * 1000.0F);
+        }
+
+        cacheDirectory = cc::FileUtils::getInstance()->getWritablePath() + "physx-mesh-cache-benchmark/";
+        cc::FileUtils::getInstance()->removeDirectory(cacheDirectory);
+        cc::FileUtils::getInstance()->createDirectory(cacheDirectory);
+    }
+
+    ~MeshLevel() {
+        cc::FileUtils::getInstance()->removeDirectory(cacheDirectory);
+    }
+
+    // what loading the level asks from the cache, a fresh cache each time so nothing is kept in memory
+    void load(const ccstd::string &directory) const {
+        cc::physics::PhysXMeshCache cache(cc::physics::PhysXWorld::getPhysics(), cc::physics::PhysXWorld::getCooking());
+        cache.setCacheDirectory(directory);
+        for (const auto &points : convexPoints) {
+            physx::PxConvexMeshDesc desc;
+            desc.points.count = static_cast<physx::PxU32>(points.size());
+            desc.points.stride = sizeof(physx::PxVec3);
+            desc.points.data = points.data();
+            desc.flags = physx::PxConvexFlag::eCOMPUTE_CONVEX;
+            benchmark::DoNotOptimize(cache.getConvexMesh(desc));
+        }
+        physx::PxHeightFieldDesc desc;
+        desc.nbRows = TERRAIN_SIZE;
+        desc.nbColumns = TERRAIN_SIZE;
+        desc.samples.data = terrainSamples.data();
+        desc.samples.stride = sizeof(physx::PxHeightFieldSample);
+        benchmark::DoNotOptimize(cache.getHeightField(desc));
+    }
+
+    cc::physics::World world;
+    ccstd::vector<ccstd::vector<physx::PxVec3>> convexPoints;
+    ccstd::vector<physx::PxHeightFieldSample> terrainSamples;
+    ccstd::string cacheDirectory;
+};
+
+} // namespace
+
+// first load, every collider is cooked
+static void BM_PhysicsMeshLoadCold(benchmark::State &state) {
+    MeshLevel level;
+    for (auto _ : state) {
+        level.load({});
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * (CONVEX_COUNT + 1));
+}
+BENCHMARK(BM_PhysicsMeshLoadCold)->Unit(benchmark::kMillisecond);
+
+// later loads, every collider is deserialized from the disk cache
+static void BM_PhysicsMeshLoadWarm(benchmark::State &state) {
+    MeshLevel level;
+    level.load(level.cacheDirectory);
+    for (auto _ : state) {
+        level.load(level.cacheDirectory);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * (CONVEX_COUNT + 1));
+}
+BENCHMARK(BM_PhysicsMeshLoadWarm)->Unit(benchmark::kMillisecond);
+
+#endif
@@ -0,0 +1,144 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#if CC_USE_PHYSICS_PHYSX
+
+    #include <cmath>
+    #include <cstdint>
+    #include <memory>
+    #include "benchmark/benchmark.h"
+    #include "cocos/base/Ptr.h"
+    #include "cocos/base/memory/Memory.h"
+    #include "cocos/base/std/container/vector.h"
+    #include "cocos/core/scene-graph/Node.h"
+    #include "cocos/physics/sdk/RigidBody.h"
+    #include "cocos/physics/sdk/Shape.h"
+    #include "cocos/physics/sdk/World.h"
+
+namespace {
+
+namespace physics = cc::physics;
+
+constexpr uint32_t GRID_SIZE{32};
+
+// a grid of static pillars, rays are cast across the grid from its border like line of sight checks
+class PillarField {
+public:
+    PillarField() {
+        world.createMaterial(0, 0.6F, 0.6F, 0.1F, 2, 2);
+        for (uint32_t i = 0; i < GRID_SIZE * GRID_SIZE; ++i) {
+            auto *node = ccnew cc::Node();
+            node->setPosition(static_cast<float>(i % GRID_SIZE) * 4.0F, 2.0F, static_cast<float>(i / GRID_SIZE) * 4.0F);
+            node->setActiveInHierarchy(true);
+            node->updateWorldTransform();
+
+            auto body = std::make_unique<physics::RigidBody>();
+            body->initialize(node, physics::ERigidBodyType::STATIC, 1);
+            body->onEnable();
+            auto shape = std::make_unique<physics::BoxShape>();
+            shape->initialize(node);
+            shape->setMaterial(0, 0.6F, 0.6F, 0.1F, 2, 2);
+            shape->setSize(1.0F, 4.0F, 1.0F);
+            shape->onEnable();
+
+            nodes.emplace_back(node);
+            bodies.emplace_back(std::move(body));
+            shapes.emplace_back(std::move(shape));
+        }
+        world.syncSceneToPhysics();
+        world.step(1.0F / 60.0F);
+    }
+
+    ~PillarField() {
+        world.destroy();
+        for (auto &shape : shapes) shape->onDestroy();
+        for (auto &body : bodies) body->onDestroy();
+    }
+
+    // the i-th ray starts on the border and aims at a pseudo random point of the field
+    static void getRay(uint32_t i, float *origin, float *unitDir) {
+        const float extent = static_cast<float>(GRID_SIZE) * 4.0F;
+        const float t = static_cast<float>((i * 7919U) % 1024U) / 1024.0F;
+        origin[0] = -2.0F;
+        origin[1] = 1.0F;
+        origin[2] = t * extent;
+        const float dx = extent;
+        const float dz = (0.5F - t) * extent;
+        const float len = std::sqrt(dx * dx + dz * dz);
+        unitDir[0] = dx / len;
+        unitDir[1] = 0.0F;
+        unitDir[2] = dz / len;
+    }
+
+    physics::World world;
+
+private:
+    ccstd::vector<cc::IntrusivePtr<cc::Node>> nodes;
+    ccstd::vector<std::unique_ptr<physics::RigidBody>> bodies;
+    ccstd::vector<std::unique_ptr<physics::BoxShape>> shapes;
+};
+
+} // namespace
+
+// one raycastClosest per ray, the way scripts issue them today
+static void BM_PhysicsRaycastClosest(benchmark::State &state) {
+    PillarField field;
+    const auto rayCount = static_cast<uint32_t>(state.range(0));
+    physics::RaycastOptions opt{};
+    opt.distance = 1000.0F;
+    opt.mask = 0xffffffff;
+    for (auto _ : state) {
+        uint32_t hitCount = 0;
+        for (uint32_t i = 0; i < rayCount; ++i) {
+            PillarField::getRay(i, &opt.origin.x, &opt.unitDir.x);
+            hitCount += field.world.raycastClosest(opt) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(hitCount);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * rayCount);
+}
+BENCHMARK(BM_PhysicsRaycastClosest)->Arg(4096)->Arg(16384)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+static void BM_PhysicsSceneQueryBatch(benchmark::State &state) {
+    PillarField field;
+    const auto rayCount = static_cast<uint32_t>(state.range(0));
+    ccstd::vector<physics::SceneQuery> queries(rayCount);
+    ccstd::vector<physics::SceneQueryHit> hits(rayCount);
+    ccstd::vector<uint32_t> hitCounts(rayCount);
+    physics::SceneQueryBatch batch;
+    batch.attach(queries.data(), hits.data(), hitCounts.data(), rayCount, 1);
+    for (uint32_t i = 0; i < rayCount; ++i) {
+        auto &query = batch.queries[i];
+        query.type = physics::ESceneQueryType::RAYCAST_CLOSEST;
+        query.distance = 1000.0F;
+        PillarField::getRay(i, query.origin, query.unitDir);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(field.world.sceneQuery(batch, rayCount));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * rayCount);
+}
+BENCHMARK(BM_PhysicsSceneQueryBatch)->Arg(4096)->Arg(16384)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+#endif
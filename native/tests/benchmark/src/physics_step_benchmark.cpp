@@ -0,0 +1,145 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#if CC_USE_PHYSICS_PHYSX
+
+    #include <cstdint>
+    #include <memory>
+    #include "benchmark/benchmark.h"
+    #include "cocos/base/Ptr.h"
+    #include "cocos/base/memory/Memory.h"
+    #include "cocos/base/std/container/vector.h"
+    #include "cocos/core/scene-graph/Node.h"
+    #include "cocos/engine/EngineEvents.h"
+    #include "cocos/math/Mat4.h"
+    #include "cocos/physics/sdk/RigidBody.h"
+    #include "cocos/physics/sdk/Shape.h"
+    #include "cocos/physics/sdk/World.h"
+
+namespace {
+
+namespace physics = cc::physics;
+
+constexpr float FIXED_TIME_STEP{1.0F / 60.0F};
+constexpr uint32_t SUB_STEPS{2};
+
+// a pile of dynamic boxes dropped on a static ground box, arranged in layers of 32x32
+class BoxPile {
+public:
+    explicit BoxPile(uint32_t bodyCount) {
+        world.setGravity(0.0F, -10.0F, 0.0F);
+        world.createMaterial(0, 0.6F, 0.6F, 0.1F, 2, 2);
+
+        addBox(0.0F, -0.5F, 0.0F, 100.0F, physics::ERigidBodyType::STATIC);
+        for (uint32_t i = 0; i < bodyCount; ++i) {
+            const auto x = static_cast<float>(i % 32) * 1.1F - 17.6F;
+            const auto z = static_cast<float>((i / 32) % 32) * 1.1F - 17.6F;
+            const auto y = static_cast<float>(i / 1024) * 1.1F + 0.5F;
+            addBox(x, y, z, 1.0F, physics::ERigidBodyType::DYNAMIC);
+        }
+    }
+
+    ~BoxPile() {
+        world.destroy();
+        for (auto &shape : shapes) shape->onDestroy();
+        for (auto &body : bodies) body->onDestroy();
+    }
+
+    // what PhysicsSystem does for one frame of fixed sub steps, the trailing sync is the one of a
+    // frame whose time left is below a step
+    void frame() {
+        for (uint32_t i = 0; i < SUB_STEPS; ++i) {
+            world.syncSceneToPhysics();
+            world.step(FIXED_TIME_STEP);
+            world.emitEvents();
+            world.syncSceneWithCheck();
+        }
+        world.syncSceneToPhysics();
+    }
+
+    physics::World world;
+
+private:
+    void addBox(float x, float y, float z, float size, physics::ERigidBodyType type) {
+        auto *node = ccnew cc::Node();
+        node->setPosition(x, y, z);
+        node->setActiveInHierarchy(true);
+        node->updateWorldTransform();
+
+        auto body = std::make_unique<physics::RigidBody>();
+        body->initialize(node, type, 1);
+        body->onEnable();
+        auto shape = std::make_unique<physics::BoxShape>();
+        shape->initialize(node);
+        shape->setMaterial(0, 0.6F, 0.6F, 0.1F, 2, 2);
+        shape->setSize(size, size, size);
+        shape->onEnable();
+
+        nodes.emplace_back(node);
+        bodies.emplace_back(std::move(body));
+        shapes.emplace_back(std::move(shape));
+    }
+
+    ccstd::vector<cc::IntrusivePtr<cc::Node>> nodes;
+    ccstd::vector<std::unique_ptr<physics::RigidBody>> bodies;
+    ccstd::vector<std::unique_ptr<physics::BoxShape>> shapes;
+};
+
+// stands in for the render work of a frame that the last sub step can overlap with
+void renderFrame() {
+    cc::Mat4 m;
+    for (uint32_t i = 0; i < 20000; ++i) {
+        m.rotateY(0.01F);
+        benchmark::DoNotOptimize(m);
+    }
+}
+
+} // namespace
+
+static void BM_PhysicsStepSync(benchmark::State &state) {
+    BoxPile pile(static_cast<uint32_t>(state.range(0)));
+    pile.world.setAsyncStep(false);
+    for (auto _ : state) {
+        pile.frame();
+        renderFrame();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_PhysicsStepSync)->Arg(5000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_PhysicsStepAsync(benchmark::State &state) {
+    BoxPile pile(static_cast<uint32_t>(state.range(0)));
+    pile.world.setAsyncStep(true);
+    for (auto _ : state) {
+        pile.frame();
+        renderFrame();
+        // the end of frame tick fetches the sub step left running
+        cc::events::Tick::broadcast(FIXED_TIME_STEP);
+    }
+    pile.world.setAsyncStep(false);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_PhysicsStepAsync)->Arg(5000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+#endif
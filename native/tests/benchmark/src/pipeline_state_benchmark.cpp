@@ -0,0 +1,119 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <cstdint>
+#include "benchmark/benchmark.h"
+#include "cocos/base/std/container/vector.h"
+#include "cocos/renderer/gfx-base/GFXDevice.h"
+#include "cocos/renderer/pipeline/PipelineStateManager.h"
+
+namespace {
+
+constexpr uint32_t PASS_COUNT = 256;
+
+// one shader and render pass, PASS_COUNT distinct pass hashes as a scene with many materials would have
+struct PipelineStateScene {
+    PipelineStateScene() {
+        auto *device = cc::gfx::Device::getInstance();
+        cc::gfx::ShaderInfo shaderInfo;
+        shaderInfo.name = "benchmark|CC_USE_BENCHMARK";
+        shader = device->createShader(shaderInfo);
+        pipelineLayout = device->createPipelineLayout({});
+
+        cc::gfx::RenderPassInfo renderPassInfo;
+        renderPassInfo.colorAttachments.emplace_back();
+        renderPassInfo.colorAttachments.back().format = cc::gfx::Format::RGBA8;
+        renderPassInfo.depthStencilAttachment.format = cc::gfx::Format::DEPTH_STENCIL;
+        renderPass = device->createRenderPass(renderPassInfo);
+
+        info.shader = shader;
+        info.pipelineLayout = pipelineLayout;
+        info.renderPass = renderPass;
+        info.inputState.attributes.push_back({"a_position", cc::gfx::Format::RGB32F});
+
+        for (uint32_t i = 0; i < PASS_COUNT; ++i) {
+            keys.push_back({0x9e3779b9U * (i + 1), renderPass->getHash(), 0x1234U, shader->getTypedID(), 0});
+        }
+    }
+
+    ~PipelineStateScene() {
+        cc::pipeline::PipelineStateManager::destroyAll();
+        CC_SAFE_DESTROY_AND_DELETE(renderPass);
+        CC_SAFE_DESTROY_AND_DELETE(pipelineLayout);
+        CC_SAFE_DESTROY_AND_DELETE(shader);
+    }
+
+    cc::gfx::Shader *shader{nullptr};
+    cc::gfx::PipelineLayout *pipelineLayout{nullptr};
+    cc::gfx::RenderPass *renderPass{nullptr};
+    cc::gfx::PipelineStateInfo info;
+    ccstd::vector<cc::pipeline::PipelineStateKey> keys;
+};
+
+} // namespace
+
+// the per draw lookup once every pipeline state is cached
+static void BM_PipelineStateLookup(benchmark::State &state) {
+    PipelineStateScene scene;
+    for (const auto &key : scene.keys) {
+        cc::pipeline::PipelineStateManager::getOrCreatePipelineState(key, scene.info);
+    }
+    for (auto _ : state) {
+        for (const auto &key : scene.keys) {
+            benchmark::DoNotOptimize(cc::pipeline::PipelineStateManager::getOrCreatePipelineState(key, scene.info));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * PASS_COUNT);
+}
+BENCHMARK(BM_PipelineStateLookup)->Unit(benchmark::kMicrosecond);
+
+// cold cache, every lookup creates and records a pipeline state
+static void BM_PipelineStateCreate(benchmark::State &state) {
+    PipelineStateScene scene;
+    for (auto _ : state) {
+        for (const auto &key : scene.keys) {
+            benchmark::DoNotOptimize(cc::pipeline::PipelineStateManager::getOrCreatePipelineState(key, scene.info));
+        }
+        state.PauseTiming();
+        cc::pipeline::PipelineStateManager::destroyAll();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * PASS_COUNT);
+}
+BENCHMARK(BM_PipelineStateCreate)->Unit(benchmark::kMicrosecond);
+
+static void BM_PipelineStateSerialize(benchmark::State &state) {
+    PipelineStateScene scene;
+    for (const auto &key : scene.keys) {
+        cc::pipeline::PipelineStateManager::getOrCreatePipelineState(key, scene.info);
+    }
+    ccstd::vector<uint8_t> bytes;
+    for (auto _ : state) {
+        bytes.clear();
+        cc::pipeline::PipelineStateManager::serializeCache(bytes);
+        benchmark::DoNotOptimize(bytes.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(bytes.size()));
+}
+BENCHMARK(BM_PipelineStateSerialize)->Unit(benchmark::kMicrosecond);
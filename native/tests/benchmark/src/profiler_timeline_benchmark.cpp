@@ -0,0 +1,71 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "benchmark/benchmark.h"
+#include "profiler/TimelineRecorder.h"
+
+// the cost of a recorded scope, begin and end events included, should stay well under 100ns
+static void BM_TimelineScopeRecording(benchmark::State &state) {
+    auto *recorder = cc::TimelineRecorder::getInstance();
+    recorder->start();
+    for (auto _ : state) {
+        cc::TimelineScope scope("BenchmarkScope");
+        benchmark::ClobberMemory();
+    }
+    recorder->stop();
+}
+BENCHMARK(BM_TimelineScopeRecording)->ThreadRange(1, 4);
+
+static void BM_TimelineScopeIdle(benchmark::State &state) {
+    for (auto _ : state) {
+        cc::TimelineScope scope("BenchmarkScope");
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_TimelineScopeIdle);
+
+static void BM_TimelineCounter(benchmark::State &state) {
+    auto *recorder = cc::TimelineRecorder::getInstance();
+    recorder->start();
+    double value = 0.0;
+    for (auto _ : state) {
+        recorder->counter("BenchmarkCounter", value);
+        value += 1.0;
+    }
+    recorder->stop();
+}
+BENCHMARK(BM_TimelineCounter);
+
+static void BM_TimelineClock(benchmark::State &state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cc::TimelineRecorder::now());
+    }
+}
+BENCHMARK(BM_TimelineClock);
+
+static void BM_TimelineTicks(benchmark::State &state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cc::TimelineRecorder::ticks());
+    }
+}
+BENCHMARK(BM_TimelineTicks);
@@ -0,0 +1,127 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <cstdint>
+#include "benchmark/benchmark.h"
+#include "cocos/base/Ptr.h"
+#include "cocos/base/memory/Memory.h"
+#include "cocos/base/std/container/vector.h"
+#include "cocos/core/geometry/AABB.h"
+#include "cocos/core/scene-graph/Node.h"
+#include "cocos/core/scene-graph/TransformHierarchy.h"
+#include "cocos/renderer/gfx-base/GFXDevice.h"
+#include "cocos/scene/Model.h"
+#include "cocos/scene/Pass.h"
+#include "cocos/scene/RenderScene.h"
+#include "cocos/scene/SubModel.h"
+
+namespace {
+
+// a sub-model without passes, enough for the model to write and upload its local UBO
+class LocalSubModel final : public cc::scene::SubModel {
+public:
+    explicit LocalSubModel(cc::gfx::DescriptorSetLayout *layout) {
+        _passes = std::make_shared<ccstd::vector<cc::IntrusivePtr<cc::scene::Pass>>>();
+        _descriptorSet = cc::gfx::Device::getInstance()->createDescriptorSet({layout});
+    }
+};
+
+class LocalModel final : public cc::scene::Model {
+public:
+    void addSubModel(cc::gfx::DescriptorSetLayout *layout) {
+        _subModels.emplace_back(ccnew LocalSubModel(layout));
+        initLocalDescriptors(static_cast<index_t>(_subModels.size() - 1));
+    }
+};
+
+// a flat crowd of models under one root, the root turns every frame so all models are changed
+class ModelScene {
+public:
+    explicit ModelScene(uint32_t modelCount) : root(ccnew cc::Node()), hierarchy(root) {
+        descriptorSetLayout = cc::gfx::Device::getInstance()->createDescriptorSetLayout({});
+
+        for (uint32_t i = 0; i < modelCount; ++i) {
+            auto *node = ccnew cc::Node();
+            node->setPosition(static_cast<float>(i % 128), 0.0F, static_cast<float>(i / 128));
+            node->setParent(root);
+
+            auto *model = ccnew LocalModel();
+            model->initialize();
+            model->setTransform(node);
+            model->setNode(node);
+            model->setModelBounds(ccnew cc::geometry::AABB(0.0F, 0.5F, 0.0F, 0.5F, 0.5F, 0.5F));
+            model->setWorldBounds(ccnew cc::geometry::AABB());
+            model->addSubModel(descriptorSetLayout);
+            scene.addModel(model);
+            nodes.emplace_back(node);
+        }
+        root->walk([](cc::Node *node) { node->setActiveInHierarchy(true); });
+        scene.setTransformHierarchy(&hierarchy);
+    }
+
+    ~ModelScene() {
+        scene.setTransformHierarchy(nullptr);
+        scene.removeModels();
+    }
+
+    void animate(uint32_t frame) {
+        root->setRotationFromEuler(0.0F, static_cast<float>(frame % 360), 0.0F);
+    }
+
+    cc::IntrusivePtr<cc::Node> root;
+    ccstd::vector<cc::IntrusivePtr<cc::Node>> nodes;
+    cc::IntrusivePtr<cc::gfx::DescriptorSetLayout> descriptorSetLayout;
+    cc::TransformHierarchy hierarchy;
+    cc::scene::RenderScene scene;
+};
+
+} // namespace
+
+// the per model update RenderScene used before models were split into a parallel and a commit phase
+static void BM_RenderSceneUpdateSerial(benchmark::State &state) {
+    ModelScene scene(static_cast<uint32_t>(state.range(0)));
+    uint32_t frame = 0;
+    for (auto _ : state) {
+        scene.animate(++frame);
+        scene.hierarchy.update();
+        for (const auto &model : scene.scene.getModels()) {
+            model->updateTransform(frame);
+            model->updateUBOs(frame);
+            model->updateOctree();
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_RenderSceneUpdateSerial)->Arg(1024)->Arg(16384)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+static void BM_RenderSceneUpdate(benchmark::State &state) {
+    ModelScene scene(static_cast<uint32_t>(state.range(0)));
+    uint32_t frame = 0;
+    for (auto _ : state) {
+        scene.animate(++frame);
+        scene.scene.update(frame);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_RenderSceneUpdate)->Arg(1024)->Arg(16384)->Unit(benchmark::kMicrosecond)->UseRealTime();
@@ -0,0 +1,152 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include <cstdint>
+#include "benchmark/benchmark.h"
+#include "cocos/core/geometry/AABB.h"
+#include "cocos/core/geometry/AABBSoA.h"
+#include "cocos/core/geometry/Frustum.h"
+#include "cocos/core/geometry/Intersect.h"
+#include "cocos/core/scene-graph/Layers.h"
+#include "cocos/math/Mat4.h"
+#include "cocos/math/Quaternion.h"
+#include "cocos/scene/Model.h"
+#include "cocos/scene/Octree.h"
+
+namespace {
+
+constexpr uint32_t SCENE_MODEL_COUNT = 30000;
+
+// a static scene of small boxes scattered in the default octree bounds
+class CullingScene {
+public:
+    CullingScene() {
+        cc::scene::OctreeInfo info;
+        info.setEnabled(true);
+        octree.initialize(info);
+
+        uint32_t seed = 12345U;
+        auto random = [&seed](float min, float max) {
+            seed = seed * 1664525U + 1013904223U;
+            return min + (max - min) * static_cast<float>(seed >> 8) / static_cast<float>(1U << 24);
+        };
+
+        for (uint32_t i = 0; i < SCENE_MODEL_COUNT; ++i) {
+            auto *model = ccnew cc::scene::Model();
+            model->initialize();
+            model->setVisFlags(cc::Layers::Enum::DEFAULT);
+            model->setCastShadow(i % 2 == 0);
+            model->setWorldBounds(ccnew cc::geometry::AABB(random(-1000.0F, 1000.0F), random(-50.0F, 50.0F), random(-1000.0F, 1000.0F),
+                                                           random(0.5F, 5.0F), random(0.5F, 5.0F), random(0.5F, 5.0F)));
+            octree.insert(model);
+            models.emplace_back(model);
+            bounds.push(*model->getWorldBounds());
+        }
+
+        cc::Mat4 transform;
+        cc::Quaternion rot;
+        cc::Quaternion::createFromAxisAngle(cc::Vec3{0.0F, 1.0F, 0.0F}, 0.7F, &rot);
+        cc::Mat4::fromRT(rot, cc::Vec3{0.0F, 10.0F, 0.0F}, &transform);
+        cameraFrustum.split(0.1F, 500.0F, 16.0F / 9.0F, 1.0F, transform);
+        cc::geometry::Frustum::createOrtho(&shadowFrustum, 400.0F, 400.0F, 0.1F, 1000.0F, transform);
+    }
+
+    ~CullingScene() {
+        for (const auto &model : models) {
+            octree.remove(model);
+        }
+    }
+
+    cc::scene::Octree octree;
+    ccstd::vector<cc::IntrusivePtr<cc::scene::Model>> models;
+    cc::geometry::AABBSoA bounds;
+    cc::geometry::Frustum cameraFrustum;
+    cc::geometry::Frustum shadowFrustum;
+};
+
+CullingScene &getScene() {
+    static CullingScene scene;
+    return scene;
+}
+
+const auto VISIBILITY = static_cast<uint32_t>(cc::Layers::Enum::DEFAULT);
+
+} // namespace
+
+// the brute force loop used by SceneCulling when octree is disabled
+static void BM_SceneCullingLinear(benchmark::State &state) {
+    auto &scene = getScene();
+    ccstd::vector<cc::scene::Model *> results;
+    for (auto _ : state) {
+        results.clear();
+        for (const auto &model : scene.models) {
+            if (model->isEnabled() && (VISIBILITY & static_cast<uint32_t>(model->getVisFlags())) &&
+                model->getWorldBounds()->aabbFrustum(scene.cameraFrustum)) {
+                results.push_back(model);
+            }
+        }
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * SCENE_MODEL_COUNT);
+}
+BENCHMARK(BM_SceneCullingLinear)->Unit(benchmark::kMicrosecond);
+
+static void BM_SceneCullingBatch(benchmark::State &state) {
+    auto &scene = getScene();
+    ccstd::vector<uint8_t> results(scene.bounds.size());
+    for (auto _ : state) {
+        cc::geometry::aabbFrustumBatch(scene.bounds, scene.cameraFrustum, results.data());
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * SCENE_MODEL_COUNT);
+}
+BENCHMARK(BM_SceneCullingBatch)->Unit(benchmark::kMicrosecond);
+
+static void BM_SceneCullingOctree(benchmark::State &state) {
+    auto &scene = getScene();
+    const cc::scene::OctreeQuery query{&scene.cameraFrustum, false};
+    ccstd::vector<cc::scene::Model *> results;
+    for (auto _ : state) {
+        results.clear();
+        scene.octree.queryVisibility(VISIBILITY, &query, 1, &results);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * SCENE_MODEL_COUNT);
+}
+BENCHMARK(BM_SceneCullingOctree)->Unit(benchmark::kMicrosecond);
+
+// camera and shadow caster queries sharing one traversal
+static void BM_SceneCullingOctreeWithShadow(benchmark::State &state) {
+    auto &scene = getScene();
+    const cc::scene::OctreeQuery queries[] = {{&scene.cameraFrustum, false}, {&scene.shadowFrustum, true}};
+    ccstd::vector<cc::scene::Model *> results[2];
+    for (auto _ : state) {
+        results[0].clear();
+        results[1].clear();
+        scene.octree.queryVisibility(VISIBILITY, queries, 2, results);
+        benchmark::DoNotOptimize(results[0].data());
+        benchmark::DoNotOptimize(results[1].data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * SCENE_MODEL_COUNT);
+}
+BENCHMARK(BM_SceneCullingOctreeWithShadow)->Unit(benchmark::kMicrosecond);
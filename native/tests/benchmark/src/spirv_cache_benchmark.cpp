@@ -0,0 +1,137 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <cstdint>
+#include "benchmark/benchmark.h"
+#include "cocos/base/std/container/string.h"
+#include "cocos/platform/FileUtils.h"
+#include "cocos/renderer/gfx-base/SPIRVUtils.h"
+
+namespace {
+
+constexpr uint32_t SHADER_COUNT = 32;
+
+const char *const VERTEX_SOURCE = R"(
+layout(location = 0) in vec3 a_position;
+layout(location = 1) in vec3 a_normal;
+layout(location = 2) in vec2 a_texCoord;
+layout(set = 0, binding = 0) uniform CCGlobal { mat4 cc_matViewProj; vec4 cc_time; };
+layout(set = 2, binding = 0) uniform CCLocal { mat4 cc_matWorld; mat4 cc_matWorldIT; };
+layout(location = 0) out vec3 v_normal;
+layout(location = 1) out vec2 v_uv;
+void main () {
+  vec4 pos = cc_matWorld * vec4(a_position, 1.0);
+  #if VARIANT % 2
+    pos.y += sin(cc_time.x + pos.x) * 0.1;
+  #endif
+  v_normal = normalize((cc_matWorldIT * vec4(a_normal, 0.0)).xyz);
+  v_uv = a_texCoord * float(VARIANT + 1);
+  gl_Position = cc_matViewProj * pos;
+}
+)";
+
+const char *const FRAGMENT_SOURCE = R"(
+layout(location = 0) in vec3 v_normal;
+layout(location = 1) in vec2 v_uv;
+layout(set = 1, binding = 0) uniform sampler2D mainTexture;
+layout(set = 1, binding = 1) uniform Constants { vec4 mainColor; vec4 lightDir; };
+layout(location = 0) out vec4 fragColor;
+void main () {
+  vec4 color = mainColor * texture(mainTexture, v_uv);
+  float ndl = max(dot(normalize(v_normal), -lightDir.xyz), 0.0);
+  #if VARIANT % 3
+    color.rgb *= 0.5 + 0.5 * ndl;
+  #else
+    color.rgb *= ndl;
+  #endif
+  fragColor = color;
+}
+)";
+
+// SHADER_COUNT variants of a lit shader, sources as the vulkan backend compiles them
+struct SPIRVScene {
+    SPIRVScene() {
+        cc::gfx::SPIRVUtils::getInstance()->initialize(0);
+        for (uint32_t i = 0; i < SHADER_COUNT; ++i) {
+            ccstd::string header = "#version 450\n#define VARIANT " + std::to_string(i) + "\n";
+            stages.push_back({cc::gfx::ShaderStageFlagBit::VERTEX, header + VERTEX_SOURCE});
+            stages.push_back({cc::gfx::ShaderStageFlagBit::FRAGMENT, header + FRAGMENT_SOURCE});
+        }
+        cacheDirectory = cc::FileUtils::getInstance()->getWritablePath() + "spirv-cache-benchmark/";
+        cc::FileUtils::getInstance()->removeDirectory(cacheDirectory);
+        cc::FileUtils::getInstance()->createDirectory(cacheDirectory);
+    }
+
+    ~SPIRVScene() {
+        cc::gfx::SPIRVUtils::getInstance()->setCacheDirectory({});
+        cc::gfx::SPIRVUtils::getInstance()->destroy();
+        cc::FileUtils::getInstance()->removeDirectory(cacheDirectory);
+    }
+
+    void compileAll() const {
+        auto *spirv = cc::gfx::SPIRVUtils::getInstance();
+        for (const auto &stage : stages) {
+            spirv->compileGLSL(stage.stage, stage.source);
+            benchmark::DoNotOptimize(spirv->getOutputData());
+        }
+    }
+
+    cc::gfx::ShaderStageList stages;
+    ccstd::string cacheDirectory;
+};
+
+} // namespace
+
+// first run, every stage goes through glslang one after another
+static void BM_SPIRVCompileCold(benchmark::State &state) {
+    SPIRVScene scene;
+    for (auto _ : state) {
+        scene.compileAll();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(scene.stages.size()));
+}
+BENCHMARK(BM_SPIRVCompileCold)->Unit(benchmark::kMillisecond);
+
+// first run, the misses are compiled on the job system before being picked up
+static void BM_SPIRVCompileColdParallel(benchmark::State &state) {
+    SPIRVScene scene;
+    for (auto _ : state) {
+        cc::gfx::SPIRVUtils::getInstance()->precompileGLSL(scene.stages);
+        scene.compileAll();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(scene.stages.size()));
+}
+BENCHMARK(BM_SPIRVCompileColdParallel)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// later runs, every stage is read back from the disk cache
+static void BM_SPIRVCompileWarm(benchmark::State &state) {
+    SPIRVScene scene;
+    cc::gfx::SPIRVUtils::getInstance()->setCacheDirectory(scene.cacheDirectory);
+    scene.compileAll();
+    for (auto _ : state) {
+        scene.compileAll();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(scene.stages.size()));
+}
+BENCHMARK(BM_SPIRVCompileWarm)->Unit(benchmark::kMillisecond);
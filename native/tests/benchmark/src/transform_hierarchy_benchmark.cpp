@@ -0,0 +1,131 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include <cstdint>
+#include "benchmark/benchmark.h"
+#include "cocos/base/Ptr.h"
+#include "cocos/base/memory/Memory.h"
+#include "cocos/base/std/container/vector.h"
+#include "cocos/core/scene-graph/Node.h"
+#include "cocos/core/scene-graph/TransformHierarchy.h"
+
+namespace {
+
+// rootChildren subtrees under the root, each holding chainsPerChild chains of chainLength nodes
+struct HierarchyShape {
+    uint32_t rootChildren;
+    uint32_t chainsPerChild;
+    uint32_t chainLength;
+};
+
+class TransformScene {
+public:
+    explicit TransformScene(const HierarchyShape &shape) {
+        root = ccnew cc::Node();
+        nodes.emplace_back(root);
+        for (uint32_t i = 0; i < shape.rootChildren; ++i) {
+            auto *child = ccnew cc::Node();
+            child->setPosition(static_cast<float>(i), 0.0F, 0.0F);
+            child->setParent(root);
+            nodes.emplace_back(child);
+            movers.emplace_back(child);
+            for (uint32_t c = 0; c < shape.chainsPerChild; ++c) {
+                cc::Node *parent = child;
+                for (uint32_t d = 0; d < shape.chainLength; ++d) {
+                    auto *node = ccnew cc::Node();
+                    node->setPosition(0.0F, 1.0F, static_cast<float>(c));
+                    node->setRotationFromEuler(0.0F, 10.0F, 0.0F);
+                    node->setScale(1.01F, 1.0F, 0.99F);
+                    node->setParent(parent);
+                    nodes.emplace_back(node);
+                    parent = node;
+                }
+            }
+        }
+        root->walk([](cc::Node *node) { node->setActiveInHierarchy(true); });
+    }
+
+    // every subtree moves each frame, like an animated crowd
+    void animate(uint32_t frame) {
+        const float angle = static_cast<float>(frame % 360);
+        for (auto *node : movers) {
+            node->setRotationFromEuler(0.0F, angle, 0.0F);
+        }
+    }
+
+    cc::IntrusivePtr<cc::Node> root;
+    ccstd::vector<cc::IntrusivePtr<cc::Node>> nodes;
+    ccstd::vector<cc::Node *> movers;
+};
+
+const HierarchyShape DEEP_SHAPE{16, 4, 256};
+const HierarchyShape WIDE_SHAPE{4096, 4, 2};
+
+void updateLazy(benchmark::State &state, const HierarchyShape &shape) {
+    TransformScene scene(shape);
+    uint32_t frame = 0;
+    for (auto _ : state) {
+        scene.animate(++frame);
+        for (const auto &node : scene.nodes) {
+            benchmark::DoNotOptimize(node->getWorldMatrix().m[0]);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(scene.nodes.size()));
+}
+
+void updateHierarchy(benchmark::State &state, const HierarchyShape &shape) {
+    TransformScene scene(shape);
+    cc::TransformHierarchy hierarchy(scene.root);
+    uint32_t frame = 0;
+    for (auto _ : state) {
+        scene.animate(++frame);
+        hierarchy.update();
+        for (const auto &node : scene.nodes) {
+            benchmark::DoNotOptimize(node->getWorldMatrix().m[0]);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(scene.nodes.size()));
+}
+
+} // namespace
+
+// Node::updateWorldTransform resolving each node through its parent chain on first access
+static void BM_TransformLazyDeep(benchmark::State &state) {
+    updateLazy(state, DEEP_SHAPE);
+}
+BENCHMARK(BM_TransformLazyDeep)->Unit(benchmark::kMicrosecond);
+
+static void BM_TransformHierarchyDeep(benchmark::State &state) {
+    updateHierarchy(state, DEEP_SHAPE);
+}
+BENCHMARK(BM_TransformHierarchyDeep)->Unit(benchmark::kMicrosecond);
+
+static void BM_TransformLazyWide(benchmark::State &state) {
+    updateLazy(state, WIDE_SHAPE);
+}
+BENCHMARK(BM_TransformLazyWide)->Unit(benchmark::kMicrosecond);
+
+static void BM_TransformHierarchyWide(benchmark::State &state) {
+    updateHierarchy(state, WIDE_SHAPE);
+}
+BENCHMARK(BM_TransformHierarchyWide)->Unit(benchmark::kMicrosecond);
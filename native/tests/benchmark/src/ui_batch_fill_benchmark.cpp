@@ -0,0 +1,154 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include <memory>
+#include "2d/renderer/RenderDrawInfo.h"
+#include "2d/renderer/RenderEntity.h"
+#include "2d/renderer/UIBufferFiller.h"
+#include "2d/renderer/UIMeshBuffer.h"
+#include "base/memory/Memory.h"
+#include "benchmark/benchmark.h"
+#include "core/scene-graph/Node.h"
+
+namespace {
+
+constexpr uint8_t STRIDE = 9;
+
+// quads under one root, every frame moves the root so all vertices are refilled
+struct SpriteBatch {
+    explicit SpriteBatch(uint32_t count) {
+        root = ccnew cc::Node();
+        meshBuffer.syncSharedBufferToNative(layout);
+        vData.resize(count * 4 * STRIDE);
+        iData.resize(count * 6);
+        layouts.resize(count * 4);
+        indices.resize(count * 6);
+        for (uint32_t i = 0; i < count; ++i) {
+            cc::IntrusivePtr<cc::Node> node = ccnew cc::Node();
+            node->setPosition(static_cast<float>(i % 128), static_cast<float>(i / 128), 0.0F);
+            node->setRotationFromEuler(0.0F, 0.0F, static_cast<float>(i % 360));
+            root->addChild(node);
+            nodes.push_back(node);
+
+            cc::IntrusivePtr<cc::RenderEntity> entity = ccnew cc::RenderEntity(cc::RenderEntityType::DYNAMIC);
+            entity->setNode(node);
+            entity->setOpacity(1.0F);
+            entities.push_back(entity);
+
+            for (uint32_t v = 0; v < 4; ++v) {
+                layouts[i * 4 + v].position.set(static_cast<float>(v & 1U), static_cast<float>(v >> 1U), 0.0F);
+            }
+            const uint16_t quad[] = {0, 1, 2, 1, 3, 2};
+            for (uint32_t n = 0; n < 6; ++n) {
+                indices[i * 6 + n] = static_cast<uint16_t>((i * 4 + quad[n]) & 0xffffU);
+            }
+
+            auto drawInfo = std::make_unique<cc::RenderDrawInfo>();
+            drawInfo->setDrawInfoType(static_cast<uint32_t>(cc::RenderDrawInfoType::COMP));
+            drawInfo->setStride(STRIDE);
+            drawInfo->setVbCount(4);
+            drawInfo->setIbCount(6);
+            drawInfo->setVbBuffer(vData.data() + i * 4 * STRIDE);
+            drawInfo->setIbBuffer(indices.data() + i * 6);
+            drawInfo->setIDataBuffer(iData.data());
+            drawInfo->setMeshBuffer(&meshBuffer);
+            drawInfo->setRender2dBufferToNative(reinterpret_cast<uint8_t *>(layouts.data() + i * 4));
+            drawInfos.push_back(std::move(drawInfo));
+        }
+    }
+
+    void nextFrame() {
+        root->setPosition(root->getPosition().x + 1.0F, 0.0F, 0.0F);
+        meshBuffer.setIndexOffset(0);
+    }
+
+    uint32_t layout[4]{};
+    cc::UIMeshBuffer meshBuffer;
+    cc::IntrusivePtr<cc::Node> root;
+    ccstd::vector<cc::IntrusivePtr<cc::Node>> nodes;
+    ccstd::vector<cc::IntrusivePtr<cc::RenderEntity>> entities;
+    ccstd::vector<std::unique_ptr<cc::RenderDrawInfo>> drawInfos;
+    ccstd::vector<cc::Render2dLayout> layouts;
+    ccstd::vector<uint16_t> indices;
+    ccstd::vector<float> vData;
+    ccstd::vector<uint16_t> iData;
+};
+
+void runFiller(benchmark::State &state, bool parallel) {
+    SpriteBatch batch(static_cast<uint32_t>(state.range(0)));
+    cc::UIBufferFiller filler;
+    filler.setParallelEnabled(parallel);
+    for (auto _ : state) {
+        batch.nextFrame();
+        for (size_t i = 0; i < batch.drawInfos.size(); ++i) {
+            filler.record(batch.entities[i], batch.drawInfos[i].get(), true, true);
+        }
+        filler.flush();
+        benchmark::DoNotOptimize(batch.vData.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+} // namespace
+
+// the fill Batcher2d did inline during the walk
+static void BM_UIFillInline(benchmark::State &state) {
+    SpriteBatch batch(static_cast<uint32_t>(state.range(0)));
+    for (auto _ : state) {
+        batch.nextFrame();
+        for (size_t n = 0; n < batch.drawInfos.size(); ++n) {
+            cc::RenderEntity *entity = batch.entities[n];
+            cc::RenderDrawInfo *drawInfo = batch.drawInfos[n].get();
+            const cc::Mat4 &matrix = entity->getNode()->getWorldMatrix();
+            const uint32_t size = drawInfo->getVbCount() * STRIDE;
+            float *vbBuffer = drawInfo->getVbBuffer();
+            for (uint32_t i = 0; i < size; i += STRIDE) {
+                reinterpret_cast<cc::Vec3 *>(vbBuffer + i)->transformMat4(drawInfo->getRender2dLayout(i)->position, matrix);
+            }
+            cc::Color temp = entity->getColor();
+            for (uint32_t i = 0; i < size; i += STRIDE) {
+                uint32_t offset = i + 5;
+                vbBuffer[offset++] = static_cast<float>(temp.r) / 255.0F;
+                vbBuffer[offset++] = static_cast<float>(temp.g) / 255.0F;
+                vbBuffer[offset++] = static_cast<float>(temp.b) / 255.0F;
+                vbBuffer[offset++] = entity->getOpacity();
+            }
+            uint32_t indexOffset = batch.meshBuffer.getIndexOffset();
+            memcpy(&drawInfo->getIDataBuffer()[indexOffset], drawInfo->getIbBuffer(), drawInfo->getIbCount() * sizeof(uint16_t));
+            batch.meshBuffer.setIndexOffset(indexOffset + drawInfo->getIbCount());
+        }
+        benchmark::DoNotOptimize(batch.vData.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_UIFillInline)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+static void BM_UIBufferFillerSerial(benchmark::State &state) {
+    runFiller(state, false);
+}
+BENCHMARK(BM_UIBufferFillerSerial)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+static void BM_UIBufferFillerParallel(benchmark::State &state) {
+    runFiller(state, true);
+}
+BENCHMARK(BM_UIBufferFillerParallel)->Arg(1000)->Arg(10000)->UseRealTime()->Unit(benchmark::kMicrosecond);
@@ -8,6 +8,7 @@ set(CC_ENABLE_SWAPPY OFF)
 # set(COCOS_X_PATH "I:/Github/editor-3d/resources/3d/engine/native")
 set(USE_JOB_SYSTEM_TASKFLOW OFF)
 set(USE_JOB_SYSTEM_TBB OFF)
+set(USE_JOB_SYSTEM_NATIVE OFF)
 set(ENABLE_ANTIALIAS_FXAA OFF)
 set(CC_USE_VULKAN OFF)
 set(USE_PHYSICS_PHYSX OFF)
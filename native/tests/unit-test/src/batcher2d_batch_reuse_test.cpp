@@ -0,0 +1,242 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <memory>
+#include "cocos/2d/renderer/Batcher2d.h"
+#include "cocos/2d/renderer/RenderDrawInfo.h"
+#include "cocos/2d/renderer/RenderEntity.h"
+#include "cocos/2d/renderer/UIMeshBuffer.h"
+#include "cocos/bindings/jswrapper/SeApi.h"
+#include "cocos/core/Root.h"
+#include "cocos/core/assets/Material.h"
+#include "cocos/core/scene-graph/Node.h"
+#include "cocos/renderer/core/ProgramLib.h"
+#include "cocos/scene/Pass.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+constexpr uint32_t SPRITE_COUNT = 12;
+constexpr uint8_t STRIDE = 9;
+constexpr uint32_t VERTS_PER_SPRITE = 4;
+constexpr uint32_t INDICES_PER_SPRITE = 6;
+const char *const PROGRAM_NAME = "unit-test-sprite";
+
+// a material pass set up the way Pass::doInit would, without compiling anything
+class TestPass : public scene::Pass {
+public:
+    TestPass(gfx::Shader *shader, gfx::DescriptorSet *descriptorSet, ccstd::hash_t hash) : Pass(Root::getInstance()) {
+        _programName = PROGRAM_NAME;
+        _shader = shader;
+        _descriptorSet = descriptorSet;
+        _hash = hash;
+    }
+    void setShader(gfx::Shader *shader) { _shader = shader; }
+};
+
+class TestMaterial : public Material {
+public:
+    explicit TestMaterial(scene::Pass *pass) {
+        _passes = std::make_shared<ccstd::vector<IntrusivePtr<scene::Pass>>>();
+        _passes->emplace_back(pass);
+    }
+};
+
+struct SpriteScene {
+    SpriteScene() {
+        if (!ProgramLib::getInstance()) {
+            programLib = std::make_unique<ProgramLib>();
+        }
+        IShaderInfo shaderInfo;
+        shaderInfo.name = PROGRAM_NAME;
+        shaderInfo.hash = 0x5eed;
+        ProgramLib::getInstance()->define(shaderInfo);
+
+        auto *device = gfx::Device::getInstance();
+        descriptorSetLayout = device->createDescriptorSetLayout({});
+        descriptorSet = device->createDescriptorSet({descriptorSetLayout});
+        for (auto &shader : shaders) {
+            shader = device->createShader({});
+        }
+        for (uint32_t i = 0; i < 2; ++i) {
+            passes[i] = ccnew TestPass(shaders[i], descriptorSet, i + 1);
+            materials[i] = ccnew TestMaterial(passes[i]);
+        }
+
+        meshBuffer.initialize(ccstd::vector<gfx::Attribute>(*batcher.getDefaultAttribute()), false);
+        meshBuffer.syncSharedBufferToNative(layout);
+        vData.resize((SPRITE_COUNT + 1) * VERTS_PER_SPRITE * STRIDE);
+        iData.resize((SPRITE_COUNT + 1) * INDICES_PER_SPRITE, 0xffff);
+        meshBuffer.setVData(vData.data());
+        meshBuffer.setIData(iData.data());
+        batcher.syncMeshBuffersToNative(0, {&meshBuffer});
+
+        root = ccnew Node();
+        // materials A A A A B B B B A A A A, three runs
+        for (uint32_t i = 0; i < SPRITE_COUNT; ++i) {
+            addSprite(materials[(i / 4) % 2], i);
+        }
+        batcher.syncRootNodesToNative({root.get()});
+    }
+
+    RenderDrawInfo *addSprite(Material *material, uint32_t vertexOffset, index_t siblingIndex = -1) {
+        IntrusivePtr<Node> node = ccnew Node();
+        root->addChild(node);
+        if (siblingIndex >= 0) {
+            node->setSiblingIndex(siblingIndex);
+        }
+        IntrusivePtr<RenderEntity> entity = ccnew RenderEntity(RenderEntityType::DYNAMIC);
+        entity->setNode(node);
+        // the script enables the entity through the shared buffer
+        uint8_t *attrs = nullptr;
+        entity->getEntitySharedBufferForJS()->getArrayBufferData(&attrs, nullptr);
+        reinterpret_cast<EntityAttrLayout *>(attrs)->enabledIndex = 1;
+
+        auto &sprite = *sprites.emplace_back(std::make_unique<Sprite>());
+        sprite.drawInfo = std::make_unique<RenderDrawInfo>();
+        auto *drawInfo = sprite.drawInfo.get();
+        drawInfo->setDrawInfoType(static_cast<uint32_t>(RenderDrawInfoType::COMP));
+        drawInfo->setStride(STRIDE);
+        drawInfo->setDataHash(1);
+        drawInfo->setMaterial(material);
+        drawInfo->setMeshBuffer(&meshBuffer);
+        drawInfo->setVbCount(VERTS_PER_SPRITE);
+        drawInfo->setIbCount(INDICES_PER_SPRITE);
+        drawInfo->setVDataBuffer(vData.data());
+        drawInfo->setIDataBuffer(iData.data());
+        drawInfo->setVbBuffer(vData.data() + vertexOffset * VERTS_PER_SPRITE * STRIDE);
+        for (uint32_t n = 0; n < INDICES_PER_SPRITE; ++n) {
+            sprite.indices[n] = static_cast<uint16_t>(vertexOffset * VERTS_PER_SPRITE + n % VERTS_PER_SPRITE);
+        }
+        drawInfo->setIbBuffer(sprite.indices);
+        sprite.layouts.resize(VERTS_PER_SPRITE);
+        drawInfo->setRender2dBufferToNative(reinterpret_cast<uint8_t *>(sprite.layouts.data()));
+        entity->addDynamicRenderDrawInfo(drawInfo);
+
+        sprite.node = node;
+        sprite.entity = entity;
+        return drawInfo;
+    }
+
+    void renderFrame() {
+        root->walk([](Node *node) { node->setActiveInHierarchy(true); });
+        meshBuffer.setByteOffset(static_cast<uint32_t>(vData.size() * sizeof(float)));
+        batcher.update();
+        batcher.uploadBuffers();
+        batcher.reset();
+        Node::resetChangedFlags();
+    }
+
+    // the indices of the sprites in walk order, as the mesh buffer must hold them
+    bool indicesMatchWalkOrder() {
+        uint32_t offset = 0;
+        for (const auto &child : root->getChildren()) {
+            auto *entity = static_cast<RenderEntity *>(child->getUserData());
+            auto *drawInfo = entity->getRenderDrawInfoAt(0);
+            if (memcmp(&iData[offset], drawInfo->getIbBuffer(), INDICES_PER_SPRITE * sizeof(uint16_t)) != 0) {
+                return false;
+            }
+            offset += INDICES_PER_SPRITE;
+        }
+        return true;
+    }
+
+    struct Sprite {
+        IntrusivePtr<Node> node;
+        IntrusivePtr<RenderEntity> entity;
+        std::unique_ptr<RenderDrawInfo> drawInfo;
+        ccstd::vector<Render2dLayout> layouts;
+        uint16_t indices[INDICES_PER_SPRITE]{};
+    };
+
+    std::unique_ptr<ProgramLib> programLib;
+    IntrusivePtr<gfx::DescriptorSetLayout> descriptorSetLayout;
+    IntrusivePtr<gfx::DescriptorSet> descriptorSet;
+    IntrusivePtr<gfx::Shader> shaders[3];
+    IntrusivePtr<TestPass> passes[2];
+    IntrusivePtr<Material> materials[2];
+    uint32_t layout[4]{};
+    UIMeshBuffer meshBuffer;
+    ccstd::vector<float> vData;
+    ccstd::vector<uint16_t> iData;
+    IntrusivePtr<Node> root;
+    ccstd::vector<std::unique_ptr<Sprite>> sprites;
+    Batcher2d batcher{Root::getInstance()};
+};
+
+} // namespace
+
+TEST(batcher2dTest, batchReuse) {
+    auto scene = std::make_unique<SpriteScene>();
+    auto &batcher = scene->batcher;
+
+    logLabel = "the first frame builds every batch and fills every sprite";
+    scene->renderFrame();
+    EXPECT_EQ(batcher.getRebuiltBatchCount(), 3U);
+    EXPECT_EQ(batcher.getReusedBatchCount(), 0U);
+    EXPECT_EQ(batcher.getFilledDrawInfoCount(), SPRITE_COUNT);
+    ExpectEq(scene->indicesMatchWalkOrder(), true);
+
+    logLabel = "an unchanged frame reuses every batch and fills nothing";
+    scene->renderFrame();
+    EXPECT_EQ(batcher.getRebuiltBatchCount(), 0U);
+    EXPECT_EQ(batcher.getReusedBatchCount(), 3U);
+    EXPECT_EQ(batcher.getFilledDrawInfoCount(), 0U);
+    ExpectEq(scene->indicesMatchWalkOrder(), true);
+
+    logLabel = "a sprite inserted in front rebuilds its own batch only";
+    scene->addSprite(scene->materials[1], SPRITE_COUNT, 0);
+    scene->renderFrame();
+    EXPECT_EQ(batcher.getRebuiltBatchCount(), 1U);
+    EXPECT_EQ(batcher.getReusedBatchCount(), 3U);
+    // every sprite moved in the index buffer
+    EXPECT_EQ(batcher.getFilledDrawInfoCount(), SPRITE_COUNT + 1);
+    ExpectEq(scene->indicesMatchWalkOrder(), true);
+
+    scene->renderFrame();
+    EXPECT_EQ(batcher.getRebuiltBatchCount(), 0U);
+    EXPECT_EQ(batcher.getReusedBatchCount(), 4U);
+    EXPECT_EQ(batcher.getFilledDrawInfoCount(), 0U);
+
+    logLabel = "a dirty sprite is filled again without touching the batches";
+    scene->sprites[5]->drawInfo->setVertDirty(true);
+    scene->sprites[9]->node->setPosition(1.0F, 2.0F, 0.0F);
+    scene->renderFrame();
+    EXPECT_EQ(batcher.getRebuiltBatchCount(), 0U);
+    EXPECT_EQ(batcher.getReusedBatchCount(), 4U);
+    EXPECT_EQ(batcher.getFilledDrawInfoCount(), 2U);
+
+    logLabel = "a shader swapped under the same pass hash rebuilds the batches using it";
+    scene->passes[1]->setShader(scene->shaders[2]);
+    scene->renderFrame();
+    EXPECT_EQ(batcher.getRebuiltBatchCount(), 2U);
+    EXPECT_EQ(batcher.getReusedBatchCount(), 2U);
+    scene->renderFrame();
+    EXPECT_EQ(batcher.getRebuiltBatchCount(), 0U);
+    EXPECT_EQ(batcher.getReusedBatchCount(), 4U);
+    ExpectEq(scene->indicesMatchWalkOrder(), true);
+}
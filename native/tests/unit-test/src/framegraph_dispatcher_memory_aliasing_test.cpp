@@ -0,0 +1,184 @@
+/****************************************************************************
+Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "cocos/renderer/pipeline/custom/FGDispatcherGraphs.h"
+#include "cocos/renderer/pipeline/custom/test/test.h"
+#include "gfx-base/GFXDef-common.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+namespace {
+
+using namespace cc::render;
+using cc::gfx::AccessFlagBit;
+using cc::gfx::Format;
+using cc::gfx::SampleCount;
+using cc::gfx::ShaderStageFlagBit;
+using cc::gfx::TextureFlagBit;
+
+constexpr uint32_t INVALID_ID = 0xFFFFFFFF;
+
+ResourceInfo::value_type makeTarget(const char* name, uint32_t width, uint32_t height, Format format, ResourceResidency residency = ResourceResidency::MANAGED, SampleCount sampleCount = SampleCount::ONE) {
+    return {name,
+            {ResourceDimension::TEXTURE2D, 4, width, height, 1, 0, format, sampleCount, TextureFlagBit::NONE, ResourceFlags::SAMPLED | ResourceFlags::COLOR_ATTACHMENT},
+            {residency},
+            {AccessFlagBit::FRAGMENT_SHADER_READ_TEXTURE | AccessFlagBit::COLOR_ATTACHMENT_WRITE}};
+}
+
+// deferred lighting followed by bloom, tone mapping and fxaa at 1440p
+struct DeferredChain {
+    DeferredChain() {
+        resources = {
+            makeTarget("gbufferA", 2560, 1440, Format::RGBA8),
+            makeTarget("gbufferB", 2560, 1440, Format::RGBA16F),
+            makeTarget("depth", 2560, 1440, Format::DEPTH_STENCIL),
+            makeTarget("lit", 2560, 1440, Format::RGBA16F),
+            makeTarget("bloomA", 1280, 720, Format::RGBA16F),
+            makeTarget("bloomB", 1280, 720, Format::RGBA16F),
+            makeTarget("ldr", 2560, 1440, Format::RGBA8),
+            makeTarget("backbuffer", 2560, 1440, Format::RGBA8, ResourceResidency::BACKBUFFER),
+        };
+        rasterData = {
+            {PassType::RASTER, {{{}, {"gbufferA", "gbufferB", "depth"}}}},
+            {PassType::RASTER, {{{"gbufferA", "gbufferB", "depth"}, {"lit"}}}},
+            {PassType::RASTER, {{{"lit"}, {"bloomA"}}}},
+            {PassType::RASTER, {{{"bloomA"}, {"bloomB"}}}},
+            {PassType::RASTER, {{{"lit", "bloomB"}, {"ldr"}}}},
+            {PassType::RASTER, {{{"ldr"}, {"backbuffer"}}}},
+            {PassType::PRESENT, {{{"backbuffer"}, {}}}},
+        };
+        const LayoutUnit gbufferA{"gbufferA", 0, ShaderStageFlagBit::FRAGMENT};
+        const LayoutUnit gbufferB{"gbufferB", 1, ShaderStageFlagBit::FRAGMENT};
+        const LayoutUnit depth{"depth", 2, ShaderStageFlagBit::FRAGMENT};
+        const LayoutUnit lit{"lit", 3, ShaderStageFlagBit::FRAGMENT};
+        const LayoutUnit bloomA{"bloomA", 4, ShaderStageFlagBit::FRAGMENT};
+        const LayoutUnit bloomB{"bloomB", 5, ShaderStageFlagBit::FRAGMENT};
+        const LayoutUnit ldr{"ldr", 6, ShaderStageFlagBit::FRAGMENT};
+        const LayoutUnit backbuffer{"backbuffer", 7, ShaderStageFlagBit::FRAGMENT};
+        layoutInfo = {
+            {gbufferA, gbufferB, depth},
+            {gbufferA, gbufferB, depth, lit},
+            {lit, bloomA},
+            {bloomA, bloomB},
+            {lit, bloomB, ldr},
+            {ldr, backbuffer},
+            {backbuffer},
+        };
+    }
+
+    ResourceInfo resources;
+    ViewInfo rasterData;
+    LayoutInfo layoutInfo;
+};
+
+} // namespace
+
+TEST(fgDispatcherMemoryAliasing, deferredChain) {
+    DeferredChain chain;
+
+    boost::container::pmr::memory_resource* resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+
+    fillTestGraph(chain.rasterData, chain.resources, chain.layoutInfo, renderGraph, rescGraph, layoutGraphData);
+
+    FrameGraphDispatcher fgDispatcher(rescGraph, renderGraph, layoutGraphData, resource, resource);
+    fgDispatcher.enableMemoryAliasing(true);
+    fgDispatcher.run();
+
+    const auto& aliased = fgDispatcher.aliasedResources;
+    const auto id = [&rescGraph](const char* name) { return rescGraph.valueIndex.at(name); };
+
+    // the backbuffer owns its memory
+    EXPECT_EQ(aliased.size(), 7);
+    EXPECT_EQ(aliased.count(id("backbuffer")), 0);
+
+    // everything alive at once: 2 x RGBA8, D32F + S8, 2 x RGBA16F at full size, 2 x RGBA16F at half size
+    EXPECT_EQ(fgDispatcher.transientMemoryBeforeAliasing, 121651200U);
+    // bloom and ldr reuse the gbuffer and depth memory, lit overlaps with all of them
+    EXPECT_EQ(fgDispatcher.transientMemoryAfterAliasing, 92160000U);
+
+    EXPECT_EQ(aliased.at(id("lit")).prevResourceID, INVALID_ID);
+    EXPECT_EQ(aliased.at(id("bloomA")).prevResourceID, id("gbufferA"));
+    EXPECT_EQ(aliased.at(id("bloomB")).prevResourceID, id("depth"));
+    EXPECT_EQ(aliased.at(id("ldr")).prevResourceID, id("bloomA"));
+    EXPECT_EQ(aliased.at(id("ldr")).memoryBlockID, aliased.at(id("gbufferA")).memoryBlockID);
+
+    // resources sharing a block never overlap
+    for (const auto& [resID, info] : aliased) {
+        if (info.prevResourceID != INVALID_ID) {
+            EXPECT_LT(aliased.at(info.prevResourceID).lastPassID, info.firstPassID);
+        }
+    }
+
+    // the first write to bloomA waits for the last read of gbufferA
+    const auto& bloomA = aliased.at(id("bloomA"));
+    const auto& frontBarriers = fgDispatcher.getBarriers().at(bloomA.firstPassID).blockBarrier.frontBarriers;
+    auto iter = std::find_if(frontBarriers.begin(), frontBarriers.end(), [&](const Barrier& barrier) {
+        return barrier.resourceID == id("bloomA");
+    });
+    ASSERT_NE(iter, frontBarriers.end());
+    EXPECT_EQ(iter->beginStatus.vertID, aliased.at(id("gbufferA")).lastPassID);
+    EXPECT_EQ(iter->beginStatus.access, cc::gfx::MemoryAccessBit::READ_ONLY);
+    EXPECT_EQ(iter->endStatus.vertID, bloomA.firstPassID);
+}
+
+TEST(fgDispatcherMemoryAliasing, disabled) {
+    DeferredChain chain;
+
+    boost::container::pmr::memory_resource* resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+
+    fillTestGraph(chain.rasterData, chain.resources, chain.layoutInfo, renderGraph, rescGraph, layoutGraphData);
+
+    FrameGraphDispatcher fgDispatcher(rescGraph, renderGraph, layoutGraphData, resource, resource);
+    fgDispatcher.run();
+
+    EXPECT_TRUE(fgDispatcher.aliasedResources.empty());
+    EXPECT_EQ(fgDispatcher.transientMemoryAfterAliasing, 0U);
+}
+
+TEST(fgDispatcherMemoryAliasing, multisampled) {
+    DeferredChain chain;
+    chain.resources[0] = makeTarget("gbufferA", 2560, 1440, Format::RGBA8, ResourceResidency::MANAGED, SampleCount::MULTIPLE_BALANCE);
+
+    boost::container::pmr::memory_resource* resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+
+    fillTestGraph(chain.rasterData, chain.resources, chain.layoutInfo, renderGraph, rescGraph, layoutGraphData);
+
+    FrameGraphDispatcher fgDispatcher(rescGraph, renderGraph, layoutGraphData, resource, resource);
+    fgDispatcher.enableMemoryAliasing(true);
+    fgDispatcher.run();
+
+    // gbufferA counts 8 samples, the most a backend picks for MULTIPLE_BALANCE
+    EXPECT_EQ(fgDispatcher.transientMemoryBeforeAliasing, 121651200U + 2560U * 1440U * 4U * 7U);
+    // its block is never shrunk below the multisampled size by the resources aliasing it
+    EXPECT_GE(fgDispatcher.transientMemoryAfterAliasing, 2560U * 1440U * 4U * 8U + 2560U * 1440U * 8U);
+}
@@ -0,0 +1,189 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "base/RefCounted.h"
+#include "frame-graph/Resource.h"
+#include "frame-graph/ResourceAllocator.h"
+#include "gfx-base/GFXDevice.h"
+#include "gtest/gtest.h"
+
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+class FakeTexture : public RefCounted {
+public:
+    explicit FakeTexture(const gfx::TextureInfo &info) : info(info) {}
+    void resize(uint32_t width, uint32_t height) {
+        info.width = width;
+        info.height = height;
+    }
+    gfx::TextureInfo info;
+};
+
+struct FakeTextureCreator {
+    FakeTexture *operator()(const gfx::TextureInfo &desc) const {
+        return ccnew FakeTexture(desc);
+    }
+};
+
+using TextureAllocator = framegraph::ResourceAllocator<FakeTexture, gfx::TextureInfo, FakeTextureCreator>;
+
+gfx::TextureInfo makeTarget(uint32_t width, uint32_t height, gfx::Format format = gfx::Format::RGBA8) {
+    gfx::TextureInfo info;
+    info.usage = gfx::TextureUsageBit::COLOR_ATTACHMENT | gfx::TextureUsageBit::SAMPLED;
+    info.format = format;
+    info.width = width;
+    info.height = height;
+    return info;
+}
+
+} // namespace
+
+TEST(frameGraphResourceAllocator, resizeAndEvict) {
+    auto &allocator = TextureAllocator::getInstance();
+    const auto &stats = allocator.getStats();
+
+    const auto full = makeTarget(1920, 1080);
+    const auto scaled = makeTarget(1728, 972);
+    const uint64_t fullBytes = 1920 * 1080 * 4;
+    const uint64_t scaledBytes = 1728 * 972 * 4;
+
+    allocator.tick();
+    FakeTexture *first = allocator.alloc(full);
+    EXPECT_EQ(stats.liveBytes, fullBytes);
+    allocator.free(first);
+    allocator.endFrame();
+
+    // same descriptor, same texture
+    allocator.tick();
+    EXPECT_EQ(allocator.alloc(full), first);
+    allocator.free(first);
+    allocator.endFrame();
+
+    // dynamic resolution kicks in, the idle texture is resized in place
+    allocator.tick();
+    EXPECT_EQ(allocator.alloc(scaled), first);
+    EXPECT_EQ(first->info.width, 1728);
+    EXPECT_EQ(first->info.height, 972);
+    EXPECT_EQ(stats.resizeCount, 1);
+    EXPECT_EQ(stats.pooledBytes, scaledBytes);
+    EXPECT_EQ(stats.peakBytes, fullBytes);
+    allocator.free(first);
+    allocator.endFrame();
+
+    // textures freed before submission are never resized
+    allocator.tick();
+    EXPECT_EQ(allocator.alloc(scaled), first);
+    allocator.free(first);
+    FakeTexture *second = allocator.alloc(full);
+    EXPECT_NE(second, first);
+    EXPECT_EQ(stats.pooledBytes, scaledBytes + fullBytes);
+    allocator.free(second);
+    allocator.endFrame();
+
+    allocator.tick();
+    EXPECT_EQ(allocator.alloc(full), second);
+    allocator.free(second);
+    allocator.endFrame();
+
+    // the least recently used texture goes first
+    allocator.setBudget(10000000);
+    allocator.gc(1000);
+    EXPECT_EQ(stats.evictCount, 1);
+    EXPECT_EQ(stats.pooledBytes, fullBytes);
+    allocator.setBudget(0);
+
+    // a different format never aliases
+    allocator.tick();
+    FakeTexture *hdr = allocator.alloc(makeTarget(1920, 1080, gfx::Format::RGBA16F));
+    EXPECT_NE(hdr, second);
+    EXPECT_EQ(second->info.width, 1920);
+    allocator.free(hdr);
+    allocator.endFrame();
+
+    EXPECT_EQ(stats.allocCount, 7);
+    EXPECT_EQ(stats.reuseCount, 4);
+    EXPECT_EQ(stats.liveBytes, 0);
+
+    allocator.gc(0);
+    EXPECT_EQ(stats.pooledBytes, 0);
+}
+
+TEST(frameGraphResourceAllocator, memorySize) {
+    auto msaa = makeTarget(1920, 1080);
+    EXPECT_EQ(TextureAllocator::getMemorySize(msaa), 1920 * 1080 * 4);
+    // the most samples a backend picks, as the memory aliasing of the custom pipeline counts them
+    msaa.samples = gfx::SampleCount::MULTIPLE_BALANCE;
+    EXPECT_EQ(TextureAllocator::getMemorySize(msaa), 1920 * 1080 * 4 * 8);
+    msaa.samples = gfx::SampleCount::MULTIPLE_QUALITY;
+    EXPECT_EQ(TextureAllocator::getMemorySize(msaa), 1920 * 1080 * 4 * 16);
+}
+
+TEST(frameGraphResourceAllocator, resizeDropsFramebuffers) {
+    auto *device = gfx::Device::getInstance();
+    auto &textures = framegraph::Texture::Allocator::getInstance();
+    auto &framebuffers = framegraph::Framebuffer::Allocator::getInstance();
+
+    gfx::RenderPassInfo renderPassInfo;
+    renderPassInfo.colorAttachments.emplace_back();
+    renderPassInfo.colorAttachments.back().format = gfx::Format::RGBA8;
+    gfx::RenderPass *renderPass = device->createRenderPass(renderPassInfo);
+
+    // one frame rendering into a transient target of the given size
+    auto frame = [&](const gfx::TextureInfo &desc, gfx::Texture **texture) {
+        textures.tick();
+        framebuffers.tick();
+        *texture = textures.alloc(desc);
+        gfx::FramebufferInfo info;
+        info.renderPass = renderPass;
+        info.colorTextures.push_back(*texture);
+        gfx::Framebuffer *framebuffer = framebuffers.alloc(info);
+        framebuffers.free(framebuffer);
+        textures.free(*texture);
+        textures.endFrame();
+        return framebuffer;
+    };
+
+    gfx::Texture *texture{nullptr};
+    gfx::Framebuffer *first = frame(makeTarget(1920, 1080), &texture);
+    first->addRef();
+    gfx::Texture *const target = texture;
+    EXPECT_EQ(frame(makeTarget(1920, 1080), &texture), first);
+
+    // resized and resized back, the pooled framebuffer refers to storage that is gone
+    EXPECT_NE(frame(makeTarget(1728, 972), &texture), first);
+    EXPECT_EQ(texture, target);
+    EXPECT_NE(frame(makeTarget(1920, 1080), &texture), first);
+    EXPECT_EQ(texture, target);
+    EXPECT_EQ(first->getRefCount(), 1);
+    first->release();
+
+    framebuffers.gc(0);
+    textures.gc(0);
+    CC_SAFE_DESTROY_AND_DELETE(renderPass);
+}
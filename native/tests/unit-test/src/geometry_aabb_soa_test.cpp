@@ -0,0 +1,222 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include <algorithm>
+#include <cstdint>
+#include "cocos/core/geometry/AABB.h"
+#include "cocos/core/geometry/AABBSoA.h"
+#include "cocos/core/geometry/Frustum.h"
+#include "cocos/core/geometry/Intersect.h"
+#include "cocos/core/scene-graph/Layers.h"
+#include "cocos/math/Mat4.h"
+#include "cocos/math/Quaternion.h"
+#include "cocos/scene/Model.h"
+#include "cocos/scene/Octree.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+namespace {
+
+// deterministic pseudo random numbers, so failures are reproducible
+class Random {
+public:
+    float next(float min, float max) {
+        _seed = _seed * 1664525U + 1013904223U;
+        return min + (max - min) * static_cast<float>(_seed >> 8) / static_cast<float>(1U << 24);
+    }
+
+private:
+    uint32_t _seed{12345U};
+};
+
+void createFrustum(cc::geometry::Frustum &frustum) {
+    cc::Mat4 transform;
+    cc::Quaternion rot;
+    cc::Quaternion::createFromAxisAngle(cc::Vec3{0.0F, 1.0F, 0.0F}, 0.7F, &rot);
+    cc::Mat4::fromRT(rot, cc::Vec3{10.0F, 5.0F, -20.0F}, &transform);
+    frustum.split(1.0F, 300.0F, 16.0F / 9.0F, 1.0F, transform);
+}
+
+} // namespace
+
+TEST(geometryAABBSoATest, batchMatchesScalar) {
+    cc::geometry::Frustum frustum;
+    createFrustum(frustum);
+
+    Random random;
+    // cover every tail length of the 4 and 8 lanes kernels
+    for (uint32_t count = 0; count < 300; count += 13) {
+        logLabel = "boxes " + std::to_string(count);
+        cc::geometry::AABBSoA soa;
+        ccstd::vector<cc::geometry::AABB> boxes;
+        for (uint32_t i = 0; i < count; ++i) {
+            boxes.emplace_back(random.next(-300.0F, 300.0F), random.next(-50.0F, 50.0F), random.next(-300.0F, 300.0F),
+                               random.next(0.1F, 20.0F), random.next(0.1F, 20.0F), random.next(0.1F, 20.0F));
+            soa.push(boxes.back());
+        }
+        EXPECT_EQ(soa.size(), count);
+
+        ccstd::vector<uint8_t> results(count, 2);
+        cc::geometry::aabbFrustumBatch(soa, frustum, results.data());
+        for (uint32_t i = 0; i < count; ++i) {
+            ExpectEq(results[i] != 0, cc::geometry::aabbFrustum(boxes[i], frustum) != 0);
+        }
+    }
+}
+
+TEST(geometryAABBSoATest, octreeMultiQuery) {
+    cc::scene::Octree octree;
+    cc::scene::OctreeInfo info;
+    info.setEnabled(true);
+    octree.initialize(info);
+
+    cc::geometry::Frustum cameraFrustum;
+    createFrustum(cameraFrustum);
+    cc::geometry::Frustum shadowFrustum;
+    cc::geometry::Frustum::createOrtho(&shadowFrustum, 200.0F, 200.0F, 0.1F, 500.0F, cc::Mat4::IDENTITY);
+
+    // enough models to take the parallel path
+    Random random;
+    ccstd::vector<cc::IntrusivePtr<cc::scene::Model>> models;
+    for (uint32_t i = 0; i < 3000; ++i) {
+        auto *model = ccnew cc::scene::Model();
+        model->initialize();
+        model->setVisFlags(cc::Layers::Enum::DEFAULT);
+        model->setCastShadow(i % 3 == 0);
+        model->setWorldBounds(ccnew cc::geometry::AABB(random.next(-900.0F, 900.0F), random.next(-100.0F, 100.0F), random.next(-900.0F, 900.0F),
+                                                       random.next(0.5F, 10.0F), random.next(0.5F, 10.0F), random.next(0.5F, 10.0F)));
+        octree.insert(model);
+        models.emplace_back(model);
+    }
+    models[1]->setEnabled(false);
+
+    const auto visibility = static_cast<uint32_t>(cc::Layers::Enum::DEFAULT);
+    const cc::scene::OctreeQuery queries[] = {{&cameraFrustum, false}, {&shadowFrustum, true}};
+    ccstd::vector<cc::scene::Model *> results[2];
+    octree.queryVisibility(visibility, queries, 2, results);
+
+    for (uint32_t q = 0; q < 2; ++q) {
+        logLabel = "query " + std::to_string(q);
+        ccstd::vector<cc::scene::Model *> expected;
+        for (const auto &model : models) {
+            if (model->isEnabled() && (!queries[q].isShadow || model->isCastShadow()) &&
+                cc::geometry::aabbFrustum(*model->getWorldBounds(), *queries[q].frustum)) {
+                expected.push_back(model);
+            }
+        }
+        EXPECT_EQ(results[q].size(), expected.size());
+        for (auto *model : expected) {
+            ExpectEq(std::find(results[q].begin(), results[q].end(), model) != results[q].end(), true);
+        }
+
+        // a single query sees the same models in the same order
+        ccstd::vector<cc::scene::Model *> single;
+        octree.queryVisibility(visibility, &queries[q], 1, &single);
+        ExpectEq(single == results[q], true);
+    }
+
+    for (const auto &model : models) {
+        octree.remove(model);
+    }
+}
+
+// the camera and the CSM levels of SceneCulling share one traversal
+TEST(geometryAABBSoATest, octreeCascadeQueries) {
+    cc::scene::Octree octree;
+    cc::scene::OctreeInfo info;
+    info.setEnabled(true);
+    octree.initialize(info);
+
+    cc::geometry::Frustum cameraFrustum;
+    createFrustum(cameraFrustum);
+    cc::geometry::Frustum cascades[4];
+    for (uint32_t i = 0; i < 4; ++i) {
+        const float size = 50.0F * static_cast<float>(1U << i);
+        cc::geometry::Frustum::createOrtho(&cascades[i], size, size, 0.1F, 1000.0F, cc::Mat4::IDENTITY);
+    }
+
+    Random random;
+    ccstd::vector<cc::IntrusivePtr<cc::scene::Model>> models;
+    for (uint32_t i = 0; i < 3000; ++i) {
+        auto *model = ccnew cc::scene::Model();
+        model->initialize();
+        model->setVisFlags(cc::Layers::Enum::DEFAULT);
+        model->setCastShadow(i % 2 == 0);
+        model->setWorldBounds(ccnew cc::geometry::AABB(random.next(-900.0F, 900.0F), random.next(-100.0F, 100.0F), random.next(-900.0F, 900.0F),
+                                                       random.next(0.5F, 10.0F), random.next(0.5F, 10.0F), random.next(0.5F, 10.0F)));
+        octree.insert(model);
+        models.emplace_back(model);
+    }
+
+    // models without bounds are kept aside until they get bounds
+    cc::IntrusivePtr<cc::scene::Model> unbounded = ccnew cc::scene::Model();
+    unbounded->initialize();
+    octree.insert(unbounded);
+    EXPECT_EQ(octree.getUnboundedModels().size(), 1);
+    ExpectEq(octree.getUnboundedModels()[0] == unbounded.get(), true);
+
+    const auto visibility = static_cast<uint32_t>(cc::Layers::Enum::DEFAULT);
+    cc::scene::OctreeQuery queries[5] = {{&cameraFrustum, false}};
+    for (uint32_t i = 0; i < 4; ++i) {
+        queries[i + 1] = {&cascades[i], true};
+    }
+    ccstd::vector<cc::scene::Model *> results[5];
+    octree.queryVisibility(visibility, queries, 5, results);
+
+    for (uint32_t q = 0; q < 5; ++q) {
+        logLabel = "query " + std::to_string(q);
+        ccstd::vector<cc::scene::Model *> single;
+        octree.queryVisibility(visibility, &queries[q], 1, &single);
+        ExpectEq(single == results[q], true);
+        ExpectEq(std::find(results[q].begin(), results[q].end(), unbounded.get()) == results[q].end(), true);
+    }
+
+    // the union of the cascades holds every caster visible to one of them
+    ccstd::vector<cc::scene::Model *> casters;
+    for (uint32_t q = 1; q < 5; ++q) {
+        for (auto *model : results[q]) {
+            if (std::find(casters.begin(), casters.end(), model) == casters.end()) {
+                casters.push_back(model);
+            }
+        }
+    }
+    uint32_t expected = 0;
+    for (const auto &model : models) {
+        for (const auto &cascade : cascades) {
+            if (model->isCastShadow() && cc::geometry::aabbFrustum(*model->getWorldBounds(), cascade)) {
+                ++expected;
+                break;
+            }
+        }
+    }
+    EXPECT_EQ(casters.size(), expected);
+
+    unbounded->setWorldBounds(ccnew cc::geometry::AABB(0.0F, 0.0F, 0.0F, 1.0F, 1.0F, 1.0F));
+    octree.update(unbounded);
+    EXPECT_EQ(octree.getUnboundedModels().size(), 0);
+
+    octree.remove(unbounded);
+    for (const auto &model : models) {
+        octree.remove(model);
+    }
+}
@@ -0,0 +1,167 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <thread>
+#include "base/Ptr.h"
+#include "base/std/container/vector.h"
+#include "base/threading/MessageQueue.h"
+#include "gtest/gtest.h"
+#include "renderer/gfx-agent/CommandBufferAgent.h"
+#include "renderer/gfx-agent/DeviceAgent.h"
+#include "renderer/gfx-base/GFXCommandBuffer.h"
+#include "utils.h"
+
+using namespace cc;
+using namespace cc::gfx;
+
+namespace {
+
+// device-side command buffer logging the draws replayed into it,
+// executing a secondary moves the log of the secondary into the primary
+class RecordingCommandBuffer final : public CommandBuffer {
+public:
+    ccstd::vector<uint32_t> log;
+
+    void begin(RenderPass * /*renderPass*/, uint32_t /*subpass*/, Framebuffer * /*frameBuffer*/) override {}
+    void end() override {}
+    void beginRenderPass(RenderPass * /*renderPass*/, Framebuffer * /*fbo*/, const Rect & /*renderArea*/, const Color * /*colors*/, float /*depth*/, uint32_t /*stencil*/, CommandBuffer *const * /*secondaryCBs*/, uint32_t /*secondaryCBCount*/) override {}
+    void endRenderPass() override {}
+    void bindPipelineState(PipelineState * /*pso*/) override {}
+    void bindDescriptorSet(uint32_t /*set*/, DescriptorSet * /*descriptorSet*/, uint32_t /*dynamicOffsetCount*/, const uint32_t * /*dynamicOffsets*/) override {}
+    void bindInputAssembler(InputAssembler * /*ia*/) override {}
+    void setViewport(const Viewport & /*vp*/) override {}
+    void setScissor(const Rect & /*rect*/) override {}
+    void setLineWidth(float /*width*/) override {}
+    void setDepthBias(float /*constant*/, float /*clamp*/, float /*slope*/) override {}
+    void setBlendConstants(const Color & /*constants*/) override {}
+    void setDepthBound(float /*minBounds*/, float /*maxBounds*/) override {}
+    void setStencilWriteMask(StencilFace /*face*/, uint32_t /*mask*/) override {}
+    void setStencilCompareMask(StencilFace /*face*/, uint32_t /*ref*/, uint32_t /*mask*/) override {}
+    void nextSubpass() override {}
+    void draw(const DrawInfo &info) override { log.push_back(info.vertexCount); }
+    void updateBuffer(Buffer * /*buff*/, const void * /*data*/, uint32_t /*size*/) override {}
+    void copyBuffersToTexture(const uint8_t *const * /*buffers*/, Texture * /*texture*/, const BufferTextureCopy * /*regions*/, uint32_t /*count*/) override {}
+    void blitTexture(Texture * /*srcTexture*/, Texture * /*dstTexture*/, const TextureBlit * /*regions*/, uint32_t /*count*/, Filter /*filter*/) override {}
+    void execute(CommandBuffer *const *cmdBuffs, uint32_t count) override {
+        for (uint32_t i = 0; i < count; ++i) {
+            auto &secondaryLog = static_cast<RecordingCommandBuffer *>(cmdBuffs[i])->log;
+            log.insert(log.end(), secondaryLog.begin(), secondaryLog.end());
+            secondaryLog.clear();
+        }
+    }
+    void dispatch(const DispatchInfo & /*info*/) override {}
+    void pipelineBarrier(const GeneralBarrier * /*barrier*/, const BufferBarrier *const * /*bufferBarriers*/, const Buffer *const * /*buffers*/, uint32_t /*bufferBarrierCount*/, const TextureBarrier *const * /*textureBarriers*/, const Texture *const * /*textures*/, uint32_t /*textureBarrierCount*/) override {}
+    void beginQuery(QueryPool * /*queryPool*/, uint32_t /*id*/) override {}
+    void endQuery(QueryPool * /*queryPool*/, uint32_t /*id*/) override {}
+    void resetQueryPool(QueryPool * /*queryPool*/) override {}
+
+protected:
+    void doInit(const CommandBufferInfo & /*info*/) override {}
+    void doDestroy() override {}
+};
+
+void recordDraws(CommandBuffer *cmdBuff, uint32_t first, uint32_t count) {
+    cmdBuff->begin();
+    for (uint32_t i = 0; i < count; ++i) {
+        DrawInfo info;
+        info.vertexCount = first + i;
+        cmdBuff->draw(info);
+    }
+    cmdBuff->end();
+}
+
+} // namespace
+
+// secondaries recorded on their own threads are replayed right before the primary executes them,
+// in the order given to execute, the ones never executed are drained by the device flush
+TEST(gfxAgentCommandBufferTest, secondaryReplayOrder) {
+    DeviceAgent *device = DeviceAgent::getInstance();
+    ASSERT_NE(device, nullptr);
+
+    constexpr uint32_t SECONDARY_COUNT = 3;
+    constexpr uint32_t DRAW_COUNT = 5000; // spans several memory chunks per stream
+    constexpr uint32_t FRAME_COUNT = 3;
+
+    auto *primaryActor = ccnew RecordingCommandBuffer;
+    IntrusivePtr<CommandBuffer> primary = ccnew CommandBufferAgent(primaryActor);
+    primary->initialize({device->getQueue(), CommandBufferType::PRIMARY});
+
+    ccstd::vector<RecordingCommandBuffer *> secondaryActors(SECONDARY_COUNT);
+    ccstd::vector<IntrusivePtr<CommandBuffer>> secondaries(SECONDARY_COUNT);
+    for (uint32_t s = 0; s < SECONDARY_COUNT; ++s) {
+        secondaryActors[s] = ccnew RecordingCommandBuffer;
+        secondaries[s] = ccnew CommandBufferAgent(secondaryActors[s]);
+        secondaries[s]->initialize({device->getQueue(), CommandBufferType::SECONDARY});
+    }
+
+    for (uint32_t frame = 0; frame < FRAME_COUNT; ++frame) {
+        ccstd::vector<std::thread> recorders;
+        for (uint32_t s = 0; s < SECONDARY_COUNT; ++s) {
+            recorders.emplace_back([&secondaries, s]() {
+                recordDraws(secondaries[s], (s + 1) * DRAW_COUNT, DRAW_COUNT);
+            });
+        }
+        for (auto &recorder : recorders) {
+            recorder.join();
+        }
+
+        // the last secondary is recorded but never executed
+        CommandBuffer *executed[]{secondaries[1], secondaries[0]};
+        primary->begin();
+        DrawInfo info;
+        info.vertexCount = 1;
+        primary->draw(info);
+        primary->execute(executed, 2);
+        info.vertexCount = 2;
+        primary->draw(info);
+        primary->end();
+
+        CommandBuffer *submitted[]{primary, secondaries[0], secondaries[1], secondaries[2]};
+        device->flushCommands(submitted, 4);
+        device->getMessageQueue()->kickAndWait();
+
+        ccstd::vector<uint32_t> expected{1};
+        for (uint32_t s : {1U, 0U}) {
+            for (uint32_t i = 0; i < DRAW_COUNT; ++i) {
+                expected.push_back((s + 1) * DRAW_COUNT + i);
+            }
+        }
+        expected.push_back(2);
+        EXPECT_EQ(primaryActor->log, expected);
+        EXPECT_TRUE(secondaryActors[0]->log.empty());
+        EXPECT_TRUE(secondaryActors[1]->log.empty());
+
+        ASSERT_EQ(secondaryActors[2]->log.size(), DRAW_COUNT);
+        for (uint32_t i = 0; i < DRAW_COUNT; ++i) {
+            EXPECT_EQ(secondaryActors[2]->log[i], 3 * DRAW_COUNT + i);
+        }
+
+        primaryActor->log.clear();
+        secondaryActors[2]->log.clear();
+    }
+
+    primary = nullptr;
+    secondaries.clear();
+    device->getMessageQueue()->kickAndWait();
+}
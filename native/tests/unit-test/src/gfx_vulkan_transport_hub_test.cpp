@@ -0,0 +1,144 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#include "gtest/gtest.h"
+#include "utils.h"
+
+#if CC_USE_VULKAN
+
+    #include <numeric>
+    #include "base/std/container/vector.h"
+    #include "renderer/gfx-agent/DeviceAgent.h"
+    #include "renderer/gfx-vulkan/VKBuffer.h"
+    #include "renderer/gfx-vulkan/VKDevice.h"
+    #include "renderer/gfx-vulkan/VKGPUObjects.h"
+
+using namespace cc;
+using namespace cc::gfx;
+
+namespace {
+
+// submits the deferred uploads and waits for them, the copies are made visible to the host
+void flushUploads(CCVKDevice *device) {
+    device->gpuTransportHub()->checkIn(
+        [](const CCVKGPUCommandBuffer *gpuCommandBuffer) {
+            VkMemoryBarrier barrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+            vkCmdPipelineBarrier(gpuCommandBuffer->vkCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+                                 0, 1, &barrier, 0, nullptr, 0, nullptr);
+        },
+        true);
+}
+
+ccstd::vector<uint8_t> makeBytes(uint32_t size, uint8_t first) {
+    ccstd::vector<uint8_t> bytes(size);
+    std::iota(bytes.begin(), bytes.end(), first);
+    return bytes;
+}
+
+bool bytesEqual(const uint8_t *data, const uint8_t *expected, uint32_t size) {
+    return memcmp(data, expected, size) == 0;
+}
+
+} // namespace
+
+// runs on any vulkan implementation, lavapipe included, when the tests are configured with CC_UNIT_TEST_GFX_BACKEND
+TEST(gfxVulkanTest, transportHubUploads) {
+    auto *device = CCVKDevice::getInstance();
+    if (!device) {
+        GTEST_SKIP() << "the tests run on the empty device";
+    }
+    // the hub is driven from this thread, keep the device thread out of the way
+    if (auto *agent = DeviceAgent::getInstance()) {
+        agent->setMultithreaded(false);
+    }
+
+    constexpr uint32_t SIZE = 1024;
+    auto *copyCalls = &device->frameTransferStats().copyCalls;
+
+    logLabel = "adjacent regions of a buffer pair are merged and copied in order";
+    {
+        IntrusivePtr<Buffer> src = device->createBuffer({BufferUsageBit::TRANSFER_SRC, MemoryUsageBit::HOST, 2 * SIZE, 1});
+        IntrusivePtr<Buffer> dst = device->createBuffer({BufferUsageBit::TRANSFER_DST, MemoryUsageBit::HOST, SIZE, 1});
+        IntrusivePtr<Buffer> other = device->createBuffer({BufferUsageBit::TRANSFER_DST, MemoryUsageBit::HOST, SIZE, 1});
+        auto *gpuSrc = static_cast<CCVKBuffer *>(src.get())->gpuBuffer();
+        auto *gpuDst = static_cast<CCVKBuffer *>(dst.get())->gpuBuffer();
+        auto *gpuOther = static_cast<CCVKBuffer *>(other.get())->gpuBuffer();
+        auto bytes = makeBytes(2 * SIZE, 1);
+        memcpy(gpuSrc->mappedData, bytes.data(), bytes.size());
+        memset(gpuDst->mappedData, 0, SIZE);
+        memset(gpuOther->mappedData, 0, SIZE);
+
+        auto *hub = device->gpuTransportHub();
+        const uint32_t callsBefore = *copyCalls;
+        hub->checkIn(gpuSrc->vkBuffer, gpuDst->vkBuffer, {64, 0, 64});
+        hub->checkIn(gpuSrc->vkBuffer, gpuDst->vkBuffer, {128, 64, 64});
+        hub->checkIn(gpuSrc->vkBuffer, gpuOther->vkBuffer, {0, 0, SIZE});
+        hub->checkIn(gpuSrc->vkBuffer, gpuDst->vkBuffer, {0, 512, 64}); // not adjacent in the destination
+        flushUploads(device);
+        // one copy per buffer pair
+        EXPECT_EQ(*copyCalls - callsBefore, 2U);
+        ExpectEq(bytesEqual(gpuDst->mappedData, &bytes[64], 128), true);
+        ExpectEq(bytesEqual(gpuDst->mappedData + 512, &bytes[0], 64), true);
+        ExpectEq(bytesEqual(gpuOther->mappedData, &bytes[0], SIZE), true);
+
+        logLabel = "a write over a pending one is recorded after it";
+        hub->checkIn(gpuSrc->vkBuffer, gpuDst->vkBuffer, {0, 0, 256});
+        hub->checkIn(gpuSrc->vkBuffer, gpuDst->vkBuffer, {SIZE, 128, 256});
+        flushUploads(device);
+        ExpectEq(bytesEqual(gpuDst->mappedData, &bytes[0], 128), true);
+        ExpectEq(bytesEqual(gpuDst->mappedData + 128, &bytes[SIZE], 256), true);
+    }
+
+    logLabel = "device buffers go through staging once they have been submitted";
+    {
+        IntrusivePtr<Buffer> buffer = device->createBuffer({BufferUsageBit::VERTEX, MemoryUsageBit::DEVICE, SIZE, 1});
+        auto *gpuBuffer = static_cast<CCVKBuffer *>(buffer.get())->gpuBuffer();
+        auto first = makeBytes(SIZE, 3);
+        auto second = makeBytes(SIZE, 7);
+        auto &stats = device->frameTransferStats();
+
+        const uint64_t directBefore = stats.directBytes;
+        buffer->update(first.data(), SIZE);
+        if (gpuBuffer->mappedData) { // unified memory, e.g. lavapipe
+            EXPECT_EQ(stats.directBytes - directBefore, SIZE);
+            ExpectEq(bytesEqual(gpuBuffer->mappedData, first.data(), SIZE), true);
+        }
+        flushUploads(device);
+
+        const uint64_t stagingBefore = stats.stagingBytes;
+        buffer->update(second.data(), SIZE);
+        EXPECT_EQ(stats.stagingBytes - stagingBefore, SIZE);
+        if (gpuBuffer->mappedData) {
+            // nothing is written before the copy is submitted
+            ExpectEq(bytesEqual(gpuBuffer->mappedData, first.data(), SIZE), true);
+            flushUploads(device);
+            ExpectEq(bytesEqual(gpuBuffer->mappedData, second.data(), SIZE), true);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,259 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "base/job-system/job-system-native/NativeJobGraph.h"
+#include "base/job-system/job-system-native/NativeJobSystem.h"
+#include "base/job-system/job-system-native/WorkStealingDeque.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+TEST(jobSystemNativeTest, workStealingDeque) {
+    cc::WorkStealingDeque<uint32_t> deque(4);
+    ccstd::vector<uint32_t> items(100);
+    for (uint32_t i = 0; i < 100; ++i) {
+        items[i] = i;
+        deque.push(&items[i]);
+    }
+    EXPECT_EQ(deque.size(), 100);
+    EXPECT_GE(deque.capacity(), 100);
+
+    // the owner works LIFO, thieves FIFO
+    EXPECT_EQ(*deque.pop(), 99U);
+    EXPECT_EQ(*deque.steal(), 0U);
+    EXPECT_EQ(*deque.steal(), 1U);
+    EXPECT_EQ(*deque.pop(), 98U);
+    while (deque.pop()) {
+    }
+    EXPECT_TRUE(deque.empty());
+    EXPECT_EQ(deque.steal(), nullptr);
+
+    // every item is taken exactly once while thieves race against the owner
+    constexpr uint32_t ITEM_COUNT = 100000;
+    ccstd::vector<uint32_t> values(ITEM_COUNT);
+    ccstd::vector<std::atomic<uint32_t>> taken(ITEM_COUNT);
+    std::atomic<bool> done{false};
+    auto take = [&](uint32_t *item) { taken[*item].fetch_add(1); };
+
+    ccstd::vector<std::thread> thieves;
+    for (uint32_t t = 0; t < 3; ++t) {
+        thieves.emplace_back([&]() {
+            while (!done.load()) {
+                if (uint32_t *item = deque.steal()) {
+                    take(item);
+                }
+            }
+        });
+    }
+    for (uint32_t i = 0; i < ITEM_COUNT; ++i) {
+        values[i] = i;
+        deque.push(&values[i]);
+        if (i % 3 == 0) {
+            if (uint32_t *item = deque.pop()) {
+                take(item);
+            }
+        }
+    }
+    while (uint32_t *item = deque.pop()) {
+        take(item);
+    }
+    done.store(true);
+    for (auto &thief : thieves) {
+        thief.join();
+    }
+
+    uint32_t wrong = 0;
+    for (const auto &count : taken) {
+        wrong += count.load() != 1 ? 1 : 0;
+    }
+    EXPECT_EQ(wrong, 0U);
+}
+
+TEST(jobSystemNativeTest, parallelFor) {
+    cc::NativeJobSystem system(4);
+    EXPECT_EQ(system.threadCount(), 4U);
+
+    constexpr uint32_t COUNT = 10000;
+    ccstd::vector<std::atomic<uint32_t>> visits(COUNT);
+    for (uint32_t step : {1U, 3U, 64U}) {
+        logLabel = "step " + std::to_string(step);
+        for (auto &visit : visits) {
+            visit.store(0);
+        }
+        {
+            cc::NativeJobGraph g(&system);
+            g.createForEachIndexJob(5U, COUNT, step, [&visits](uint32_t i) { visits[i].fetch_add(1); });
+            g.run();
+            g.waitForAll();
+        }
+        for (uint32_t i = 0; i < COUNT; ++i) {
+            const uint32_t expected = i >= 5 && (i - 5) % step == 0 ? 1 : 0;
+            ExpectEq(visits[i].load() == expected, true);
+        }
+    }
+
+    // empty ranges complete as well
+    cc::NativeJobGraph g(&system);
+    g.createForEachIndexJob(10U, 10U, 1U, [](uint32_t /*i*/) { FAIL(); });
+    g.run();
+    g.waitForAll();
+}
+
+TEST(jobSystemNativeTest, parallelForOnWaitingThread) {
+    cc::NativeJobSystem system(1);
+
+    // keep the only worker busy, so the waiting thread is the one picking up the parallel job
+    std::atomic<bool> blocking{false};
+    std::atomic<bool> released{false};
+    cc::NativeJobGraph blocker(&system);
+    blocker.createJob([&]() {
+        blocking.store(true);
+        while (!released.load()) {
+            std::this_thread::yield();
+        }
+    });
+    blocker.run();
+    while (!blocking.load()) {
+        std::this_thread::yield();
+    }
+
+    constexpr uint32_t COUNT = 64;
+    const std::thread::id waitingThread = std::this_thread::get_id();
+    std::atomic<uint32_t> onWaitingThread{0};
+    std::atomic<uint32_t> onWorker{0};
+    cc::NativeJobGraph g(&system);
+    g.createForEachIndexJob(0U, COUNT, 1U, [&](uint32_t /*i*/) {
+        if (std::this_thread::get_id() == waitingThread) {
+            released.store(true);
+            onWaitingThread.fetch_add(1);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        } else {
+            onWorker.fetch_add(1);
+        }
+    });
+    g.run();
+    g.waitForAll();
+    blocker.waitForAll();
+
+    // the waiting thread shared the upper half of its range with the worker once it was released
+    EXPECT_EQ(onWaitingThread.load() + onWorker.load(), COUNT);
+    EXPECT_GT(onWaitingThread.load(), 0U);
+    EXPECT_GT(onWorker.load(), 0U);
+}
+
+TEST(jobSystemNativeTest, dependencies) {
+    cc::NativeJobSystem system(3);
+
+    // a -> (parallel b, c) -> d, and the graph can be run again
+    std::atomic<uint32_t> a{0};
+    std::atomic<uint32_t> b{0};
+    std::atomic<uint32_t> c{0};
+    std::atomic<uint32_t> errors{0};
+    uint32_t d = 0;
+
+    cc::NativeJobGraph g(&system, "dependencies");
+    const uint32_t jobA = g.createJob([&]() { a.fetch_add(1); });
+    const uint32_t jobB = g.createForEachIndexJob(0U, 1000U, 1U, [&](uint32_t /*i*/) {
+        errors.fetch_add(a.load() == d + 1 ? 0 : 1);
+        b.fetch_add(1);
+    });
+    const uint32_t jobC = g.createJob([&]() {
+        errors.fetch_add(a.load() == d + 1 ? 0 : 1);
+        c.fetch_add(1);
+    });
+    const uint32_t jobD = g.createJob([&]() {
+        errors.fetch_add(b.load() == (d + 1) * 1000 && c.load() == d + 1 ? 0 : 1);
+        ++d;
+    });
+    g.makeEdge(jobA, jobB);
+    g.makeEdge(jobA, jobC);
+    g.makeEdge(jobB, jobD);
+    g.makeEdge(jobC, jobD);
+
+    for (uint32_t i = 0; i < 10; ++i) {
+        g.run();
+        g.waitForAll();
+    }
+    EXPECT_EQ(errors.load(), 0U);
+    EXPECT_EQ(d, 10U);
+}
+
+TEST(jobSystemNativeTest, continuationsAndNesting) {
+    cc::NativeJobSystem system(2);
+
+    // a long chain runs as continuations on a single worker at a time
+    constexpr uint32_t CHAIN_LENGTH = 500;
+    ccstd::vector<uint32_t> order;
+    cc::NativeJobGraph chain(&system);
+    for (uint32_t i = 0; i < CHAIN_LENGTH; ++i) {
+        const uint32_t job = chain.createJob([&order, i]() { order.push_back(i); });
+        if (i) {
+            chain.makeEdge(job - 1, job);
+        }
+    }
+    chain.run();
+    chain.waitForAll();
+    ASSERT_EQ(order.size(), CHAIN_LENGTH);
+    for (uint32_t i = 0; i < CHAIN_LENGTH; ++i) {
+        ExpectEq(order[i] == i, true);
+    }
+
+    // jobs may wait for graphs of their own without starving the pool
+    std::atomic<uint32_t> sum{0};
+    cc::NativeJobGraph outer(&system);
+    outer.createForEachIndexJob(0U, 8U, 1U, [&](uint32_t /*i*/) {
+        cc::NativeJobGraph inner(&system);
+        inner.createForEachIndexJob(0U, 100U, 1U, [&](uint32_t j) { sum.fetch_add(j); });
+        inner.run();
+        inner.waitForAll();
+    });
+    outer.run();
+    outer.waitForAll();
+    EXPECT_EQ(sum.load(), 8U * 4950U);
+}
+
+TEST(jobSystemNativeTest, trace) {
+    cc::NativeJobSystem system(2);
+    system.setTracing(true);
+
+    cc::NativeJobGraph g(&system, "TraceGraph");
+    const uint32_t job = g.createJob([]() {});
+    g.setJobName(job, "NamedJob");
+    g.createForEachIndexJob(0U, 64U, 1U, [](uint32_t /*i*/) {});
+    g.run();
+    g.waitForAll();
+    system.setTracing(false);
+
+    const ccstd::string trace = system.dumpTrace();
+    EXPECT_EQ(trace.rfind(R"({"displayTimeUnit":"ns","traceEvents":[)", 0), 0);
+    EXPECT_NE(trace.find(R"("name":"NamedJob")"), ccstd::string::npos);
+    EXPECT_NE(trace.find(R"("name":"TraceGraph")"), ccstd::string::npos);
+    EXPECT_NE(trace.find(R"("name":"JobWorker 1")"), ccstd::string::npos);
+    EXPECT_EQ(trace.find(R"("name":"Job")"), ccstd::string::npos);
+
+    system.clearTrace();
+    EXPECT_EQ(system.dumpTrace().find(R"("ph":"X")"), ccstd::string::npos);
+}
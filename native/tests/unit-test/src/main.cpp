@@ -22,11 +22,14 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ****************************************************************************/
 
-#undef CC_USE_NVN
-#undef CC_USE_VULKAN
-#undef CC_USE_METAL
-#undef CC_USE_GLES3
-#undef CC_USE_GLES2
+// the tests run on the empty device unless configured with CC_UNIT_TEST_GFX_BACKEND
+#if !CC_UNIT_TEST_GFX_BACKEND
+    #undef CC_USE_NVN
+    #undef CC_USE_VULKAN
+    #undef CC_USE_METAL
+    #undef CC_USE_GLES3
+    #undef CC_USE_GLES2
+#endif
 
 #include "bindings/jswrapper/SeApi.h"
 #include "core/Root.h"
@@ -267,3 +267,45 @@ TEST(mathMat4Test, test5) {
     cc::Mat4 b{1.111224F, 0.123455F, 0.384182F, 1.111223F, 3.123456F, 4.384184F, 5.111224F, 6.123456F, 2.384182F, 3.111223F, 4.123456F, 5.384184F, 6.111223F, 7.123455F, 8.384184F, 9.111223F};
     ExpectEq(a.approxEquals(b), true);
 }
+
+TEST(mathMat4Test, batch) {
+    // two groups of four for the SIMD compose, the last three matrices take the scalar path
+    constexpr uint32_t count = 11;
+    cc::Quaternion rotations[count];
+    cc::Vec3 translations[count];
+    cc::Vec3 scales[count];
+    cc::Mat4 parents[count];
+    for (uint32_t i = 0; i < count; ++i) {
+        const auto f = static_cast<float>(i);
+        cc::Quaternion::fromEuler(f * 10.0F, f * 25.0F - 40.0F, f * 7.0F, &rotations[i]);
+        translations[i].set(f, -2.0F * f, 0.5F * f + 1.0F);
+        scales[i].set(1.0F + 0.1F * f, 2.0F - 0.1F * f, 0.5F);
+        cc::Mat4::fromRTS(rotations[(i + 3) % count], translations[(i + 5) % count], scales[(i + 7) % count], &parents[i]);
+    }
+
+    // fromRTSBatch
+    logLabel = "test the mat4 fromRTSBatch function";
+    cc::Mat4 locals[count];
+    cc::Mat4::fromRTSBatch(rotations, translations, scales, locals, count);
+    for (uint32_t i = 0; i < count; ++i) {
+        cc::Mat4 expected;
+        cc::Mat4::fromRTS(rotations[i], translations[i], scales[i], &expected);
+        ExpectEq(locals[i].approxEquals(expected), true);
+    }
+
+    // multiplyBatch
+    logLabel = "test the mat4 multiplyBatch function";
+    cc::Mat4 worlds[count];
+    cc::Mat4::multiplyBatch(parents, locals, worlds, count);
+    for (uint32_t i = 0; i < count; ++i) {
+        cc::Mat4 expected;
+        cc::Mat4::multiply(parents[i], locals[i], &expected);
+        ExpectEq(worlds[i].approxEquals(expected), true);
+    }
+
+    // the result may be written over one of the inputs
+    cc::Mat4::multiplyBatch(parents, locals, locals, count);
+    for (uint32_t i = 0; i < count; ++i) {
+        ExpectEq(locals[i].approxEquals(worlds[i]), true);
+    }
+}
@@ -110,3 +110,29 @@ TEST(mathQuaternionTest, test6) {
     cc::Quaternion b{0.123455F, 1.234568F, 2.345679F, 3.345678F};
     ExpectEq(a.approxEquals(b), true);
 }
+
+TEST(mathQuaternionTest, multiplyBatch) {
+    logLabel = "test the quaternion multiplyBatch function";
+    // products 8 to 10 are left to the scalar path, they must match the SIMD ones before them
+    constexpr uint32_t count = 11;
+    cc::Quaternion parents[count];
+    cc::Quaternion locals[count];
+    for (uint32_t i = 0; i < count; ++i) {
+        const auto f = static_cast<float>(i);
+        cc::Quaternion::fromEuler(f * 10.0F, f * 25.0F - 40.0F, f * 7.0F, &parents[i]);
+        cc::Quaternion::fromEuler(-f * 3.0F, f * 11.0F, 90.0F - f * 13.0F, &locals[i]);
+    }
+    cc::Quaternion worlds[count];
+    cc::Quaternion::multiplyBatch(parents, locals, worlds, count);
+    for (uint32_t i = 0; i < count; ++i) {
+        cc::Quaternion expected;
+        cc::Quaternion::multiply(parents[i], locals[i], &expected);
+        ExpectEq(worlds[i].approxEquals(expected), true);
+    }
+
+    // the result may be written over one of the inputs
+    cc::Quaternion::multiplyBatch(parents, locals, locals, count);
+    for (uint32_t i = 0; i < count; ++i) {
+        ExpectEq(locals[i].approxEquals(worlds[i]), true);
+    }
+}
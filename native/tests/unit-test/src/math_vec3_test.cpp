@@ -160,3 +160,43 @@ TEST(mathVec3Test, test2) {
     cc::Vec3 b{0.123455F, 1.234568F, 2.345679F};
     ExpectEq(a.approxEquals(b), true);
 }
+
+TEST(mathVec3Test, transformMat4Batch) {
+    logLabel = "test the vec3 transformMat4Batch function";
+    cc::Mat4 proj;
+    cc::Mat4::createPerspective(60.0F, 1.5F, 0.1F, 100.0F, &proj);
+    cc::Mat4 view;
+    cc::Mat4::fromRT(cc::Quaternion{0.1F, 0.2F, 0.3F, 0.927F}, cc::Vec3{1.0F, 2.0F, 3.0F}, &view);
+    cc::Mat4 viewProj;
+    cc::Mat4::multiply(proj, view, &viewProj);
+
+    // three groups of four for the SIMD kernel, the last point is left to the scalar path
+    constexpr uint32_t count = 13;
+    cc::Vec3 points[count];
+    for (uint32_t i = 0; i < count; ++i) {
+        const auto f = static_cast<float>(i);
+        points[i].set(f - 6.0F, 0.5F * f, -10.0F - f);
+    }
+    // w is zero, no perspective division
+    points[count - 1].set(-1.0F, -2.0F, 0.0F);
+
+    for (const auto *mat : {&view, &viewProj}) {
+        cc::Vec3 results[count];
+        cc::Vec3::transformMat4Batch(points, *mat, results, count);
+        for (uint32_t i = 0; i < count; ++i) {
+            cc::Vec3 expected;
+            cc::Vec3::transformMat4(points[i], *mat, &expected);
+            ExpectEq(results[i].approxEquals(expected), true);
+        }
+    }
+
+    // in place
+    cc::Vec3 inPlace[count];
+    std::copy(std::begin(points), std::end(points), std::begin(inPlace));
+    cc::Vec3::transformMat4Batch(inPlace, view, inPlace, count);
+    for (uint32_t i = 0; i < count; ++i) {
+        cc::Vec3 expected;
+        cc::Vec3::transformMat4(points[i], view, &expected);
+        ExpectEq(inPlace[i].approxEquals(expected), true);
+    }
+}
@@ -0,0 +1,100 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <thread>
+#include "base/std/container/vector.h"
+#include "base/threading/MessageQueue.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+using namespace cc;
+
+// the pattern behind parallel secondary command buffers in gfx-agent:
+// producers record into their own queues, the consumer replays them in a fixed order
+TEST(messageQueueStreamsTest, replayInOrder) {
+    constexpr uint32_t STREAM_COUNT = 4;
+    constexpr uint32_t MESSAGE_COUNT = 20000; // spans several memory chunks per stream
+    constexpr uint32_t FRAME_COUNT = 3;
+
+    auto *mainQueue = ccnew MessageQueue;
+    mainQueue->setImmediateMode(false);
+    mainQueue->runConsumerThread();
+
+    ccstd::vector<MessageQueue *> streams(STREAM_COUNT);
+    for (auto *&stream : streams) {
+        stream = ccnew MessageQueue;
+        stream->setImmediateMode(false);
+    }
+
+    ccstd::vector<uint32_t> replayed;
+    auto *pReplayed = &replayed;
+    for (uint32_t frame = 0; frame < FRAME_COUNT; ++frame) {
+        ccstd::vector<std::thread> producers;
+        for (uint32_t s = 0; s < STREAM_COUNT; ++s) {
+            producers.emplace_back([&streams, pReplayed, s]() {
+                for (uint32_t i = 0; i < MESSAGE_COUNT; ++i) {
+                    uint32_t value = s * MESSAGE_COUNT + i;
+                    ENQUEUE_MESSAGE_2(
+                        streams[s], StreamRecord,
+                        replayed, pReplayed,
+                        value, value,
+                        {
+                            replayed->push_back(value);
+                        });
+                }
+            });
+        }
+        for (auto &producer : producers) {
+            producer.join();
+        }
+
+        auto **mergedStreams = mainQueue->allocate<MessageQueue *>(STREAM_COUNT);
+        for (uint32_t s = 0; s < STREAM_COUNT; ++s) {
+            mergedStreams[s] = streams[s];
+            streams[s]->finishWriting();
+        }
+        ENQUEUE_MESSAGE_2(
+            mainQueue, StreamMerge,
+            streams, mergedStreams,
+            count, STREAM_COUNT,
+            {
+                for (uint32_t s = 0; s < count; ++s) {
+                    streams[s]->flushMessages();
+                }
+            });
+        mainQueue->kick();
+    }
+    mainQueue->kickAndWait();
+
+    ASSERT_EQ(replayed.size(), STREAM_COUNT * MESSAGE_COUNT * FRAME_COUNT);
+    for (uint32_t i = 0; i < replayed.size(); ++i) {
+        EXPECT_EQ(replayed[i], i % (STREAM_COUNT * MESSAGE_COUNT));
+    }
+
+    mainQueue->terminateConsumerThread();
+    for (auto *stream : streams) {
+        CC_SAFE_DELETE(stream);
+    }
+    CC_SAFE_DELETE(mainQueue);
+}
@@ -0,0 +1,184 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <vector>
+#include "cocos/editor-support/FrameCache.h"
+#include "gtest/gtest.h"
+
+using cc::middleware::CachedAnimation;
+using cc::middleware::CompactFrame;
+using cc::middleware::IOBuffer;
+
+namespace {
+
+// x, y, z, u, v and two packed colors, like the spine two color vertex
+constexpr std::size_t VERTEX_FLOATS = 7;
+constexpr std::size_t VERTEX_COUNT = 200;
+
+void fillFrame(IOBuffer &vb, IOBuffer &ib, float offset) {
+    vb.reset();
+    vb.checkSpace(VERTEX_COUNT * VERTEX_FLOATS * sizeof(float));
+    for (std::size_t i = 0; i < VERTEX_COUNT; ++i) {
+        vb.writeFloat32(static_cast<float>(i) * 1.5F - 120.0F + offset);
+        vb.writeFloat32(static_cast<float>(i % 17) * 9.25F + offset);
+        vb.writeFloat32(0.0F);
+        vb.writeFloat32(static_cast<float>(i % 10) / 10.0F);
+        vb.writeFloat32(static_cast<float>(i % 7) / 7.0F);
+        vb.writeUint32(0xffffffff);
+        vb.writeUint32(0);
+    }
+    ib.reset();
+    ib.checkSpace(VERTEX_COUNT * 3 * sizeof(uint16_t));
+    for (std::size_t i = 0; i + 2 < VERTEX_COUNT; i += 2) {
+        ib.writeUint16(static_cast<uint16_t>(i));
+        ib.writeUint16(static_cast<uint16_t>(i + 1));
+        ib.writeUint16(static_cast<uint16_t>(i + 2));
+    }
+}
+
+class FakeAnimation : public CachedAnimation {
+public:
+    void bake(std::size_t bytes) { addMemorySize(bytes); }
+    void use() { touch(); }
+    int evictCount = 0;
+
+protected:
+    void evict() override {
+        ++evictCount;
+        clearMemorySize();
+    }
+};
+
+} // namespace
+
+TEST(middlewareFrameCacheTest, quantizedRoundTrip) {
+    IOBuffer vb;
+    IOBuffer ib;
+    fillFrame(vb, ib, 0.0F);
+
+    CompactFrame frame;
+    frame.encode(vb, VERTEX_FLOATS, ib, nullptr);
+    EXPECT_EQ(frame.getVertexCount(), VERTEX_COUNT);
+    EXPECT_EQ(frame.getIndexCount(), ib.getCurPos() / sizeof(uint16_t));
+    EXPECT_LT(frame.getMemorySize(), vb.getCurPos() + ib.getCurPos());
+
+    IOBuffer outVB;
+    IOBuffer outIB;
+    frame.decode(outVB, VERTEX_FLOATS, outIB);
+    ASSERT_EQ(outVB.getCurPos(), vb.getCurPos());
+    ASSERT_EQ(outIB.getCurPos(), ib.getCurPos());
+
+    const auto *src = reinterpret_cast<const float *>(vb.getBuffer());
+    const auto *dst = reinterpret_cast<const float *>(outVB.getBuffer());
+    for (std::size_t i = 0; i < VERTEX_COUNT; ++i) {
+        for (std::size_t c = 0; c < 5; ++c) {
+            EXPECT_NEAR(dst[i * VERTEX_FLOATS + c], src[i * VERTEX_FLOATS + c], 0.01F);
+        }
+    }
+    EXPECT_EQ(memcmp(outIB.getBuffer(), ib.getBuffer(), ib.getCurPos()), 0);
+}
+
+TEST(middlewareFrameCacheTest, sharesUnchangedStreams) {
+    IOBuffer vb;
+    IOBuffer ib;
+    fillFrame(vb, ib, 0.0F);
+    CompactFrame first;
+    first.encode(vb, VERTEX_FLOATS, ib, nullptr);
+
+    // only the positions move, uvs and indices are taken from the first frame
+    fillFrame(vb, ib, 3.0F);
+    CompactFrame second;
+    second.encode(vb, VERTEX_FLOATS, ib, &first);
+    EXPECT_LT(second.getMemorySize(), first.getMemorySize());
+
+    IOBuffer outVB;
+    IOBuffer outIB;
+    second.decode(outVB, VERTEX_FLOATS, outIB);
+    const auto *src = reinterpret_cast<const float *>(vb.getBuffer());
+    const auto *dst = reinterpret_cast<const float *>(outVB.getBuffer());
+    for (std::size_t i = 0; i < VERTEX_COUNT * VERTEX_FLOATS; i += VERTEX_FLOATS) {
+        EXPECT_NEAR(dst[i], src[i], 0.01F);
+        EXPECT_NEAR(dst[i + 3], src[i + 3], 0.001F);
+    }
+    EXPECT_EQ(memcmp(outIB.getBuffer(), ib.getBuffer(), ib.getCurPos()), 0);
+}
+
+TEST(middlewareFrameCacheTest, boneRoundTrip) {
+    cc::Mat4 bone;
+    bone.m[0] = 0.5F;
+    bone.m[1] = -0.25F;
+    bone.m[4] = 0.25F;
+    bone.m[5] = 0.5F;
+    bone.m[12] = 100.0F;
+    bone.m[13] = -42.0F;
+
+    CompactFrame frame;
+    frame.encodeBone(cc::Mat4::IDENTITY);
+    frame.encodeBone(bone);
+    ASSERT_EQ(frame.getBoneCount(), 2);
+
+    cc::Mat4 decoded;
+    frame.decodeBone(1, decoded);
+    for (int i = 0; i < 16; ++i) {
+        EXPECT_FLOAT_EQ(decoded.m[i], bone.m[i]);
+    }
+}
+
+TEST(middlewareFrameCacheTest, evictsLeastRecentlyUsed) {
+    CachedAnimation::setBudget(1000);
+    FakeAnimation idle;
+    FakeAnimation playing;
+    FakeAnimation baking;
+
+    idle.bake(400);
+    playing.bake(400);
+    CachedAnimation::tick();
+
+    // over budget, but nothing is evicted between the update and the render of a frame
+    baking.bake(400);
+    playing.use();
+    EXPECT_EQ(idle.evictCount, 0);
+    EXPECT_EQ(CachedAnimation::getTotalMemorySize(), 1200);
+
+    // the least recently used animation is the only one to go
+    CachedAnimation::tick();
+    EXPECT_EQ(idle.evictCount, 1);
+    EXPECT_EQ(playing.evictCount, 0);
+    EXPECT_EQ(CachedAnimation::getTotalMemorySize(), 800);
+
+    // animations used during the tick are kept even over budget
+    baking.bake(400);
+    playing.use();
+    CachedAnimation::tick();
+    EXPECT_EQ(playing.evictCount, 0);
+    EXPECT_EQ(CachedAnimation::getTotalMemorySize(), 1200);
+
+    baking.bake(400);
+    CachedAnimation::tick();
+    EXPECT_EQ(playing.evictCount, 1);
+    EXPECT_EQ(CachedAnimation::getTotalMemorySize(), 1200);
+    EXPECT_EQ(baking.getStats().memorySize, 1200);
+
+    CachedAnimation::setBudget(0);
+}
@@ -0,0 +1,118 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#if CC_USE_PHYSICS_PHYSX
+
+    #include <atomic>
+    #include <thread>
+    #include "cocos/base/std/container/vector.h"
+    #include "cocos/physics/physx/PhysXJobDispatcher.h"
+    #include "gtest/gtest.h"
+
+namespace {
+
+// stands in for the tasks of a PhysX simulation: a task is submitted once all of its children
+// released it, as PxLightCpuTask does with its continuation
+class StubTask final : public physx::PxBaseTask {
+public:
+    void run() override { runCount.fetch_add(1, std::memory_order_relaxed); }
+    const char *getName() const override { return "StubTask"; }
+    void addReference() override { refCount.fetch_add(1, std::memory_order_relaxed); }
+    void removeReference() override {
+        if (refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            dispatcher->submitTask(*this);
+        }
+    }
+    int32_t getReference() const override { return refCount.load(std::memory_order_relaxed); }
+    void release() override {
+        if (parent) {
+            parent->removeReference();
+        } else {
+            done->store(true, std::memory_order_release);
+        }
+    }
+
+    cc::physics::PhysXJobDispatcher *dispatcher{nullptr};
+    StubTask *parent{nullptr};
+    std::atomic<bool> *done{nullptr};
+    std::atomic<int32_t> refCount{0};
+    std::atomic<uint32_t> runCount{0};
+};
+
+// a complete binary tree, the leaves are submitted and the root finishes the step
+class StubTaskTree {
+public:
+    StubTaskTree(cc::physics::PhysXJobDispatcher &dispatcher, uint32_t depth)
+    : _tasks((1U << depth) - 1) {
+        for (uint32_t i = 0; i < _tasks.size(); ++i) {
+            _tasks[i].dispatcher = &dispatcher;
+            _tasks[i].parent = i > 0 ? &_tasks[(i - 1) / 2] : nullptr;
+            _tasks[i].done = &_done;
+        }
+    }
+
+    void step() {
+        _done.store(false);
+        const auto firstLeaf = static_cast<uint32_t>(_tasks.size() / 2);
+        for (uint32_t i = 0; i < firstLeaf; ++i) {
+            _tasks[i].refCount.store(2);
+        }
+        for (auto i = firstLeaf; i < _tasks.size(); ++i) {
+            _tasks[i].refCount.store(1);
+        }
+        for (auto i = firstLeaf; i < _tasks.size(); ++i) {
+            _tasks[i].removeReference();
+        }
+        // what fetchResults(true) does before the world reclaims the dispatcher
+        while (!_done.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
+
+    const ccstd::vector<StubTask> &getTasks() const { return _tasks; }
+
+private:
+    ccstd::vector<StubTask> _tasks;
+    std::atomic<bool> _done{false};
+};
+
+} // namespace
+
+TEST(physicsJobDispatcherTest, stepTaskTreeRepeatedly) {
+    cc::physics::PhysXJobDispatcher dispatcher;
+    StubTaskTree tree(dispatcher, 8);
+
+    // graphs must not be reused across steps, the dummy backend clears them once run
+    constexpr uint32_t STEP_COUNT = 3;
+    for (uint32_t step = 1; step <= STEP_COUNT; ++step) {
+        tree.step();
+        dispatcher.reclaim();
+        for (const auto &task : tree.getTasks()) {
+            EXPECT_EQ(task.runCount.load(), step);
+            EXPECT_EQ(task.getReference(), 0);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,140 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "cocos/renderer/gfx-base/GFXDevice.h"
+#include "cocos/renderer/pipeline/InstancedBuffer.h"
+#include "cocos/scene/SubModel.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+using namespace cc;
+using namespace cc::pipeline;
+
+namespace {
+
+constexpr uint32_t INSTANCE_STRIDE = 16;
+
+struct InstancedBufferFixture {
+    InstancedBufferFixture() {
+        auto *device = gfx::Device::getInstance();
+        vertexBuffer = device->createBuffer({gfx::BufferUsageBit::VERTEX, gfx::MemoryUsageBit::DEVICE, 12 * 4, 12});
+        gfx::InputAssemblerInfo iaInfo;
+        iaInfo.attributes.push_back({"a_position", gfx::Format::RGB32F});
+        iaInfo.vertexBuffers.push_back(vertexBuffer);
+        for (uint32_t i = 0; i < 2; ++i) {
+            indexBuffers[i] = device->createBuffer({gfx::BufferUsageBit::INDEX, gfx::MemoryUsageBit::DEVICE, 2 * 6, 2});
+            iaInfo.indexBuffer = indexBuffers[i];
+            inputAssemblers[i] = device->createInputAssembler(iaInfo);
+        }
+        descriptorSetLayout = device->createDescriptorSetLayout({});
+        descriptorSet = device->createDescriptorSet({descriptorSetLayout});
+        gfx::ShaderInfo shaderInfo;
+        shaderInfo.name = "unit-test-instancing";
+        shader = device->createShader(shaderInfo);
+    }
+
+    // a sub-model drawing the mesh with the given index buffer, with a per-instance matrix row
+    scene::SubModel *createSubModel(uint32_t mesh) {
+        auto *subModel = subModels.emplace_back(ccnew scene::SubModel()).get();
+        subModel->setInputAssembler(inputAssemblers[mesh]);
+        subModel->setDescriptorSet(descriptorSet);
+        subModel->setShaders({shader});
+        auto &attrs = subModel->getInstancedAttributeBlock();
+        attrs.buffer = Uint8Array(INSTANCE_STRIDE);
+        attrs.attributes.push_back({"a_matWorld0", gfx::Format::RGBA32F});
+        return subModel;
+    }
+
+    IntrusivePtr<gfx::Buffer> vertexBuffer;
+    IntrusivePtr<gfx::Buffer> indexBuffers[2];
+    IntrusivePtr<gfx::InputAssembler> inputAssemblers[2];
+    IntrusivePtr<gfx::DescriptorSetLayout> descriptorSetLayout;
+    IntrusivePtr<gfx::DescriptorSet> descriptorSet;
+    IntrusivePtr<gfx::Shader> shader;
+    ccstd::vector<IntrusivePtr<scene::SubModel>> subModels;
+};
+
+} // namespace
+
+TEST(pipelineInstancedBufferTest, merge) {
+    InstancedBufferFixture fixture;
+    IntrusivePtr<InstancedBuffer> buffer = ccnew InstancedBuffer(nullptr);
+
+    logLabel = "sub-models sharing the index buffer are merged";
+    for (uint32_t i = 0; i < 3; ++i) {
+        buffer->merge(fixture.createSubModel(0), 0);
+    }
+    ASSERT_EQ(buffer->getInstances().size(), 1U);
+    EXPECT_EQ(buffer->getInstances()[0].count, 3U);
+    EXPECT_EQ(buffer->getInstances()[0].shader, fixture.shader.get());
+
+    logLabel = "another index buffer starts a new batch";
+    buffer->merge(fixture.createSubModel(1), 0);
+    ASSERT_EQ(buffer->getInstances().size(), 2U);
+    EXPECT_EQ(buffer->getInstances()[1].count, 1U);
+    ExpectEq(buffer->hasPendingModels(), true);
+
+    logLabel = "uploads cover the merged instances only";
+    buffer->uploadBuffers(gfx::Device::getInstance()->getCommandBuffer());
+    EXPECT_EQ(buffer->getStats().instanceCount, 4U);
+    EXPECT_EQ(buffer->getStats().batchCount, 2U);
+    EXPECT_EQ(buffer->getStats().uploadedBytes, 4 * INSTANCE_STRIDE);
+
+    logLabel = "clear keeps the batches for the next frame";
+    buffer->clear();
+    EXPECT_EQ(buffer->getStats().instanceCount, 0U);
+    EXPECT_EQ(buffer->getStats().batchCount, 0U);
+    EXPECT_EQ(buffer->getStats().uploadedBytes, 0U);
+    ExpectEq(buffer->hasPendingModels(), false);
+    buffer->merge(fixture.createSubModel(1), 0);
+    buffer->merge(fixture.createSubModel(0), 0);
+    ASSERT_EQ(buffer->getInstances().size(), 2U);
+    EXPECT_EQ(buffer->getInstances()[0].count, 1U);
+    EXPECT_EQ(buffer->getInstances()[1].count, 1U);
+
+    buffer->destroy();
+}
+
+TEST(pipelineInstancedBufferTest, maxCapacity) {
+    InstancedBufferFixture fixture;
+    IntrusivePtr<InstancedBuffer> buffer = ccnew InstancedBuffer(nullptr);
+
+    logLabel = "a full batch is never grown past MAX_CAPACITY";
+    for (uint32_t i = 0; i < InstancedBuffer::MAX_CAPACITY + 1; ++i) {
+        buffer->merge(fixture.createSubModel(0), 0);
+    }
+    const auto &instances = buffer->getInstances();
+    ASSERT_EQ(instances.size(), 2U);
+    EXPECT_EQ(instances[0].count, InstancedBuffer::MAX_CAPACITY);
+    EXPECT_EQ(instances[0].capacity, InstancedBuffer::MAX_CAPACITY);
+    EXPECT_EQ(instances[0].vb->getSize(), InstancedBuffer::MAX_CAPACITY * INSTANCE_STRIDE);
+    EXPECT_EQ(instances[1].count, 1U);
+    EXPECT_EQ(instances[1].capacity, InstancedBuffer::INITIAL_CAPACITY);
+
+    buffer->uploadBuffers(gfx::Device::getInstance()->getCommandBuffer());
+    EXPECT_EQ(buffer->getStats().instanceCount, InstancedBuffer::MAX_CAPACITY + 1);
+    EXPECT_EQ(buffer->getStats().batchCount, 2U);
+    EXPECT_EQ(buffer->getStats().uploadedBytes, (InstancedBuffer::MAX_CAPACITY + 1) * INSTANCE_STRIDE);
+
+    buffer->destroy();
+}
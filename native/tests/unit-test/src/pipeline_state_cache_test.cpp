@@ -0,0 +1,150 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "cocos/renderer/gfx-base/GFXDevice.h"
+#include "cocos/renderer/pipeline/PipelineStateManager.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+using namespace cc;
+using namespace cc::pipeline;
+
+namespace {
+
+struct PipelineStateCacheFixture {
+    PipelineStateCacheFixture() {
+        auto *device = gfx::Device::getInstance();
+        gfx::ShaderInfo shaderInfo;
+        shaderInfo.name = "unit-test|CC_USE_TEST1";
+        shader = device->createShader(shaderInfo);
+        pipelineLayout = device->createPipelineLayout({});
+
+        gfx::RenderPassInfo renderPassInfo;
+        renderPassInfo.colorAttachments.emplace_back();
+        renderPassInfo.colorAttachments.back().format = gfx::Format::RGBA8;
+        renderPassInfo.depthStencilAttachment.format = gfx::Format::DEPTH_STENCIL;
+        renderPass = device->createRenderPass(renderPassInfo);
+
+        info.shader = shader;
+        info.pipelineLayout = pipelineLayout;
+        info.renderPass = renderPass;
+        info.inputState.attributes.push_back({"a_position", gfx::Format::RGB32F});
+        info.blendState.targets[0].blend = 1;
+    }
+
+    ~PipelineStateCacheFixture() {
+        PipelineStateManager::destroyAll();
+        CC_SAFE_DESTROY_AND_DELETE(renderPass);
+        CC_SAFE_DESTROY_AND_DELETE(pipelineLayout);
+        CC_SAFE_DESTROY_AND_DELETE(shader);
+    }
+
+    PipelineStateKey makeKey(ccstd::hash_t passHash, ccstd::hash_t attributesHash) const {
+        return {passHash, renderPass->getHash(), attributesHash, shader->getTypedID(), 0};
+    }
+
+    gfx::Shader *shader{nullptr};
+    gfx::PipelineLayout *pipelineLayout{nullptr};
+    gfx::RenderPass *renderPass{nullptr};
+    gfx::PipelineStateInfo info;
+};
+
+} // namespace
+
+TEST(pipelineStateCacheTest, structuredKey) {
+    PipelineStateCacheFixture fixture;
+    PipelineStateManager::resetStats();
+
+    logLabel = "swapped key components must not alias";
+    auto *pso1 = PipelineStateManager::getOrCreatePipelineState(fixture.makeKey(0x1234, 0x5678), fixture.info);
+    auto *pso2 = PipelineStateManager::getOrCreatePipelineState(fixture.makeKey(0x5678, 0x1234), fixture.info);
+    ExpectEq(pso1 != nullptr && pso2 != nullptr, true);
+    ExpectEq(pso1 != pso2, true);
+
+    logLabel = "same key hits the cache";
+    auto *pso3 = PipelineStateManager::getOrCreatePipelineState(fixture.makeKey(0x1234, 0x5678), fixture.info);
+    ExpectEq(pso1 == pso3, true);
+
+    const auto &stats = PipelineStateManager::getStats();
+    EXPECT_EQ(stats.misses, 2U);
+    EXPECT_EQ(stats.hits, 1U);
+}
+
+TEST(pipelineStateCacheTest, warmStart) {
+    PipelineStateCacheFixture fixture;
+    PipelineStateManager::getOrCreatePipelineState(fixture.makeKey(1, 2), fixture.info);
+    PipelineStateManager::getOrCreatePipelineState(fixture.makeKey(3, 4), fixture.info);
+
+    ccstd::vector<uint8_t> bytes;
+    ExpectEq(PipelineStateManager::serializeCache(bytes), true);
+
+    // simulate a new session
+    PipelineStateManager::destroyAll();
+    PipelineStateManager::resetStats();
+
+    logLabel = "truncated cache is rejected";
+    ExpectEq(PipelineStateManager::deserializeCache(bytes.data(), bytes.size() / 2), false);
+
+    logLabel = "cache is loaded and prewarmed";
+    ExpectEq(PipelineStateManager::deserializeCache(bytes.data(), bytes.size()), true);
+    EXPECT_EQ(PipelineStateManager::getStats().recordsPending, 2U);
+
+    uint32_t pending = PipelineStateManager::prewarm([](const ccstd::string &, gfx::Shader *&, gfx::PipelineLayout *&) { return false; });
+    EXPECT_EQ(pending, 2U);
+
+    pending = PipelineStateManager::prewarm([&](const ccstd::string &name, gfx::Shader *&shader, gfx::PipelineLayout *&layout) {
+        if (name != fixture.shader->getName()) return false;
+        shader = fixture.shader;
+        layout = fixture.pipelineLayout;
+        return true;
+    });
+    EXPECT_EQ(pending, 0U);
+    EXPECT_EQ(PipelineStateManager::getStats().prewarmed, 2U);
+
+    logLabel = "prewarmed pipeline states are hit at runtime";
+    PipelineStateManager::getOrCreatePipelineState(fixture.makeKey(1, 2), fixture.info);
+    PipelineStateManager::getOrCreatePipelineState(fixture.makeKey(3, 4), fixture.info);
+    EXPECT_EQ(PipelineStateManager::getStats().hits, 2U);
+    EXPECT_EQ(PipelineStateManager::getStats().misses, 0U);
+}
+
+TEST(pipelineStateCacheTest, corruptedCount) {
+    PipelineStateCacheFixture fixture;
+    PipelineStateManager::getOrCreatePipelineState(fixture.makeKey(1, 2), fixture.info);
+
+    ccstd::vector<uint8_t> bytes;
+    ExpectEq(PipelineStateManager::serializeCache(bytes), true);
+    PipelineStateManager::destroyAll();
+    PipelineStateManager::resetStats();
+
+    // the record count follows the magic, version, API and renderer name
+    const auto &renderer = gfx::Device::getInstance()->getRenderer();
+    const size_t countOffset = 4 * sizeof(uint32_t) + renderer.size();
+    ASSERT_LT(countOffset + sizeof(uint32_t), bytes.size());
+    const uint32_t count = UINT32_MAX;
+    memcpy(bytes.data() + countOffset, &count, sizeof(count));
+
+    logLabel = "a corrupted record count is rejected";
+    ExpectEq(PipelineStateManager::deserializeCache(bytes.data(), bytes.size()), false);
+    EXPECT_EQ(PipelineStateManager::getStats().recordsPending, 0U);
+}
@@ -0,0 +1,109 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <cstdio>
+#include <cstring>
+#include "cocos/base/Data.h"
+#include "cocos/platform/FilePack.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+const char *const PACK_PATH = "unit_test_file_pack.ccpk";
+
+FileView makeView(const ccstd::string &text) {
+    Data data;
+    data.copy(reinterpret_cast<const unsigned char *>(text.data()), static_cast<uint32_t>(text.size()));
+    return FileView::fromData(std::move(data));
+}
+
+ccstd::string toString(const FileView &view) {
+    return {reinterpret_cast<const char *>(view.data()), view.size()};
+}
+
+} // namespace
+
+TEST(platformFilePackTest, roundTrip) {
+    ccstd::string repeated(4096, 'a');
+    ccstd::vector<FilePack::Source> sources;
+    sources.push_back({"textures/b.png", makeView("second"), false});
+    sources.push_back({"textures/a.png", makeView("first"), false});
+    sources.push_back({"data/config.json", makeView(repeated), true});
+    sources.push_back({"empty", FileView(), false});
+    ASSERT_TRUE(FilePack::write(PACK_PATH, sources));
+
+    auto pack = FilePack::open(PACK_PATH);
+    ASSERT_NE(pack, nullptr);
+    EXPECT_EQ(pack->getEntryCount(), 4);
+
+    // stored entries are slices of the mapping
+    auto first = pack->getView("textures/a.png");
+    EXPECT_EQ(toString(first), "first");
+    EXPECT_TRUE(first.isMapped());
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(first.data()) % 16, 0);
+    EXPECT_EQ(toString(pack->getView("textures/b.png")), "second");
+    EXPECT_TRUE(pack->contains("empty"));
+    EXPECT_TRUE(pack->getView("empty").empty());
+
+    // compressed entries decode as a whole or chunk by chunk
+    EXPECT_EQ(toString(pack->getView("data/config.json")), repeated);
+    auto stream = pack->openStream("data/config.json");
+    ASSERT_NE(stream, nullptr);
+    EXPECT_EQ(stream->getSize(), repeated.size());
+    char chunk[1000];
+    size_t total = 0;
+    size_t count = 0;
+    while ((count = stream->read(chunk, sizeof(chunk))) > 0) {
+        EXPECT_EQ(ccstd::string(chunk, count), repeated.substr(total, count));
+        total += count;
+    }
+    EXPECT_EQ(total, repeated.size());
+
+    // views outlive the pack
+    pack.reset();
+    EXPECT_EQ(toString(first), "first");
+
+    remove(PACK_PATH);
+}
+
+TEST(platformFilePackTest, missingEntries) {
+    ccstd::vector<FilePack::Source> sources;
+    sources.push_back({"a", makeView("a"), false});
+    ASSERT_TRUE(FilePack::write(PACK_PATH, sources));
+
+    auto pack = FilePack::open(PACK_PATH);
+    ASSERT_NE(pack, nullptr);
+    EXPECT_FALSE(pack->contains("b"));
+    EXPECT_FALSE(pack->contains(""));
+    EXPECT_TRUE(pack->getView("b").empty());
+    EXPECT_EQ(pack->openStream("b"), nullptr);
+    remove(PACK_PATH);
+
+    // not a pack
+    EXPECT_FALSE(FilePack(makeView("not a pack file at all")).isValid());
+    EXPECT_EQ(FilePack::open(PACK_PATH), nullptr);
+}
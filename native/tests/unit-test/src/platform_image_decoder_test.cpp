@@ -0,0 +1,181 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <cstdio>
+#include "cocos/platform/Image.h"
+#include "cocos/platform/ImageDecoder.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+// 2x2 pixels, opaque red, half transparent green, transparent blue, white
+const uint8_t PIXELS[] = {
+    255, 0, 0, 255, 0, 255, 0, 128,
+    0, 0, 255, 0, 255, 255, 255, 255};
+
+const char *const RGBA_PATH = "unit_test_image_rgba.png";
+const char *const RGB_PATH = "unit_test_image_rgb.png";
+const char *const JPG_PATH = "unit_test_image.jpg";
+
+void writeImages() {
+    IntrusivePtr<Image> image = ccnew Image();
+    image->initWithRawData(PIXELS, sizeof(PIXELS), 2, 2, 8);
+    image->saveToFile(RGBA_PATH, false);
+    image->saveToFile(RGB_PATH, true);
+    image->saveToFile(JPG_PATH);
+}
+
+void removeImages() {
+    remove(RGBA_PATH);
+    remove(RGB_PATH);
+    remove(JPG_PATH);
+}
+
+IntrusivePtr<Image> decode(const char *path, bool expandToRGBA, bool premultiplyAlpha) {
+    IntrusivePtr<Image> image = ccnew Image();
+    image->setDecodeOptions({expandToRGBA, premultiplyAlpha});
+    if (!image->initWithImageFile(path)) {
+        return nullptr;
+    }
+    return image;
+}
+
+} // namespace
+
+TEST(platformImageDecoderTest, decodeOptions) {
+    writeImages();
+
+    auto image = decode(RGBA_PATH, false, false);
+    ASSERT_NE(image, nullptr);
+    EXPECT_EQ(image->getRenderFormat(), gfx::Format::RGBA8);
+    EXPECT_FALSE(image->hasPremultipliedAlpha());
+    EXPECT_EQ(memcmp(image->getData(), PIXELS, sizeof(PIXELS)), 0);
+
+    // color is multiplied by alpha while decoding
+    image = decode(RGBA_PATH, false, true);
+    ASSERT_NE(image, nullptr);
+    EXPECT_TRUE(image->hasPremultipliedAlpha());
+    const uint8_t premultiplied[] = {
+        255, 0, 0, 255, 0, 128, 0, 128,
+        0, 0, 0, 0, 255, 255, 255, 255};
+    EXPECT_EQ(memcmp(image->getData(), premultiplied, sizeof(premultiplied)), 0);
+
+    // RGB is expanded to RGBA while decoding, there's nothing to premultiply
+    image = decode(RGB_PATH, false, false);
+    ASSERT_NE(image, nullptr);
+    EXPECT_EQ(image->getRenderFormat(), gfx::Format::RGB8);
+    image = decode(RGB_PATH, true, true);
+    ASSERT_NE(image, nullptr);
+    EXPECT_EQ(image->getRenderFormat(), gfx::Format::RGBA8);
+    EXPECT_FALSE(image->hasPremultipliedAlpha());
+    ASSERT_EQ(image->getDataLen(), 16);
+    for (uint32_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(memcmp(image->getData() + i * 4, PIXELS + i * 4, 3), 0);
+        EXPECT_EQ(image->getData()[i * 4 + 3], 255);
+    }
+
+    image = decode(JPG_PATH, true, false);
+    ASSERT_NE(image, nullptr);
+    EXPECT_EQ(image->getRenderFormat(), gfx::Format::RGBA8);
+    ASSERT_EQ(image->getDataLen(), 16);
+    for (uint32_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(image->getData()[i * 4 + 3], 255);
+    }
+
+    removeImages();
+}
+
+TEST(platformImageDecoderTest, priorities) {
+    writeImages();
+
+    ccstd::vector<ccstd::string> delivered;
+    auto makeRequest = [&](const char *path, int32_t priority) {
+        ImageDecoder::Request request;
+        request.path = path;
+        request.priority = priority;
+        request.callback = [&delivered, path](const IntrusivePtr<Image> &image) {
+            EXPECT_NE(image, nullptr);
+            delivered.emplace_back(path);
+        };
+        return request;
+    };
+
+    {
+        // the first request starts at once, a tiny budget makes the others wait for each flush
+        ImageDecoder decoder(1);
+        decoder.setMemoryBudget(1);
+        decoder.push(makeRequest(RGBA_PATH, 0));
+        decoder.push(makeRequest(RGB_PATH, 0));
+        decoder.push(makeRequest(JPG_PATH, 1));
+        for (uint32_t i = 0; i < 3; ++i) {
+            decoder.waitForAll();
+            EXPECT_EQ(decoder.getPendingCount(), 2 - i);
+            EXPECT_EQ(decoder.flush(), 1);
+        }
+        ASSERT_EQ(delivered.size(), 3);
+        EXPECT_EQ(delivered[0], RGBA_PATH);
+        EXPECT_EQ(delivered[1], JPG_PATH);
+        EXPECT_EQ(delivered[2], RGB_PATH);
+    }
+
+    {
+        // a request may finish before the next one is pushed, so only the totals are fixed:
+        // no more than the 2 threads run past the budget, and every request is delivered in the end
+        delivered.clear();
+        ImageDecoder decoder(2);
+        decoder.setMemoryBudget(1);
+        decoder.push(makeRequest(RGBA_PATH, 0));
+        decoder.push(makeRequest(RGB_PATH, 0));
+        decoder.push(makeRequest(JPG_PATH, 0));
+        uint32_t flushes = 0;
+        while (delivered.size() < 3 && flushes < 3) {
+            decoder.waitForAll();
+            const auto pending = decoder.getPendingCount();
+            const auto count = decoder.flush();
+            EXPECT_GE(count, 1);
+            EXPECT_LE(count, 2);
+            EXPECT_EQ(pending + delivered.size(), 3);
+            ++flushes;
+        }
+        EXPECT_EQ(delivered.size(), 3);
+        EXPECT_EQ(decoder.getPendingCount(), 0);
+    }
+
+    {
+        delivered.clear();
+        ImageDecoder decoder(1);
+        decoder.setMemoryBudget(1);
+        decoder.push(makeRequest(RGBA_PATH, 0));
+        auto id = decoder.push(makeRequest(RGB_PATH, 0));
+        EXPECT_TRUE(decoder.cancel(id));
+        EXPECT_FALSE(decoder.cancel(id));
+        decoder.waitForAll();
+        EXPECT_EQ(decoder.flush(), 1);
+    }
+
+    removeImages();
+}
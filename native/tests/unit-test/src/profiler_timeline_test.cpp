@@ -0,0 +1,126 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <thread>
+#include "base/std/container/string.h"
+#include "gtest/gtest.h"
+#include "profiler/TimelineRecorder.h"
+#include "utils.h"
+
+namespace {
+
+uint32_t countOf(const ccstd::string &trace, const ccstd::string &pattern) {
+    uint32_t count = 0;
+    for (size_t pos = trace.find(pattern); pos != ccstd::string::npos; pos = trace.find(pattern, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+} // namespace
+
+TEST(profilerTimelineTest, recordsThreads) {
+    auto *recorder = cc::TimelineRecorder::getInstance();
+    recorder->setThreadName("TestMain");
+    recorder->start();
+    {
+        cc::TimelineScope outer("Outer");
+        {
+            cc::TimelineScope inner("Inner");
+        }
+        recorder->counter("Items", 42.5);
+        recorder->markFrame("TestFrame");
+        recorder->markFrame("TestFrame");
+    }
+    std::thread worker([recorder]() {
+        recorder->setThreadName("TestWorker");
+        cc::TimelineScope scope("WorkerScope");
+    });
+    worker.join();
+    recorder->stop();
+
+    // scopes opened after stop are not recorded
+    { cc::TimelineScope late("Late"); }
+
+    const ccstd::string trace = recorder->dumpTrace();
+    EXPECT_EQ(trace.rfind(R"({"displayTimeUnit":"ns","traceEvents":[)", 0), 0);
+    EXPECT_EQ(countOf(trace, R"("args":{"name":"TestMain"})"), 1);
+    EXPECT_EQ(countOf(trace, R"("args":{"name":"TestWorker"})"), 1);
+    EXPECT_EQ(countOf(trace, R"({"name":"Outer","cat":"cpu","ph":"X")"), 1);
+    EXPECT_EQ(countOf(trace, R"({"name":"Inner","cat":"cpu","ph":"X")"), 1);
+    EXPECT_EQ(countOf(trace, R"({"name":"WorkerScope","cat":"cpu","ph":"X")"), 1);
+    EXPECT_EQ(countOf(trace, R"({"name":"Items","ph":"C")"), 1);
+    EXPECT_EQ(countOf(trace, R"("args":{"value":42.5})"), 1);
+    EXPECT_EQ(countOf(trace, R"({"name":"TestFrame","cat":"frame","ph":"i")"), 2);
+    EXPECT_EQ(countOf(trace, R"("args":{"frame":1})"), 1);
+    EXPECT_EQ(countOf(trace, "\"Late\""), 0);
+
+    // a new session drops the events of the previous one
+    recorder->start();
+    { cc::TimelineScope scope("NextSession"); }
+    recorder->stop();
+    const ccstd::string next = recorder->dumpTrace();
+    EXPECT_EQ(countOf(next, "\"Outer\""), 0);
+    EXPECT_EQ(countOf(next, "\"NextSession\""), 1);
+}
+
+TEST(profilerTimelineTest, escapesNames) {
+    auto *recorder = cc::TimelineRecorder::getInstance();
+    recorder->start();
+    std::thread worker([recorder]() {
+        recorder->setThreadName(R"(Quoted "Worker" C:\path)");
+        cc::TimelineScope scope("Tab\tScope");
+    });
+    worker.join();
+    recorder->stop();
+
+    const ccstd::string trace = recorder->dumpTrace();
+    EXPECT_EQ(countOf(trace, R"("args":{"name":"Quoted \"Worker\" C:\\path"})"), 1);
+    EXPECT_EQ(countOf(trace, R"({"name":"Tab\tScope","cat":"cpu","ph":"X")"), 1);
+    EXPECT_EQ(countOf(trace, "\t"), 0);
+}
+
+TEST(profilerTimelineTest, ringOverflow) {
+    auto *recorder = cc::TimelineRecorder::getInstance();
+    recorder->setCapacity(16);
+    recorder->start();
+    std::thread worker([recorder]() {
+        recorder->setThreadName("OverflowWorker");
+        cc::TimelineScope outer("OverflowOuter");
+        for (uint32_t i = 0; i < 100; ++i) {
+            cc::TimelineScope scope("OverflowScope");
+        }
+    });
+    worker.join();
+    recorder->stop();
+    recorder->setCapacity(cc::TimelineRecorder::DEFAULT_CAPACITY);
+
+    // only the latest events are kept, the scope whose begin got overwritten is dropped
+    const ccstd::string trace = recorder->dumpTrace();
+    EXPECT_EQ(countOf(trace, R"("args":{"name":"OverflowWorker"})"), 1);
+    EXPECT_EQ(countOf(trace, "\"OverflowOuter\""), 0);
+    const uint32_t scopes = countOf(trace, "\"OverflowScope\"");
+    EXPECT_GE(scopes, 7);
+    EXPECT_LE(scopes, 8);
+}
@@ -0,0 +1,136 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#include "cocos/renderer/core/ProgramLib.h"
+#include "cocos/renderer/gfx-base/GFXDevice.h"
+#include "cocos/renderer/pipeline/custom/RenderInterfaceTypes.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+const char *const PROGRAM_NAME = "unit-test-async";
+const char *const PATCH_NAME = "CC_UNIT_TEST_PATCH";
+
+// only the macros and the global set layout are read when compiling
+class TestPipeline : public render::PipelineRuntime {
+public:
+    TestPipeline() {
+        _descriptorSetLayout = gfx::Device::getInstance()->createDescriptorSetLayout({});
+    }
+    bool activate(gfx::Swapchain * /*swapchain*/) override { return true; }
+    bool destroy() noexcept override { return true; }
+    void render(const ccstd::vector<scene::Camera *> & /*cameras*/) override {}
+    gfx::Device *getDevice() const override { return gfx::Device::getInstance(); }
+    const MacroRecord &getMacros() const override { return _macros; }
+    pipeline::GlobalDSManager *getGlobalDSManager() const override { return nullptr; }
+    gfx::DescriptorSetLayout *getDescriptorSetLayout() const override { return _descriptorSetLayout; }
+    gfx::DescriptorSet *getDescriptorSet() const override { return nullptr; }
+    const ccstd::vector<gfx::CommandBuffer *> &getCommandBuffers() const override { return _commandBuffers; }
+    pipeline::PipelineSceneData *getPipelineSceneData() const override { return nullptr; }
+    const ccstd::string &getConstantMacros() const override { return _constantMacros; }
+    scene::Model *getProfiler() const override { return nullptr; }
+    void setProfiler(scene::Model * /*profiler*/) override {}
+    pipeline::GeometryRenderer *getGeometryRenderer() const override { return nullptr; }
+    float getShadingScale() const override { return 1.F; }
+    void setShadingScale(float /*scale*/) override {}
+    const ccstd::string &getMacroString(const ccstd::string & /*name*/) const override { return _constantMacros; }
+    int32_t getMacroInt(const ccstd::string & /*name*/) const override { return 0; }
+    bool getMacroBool(const ccstd::string & /*name*/) const override { return false; }
+    void setMacroString(const ccstd::string & /*name*/, const ccstd::string & /*value*/) override {}
+    void setMacroInt(const ccstd::string & /*name*/, int32_t /*value*/) override {}
+    void setMacroBool(const ccstd::string & /*name*/, bool /*value*/) override {}
+    void onGlobalPipelineStateChanged() override {}
+    void setValue(const ccstd::string & /*name*/, int32_t /*value*/) override {}
+    void setValue(const ccstd::string & /*name*/, bool /*value*/) override {}
+    bool isOcclusionQueryEnabled() const override { return false; }
+    void resetRenderQueue(bool /*reset*/) override {}
+    bool isRenderQueueReset() const override { return false; }
+
+private:
+    MacroRecord _macros;
+    ccstd::string _constantMacros;
+    ccstd::vector<gfx::CommandBuffer *> _commandBuffers;
+    IntrusivePtr<gfx::DescriptorSetLayout> _descriptorSetLayout;
+};
+
+bool hasPatch(const gfx::Shader *shader) {
+    return shader->getStages()[0].source.find(ccstd::string{"#define "} + PATCH_NAME + " 1") != ccstd::string::npos;
+}
+
+} // namespace
+
+TEST(programLibTest, asyncCompile) {
+    std::unique_ptr<ProgramLib> ownedLib;
+    if (!ProgramLib::getInstance()) {
+        ownedLib = std::make_unique<ProgramLib>();
+    }
+    auto *programLib = ProgramLib::getInstance();
+    auto *device = gfx::Device::getInstance();
+    TestPipeline pipeline;
+
+    IShaderInfo shaderInfo;
+    shaderInfo.name = PROGRAM_NAME;
+    shaderInfo.hash = 0xa5c;
+    shaderInfo.defines.push_back({PATCH_NAME, "boolean"});
+    shaderInfo.glsl4 = {"void main() {}", "void main() {}"};
+    programLib->define(shaderInfo);
+
+    MacroRecord defines;
+    auto *fallback = programLib->getGFXShader(device, PROGRAM_NAME, defines, &pipeline);
+    ASSERT_NE(fallback, nullptr);
+    ExpectEq(hasPatch(fallback), false);
+
+    const bool asyncCompileEnabled = programLib->isAsyncCompileEnabled();
+    programLib->setAsyncCompileEnabled(true);
+    const auto generation = programLib->getShaderGeneration();
+
+    logLabel = "a new combination returns the fallback and is compiled later";
+    MacroRecord patched{{PATCH_NAME, true}};
+    EXPECT_EQ(programLib->getGFXShaderAsync(device, PROGRAM_NAME, patched, &pipeline, fallback), fallback);
+    EXPECT_EQ(programLib->getGFXShaderAsync(device, PROGRAM_NAME, patched, &pipeline, fallback), fallback);
+    ExpectEq(programLib->hasPendingShaders(), true);
+    ExpectEq(programLib->isShaderPending(programLib->getKey(PROGRAM_NAME, patched)), true);
+    EXPECT_EQ(programLib->getShaderGeneration(), generation);
+
+    logLabel = "update compiles the variant and bumps the generation holders re-fetch on";
+    programLib->update();
+    ExpectEq(programLib->hasPendingShaders(), false);
+    ExpectEq(programLib->isShaderPending(programLib->getKey(PROGRAM_NAME, patched)), false);
+    EXPECT_NE(programLib->getShaderGeneration(), generation);
+    auto *variant = programLib->getGFXShaderAsync(device, PROGRAM_NAME, patched, &pipeline, fallback);
+    ASSERT_NE(variant, fallback);
+    ExpectEq(hasPatch(variant), true);
+    EXPECT_EQ(variant, programLib->getGFXShader(device, PROGRAM_NAME, patched, &pipeline));
+
+    logLabel = "nothing pending leaves the generation alone";
+    const auto compiledGeneration = programLib->getShaderGeneration();
+    programLib->update();
+    EXPECT_EQ(programLib->getShaderGeneration(), compiledGeneration);
+
+    programLib->setAsyncCompileEnabled(asyncCompileEnabled);
+}
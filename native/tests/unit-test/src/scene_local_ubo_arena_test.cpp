@@ -0,0 +1,103 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "gtest/gtest.h"
+#include "renderer/gfx-base/GFXBuffer.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/pipeline/Define.h"
+#include "scene/LocalUBOArena.h"
+
+using cc::scene::LocalUBOArena;
+
+TEST(sceneLocalUBOArenaTest, slotsAreAlignedViews) {
+    auto *device = cc::gfx::Device::getInstance();
+    LocalUBOArena arena(device);
+    EXPECT_EQ(arena.getStride() % device->getCapabilities().uboOffsetAlignment, 0);
+    EXPECT_GE(arena.getStride(), cc::pipeline::UBOLocal::SIZE);
+
+    uint32_t slot0 = LocalUBOArena::INVALID_SLOT;
+    uint32_t slot1 = LocalUBOArena::INVALID_SLOT;
+    cc::IntrusivePtr<cc::gfx::Buffer> view0 = arena.allocate(&slot0);
+    cc::IntrusivePtr<cc::gfx::Buffer> view1 = arena.allocate(&slot1);
+    EXPECT_EQ(slot0, 0);
+    EXPECT_EQ(slot1, 1);
+    EXPECT_TRUE(view0->isBufferView());
+    EXPECT_EQ(view0->getSize(), cc::pipeline::UBOLocal::SIZE);
+    EXPECT_EQ(arena.getSlotData(slot1) - arena.getSlotData(slot0), arena.getStride() / sizeof(float));
+
+    view0->destroy();
+    view1->destroy();
+}
+
+TEST(sceneLocalUBOArenaTest, freedSlotsAreReusedLowestFirst) {
+    LocalUBOArena arena(cc::gfx::Device::getInstance());
+    ccstd::vector<cc::IntrusivePtr<cc::gfx::Buffer>> views;
+    uint32_t slot = LocalUBOArena::INVALID_SLOT;
+    for (uint32_t i = 0; i < 8; ++i) {
+        views.emplace_back(arena.allocate(&slot));
+    }
+    arena.free(5);
+    arena.free(2);
+    views.emplace_back(arena.allocate(&slot));
+    EXPECT_EQ(slot, 2);
+    views.emplace_back(arena.allocate(&slot));
+    EXPECT_EQ(slot, 5);
+    views.emplace_back(arena.allocate(&slot));
+    EXPECT_EQ(slot, 8);
+
+    for (const auto &view : views) {
+        view->destroy();
+    }
+}
+
+TEST(sceneLocalUBOArenaTest, flushUploadsEachDirtyPageOnce) {
+    LocalUBOArena arena(cc::gfx::Device::getInstance());
+    ccstd::vector<cc::IntrusivePtr<cc::gfx::Buffer>> views;
+    uint32_t slot = LocalUBOArena::INVALID_SLOT;
+    for (uint32_t i = 0; i < LocalUBOArena::SLOTS_PER_PAGE + 4; ++i) {
+        views.emplace_back(arena.allocate(&slot));
+    }
+    EXPECT_EQ(slot, LocalUBOArena::SLOTS_PER_PAGE + 3);
+
+    arena.flush();
+    EXPECT_EQ(arena.getUploadCount(), 0);
+
+    for (uint32_t i = 0; i < 10; ++i) {
+        arena.markDirty(i);
+    }
+    arena.markDirty(LocalUBOArena::SLOTS_PER_PAGE + 1);
+    arena.flush();
+    EXPECT_EQ(arena.getDirtySlotCount(), 11);
+    EXPECT_EQ(arena.getUploadCount(), 2);
+    EXPECT_EQ(arena.getUploadBytes(), 12 * arena.getStride());
+
+    arena.flush();
+    EXPECT_EQ(arena.getDirtySlotCount(), 0);
+    EXPECT_EQ(arena.getUploadCount(), 0);
+    EXPECT_EQ(arena.getUploadBytes(), 0);
+
+    for (const auto &view : views) {
+        view->destroy();
+    }
+}
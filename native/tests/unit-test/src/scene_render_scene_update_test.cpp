@@ -0,0 +1,146 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <cstring>
+#include "base/Ptr.h"
+#include "core/geometry/AABB.h"
+#include "core/scene-graph/Node.h"
+#include "core/scene-graph/TransformHierarchy.h"
+#include "gtest/gtest.h"
+#include "renderer/gfx-base/GFXBuffer.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/pipeline/Define.h"
+#include "scene/Model.h"
+#include "scene/Pass.h"
+#include "scene/RenderScene.h"
+#include "scene/SubModel.h"
+#include "utils.h"
+
+namespace {
+
+// a sub-model without passes, enough for the model to write and upload its local UBO
+class LocalSubModel final : public cc::scene::SubModel {
+public:
+    explicit LocalSubModel(cc::gfx::DescriptorSetLayout *layout) {
+        _passes = std::make_shared<ccstd::vector<cc::IntrusivePtr<cc::scene::Pass>>>();
+        _descriptorSet = cc::gfx::Device::getInstance()->createDescriptorSet({layout});
+    }
+};
+
+class LocalModel final : public cc::scene::Model {
+public:
+    void addSubModel(cc::gfx::DescriptorSetLayout *layout) {
+        _subModels.emplace_back(ccnew LocalSubModel(layout));
+        initLocalDescriptors(static_cast<index_t>(_subModels.size() - 1));
+    }
+};
+
+// reads back what models wrote to their local buffers
+class StagingReader final : public cc::gfx::Buffer {
+public:
+    static const float *read(cc::gfx::Buffer *buffer) {
+        return reinterpret_cast<const float *>(getBufferStagingAddress(buffer));
+    }
+};
+
+// models in a small hierarchy, the root and some children move every frame
+class ModelScene {
+public:
+    explicit ModelScene(uint32_t modelCount) : root(ccnew cc::Node()), hierarchy(root) {
+        descriptorSetLayout = cc::gfx::Device::getInstance()->createDescriptorSetLayout({});
+        for (uint32_t i = 0; i < modelCount; ++i) {
+            auto *node = ccnew cc::Node();
+            node->setPosition(static_cast<float>(i % 32), static_cast<float>(i % 7), static_cast<float>(i / 32));
+            node->setScale(1.0F + static_cast<float>(i % 3), 1.0F, 1.0F);
+            node->setParent(root);
+
+            auto *model = ccnew LocalModel();
+            model->initialize();
+            model->setTransform(node);
+            model->setNode(node);
+            model->setModelBounds(ccnew cc::geometry::AABB(0.0F, 0.5F, 0.0F, 0.5F, 0.5F, 0.5F));
+            model->setWorldBounds(ccnew cc::geometry::AABB());
+            model->addSubModel(descriptorSetLayout);
+            scene.addModel(model);
+            nodes.emplace_back(node);
+        }
+        root->walk([](cc::Node *node) { node->setActiveInHierarchy(true); });
+    }
+
+    ~ModelScene() {
+        scene.removeModels();
+    }
+
+    void animate(uint32_t frame) {
+        root->setRotationFromEuler(0.0F, static_cast<float>(frame * 7 % 360), 0.0F);
+        for (uint32_t i = frame % 5; i < nodes.size(); i += 5) {
+            nodes[i]->setRotationFromEuler(static_cast<float>(frame), 0.0F, 0.0F);
+        }
+    }
+
+    cc::IntrusivePtr<cc::Node> root;
+    ccstd::vector<cc::IntrusivePtr<cc::Node>> nodes;
+    cc::IntrusivePtr<cc::gfx::DescriptorSetLayout> descriptorSetLayout;
+    cc::TransformHierarchy hierarchy;
+    cc::scene::RenderScene scene;
+};
+
+} // namespace
+
+TEST(sceneRenderSceneUpdateTest, parallelMatchesSerial) {
+    // enough models to split the update in several jobs
+    constexpr uint32_t MODEL_COUNT = 2000;
+    ModelScene parallel(MODEL_COUNT);
+    parallel.scene.setTransformHierarchy(&parallel.hierarchy);
+    ModelScene serial(MODEL_COUNT);
+
+    for (uint32_t frame = 1; frame <= 3; ++frame) {
+        cc::Node::resetChangedFlags();
+        parallel.animate(frame);
+        parallel.scene.update(frame);
+
+        // the per model update used before the parallel phase was added
+        serial.animate(frame);
+        for (const auto &model : serial.scene.getModels()) {
+            model->updateTransform(frame);
+            model->updateUBOs(frame);
+            model->updateOctree();
+        }
+
+        for (uint32_t i = 0; i < MODEL_COUNT; ++i) {
+            logLabel = "frame " + std::to_string(frame) + " model " + std::to_string(i);
+            const auto *expected = serial.scene.getModels()[i].get();
+            const auto *actual = parallel.scene.getModels()[i].get();
+            ExpectEq(actual->getWorldBounds()->center == expected->getWorldBounds()->center, true);
+            ExpectEq(actual->getWorldBounds()->halfExtents == expected->getWorldBounds()->halfExtents, true);
+
+            const float *expectedUBO = StagingReader::read(expected->getLocalBuffer());
+            const float *actualUBO = StagingReader::read(actual->getLocalBuffer());
+            ExpectEq(memcmp(actualUBO + cc::pipeline::UBOLocal::MAT_WORLD_OFFSET, expectedUBO + cc::pipeline::UBOLocal::MAT_WORLD_OFFSET, sizeof(cc::Mat4)) == 0, true);
+            ExpectEq(memcmp(actualUBO + cc::pipeline::UBOLocal::MAT_WORLD_IT_OFFSET, expectedUBO + cc::pipeline::UBOLocal::MAT_WORLD_IT_OFFSET, sizeof(cc::Mat4)) == 0, true);
+        }
+    }
+
+    parallel.scene.setTransformHierarchy(nullptr);
+}
@@ -0,0 +1,142 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "cocos/base/memory/Memory.h"
+#include "cocos/core/scene-graph/Node.h"
+#include "cocos/core/scene-graph/TransformHierarchy.h"
+#include "cocos/math/Quaternion.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+namespace {
+
+// deterministic pseudo random numbers, so failures are reproducible
+class Random {
+public:
+    float next(float min, float max) {
+        _seed = _seed * 1664525U + 1013904223U;
+        return min + (max - min) * static_cast<float>(_seed >> 8) / static_cast<float>(1U << 24);
+    }
+
+private:
+    uint32_t _seed{12345U};
+};
+
+void randomizeTransform(cc::Node *node, Random &random) {
+    cc::Quaternion rot;
+    cc::Quaternion::fromEuler(random.next(-180.0F, 180.0F), random.next(-180.0F, 180.0F), random.next(-180.0F, 180.0F), &rot);
+    node->setPosition(random.next(-10.0F, 10.0F), random.next(-10.0F, 10.0F), random.next(-10.0F, 10.0F));
+    node->setRotation(rot);
+    node->setScale(random.next(0.5F, 2.0F), random.next(0.5F, 2.0F), random.next(0.5F, 2.0F));
+}
+
+// root -> WIDTH children -> chains of DEPTH nodes, the same transforms in both trees.
+// Nodes are owned by the test as they are by script objects in the engine, reparenting would free them otherwise.
+constexpr uint32_t WIDTH = 3000;
+constexpr uint32_t DEPTH = 4;
+
+void createHierarchy(ccstd::vector<cc::IntrusivePtr<cc::Node>> &nodes) {
+    Random random;
+    auto *root = ccnew cc::Node();
+    root->setPosition(1.0F, 2.0F, 3.0F);
+    nodes.push_back(root);
+    for (uint32_t i = 0; i < WIDTH; ++i) {
+        cc::Node *parent = root;
+        for (uint32_t d = 0; d < DEPTH; ++d) {
+            auto *node = ccnew cc::Node();
+            randomizeTransform(node, random);
+            parent->addChild(node);
+            nodes.push_back(node);
+            parent = node;
+        }
+    }
+    root->walk([](cc::Node *node) { node->setActiveInHierarchy(true); });
+}
+
+void expectSameWorldTransforms(const ccstd::vector<cc::IntrusivePtr<cc::Node>> &batched, const ccstd::vector<cc::IntrusivePtr<cc::Node>> &lazy) {
+    for (size_t i = 0; i < batched.size(); ++i) {
+        // read the batched results before the getters get a chance to recompute them
+        ExpectEq(batched[i]->getDirtyFlag() == 0 || !batched[i]->isActiveInHierarchy(), true);
+        ExpectEq(batched[i]->getWorldMatrix().approxEquals(lazy[i]->getWorldMatrix(), 1e-4F), true);
+        ExpectEq(batched[i]->getWorldPosition().approxEquals(lazy[i]->getWorldPosition(), 1e-4F), true);
+        ExpectEq(batched[i]->getWorldRotation().approxEquals(lazy[i]->getWorldRotation(), 1e-4F), true);
+        ExpectEq(batched[i]->getWorldScale().approxEquals(lazy[i]->getWorldScale(), 1e-4F), true);
+    }
+}
+
+} // namespace
+
+TEST(transformHierarchyTest, matchesLazyUpdate) {
+    ccstd::vector<cc::IntrusivePtr<cc::Node>> batched;
+    ccstd::vector<cc::IntrusivePtr<cc::Node>> lazy;
+    createHierarchy(batched);
+    createHierarchy(lazy);
+
+    cc::TransformHierarchy hierarchy(batched[0]);
+    hierarchy.update();
+    EXPECT_EQ(hierarchy.getNodeCount(), 1 + WIDTH * DEPTH);
+    EXPECT_EQ(hierarchy.getLevelCount(), 1 + DEPTH);
+    logLabel = "initial";
+    expectSameWorldTransforms(batched, lazy);
+
+    // partial updates: translate some roots of chains, rotate or scale nodes in the middle
+    Random random;
+    for (size_t i = 1; i < batched.size(); i += 7) {
+        const uint32_t kind = i % 3;
+        for (cc::Node *node : {batched[i].get(), lazy[i].get()}) {
+            if (kind == 0) {
+                node->setPosition(static_cast<float>(i), 0.0F, 1.0F);
+            } else if (kind == 1) {
+                node->setRotationFromEuler(0.0F, static_cast<float>(i % 360), 0.0F);
+            } else {
+                node->setScale(1.0F, 0.5F, static_cast<float>(i % 5 + 1));
+            }
+        }
+    }
+    hierarchy.update();
+    logLabel = "partial";
+    expectSameWorldTransforms(batched, lazy);
+
+    // hierarchy changes are picked up on the next update
+    for (size_t i = 1; i + DEPTH < batched.size(); i += DEPTH * 11) {
+        batched[i + DEPTH]->setParent(batched[i]);
+        lazy[i + DEPTH]->setParent(lazy[i]);
+    }
+    batched[0]->setPosition(-4.0F, 5.0F, 6.0F);
+    lazy[0]->setPosition(-4.0F, 5.0F, 6.0F);
+    hierarchy.update();
+    EXPECT_EQ(hierarchy.getNodeCount(), 1 + WIDTH * DEPTH);
+    EXPECT_GT(hierarchy.getLevelCount(), 1 + DEPTH);
+    logLabel = "reparented";
+    expectSameWorldTransforms(batched, lazy);
+
+    // inactive subtrees are skipped and keep resolving lazily
+    batched[1]->walk([](cc::Node *node) { node->setActiveInHierarchy(false); });
+    batched[1]->setPosition(3.0F, 3.0F, 3.0F);
+    lazy[1]->setPosition(3.0F, 3.0F, 3.0F);
+    hierarchy.update();
+    EXPECT_NE(batched[2]->getDirtyFlag(), 0);
+    logLabel = "inactive";
+    expectSameWorldTransforms(batched, lazy);
+}
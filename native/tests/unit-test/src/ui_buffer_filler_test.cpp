@@ -0,0 +1,178 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <memory>
+#include "cocos/2d/renderer/RenderDrawInfo.h"
+#include "cocos/2d/renderer/RenderEntity.h"
+#include "cocos/2d/renderer/UIBufferFiller.h"
+#include "cocos/2d/renderer/UIMeshBuffer.h"
+#include "cocos/base/memory/Memory.h"
+#include "cocos/core/scene-graph/Node.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+namespace {
+
+constexpr uint32_t SPRITE_COUNT = 3000;
+constexpr uint8_t STRIDE = 9;
+
+// sprites of varying size sharing one mesh buffer, the same data on every construction
+struct SpriteBatch {
+    SpriteBatch() {
+        root = ccnew cc::Node();
+        root->setPosition(10.0F, 20.0F, 0.0F);
+        root->setScale(2.0F, 2.0F, 1.0F);
+        meshBuffer.syncSharedBufferToNative(layout);
+
+        uint32_t vertexCount = 0;
+        uint32_t indexCount = 0;
+        for (uint32_t i = 0; i < SPRITE_COUNT; ++i) {
+            vertexCount += 4 + i % 5;
+            indexCount += 6 + 3 * (i % 3);
+        }
+        vData.resize(vertexCount * STRIDE);
+        iData.resize(indexCount, 0xffff);
+        layouts.resize(vertexCount);
+        indices.resize(indexCount);
+        for (size_t i = 0; i < vData.size(); ++i) {
+            vData[i] = static_cast<float>(i % 97);
+        }
+
+        uint32_t vertex = 0;
+        uint32_t index = 0;
+        for (uint32_t i = 0; i < SPRITE_COUNT; ++i) {
+            cc::IntrusivePtr<cc::Node> node = ccnew cc::Node();
+            node->setPosition(static_cast<float>(i % 64), static_cast<float>(i / 64), 0.0F);
+            node->setRotationFromEuler(0.0F, 0.0F, static_cast<float>(i % 360));
+            root->addChild(node);
+            nodes.push_back(node);
+
+            cc::IntrusivePtr<cc::RenderEntity> entity = ccnew cc::RenderEntity(cc::RenderEntityType::DYNAMIC);
+            entity->setNode(node);
+            entity->setOpacity(static_cast<float>(i % 11) / 10.0F);
+            entities.push_back(entity);
+
+            const uint32_t vbCount = 4 + i % 5;
+            const uint32_t ibCount = 6 + 3 * (i % 3);
+            for (uint32_t v = 0; v < vbCount; ++v) {
+                layouts[vertex + v].position.set(static_cast<float>(v), static_cast<float>(v * 2), 0.5F);
+            }
+            for (uint32_t n = 0; n < ibCount; ++n) {
+                indices[index + n] = static_cast<uint16_t>(vertex + n % vbCount);
+            }
+
+            auto drawInfo = std::make_unique<cc::RenderDrawInfo>();
+            drawInfo->setDrawInfoType(static_cast<uint32_t>(cc::RenderDrawInfoType::COMP));
+            drawInfo->setStride(STRIDE);
+            drawInfo->setVbCount(vbCount);
+            drawInfo->setIbCount(ibCount);
+            drawInfo->setVbBuffer(vData.data() + vertex * STRIDE);
+            drawInfo->setIbBuffer(indices.data() + index);
+            drawInfo->setVDataBuffer(vData.data());
+            drawInfo->setIDataBuffer(iData.data());
+            drawInfo->setMeshBuffer(&meshBuffer);
+            drawInfo->setRender2dBufferToNative(reinterpret_cast<uint8_t *>(layouts.data() + vertex));
+            drawInfos.push_back(std::move(drawInfo));
+
+            vertex += vbCount;
+            index += ibCount;
+        }
+    }
+
+    static bool fillVertices(uint32_t i) { return i % 3 != 0; }
+    static bool fillColors(uint32_t i) { return i % 2 == 0; }
+
+    uint32_t layout[4]{};
+    cc::UIMeshBuffer meshBuffer;
+    cc::IntrusivePtr<cc::Node> root;
+    ccstd::vector<cc::IntrusivePtr<cc::Node>> nodes;
+    ccstd::vector<cc::IntrusivePtr<cc::RenderEntity>> entities;
+    ccstd::vector<std::unique_ptr<cc::RenderDrawInfo>> drawInfos;
+    ccstd::vector<cc::Render2dLayout> layouts;
+    ccstd::vector<uint16_t> indices;
+    ccstd::vector<float> vData;
+    ccstd::vector<uint16_t> iData;
+};
+
+// the serial fill Batcher2d did during the walk, kept as the golden reference
+void fillSerially(SpriteBatch &batch) {
+    for (uint32_t n = 0; n < SPRITE_COUNT; ++n) {
+        cc::RenderEntity *entity = batch.entities[n];
+        cc::RenderDrawInfo *drawInfo = batch.drawInfos[n].get();
+        const uint32_t size = drawInfo->getVbCount() * drawInfo->getStride();
+        float *vbBuffer = drawInfo->getVbBuffer();
+        if (SpriteBatch::fillVertices(n)) {
+            const cc::Mat4 &matrix = entity->getNode()->getWorldMatrix();
+            for (uint32_t i = 0; i < size; i += drawInfo->getStride()) {
+                reinterpret_cast<cc::Vec3 *>(vbBuffer + i)->transformMat4(drawInfo->getRender2dLayout(i)->position, matrix);
+            }
+        }
+        if (SpriteBatch::fillColors(n)) {
+            cc::Color temp = entity->getColor();
+            for (uint32_t i = 0; i < size; i += drawInfo->getStride()) {
+                uint32_t offset = i + 5;
+                vbBuffer[offset++] = static_cast<float>(temp.r) / 255.0F;
+                vbBuffer[offset++] = static_cast<float>(temp.g) / 255.0F;
+                vbBuffer[offset++] = static_cast<float>(temp.b) / 255.0F;
+                vbBuffer[offset++] = entity->getOpacity();
+            }
+        }
+        uint32_t indexOffset = batch.meshBuffer.getIndexOffset();
+        memcpy(&drawInfo->getIDataBuffer()[indexOffset], drawInfo->getIbBuffer(), drawInfo->getIbCount() * sizeof(uint16_t));
+        batch.meshBuffer.setIndexOffset(indexOffset + drawInfo->getIbCount());
+    }
+}
+
+void fillWith(SpriteBatch &batch, cc::UIBufferFiller &filler) {
+    for (uint32_t n = 0; n < SPRITE_COUNT; ++n) {
+        filler.record(batch.entities[n], batch.drawInfos[n].get(), SpriteBatch::fillVertices(n), SpriteBatch::fillColors(n));
+    }
+    EXPECT_EQ(filler.getCommandCount(), SPRITE_COUNT);
+    filler.flush();
+    EXPECT_EQ(filler.getCommandCount(), 0);
+}
+
+} // namespace
+
+TEST(uiBufferFillerTest, matchesSerialFill) {
+    SpriteBatch golden;
+    fillSerially(golden);
+
+    for (bool parallel : {true, false}) {
+        SpriteBatch batch;
+        cc::UIBufferFiller filler;
+        filler.setParallelEnabled(parallel);
+        fillWith(batch, filler);
+
+        EXPECT_EQ(batch.meshBuffer.getIndexOffset(), golden.meshBuffer.getIndexOffset());
+        EXPECT_EQ(batch.meshBuffer.getIndexOffset(), static_cast<uint32_t>(golden.iData.size()));
+        EXPECT_EQ(memcmp(batch.vData.data(), golden.vData.data(), golden.vData.size() * sizeof(float)), 0);
+        EXPECT_EQ(memcmp(batch.iData.data(), golden.iData.data(), golden.iData.size() * sizeof(uint16_t)), 0);
+
+        // a second frame appends after the reserved ranges of the first
+        batch.meshBuffer.setIndexOffset(0);
+        fillWith(batch, filler);
+        EXPECT_EQ(memcmp(batch.iData.data(), golden.iData.data(), golden.iData.size() * sizeof(uint16_t)), 0);
+    }
+}
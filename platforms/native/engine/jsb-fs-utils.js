@@ -174,6 +174,16 @@ var fsUtils = {
         fsUtils.readFile(filePath, '', onComplete);
     },
 
+    // copied once from the mapped file or pack, without the intermediate buffer of readArrayBuffer
+    readArrayBufferView (filePath, onComplete) {
+        const content = fs.getFileView(filePath);
+        if (!content) {
+            fsUtils.readArrayBuffer(filePath, onComplete);
+            return;
+        }
+        onComplete && onComplete(null, content);
+    },
+
     readJson (filePath, onComplete) {
         fsUtils.readFile(filePath, 'utf8', (err, text) => {
             let out = null;
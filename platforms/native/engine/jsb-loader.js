@@ -27,7 +27,7 @@
 'use strict';
 
 const cacheManager = require('./jsb-cache-manager');
-const { downloadFile, readText, readArrayBuffer, readJson, getUserDataPath, initJsbDownloader } = require('./jsb-fs-utils');
+const { downloadFile, readText, readArrayBuffer, readArrayBufferView, readJson, getUserDataPath, initJsbDownloader } = require('./jsb-fs-utils');
 
 const REGEX = /^\w+:\/\/.*/;
 const downloader = cc.assetManager.downloader;
@@ -176,6 +176,11 @@ function parseArrayBuffer (url, options, onComplete) {
     readArrayBuffer(url, onComplete);
 }
 
+// .bin assets (meshes, buffer assets) and CCON chunks are copied straight from the mapped file or pack
+function parseArrayBufferView (url, options, onComplete) {
+    readArrayBufferView(url, onComplete);
+}
+
 function downloadJson (url, options, onComplete) {
     download(url, parseJson, options, options.onFileProgress, onComplete);
 } 
@@ -257,7 +262,7 @@ const downloadCCONB = (url, options, onComplete) => {
 };
 
 function downloadArrayBuffer (url, options, onComplete) {
-    download(url, parseArrayBuffer, options, options.onFileProgress, onComplete);
+    download(url, parseArrayBufferView, options, options.onFileProgress, onComplete);
 }
 
 function loadFont (url, options, onComplete) {
@@ -396,7 +401,7 @@ parser.register({
     '.astc': downloader.downloadDomImage,
 
     '.binary' : parseArrayBuffer,
-    '.bin' : parseArrayBuffer,
+    '.bin' : parseArrayBufferView,
     '.dbbin': parseArrayBuffer,
     '.skel': parseArrayBuffer,
 